@@ -0,0 +1,389 @@
+/***************************************************************************
+ *                                                                         *
+ *   @file   vbatchexport.cpp                                              *
+ *   @author Seamly2D project                                              *
+ *   @date   10.16.2026                                                    *
+ *   Copyright (C) 2017  Seamly, LLC                                       *
+ *                                                                         *
+ *   https://github.com/fashionfreedom/seamly2d                            *
+ *                                                                         *
+ ***************************************************************************
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **************************************************************************/
+
+#include "vbatchexport.h"
+#include "../vmisc/commandoptions.h"
+#include "../vmisc/vsysexits.h"
+
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QProcess>
+#include <QSharedPointer>
+#include <QTemporaryDir>
+#include <QTextStream>
+#include <QtDebug>
+
+namespace
+{
+const QChar manifestSeparator = QLatin1Char(';');
+const QChar reportSeparator = QLatin1Char('\t');
+
+//---------------------------------------------------------------------------------------------------------------------
+QString AbsolutePath(const QDir &base, const QString &path)
+{
+    return path.isEmpty() ? path : QDir::cleanPath(base.absoluteFilePath(path));
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief BaseName base name of exported files. Pattern's name plus size and height if they were set, so jobs for the
+ * same pattern can share a destination.
+ */
+QString VBatchJob::BaseName() const
+{
+    QString name = QFileInfo(pattern).completeBaseName();
+    if (not gradationSize.isEmpty())
+    {
+        name += QLatin1Char('_') + gradationSize;
+    }
+
+    if (not gradationHeight.isEmpty())
+    {
+        name += QLatin1Char('_') + gradationHeight;
+    }
+    return name;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SamePattern check if the job can reuse the pattern loaded for this one. Only size and height may differ, and
+ * only if the job sets them again.
+ */
+bool VBatchJob::SamePattern(const VBatchJob &job) const
+{
+    return pattern == job.pattern and measurements == job.measurements
+            and gradationSize.isEmpty() == job.gradationSize.isEmpty()
+            and gradationHeight.isEmpty() == job.gradationHeight.isEmpty();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ReadManifest read list of jobs.
+ * @param fileName manifest file.
+ * @param error error description, empty on success.
+ * @return jobs in order of appearance.
+ */
+QVector<VBatchJob> VBatchExport::ReadManifest(const QString &fileName, QString &error)
+{
+    QVector<VBatchJob> jobs;
+    error.clear();
+
+    QFile file(fileName);
+    if (not file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        error = tr("Can't open manifest %1: %2.").arg(fileName, file.errorString());
+        return jobs;
+    }
+
+    const QDir base = QFileInfo(fileName).absoluteDir();
+    QTextStream in(&file);
+    in.setCodec("UTF-8");
+    int lineNumber = 0;
+    while (not in.atEnd())
+    {
+        ++lineNumber;
+        const QString line = in.readLine().trimmed();
+        if (line.isEmpty() || line.startsWith(QLatin1Char('#')))
+        {
+            continue;
+        }
+
+        const QStringList fields = line.split(manifestSeparator);
+        if (fields.size() > 6 || fields.at(0).trimmed().isEmpty())
+        {
+            error = tr("Invalid job in manifest %1 on line %2.").arg(fileName).arg(lineNumber);
+            return QVector<VBatchJob>();
+        }
+
+        auto Field = [&fields](int i)
+        {
+            return i < fields.size() ? fields.at(i).trimmed() : QString();
+        };
+
+        VBatchJob job;
+        job.line = lineNumber;
+        job.pattern = AbsolutePath(base, Field(0));
+        job.measurements = AbsolutePath(base, Field(1));
+
+        if (not Field(4).isEmpty())
+        {
+            bool ok = false;
+            job.format = Field(4).toInt(&ok);
+            if (not ok)
+            {
+                error = tr("Invalid format number in manifest %1 on line %2.").arg(fileName).arg(lineNumber);
+                return QVector<VBatchJob>();
+            }
+        }
+
+        job.destination = Field(5).isEmpty() ? base.absolutePath() : AbsolutePath(base, Field(5));
+
+        // Sweep keeps jobs of one pattern together, so they can reuse the parsed pattern
+        const QStringList sizes = Field(2).split(QLatin1Char(','));
+        const QStringList heights = Field(3).split(QLatin1Char(','));
+        for (int s = 0; s < sizes.size(); ++s)
+        {
+            for (int h = 0; h < heights.size(); ++h)
+            {
+                job.gradationSize = sizes.at(s).trimmed();
+                job.gradationHeight = heights.at(h).trimmed();
+                jobs.append(job);
+            }
+        }
+    }
+
+    return jobs;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief WriteManifest write jobs with absolute paths. Original line numbers are not kept.
+ */
+bool VBatchExport::WriteManifest(const QString &fileName, const QVector<VBatchJob> &jobs)
+{
+    QFile file(fileName);
+    if (not file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        return false;
+    }
+
+    QTextStream out(&file);
+    out.setCodec("UTF-8");
+    for (int i = 0; i < jobs.size(); ++i)
+    {
+        const VBatchJob &job = jobs.at(i);
+        out << QStringList({job.pattern, job.measurements, job.gradationSize, job.gradationHeight,
+                            QString::number(job.format), job.destination}).join(manifestSeparator) << '\n';
+    }
+    out.flush();
+    return out.status() == QTextStream::Ok;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SplitByPattern split jobs into runs of consecutive jobs that share a pattern, see VBatchJob::SamePattern().
+ * Pattern of a run is parsed once, its sizes and heights can be evaluated in parallel.
+ * @param jobs all jobs.
+ * @return runs in order of jobs.
+ */
+QVector<QVector<VBatchJob>> VBatchExport::SplitByPattern(const QVector<VBatchJob> &jobs)
+{
+    QVector<QVector<VBatchJob>> runs;
+    for (int i = 0; i < jobs.size(); ++i)
+    {
+        if (runs.isEmpty() or not runs.last().last().SamePattern(jobs.at(i)))
+        {
+            runs.append(QVector<VBatchJob>());
+        }
+        runs.last().append(jobs.at(i));
+    }
+    return runs;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief RunWorkers split jobs between worker processes and wait for all of them.
+ *
+ * Fallback for manifests where no two consecutive jobs share a pattern. Parsing creates tools and scene items that
+ * exist once per process, so different patterns can't be parsed in parallel threads. Each worker gets a contiguous part
+ * of jobs and exports them one by one, paying application startup once.
+ * @param jobs all jobs.
+ * @param workers number of processes to start.
+ * @param arguments options shared by all jobs (layout settings etc.).
+ * @return results in order of jobs.
+ */
+QVector<VBatchResult> VBatchExport::RunWorkers(const QVector<VBatchJob> &jobs, int workers,
+                                               const QStringList &arguments)
+{
+    QVector<VBatchResult> results;
+    if (jobs.isEmpty())
+    {
+        return results;
+    }
+
+    QTemporaryDir dir;
+    if (not dir.isValid())
+    {
+        qCritical() << tr("Can't create temporary folder for batch workers.");
+        return results;
+    }
+
+    // Contiguous parts keep jobs of one pattern in one worker, it parses the pattern once for all of them
+    workers = qBound(1, workers, jobs.size());
+    QVector<int> firstJob(workers + 1);
+    QVector<QVector<VBatchJob>> parts(workers);
+    for (int worker = 0; worker < workers; ++worker)
+    {
+        firstJob[worker] = worker * jobs.size() / workers;
+        firstJob[worker + 1] = (worker + 1) * jobs.size() / workers;
+        parts[worker] = jobs.mid(firstJob.at(worker), firstJob.at(worker + 1) - firstJob.at(worker));
+    }
+
+    QVector<QSharedPointer<QProcess>> processes;
+    QStringList reports;
+    for (int i = 0; i < workers; ++i)
+    {
+        const QString manifest = dir.path() + QStringLiteral("/jobs%1.txt").arg(i);
+        const QString report = dir.path() + QStringLiteral("/report%1.txt").arg(i);
+        reports.append(report);
+
+        if (not WriteManifest(manifest, parts.at(i)))
+        {
+            qCritical() << tr("Can't write manifest for batch worker %1.").arg(i);
+            continue;
+        }
+
+        QStringList workerArguments = arguments;
+        workerArguments << QLatin1String("--") + LONG_OPTION_BATCH << manifest
+                        << QLatin1String("--") + LONG_OPTION_BATCHJOBS << QStringLiteral("1")
+                        << QLatin1String("--") + LONG_OPTION_BATCHREPORT << report;
+
+        QSharedPointer<QProcess> process(new QProcess());
+        process->setProcessChannelMode(QProcess::ForwardedChannels);
+        process->start(QCoreApplication::applicationFilePath(), workerArguments);
+        processes.append(process);
+    }
+
+    for (int i = 0; i < processes.size(); ++i)
+    {
+        processes.at(i)->waitForFinished(-1);
+    }
+
+    // A crashed worker leaves its jobs without results, they stay failed
+    results.reserve(jobs.size());
+    for (int i = 0; i < jobs.size(); ++i)
+    {
+        VBatchResult result;
+        result.line = jobs.at(i).line;
+        result.name = jobs.at(i).BaseName();
+        result.error = tr("Worker didn't finish the job.");
+        results.append(result);
+    }
+
+    for (int worker = 0; worker < reports.size(); ++worker)
+    {
+        const QVector<VBatchResult> finished = ReadReport(reports.at(worker));
+        for (int i = 0; i < finished.size(); ++i)
+        {
+            // Worker's manifest has one job per line, line n is the job n-1 of its part
+            const int index = firstJob.at(worker) + finished.at(i).line - 1;
+            if (index >= firstJob.at(worker) && index < firstJob.at(worker + 1))
+            {
+                VBatchResult &result = results[index];
+                result.ok = finished.at(i).ok;
+                result.elapsed = finished.at(i).elapsed;
+                result.error = finished.at(i).error;
+            }
+        }
+    }
+
+    return results;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VBatchExport::WriteReport(const QString &fileName, const QVector<VBatchResult> &results)
+{
+    QFile file(fileName);
+    if (not file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        return false;
+    }
+
+    QTextStream out(&file);
+    out.setCodec("UTF-8");
+    for (int i = 0; i < results.size(); ++i)
+    {
+        const VBatchResult &result = results.at(i);
+        out << QStringList({QString::number(result.line), result.ok ? QStringLiteral("ok") : QStringLiteral("failed"),
+                            QString::number(result.elapsed), result.name,
+                            QString(result.error).replace(reportSeparator, QLatin1Char(' '))
+                                                 .replace(QLatin1Char('\n'), QLatin1Char(' '))})
+               .join(reportSeparator) << '\n';
+    }
+    out.flush();
+    return out.status() == QTextStream::Ok;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<VBatchResult> VBatchExport::ReadReport(const QString &fileName)
+{
+    QVector<VBatchResult> results;
+
+    QFile file(fileName);
+    if (not file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        return results;
+    }
+
+    QTextStream in(&file);
+    in.setCodec("UTF-8");
+    while (not in.atEnd())
+    {
+        const QStringList fields = in.readLine().split(reportSeparator);
+        if (fields.size() < 5)
+        {
+            continue;
+        }
+
+        VBatchResult result;
+        result.line = fields.at(0).toInt();
+        result.ok = fields.at(1) == QLatin1String("ok");
+        result.elapsed = fields.at(2).toLongLong();
+        result.name = fields.at(3);
+        result.error = fields.at(4);
+        results.append(result);
+    }
+    return results;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VBatchExport::PrintSummary(const QVector<VBatchResult> &results)
+{
+    int failed = 0;
+    qint64 total = 0;
+    for (int i = 0; i < results.size(); ++i)
+    {
+        const VBatchResult &result = results.at(i);
+        total += result.elapsed;
+        if (result.ok)
+        {
+            vStdOut() << tr("Line %1: %2 exported in %3 ms.").arg(result.line).arg(result.name).arg(result.elapsed)
+                      << "\n";
+        }
+        else
+        {
+            ++failed;
+            vStdOut() << tr("Line %1: %2 failed after %3 ms. %4").arg(result.line).arg(result.name)
+                         .arg(result.elapsed).arg(result.error) << "\n";
+        }
+    }
+
+    vStdOut() << tr("Batch finished: %1 jobs, %2 failed, %3 ms of job time.").arg(results.size()).arg(failed)
+                 .arg(total) << "\n";
+    vStdOut().flush();
+}
@@ -0,0 +1,87 @@
+/***************************************************************************
+ *                                                                         *
+ *   @file   vbatchexport.h                                                *
+ *   @author Seamly2D project                                              *
+ *   @date   10.16.2026                                                    *
+ *   Copyright (C) 2017  Seamly, LLC                                       *
+ *                                                                         *
+ *   https://github.com/fashionfreedom/seamly2d                            *
+ *                                                                         *
+ ***************************************************************************
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **************************************************************************/
+
+#ifndef VBATCHEXPORT_H
+#define VBATCHEXPORT_H
+
+#include <QCoreApplication>
+#include <QString>
+#include <QStringList>
+#include <QVector>
+
+/**
+ * @brief The VBatchJob struct one line of a batch export manifest.
+ *
+ * Manifest is a text file with one job per line: pattern;measurements;gsize;gheight;format;destination. Only pattern is
+ * required. Empty lines and lines starting with '#' are skipped. Relative paths are resolved against the manifest's
+ * folder. Sizes and heights may be comma separated lists, such a line gives a job for each size and height pair.
+ */
+struct VBatchJob
+{
+    int     line{0};
+    QString pattern{};
+    QString measurements{};
+    QString gradationSize{};
+    QString gradationHeight{};
+    int     format{0};
+    QString destination{};
+
+    QString BaseName() const;
+    bool    SamePattern(const VBatchJob &job) const;
+};
+
+/**
+ * @brief The VBatchResult struct outcome of one batch job.
+ */
+struct VBatchResult
+{
+    int     line{0};
+    bool    ok{false};
+    qint64  elapsed{0};
+    QString name{};
+    QString error{};
+};
+
+class VBatchExport
+{
+    Q_DECLARE_TR_FUNCTIONS(VBatchExport)
+public:
+    static QVector<VBatchJob> ReadManifest(const QString &fileName, QString &error);
+    static bool               WriteManifest(const QString &fileName, const QVector<VBatchJob> &jobs);
+
+    static QVector<QVector<VBatchJob>> SplitByPattern(const QVector<VBatchJob> &jobs);
+    static QVector<VBatchResult> RunWorkers(const QVector<VBatchJob> &jobs, int workers,
+                                            const QStringList &arguments);
+
+    static bool               WriteReport(const QString &fileName, const QVector<VBatchResult> &results);
+    static QVector<VBatchResult> ReadReport(const QString &fileName);
+    static void               PrintSummary(const QVector<VBatchResult> &results);
+
+private:
+    Q_DISABLE_COPY(VBatchExport)
+};
+
+#endif // VBATCHEXPORT_H
@@ -29,12 +29,14 @@
 #include "vcmdexport.h"
 #include "../dialogs/dialoglayoutsettings.h"
 #include "../dialogs/dialogsavelayout.h"
+#include "../ifc/xml/vabstractconverter.h"
 #include "../ifc/xml/vdomdocument.h"
 #include "../vformat/vmeasurements.h"
 #include "../vmisc/commandoptions.h"
 #include "../vmisc/vsettings.h"
 #include "../vlayout/vlayoutgenerator.h"
 #include <QDebug>
+#include <QThread>
 
 VCommandLinePtr VCommandLine::instance = nullptr;
 
@@ -258,6 +260,52 @@ void VCommandLine::InitOptions(VCommandLineOptions &options, QMap<QString, int>
                                           .arg(DialogLayoutSettings::MakeGroupsHelp()),
                                           translate("VCommandLine", "Grouping type"), "2"));
 
+    optionsIndex.insert(LONG_OPTION_ENGINE, index++);
+    options.append(new QCommandLineOption(QStringList() << LONG_OPTION_ENGINE,
+                                          translate("VCommandLine", "Sets layout nesting engine (export mode): %1.")
+                                          .arg(DialogLayoutSettings::MakeEnginesHelp()),
+                                          translate("VCommandLine", "Engine type"), "0"));
+
+    optionsIndex.insert(LONG_OPTION_ATTEMPTS, index++);
+    options.append(new QCommandLineOption(QStringList() << LONG_OPTION_ATTEMPTS,
+                                          translate("VCommandLine", "Number of layouts with different options "
+                                                    "generated at the same time, the best one is kept (export mode). "
+                                                    "Default value is 1."),
+                                          translate("VCommandLine", "The attempts count"), "1"));
+
+    optionsIndex.insert(LONG_OPTION_TIMEBUDGET, index++);
+    options.append(new QCommandLineOption(QStringList() << LONG_OPTION_TIMEBUDGET,
+                                          translate("VCommandLine", "Time limit in seconds for several layout "
+                                                    "attempts (export mode). Running attempts are stopped once the "
+                                                    "limit is reached and at least one attempt has finished. 0 means "
+                                                    "no limit."),
+                                          translate("VCommandLine", "Seconds"), "0"));
+
+    //=================================================================================================================
+    optionsIndex.insert(LONG_OPTION_BATCH, index++);
+    options.append(new QCommandLineOption(QStringList() << LONG_OPTION_BATCH,
+                                          translate("VCommandLine", "Export many patterns in one run. The manifest has "
+                                                    "one job per line: pattern;measurements;gsize;gheight;format;"
+                                                    "destination. Only pattern is required, relative paths are "
+                                                    "resolved against the manifest's folder. gsize and gheight may be "
+                                                    "comma-separated lists to sweep a multisize pattern. Layout "
+                                                    "options apply to all jobs."),
+                                          translate("VCommandLine", "The manifest file")));
+
+    optionsIndex.insert(LONG_OPTION_BATCHJOBS, index++);
+    options.append(new QCommandLineOption(QStringList() << LONG_OPTION_BATCHJOBS,
+                                          translate("VCommandLine", "Number of threads evaluating sizes and "
+                                                    "heights of a pattern in parallel (batch mode). If no two "
+                                                    "consecutive jobs share a pattern, jobs are split between as many "
+                                                    "worker processes. 0 means one per processor core."),
+                                          translate("VCommandLine", "The workers count"), "0"));
+
+    optionsIndex.insert(LONG_OPTION_BATCHREPORT, index++);
+    options.append(new QCommandLineOption(QStringList() << LONG_OPTION_BATCHREPORT,
+                                          translate("VCommandLine", "Write tab separated report with result and time "
+                                                    "of each job (batch mode)."),
+                                          translate("VCommandLine", "The report file")));
+
     optionsIndex.insert(LONG_OPTION_TEST, index++);
     options.append(new QCommandLineOption(QStringList() << SINGLE_OPTION_TEST << LONG_OPTION_TEST,
                                           translate("VCommandLine", "Run the program in a test mode. The program in "
@@ -265,6 +313,23 @@ void VCommandLine::InitOptions(VCommandLineOptions &options, QMap<QString, int>
                                                     "showing the main window. The key have priority before key '%1'.")
                                                     .arg(LONG_OPTION_BASENAME)));
 
+    optionsIndex.insert(LONG_OPTION_TESTINCREMENTAL, index++);
+    options.append(new QCommandLineOption(QStringList() << LONG_OPTION_TESTINCREMENTAL,
+                                          translate("VCommandLine", "Check incremental recalculation (test mode). "
+                                                    "Size and height set by '%1' and '%2' are compared with a full "
+                                                    "parse. Then each length formula in turn is changed, the pattern "
+                                                    "is recalculated incrementally and compared with a full parse. "
+                                                    "Exit with an error if they differ.")
+                                          .arg(LONG_OPTION_GRADATIONSIZE, LONG_OPTION_GRADATIONHEIGHT)));
+
+    optionsIndex.insert(LONG_OPTION_TESTGRADATIONS, index++);
+    options.append(new QCommandLineOption(QStringList() << LONG_OPTION_TESTGRADATIONS,
+                                          translate("VCommandLine", "Check parallel evaluation of gradations (test "
+                                                    "mode, multisize measurements). The pattern is calculated for the "
+                                                    "smallest, current and biggest size and height at once and "
+                                                    "compared with parsing it for each of them in turn. Exit with an "
+                                                    "error if they differ.")));
+
     optionsIndex.insert(LONG_OPTION_NO_HDPI_SCALING, index++);
     options.append(new QCommandLineOption(QStringList() << LONG_OPTION_NO_HDPI_SCALING,
                                           translate("VCommandLine", "Disable high dpi scaling. Call this option if has "
@@ -435,6 +500,9 @@ VLayoutGeneratorPtr VCommandLine::DefaultGenerator() const
     diag.SetUnitePages(parser.isSet(*optionsUsed.value(optionsIndex.value(LONG_OPTION_UNITE))));
     diag.SetSaveLength(parser.isSet(*optionsUsed.value(optionsIndex.value(LONG_OPTION_SAVELENGTH))));
     diag.SetGroup(OptGroup());
+    diag.SetEngine(OptEngine());
+    diag.SetAttempts(OptAttempts());
+    diag.SetTimeBudget(OptTimeBudget());
 
     if (parser.isSet(*optionsUsed.value(optionsIndex.value(LONG_OPTION_IGNORE_MARGINS))))
     {
@@ -493,7 +561,13 @@ VCommandLinePtr VCommandLine::Get(const QCoreApplication& app)
     instance->parser.process(app);
 
     //fixme: in case of additional options/modes which will need to disable GUI - add it here too
-    instance->isGuiEnabled = not (instance->IsExportEnabled() || instance->IsTestModeEnabled());
+    instance->isGuiEnabled = not (instance->IsExportEnabled() || instance->IsTestModeEnabled()
+                                  || instance->IsBatchEnabled());
+
+    // Test mode checks each step of converting an old file
+    VAbstractConverter::SetIntermediateValidation(instance->IsTestModeEnabled());
+    // Without GUI nobody edits the document, read it the faster way
+    VDomDocument::SetStreamLoading(not instance->isGuiEnabled);
 
     return instance;
 }
@@ -541,6 +615,82 @@ bool VCommandLine::IsExportEnabled() const
     return r;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+bool VCommandLine::IsTestIncrementalEnabled() const
+{
+    return parser.isSet(*optionsUsed.value(optionsIndex.value(LONG_OPTION_TESTINCREMENTAL)));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VCommandLine::IsTestGradationsEnabled() const
+{
+    return parser.isSet(*optionsUsed.value(optionsIndex.value(LONG_OPTION_TESTGRADATIONS)));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VCommandLine::IsBatchEnabled() const
+{
+    return parser.isSet(*optionsUsed.value(optionsIndex.value(LONG_OPTION_BATCH)));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QString VCommandLine::OptBatchManifest() const
+{
+    return parser.value(*optionsUsed.value(optionsIndex.value(LONG_OPTION_BATCH)));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VCommandLine::OptBatchJobs() const
+{
+    bool ok = false;
+    const int jobs = parser.value(*optionsUsed.value(optionsIndex.value(LONG_OPTION_BATCHJOBS))).toInt(&ok);
+    if (not ok || jobs < 0)
+    {
+        qCritical() << translate("VCommandLine", "Invalid workers count.") << "\n";
+        const_cast<VCommandLine*>(this)->parser.showHelp(V_EX_USAGE);
+    }
+    return jobs == 0 ? qMax(QThread::idealThreadCount(), 1) : jobs;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QString VCommandLine::OptBatchReport() const
+{
+    return parser.value(*optionsUsed.value(optionsIndex.value(LONG_OPTION_BATCHREPORT)));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief BatchWorkerArguments options a batch worker process must get: everything set by user except options that
+ * describe a job or the batch itself.
+ */
+QStringList VCommandLine::BatchWorkerArguments() const
+{
+    const QStringList skip = QStringList() << LONG_OPTION_BATCH << LONG_OPTION_BATCHJOBS << LONG_OPTION_BATCHREPORT
+                                           << LONG_OPTION_BASENAME << LONG_OPTION_DESTINATION
+                                           << LONG_OPTION_MEASUREFILE << LONG_OPTION_EXP2FORMAT
+                                           << LONG_OPTION_GRADATIONSIZE << LONG_OPTION_GRADATIONHEIGHT
+                                           << LONG_OPTION_TEST << LONG_OPTION_TESTINCREMENTAL
+                                           << LONG_OPTION_TESTGRADATIONS;
+
+    QStringList arguments;
+    for (int i = 0; i < optionsUsed.size(); ++i)
+    {
+        const QCommandLineOption *option = optionsUsed.at(i);
+        const QString name = option->names().last();
+        if (skip.contains(name) || not parser.isSet(*option))
+        {
+            continue;
+        }
+
+        arguments << QLatin1String("--") + name;
+        if (not option->valueName().isEmpty())
+        {
+            arguments << parser.value(*option);
+        }
+    }
+    return arguments;
+}
+
 //------------------------------------------------------------------------------------------------------
 DialogLayoutSettings::PaperSizeTemplate VCommandLine::OptPaperSize() const
 {
@@ -581,6 +731,43 @@ Cases VCommandLine::OptGroup() const
     return static_cast<Cases>(r);
 }
 
+//------------------------------------------------------------------------------------------------------
+LayoutEngine VCommandLine::OptEngine() const
+{
+    int e = parser.value(*optionsUsed.value(optionsIndex.value(LONG_OPTION_ENGINE))).toInt();
+    if ( e < 0 || e >= static_cast<int>(LayoutEngine::UnknownEngine))
+    {
+        e = 0;
+    }
+    return static_cast<LayoutEngine>(e);
+}
+
+//------------------------------------------------------------------------------------------------------
+int VCommandLine::OptAttempts() const
+{
+    bool ok = false;
+    const int attempts = parser.value(*optionsUsed.value(optionsIndex.value(LONG_OPTION_ATTEMPTS))).toInt(&ok);
+    if (not ok || attempts < 1)
+    {
+        qCritical() << translate("VCommandLine", "Invalid attempts count.") << "\n";
+        const_cast<VCommandLine*>(this)->parser.showHelp(V_EX_USAGE);
+    }
+    return attempts;
+}
+
+//------------------------------------------------------------------------------------------------------
+int VCommandLine::OptTimeBudget() const
+{
+    bool ok = false;
+    const int budget = parser.value(*optionsUsed.value(optionsIndex.value(LONG_OPTION_TIMEBUDGET))).toInt(&ok);
+    if (not ok || budget < 0)
+    {
+        qCritical() << translate("VCommandLine", "Invalid time limit.") << "\n";
+        const_cast<VCommandLine*>(this)->parser.showHelp(V_EX_USAGE);
+    }
+    return budget;
+}
+
 //------------------------------------------------------------------------------------------------------
 QString VCommandLine::OptMeasurePath() const
 {
@@ -56,6 +56,12 @@ class VCommandLine
     //case test mode enabled
     bool IsTestModeEnabled() const;
 
+    //@brief tests if user asked to compare incremental recalculation with full parsing in test mode
+    bool IsTestIncrementalEnabled() const;
+
+    //@brief tests if user asked to compare parallel evaluation of gradations with sequential parsing in test mode
+    bool IsTestGradationsEnabled() const;
+
     bool IsNoScalingEnabled() const;
 
     //@brief tests if user enabled export from cmd, throws exception if not exactly 1 input VAL file supplied in case
@@ -94,6 +100,14 @@ class VCommandLine
     QString OptGradationSize() const;
     QString OptGradationHeight() const;
 
+    //@brief tests if user asked to export jobs from a manifest
+    bool IsBatchEnabled() const;
+    QString OptBatchManifest() const;
+    //@brief returns number of batch threads or worker processes, one per core if not set
+    int OptBatchJobs() const;
+    QString OptBatchReport() const;
+    QStringList BatchWorkerArguments() const;
+
 protected:
 
     VCommandLine();
@@ -104,6 +118,9 @@ class VCommandLine
     int OptRotation() const;
 
     Cases OptGroup() const;
+    LayoutEngine OptEngine() const;
+    int OptAttempts() const;
+    int OptTimeBudget() const;
 
     //@brief: called in destructor of application, so instance destroyed and new maybe created (never happen scenario though)
     static void Reset();
@@ -92,6 +92,7 @@ PreferencesPatternPage::PreferencesPatternPage(QWidget *parent)
     ui->forbidFlipping_CheckBox->setChecked(qApp->Seamly2DSettings()->GetForbidWorkpieceFlipping());
     ui->showSecondNotch_CheckBox->setChecked(qApp->Seamly2DSettings()->showSecondNotch());
     ui->hideMainPath_CheckBox->setChecked(qApp->Seamly2DSettings()->IsHideMainPath());
+    ui->curveApproximationScale_DoubleSpinBox->setValue(qApp->Seamly2DSettings()->GetCurveApproximationScale());
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -124,6 +125,12 @@ void PreferencesPatternPage::Apply()
         qApp->getCurrentDocument()->LiteParseTree(Document::LiteParse);
     }
 
+    if (not qFuzzyCompare(settings->GetCurveApproximationScale(), ui->curveApproximationScale_DoubleSpinBox->value()))
+    {
+        settings->SetCurveApproximationScale(ui->curveApproximationScale_DoubleSpinBox->value());
+        qApp->getCurrentDocument()->LiteParseTree(Document::LiteParse);
+    }
+
     settings->SetLabelDateFormat(ui->dateFormats_ComboBox->currentText());
     settings->SetLabelTimeFormat(ui->timeFormats_ComboBox->currentText());
 
@@ -74,6 +74,7 @@ DialogLayoutSettings::DialogLayoutSettings(VLayoutGenerator *generator, QWidget
     //even cleanse lists before adding
     InitPaperUnits();
     InitLayoutUnits();
+    InitEngines();
     InitTemplates(ui->comboBoxTemplates);
     MinimumPaperSize();
     MinimumLayoutSize();
@@ -356,6 +357,71 @@ void DialogLayoutSettings::SetTextAsPaths(bool value)
     ui->checkBoxTextAsPaths->setChecked(value);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+LayoutEngine DialogLayoutSettings::GetEngine() const
+{
+    return static_cast<LayoutEngine>(ui->comboBoxEngine->currentData().toInt());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void DialogLayoutSettings::SetEngine(LayoutEngine engine)
+{
+    int index = ui->comboBoxEngine->findData(static_cast<int>(engine));
+    if (index == -1)
+    {
+        index = ui->comboBoxEngine->findData(static_cast<int>(VSettings::GetDefLayoutEngine()));
+    }
+    ui->comboBoxEngine->setCurrentIndex(index);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int DialogLayoutSettings::GetAttempts() const
+{
+    return ui->spinBoxAttempts->value();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void DialogLayoutSettings::SetAttempts(int value)
+{
+    ui->spinBoxAttempts->setValue(value);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int DialogLayoutSettings::GetTimeBudget() const
+{
+    return ui->spinBoxTimeBudget->value();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void DialogLayoutSettings::SetTimeBudget(int value)
+{
+    ui->spinBoxTimeBudget->setValue(value);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool DialogLayoutSettings::IsIncremental() const
+{
+    return ui->checkBoxIncremental->isChecked();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void DialogLayoutSettings::SetIncremental(bool value)
+{
+    ui->checkBoxIncremental->setChecked(value);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int DialogLayoutSettings::GetIncrementalThreshold() const
+{
+    return ui->spinBoxIncrementalThreshold->value();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void DialogLayoutSettings::SetIncrementalThreshold(int value)
+{
+    ui->spinBoxIncrementalThreshold->setValue(value);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 QString DialogLayoutSettings::SelectedPrinter() const
 {
@@ -484,6 +550,12 @@ QString DialogLayoutSettings::MakeGroupsHelp()
     return tr("\n\tThree groups: big, middle, small = 0;\n\tTwo groups: big, small = 1;\n\tDescending area = 2");
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+QString DialogLayoutSettings::MakeEnginesHelp()
+{
+    return tr("\n\tEdge contour = 0;\n\tNo-fit polygon = 1");
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void DialogLayoutSettings::showEvent(QShowEvent *event)
 {
@@ -590,6 +662,11 @@ void DialogLayoutSettings::DialogAccepted()
     generator->SetStripOptimization(IsStripOptimization());
     generator->SetMultiplier(GetMultiplier());
     generator->SetTestAsPaths(IsTextAsPaths());
+    generator->SetEngine(GetEngine());
+    generator->SetAttempts(GetAttempts());
+    generator->SetTimeBudget(GetTimeBudget());
+    generator->SetIncremental(IsIncremental());
+    generator->SetIncrementalThreshold(GetIncrementalThreshold());
 
     if (IsIgnoreAllFields())
     {
@@ -678,6 +755,11 @@ void DialogLayoutSettings::RestoreDefaults()
     SetFields(GetDefPrinterFields());
     SetIgnoreAllFields(VSettings::GetDefIgnoreAllFields());
     SetMultiplier(VSettings::GetDefMultiplier());
+    SetEngine(VSettings::GetDefLayoutEngine());
+    SetAttempts(VSettings::GetDefLayoutAttempts());
+    SetTimeBudget(VSettings::GetDefLayoutTimeBudget());
+    SetIncremental(VSettings::GetDefLayoutIncremental());
+    SetIncrementalThreshold(VSettings::GetDefLayoutIncrementalThreshold());
 
     CorrectMaxFileds();
     IgnoreAllFields(ui->checkBoxIgnoreFileds->isChecked());
@@ -757,6 +839,13 @@ void DialogLayoutSettings::InitLayoutUnits()
     }
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+void DialogLayoutSettings::InitEngines()
+{
+    ui->comboBoxEngine->addItem(tr("Edge contour"), QVariant(static_cast<int>(LayoutEngine::Contour)));
+    ui->comboBoxEngine->addItem(tr("No-fit polygon"), QVariant(static_cast<int>(LayoutEngine::Nfp)));
+}
+
 
 //---------------------------------------------------------------------------------------------------------------------
 void DialogLayoutSettings::InitPrinter()
@@ -1005,6 +1094,11 @@ void DialogLayoutSettings::ReadSettings()
     SetStripOptimization(settings->GetStripOptimization());
     SetMultiplier(settings->GetMultiplier());
     SetTextAsPaths(settings->GetTextAsPaths());
+    SetEngine(settings->GetLayoutEngine());
+    SetAttempts(settings->GetLayoutAttempts());
+    SetTimeBudget(settings->GetLayoutTimeBudget());
+    SetIncremental(settings->GetLayoutIncremental());
+    SetIncrementalThreshold(settings->GetLayoutIncrementalThreshold());
 
     FindTemplate();
 
@@ -1031,6 +1125,11 @@ void DialogLayoutSettings::WriteSettings() const
     settings->SetStripOptimization(IsStripOptimization());
     settings->SetMultiplier(GetMultiplier());
     settings->SetTextAsPaths(IsTextAsPaths());
+    settings->SetLayoutEngine(GetEngine());
+    settings->SetLayoutAttempts(GetAttempts());
+    settings->SetLayoutTimeBudget(GetTimeBudget());
+    settings->SetLayoutIncremental(IsIncremental());
+    settings->SetLayoutIncrementalThreshold(GetIncrementalThreshold());
 }
 
 //---------------------------------------------------------------------------------------------------------------------
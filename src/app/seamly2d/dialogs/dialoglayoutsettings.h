@@ -56,6 +56,7 @@
 #include "vabstractlayoutdialog.h"
 
 #include "../vlayout/vbank.h"
+#include "../vlayout/vlayoutdef.h"
 #include "../ifc/ifcdef.h"
 
 #if QT_VERSION < QT_VERSION_CHECK(5, 3, 0)
@@ -123,6 +124,21 @@ class DialogLayoutSettings : public VAbstractLayoutDialog
     bool IsTextAsPaths() const;
     void SetTextAsPaths(bool value);
 
+    LayoutEngine GetEngine() const;
+    void         SetEngine(LayoutEngine engine);
+
+    int  GetAttempts() const;
+    void SetAttempts(int value);
+
+    int  GetTimeBudget() const;
+    void SetTimeBudget(int value);
+
+    bool IsIncremental() const;
+    void SetIncremental(bool value);
+
+    int  GetIncrementalThreshold() const;
+    void SetIncrementalThreshold(int value);
+
     QString SelectedPrinter() const;
 
     //support functions for the command line parser which uses invisible dialog to properly build layout generator
@@ -133,6 +149,7 @@ class DialogLayoutSettings : public VAbstractLayoutDialog
     qreal LayoutToPixels(qreal value) const;
     qreal PageToPixels(qreal value) const;
     static QString MakeGroupsHelp();
+    static QString MakeEnginesHelp();
 protected:
     virtual void showEvent(QShowEvent *event) Q_DECL_OVERRIDE;
     QSizeF GetTemplateSize(const PaperSizeTemplate &tmpl, const Unit &unit) const;
@@ -167,6 +184,7 @@ private slots:
 
     void InitPaperUnits();
     void InitLayoutUnits();
+    void InitEngines();
     void InitPrinter();
     QSizeF Template();
 
@@ -86,6 +86,7 @@ DialogPatternProperties::DialogPatternProperties(VPattern *doc,  VContainer *pat
       labelDataChanged(false),
       askSaveLabelData(false),
       templateDataChanged(false),
+      approximationChanged(false),
       deleteAction(nullptr),
       changeImageAction(nullptr),
       saveImageAction(nullptr),
@@ -128,6 +129,7 @@ DialogPatternProperties::DialogPatternProperties(VPattern *doc,  VContainer *pat
     connect(ui->plainTextEditTechNotes, &QPlainTextEdit::textChanged, this, &DialogPatternProperties::DescEdited);
 
     InitImage();
+    InitCurveApproximationScale();
 
     connect(ui->buttonBox->button(QDialogButtonBox::Ok), &QPushButton::clicked, this, &DialogPatternProperties::Ok);
     connect(ui->buttonBox->button(QDialogButtonBox::Apply), &QPushButton::clicked, this,
@@ -231,6 +233,7 @@ void DialogPatternProperties::Apply()
     {
         case 0:
             SaveDescription();
+            SaveCurveApproximationScale();
             break;
         case 1:
             SaveGradation();
@@ -253,6 +256,7 @@ void DialogPatternProperties::Apply()
 void DialogPatternProperties::Ok()
 {
     SaveDescription();
+    SaveCurveApproximationScale();
     SaveGradation();
     SaveDefValues();
     SaveReadOnlyState();
@@ -575,6 +579,25 @@ void DialogPatternProperties::SaveDescription()
     }
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+void DialogPatternProperties::SaveCurveApproximationScale()
+{
+    if (approximationChanged)
+    {
+        if (ui->checkBoxCurveApproximationScale->isChecked())
+        {
+            doc->SetCurveApproximationScale(ui->doubleSpinBoxCurveApproximationScale->value());
+        }
+        else
+        {
+            doc->ResetCurveApproximationScale();
+        }
+
+        approximationChanged = false;
+        doc->LiteParseTree(Document::LiteParse); // Curves must be flattened again
+    }
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void DialogPatternProperties::SaveGradation()
 {
@@ -639,6 +662,23 @@ void DialogPatternProperties::SaveTemplateData()
     }
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+void DialogPatternProperties::InitCurveApproximationScale()
+{
+    ui->checkBoxCurveApproximationScale->setChecked(doc->HasCurveApproximationScale());
+    ui->doubleSpinBoxCurveApproximationScale->setEnabled(doc->HasCurveApproximationScale());
+    ui->doubleSpinBoxCurveApproximationScale->setValue(doc->GetCurveApproximationScale());
+
+    connect(ui->checkBoxCurveApproximationScale, &QCheckBox::toggled, this, [this](bool checked)
+    {
+        ui->doubleSpinBoxCurveApproximationScale->setEnabled(checked);
+        approximationChanged = true;
+    });
+    connect(ui->doubleSpinBoxCurveApproximationScale,
+            static_cast<void (QDoubleSpinBox::*)(double)>(&QDoubleSpinBox::valueChanged), this,
+            [this](){approximationChanged = true;});
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void DialogPatternProperties::SaveReadOnlyState()
 {
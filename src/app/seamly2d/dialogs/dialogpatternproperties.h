@@ -102,6 +102,7 @@ private slots:
     bool                   labelDataChanged;
     bool                   askSaveLabelData;
     bool                   templateDataChanged;
+    bool                   approximationChanged;
     QAction                *deleteAction;
     QAction                *changeImageAction;
     QAction                *saveImageAction;
@@ -127,6 +128,7 @@ private slots:
     void         SaveLabelData();
     void         SaveTemplateData();
     void         SaveReadOnlyState();
+    void         SaveCurveApproximationScale();
 
     void         SetDefaultHeight(const QString &def);
     void         SetDefaultSize(const QString &def);
@@ -134,6 +136,7 @@ private slots:
     void         UpdateDefHeight();
     void         UpdateDefSize();
     void         InitImage();
+    void         InitCurveApproximationScale();
     QImage       GetImage();
 };
 
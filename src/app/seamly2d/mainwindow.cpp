@@ -88,6 +88,7 @@
 #include "../qmuparser/qmuparsererror.h"
 #include "../vtools/dialogs/support/dialogeditlabel.h"
 
+#include <QElapsedTimer>
 #include <QInputDialog>
 #include <QtDebug>
 #include <QMessageBox>
@@ -595,6 +596,32 @@ bool MainWindow::UpdateMeasurements(const QString &path, int size, int height)
     return true;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief UpdateGradation switch pattern to another size and height.
+ *
+ * Multisize measurements calculate their values from the current size and height, so there is no need to read the
+ * file again. Only tools that depend on measurements are recalculated by the following lite parse. The window shows
+ * the gradation set by the process-wide size and height, VPattern::EvaluateGradations() calculates other gradations
+ * next to it.
+ */
+bool MainWindow::UpdateGradation(int size, int height)
+{
+    if (qApp->patternType() != MeasurementsType::Multisize)
+    {
+        return UpdateMeasurements(AbsoluteMPath(qApp->GetPPath(), doc->MPath()), size, height);
+    }
+
+    VContainer::SetSize(size);
+    VContainer::SetHeight(height);
+
+    doc->SetPatternWasChanged(true);
+    emit doc->UpdatePatternLabel();
+
+    doc->MarkGradationChanged();
+    return true;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void MainWindow::CheckRequiredMeasurements(const VMeasurements *measurements)
 {
@@ -4149,8 +4176,7 @@ void MainWindow::PatternChangesWereSaved(bool saved)
 void MainWindow::ChangedSize(const QString & text)
 {
     const int size = static_cast<int>(VContainer::size());
-    if (UpdateMeasurements(AbsoluteMPath(qApp->GetPPath(), doc->MPath()), text.toInt(),
-                           static_cast<int>(VContainer::height())))
+    if (UpdateGradation(text.toInt(), static_cast<int>(VContainer::height())))
     {
         doc->LiteParseTree(Document::LiteParse);
         emit pieceScene->DimensionsChanged();
@@ -4179,8 +4205,7 @@ void MainWindow::ChangedSize(const QString & text)
 void MainWindow::ChangedHeight(const QString &text)
 {
     const int height = static_cast<int>(VContainer::height());
-    if (UpdateMeasurements(AbsoluteMPath(qApp->GetPPath(), doc->MPath()), static_cast<int>(VContainer::size()),
-                           text.toInt()))
+    if (UpdateGradation(static_cast<int>(VContainer::size()), text.toInt()))
     {
         doc->LiteParseTree(Document::LiteParse);
         emit pieceScene->DimensionsChanged();
@@ -6348,7 +6373,12 @@ void MainWindow::zoomFirstShow()
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-void MainWindow::DoExport(const VCommandLinePtr &expParams)
+/**
+ * @brief DoExport export loaded pattern in console mode.
+ * @return false if export failed. Callers set the exit code.
+ */
+bool MainWindow::DoExport(const VCommandLinePtr &expParams, const QString &baseName, const QString &destination,
+                          int format)
 {
     const QHash<quint32, VPiece> *details = pattern->DataPieces();
     if(not qApp->getOpeningPattern())
@@ -6356,20 +6386,29 @@ void MainWindow::DoExport(const VCommandLinePtr &expParams)
         if (details->count() == 0)
         {
             qCCritical(vMainWindow, "%s", qUtf8Printable(tr("You can't export empty scene.")));
-            qApp->exit(V_EX_DATAERR);
-            return;
+            return false;
         }
     }
     listDetails = PrepareDetailsForLayout(*details);
+    return ExportDetails(expParams, baseName, destination, format);
+}
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ExportDetails export pieces prepared for layout in console mode.
+ * @return false if export failed.
+ */
+bool MainWindow::ExportDetails(const VCommandLinePtr &expParams, const QString &baseName, const QString &destination,
+                               int format)
+{
     const bool exportOnlyDetails = expParams->IsExportOnlyDetails();
     if (exportOnlyDetails)
     {
         try
         {
-            DialogSaveLayout dialog(1, Draw::Modeling, expParams->OptBaseName(), this);
-            dialog.SetDestinationPath(expParams->OptDestinationPath());
-            dialog.SelectFormat(static_cast<LayoutExportFormats>(expParams->OptExportType()));
+            DialogSaveLayout dialog(1, Draw::Modeling, baseName, this);
+            dialog.SetDestinationPath(destination);
+            dialog.SelectFormat(static_cast<LayoutExportFormats>(format));
             dialog.SetBinaryDXFFormat(expParams->IsBinaryDXF());
             dialog.SetTextAsPaths(expParams->IsTextAsPaths());
 
@@ -6378,8 +6417,7 @@ void MainWindow::DoExport(const VCommandLinePtr &expParams)
         catch (const VException &e)
         {
             qCCritical(vMainWindow, "%s\n\n%s", qUtf8Printable(tr("Export error.")), qUtf8Printable(e.ErrorMessage()));
-            qApp->exit(V_EX_DATAERR);
-            return;
+            return false;
         }
     }
     else
@@ -6391,9 +6429,9 @@ void MainWindow::DoExport(const VCommandLinePtr &expParams)
         {
             try
             {
-                DialogSaveLayout dialog(scenes.size(), Draw::Layout, expParams->OptBaseName(), this);
-                dialog.SetDestinationPath(expParams->OptDestinationPath());
-                dialog.SelectFormat(static_cast<LayoutExportFormats>(expParams->OptExportType()));
+                DialogSaveLayout dialog(scenes.size(), Draw::Layout, baseName, this);
+                dialog.SetDestinationPath(destination);
+                dialog.SelectFormat(static_cast<LayoutExportFormats>(format));
                 dialog.SetBinaryDXFFormat(expParams->IsBinaryDXF());
 
                 ExportData(listDetails, dialog);
@@ -6401,17 +6439,277 @@ void MainWindow::DoExport(const VCommandLinePtr &expParams)
             catch (const VException &e)
             {
                 qCCritical(vMainWindow, "%s\n\n%s", qUtf8Printable(tr("Export error.")), qUtf8Printable(e.ErrorMessage()));
-                qApp->exit(V_EX_DATAERR);
-                return;
+                    return false;
             }
         }
         else
         {
-            return;
+            return false;
         }
     }
 
-    qApp->exit(V_EX_OK);
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief DoBatchExport export all jobs from the manifest.
+ *
+ * With one worker jobs run here one by one. Otherwise each run of jobs that share a pattern parses the pattern once and
+ * evaluates its sizes and heights in a thread pool, see RunBatchRun(). Only if no two consecutive jobs share a pattern
+ * there is nothing to run in parallel in one process, and jobs are split between worker processes.
+ * @return exit code.
+ */
+int MainWindow::DoBatchExport(const VCommandLinePtr &expParams)
+{
+    QString error;
+    const QVector<VBatchJob> jobs = VBatchExport::ReadManifest(expParams->OptBatchManifest(), error);
+    if (not error.isEmpty())
+    {
+        qCCritical(vMainWindow, "%s", qUtf8Printable(error));
+        return V_EX_NOINPUT;
+    }
+
+    if (jobs.isEmpty())
+    {
+        qCCritical(vMainWindow, "%s",
+                   qUtf8Printable(tr("Manifest %1 has no jobs.").arg(expParams->OptBatchManifest())));
+        return V_EX_NOINPUT;
+    }
+
+    QVector<VBatchResult> results;
+    const int workers = qMin(expParams->OptBatchJobs(), jobs.size());
+    const QVector<QVector<VBatchJob>> runs = VBatchExport::SplitByPattern(jobs);
+    if (workers > 1 and runs.size() < jobs.size())
+    {
+        results.reserve(jobs.size());
+        for (int i = 0; i < runs.size(); ++i)
+        {
+            results += RunBatchRun(expParams, runs.at(i), workers);
+        }
+    }
+    else if (workers > 1)
+    {
+        results = VBatchExport::RunWorkers(jobs, workers, expParams->BatchWorkerArguments());
+    }
+    else
+    {
+        results.reserve(jobs.size());
+        bool loaded = false;
+        for (int i = 0; i < jobs.size(); ++i)
+        {
+            results.append(RunBatchJob(expParams, jobs.at(i), loaded));
+
+            // Next size or height of the same pattern is recalculated without parsing the file again
+            loaded = results.last().ok and i + 1 < jobs.size() and jobs.at(i).SamePattern(jobs.at(i + 1));
+            if (not loaded)
+            {
+                Clear();
+                setWindowModified(false);
+            }
+        }
+    }
+
+    const QString report = expParams->OptBatchReport();
+    if (not report.isEmpty() and not VBatchExport::WriteReport(report, results))
+    {
+        qCCritical(vMainWindow, "%s", qUtf8Printable(tr("Can't write batch report %1.").arg(report)));
+    }
+    VBatchExport::PrintSummary(results);
+
+    for (int i = 0; i < results.size(); ++i)
+    {
+        if (not results.at(i).ok)
+        {
+            return V_EX_DATAERR;
+        }
+    }
+    return V_EX_OK;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief RunBatchJob export one job.
+ * @param loaded true if the pattern is already loaded by the previous job, then only size and height are changed.
+ */
+VBatchResult MainWindow::RunBatchJob(const VCommandLinePtr &expParams, const VBatchJob &job, bool loaded)
+{
+    qCDebug(vMainWindow, "Batch job on line %d: %s.", job.line, qUtf8Printable(job.pattern));
+
+    QElapsedTimer timer;
+    timer.start();
+
+    VBatchResult result;
+    result.line = job.line;
+    result.name = job.BaseName();
+
+    if (not loaded and not LoadPattern(job.pattern, job.measurements))
+    {
+        result.error = tr("Couldn't load the pattern.");
+    }
+    else if (not job.gradationSize.isEmpty() && not SetSize(job.gradationSize))
+    {
+        result.error = tr("Couldn't set size %1.").arg(job.gradationSize);
+    }
+    else if (not job.gradationHeight.isEmpty() && not SetHeight(job.gradationHeight))
+    {
+        result.error = tr("Couldn't set height %1.").arg(job.gradationHeight);
+    }
+    else if (not DoExport(expParams, job.BaseName(), job.destination, job.format))
+    {
+        result.error = tr("Export error.");
+    }
+    else
+    {
+        result.ok = true;
+    }
+
+    result.elapsed = timer.elapsed();
+    return result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief RunBatchRun export jobs that share a pattern, see VBatchExport::SplitByPattern().
+ *
+ * The pattern is parsed once. Each size and height is evaluated in own VPattern and VContainer in a thread pool, see
+ * VPattern::EvaluateGradations(). Pieces of every evaluation are laid out and exported here one after another, the
+ * layout generator uses all cores by itself.
+ * @param threads maximal number of evaluations at once.
+ * @return results in order of jobs. Time of parsing and evaluation is shared equally between jobs.
+ */
+QVector<VBatchResult> MainWindow::RunBatchRun(const VCommandLinePtr &expParams, const QVector<VBatchJob> &run,
+                                             int threads)
+{
+    SCASSERT(not run.isEmpty())
+    qCDebug(vMainWindow, "Batch run of %d jobs from line %d: %s.", run.size(), run.first().line,
+            qUtf8Printable(run.first().pattern));
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QVector<VBatchResult> results(run.size());
+    for (int i = 0; i < run.size(); ++i)
+    {
+        results[i].line = run.at(i).line;
+        results[i].name = run.at(i).BaseName();
+    }
+
+    if (not LoadPattern(run.first().pattern, run.first().measurements))
+    {
+        for (int i = 0; i < results.size(); ++i)
+        {
+            results[i].error = tr("Couldn't load the pattern.");
+            results[i].elapsed = timer.elapsed() / run.size();
+        }
+        Clear();
+        setWindowModified(false);
+        return results;
+    }
+
+    QVector<VGradation> gradations;
+    QVector<int> evaluated;
+    for (int i = 0; i < run.size(); ++i)
+    {
+        VGradation gradation(VContainer::size(), VContainer::height());
+        if (BatchGradation(run.at(i), gradation, results[i].error))
+        {
+            gradations.append(gradation);
+            evaluated.append(i);
+        }
+    }
+
+    QStringList errors;
+    const QList<VContainer> evaluations = doc->EvaluateGradations(gradations, errors, threads);
+    const qint64 shared = timer.elapsed() / run.size();
+
+    for (int i = 0; i < evaluated.size(); ++i)
+    {
+        timer.restart();
+        VBatchResult &result = results[evaluated.at(i)];
+        const VBatchJob &job = run.at(evaluated.at(i));
+
+        if (not errors.at(i).isEmpty())
+        {
+            result.error = errors.at(i);
+        }
+        else if (evaluations.at(i).DataPieces()->isEmpty())
+        {
+            result.error = tr("You can't export empty scene.");
+        }
+        else
+        {
+            try
+            {
+                listDetails = PrepareDetailsForLayout(&evaluations.at(i));
+                result.ok = ExportDetails(expParams, job.BaseName(), job.destination, job.format);
+                if (not result.ok)
+                {
+                    result.error = tr("Export error.");
+                }
+            }
+            catch (const VException &e)
+            {
+                result.error = e.ErrorMessage();
+            }
+        }
+        result.elapsed = timer.elapsed();
+    }
+
+    for (int i = 0; i < results.size(); ++i)
+    {
+        results[i].elapsed += shared;
+    }
+
+    Clear();
+    setWindowModified(false);
+    return results;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief BatchGradation size and height in pattern units a job sets. Checks them like SetSize() and SetHeight().
+ * @param gradation current size and height, receives values of the job.
+ * @param error receives error description.
+ * @return false if the job's size or height is not supported.
+ */
+bool MainWindow::BatchGradation(const VBatchJob &job, VGradation &gradation, QString &error) const
+{
+    if (job.gradationSize.isEmpty() and job.gradationHeight.isEmpty())
+    {
+        return true;
+    }
+
+    if (qApp->patternType() != MeasurementsType::Multisize)
+    {
+        error = tr("Couldn't set size and height. Need a file with multisize measurements.");
+        return false;
+    }
+
+    if (not job.gradationSize.isEmpty())
+    {
+        const int size = static_cast<int>(UnitConvertor(job.gradationSize.toInt(), Unit::Cm,
+                                                        *pattern->GetPatternUnit()));
+        if (gradationSizes->findText(QString().setNum(size)) == -1)
+        {
+            error = tr("Couldn't set size %1.").arg(job.gradationSize);
+            return false;
+        }
+        gradation.size = size;
+    }
+
+    if (not job.gradationHeight.isEmpty())
+    {
+        const int height = static_cast<int>(UnitConvertor(job.gradationHeight.toInt(), Unit::Cm,
+                                                          *pattern->GetPatternUnit()));
+        if (gradationHeights->findText(QString().setNum(height)) == -1)
+        {
+            error = tr("Couldn't set height %1.").arg(job.gradationHeight);
+            return false;
+        }
+        gradation.height = height;
+    }
+    return true;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -6500,6 +6798,48 @@ bool MainWindow::SetHeight(const QString &text)
     return true;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief TestGradations evaluate the pattern for the smallest, current and biggest size and height in parallel and
+ * compare with sequential parsing.
+ * @return found differences, empty if there are none.
+ */
+QStringList MainWindow::TestGradations() const
+{
+    if (qApp->patternType() != MeasurementsType::Multisize)
+    {
+        return QStringList() << tr("Couldn't test gradations. Need a file with multisize measurements.");
+    }
+
+    auto Values = [](const QComboBox *box)
+    {
+        QVector<qreal> values;
+        const QVector<int> indexes = QVector<int>() << 0 << box->currentIndex() << box->count() - 1;
+        for (auto index : indexes)
+        {
+            const qreal value = box->itemText(index).toDouble();
+            if (index >= 0 && not values.contains(value))
+            {
+                values.append(value);
+            }
+        }
+        return values;
+    };
+
+    const QVector<qreal> sizes = Values(gradationSizes);
+    const QVector<qreal> heights = Values(gradationHeights);
+
+    QVector<VGradation> gradations;
+    for (auto size : sizes)
+    {
+        for (auto height : heights)
+        {
+            gradations.append(VGradation(size, height));
+        }
+    }
+    return doc->TestEvaluateGradations(gradations);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void MainWindow::ProcessCMD()
 {
@@ -6508,6 +6848,12 @@ void MainWindow::ProcessCMD()
 
     isNoScaling = cmd->IsNoScalingEnabled();
 
+    if (cmd->IsBatchEnabled())
+    {
+        qApp->exit(DoBatchExport(cmd));
+        return;
+    }
+
     if (VApplication::IsGUIMode())
     {
         ReopenFilesAfterCrash(args);
@@ -6546,13 +6892,47 @@ void MainWindow::ProcessCMD()
             }
         }
 
+        if (loaded && cmd->IsTestModeEnabled() && cmd->IsTestIncrementalEnabled())
+        {
+            QStringList differences;
+            if (cmd->IsSetGradationSize() || cmd->IsSetGradationHeight())
+            {
+                // New size and height were applied by recalculating only tools that read measurements
+                differences << doc->CompareWithFullParse();
+            }
+            differences << doc->TestIncrementalParse();
+            if (not differences.isEmpty())
+            {
+                qCCritical(vMainWindow, "%s\n\n%s",
+                           qUtf8Printable(tr("Incremental recalculation differs from full parsing.")),
+                           qUtf8Printable(differences.join(QLatin1Char('\n'))));
+                qApp->exit(V_EX_SOFTWARE);
+                return;
+            }
+        }
+
+        if (loaded && cmd->IsTestModeEnabled() && cmd->IsTestGradationsEnabled())
+        {
+            const QStringList differences = TestGradations();
+            if (not differences.isEmpty())
+            {
+                qCCritical(vMainWindow, "%s\n\n%s",
+                           qUtf8Printable(tr("Parallel evaluation of gradations differs from sequential parsing.")),
+                           qUtf8Printable(differences.join(QLatin1Char('\n'))));
+                qApp->exit(V_EX_SOFTWARE);
+                return;
+            }
+        }
+
         if (not cmd->IsTestModeEnabled())
         {
             if (cmd->IsExportEnabled())
             {
                 if (loaded && hSetted && sSetted)
                 {
-                    DoExport(cmd);
+                    const bool exported = DoExport(cmd, cmd->OptBaseName(), cmd->OptDestinationPath(),
+                                                   cmd->OptExportType());
+                    qApp->exit(exported ? V_EX_OK : V_EX_DATAERR);
                     return; // process only one input file
                 }
                 else
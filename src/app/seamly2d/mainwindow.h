@@ -54,6 +54,7 @@
 
 #include "mainwindowsnogui.h"
 #include "core/vcmdexport.h"
+#include "core/vbatchexport.h"
 #include "../vmisc/vlockguard.h"
 
 #include <QPointer>
@@ -411,13 +412,22 @@ private slots:
     QSharedPointer<VMeasurements> OpenMeasurementFile(const QString &path);
     bool               LoadMeasurements(const QString &path);
     bool               UpdateMeasurements(const QString &path, int size, int height);
+    bool               UpdateGradation(int size, int height);
     void               CheckRequiredMeasurements(const VMeasurements *m);
 
     void               ReopenFilesAfterCrash(QStringList &args);
-    void               DoExport(const VCommandLinePtr& expParams);
+    bool               DoExport(const VCommandLinePtr& expParams, const QString &baseName,
+                                const QString &destination, int format);
+    bool               ExportDetails(const VCommandLinePtr& expParams, const QString &baseName,
+                                     const QString &destination, int format);
+    int                DoBatchExport(const VCommandLinePtr& expParams);
+    VBatchResult       RunBatchJob(const VCommandLinePtr& expParams, const VBatchJob &job, bool loaded);
+    QVector<VBatchResult> RunBatchRun(const VCommandLinePtr& expParams, const QVector<VBatchJob> &run, int threads);
+    bool               BatchGradation(const VBatchJob &job, VGradation &gradation, QString &error) const;
 
     bool               SetSize(const QString &text);
     bool               SetHeight(const QString & text);
+    QStringList        TestGradations() const;
 
     QString            GetPatternFileName();
     QString            GetMeasurementFileName();
@@ -121,6 +121,7 @@ MainWindowsNoGUI::MainWindowsNoGUI(QWidget *parent)
       scenes(),
       details(),
       detailsOnLayout(),
+      layoutRevision(),
       undoAction(nullptr),
       redoAction(nullptr),
       actionDockWidgetToolOptions(nullptr),      
@@ -191,6 +192,7 @@ bool MainWindowsNoGUI::LayoutSettings(VLayoutGenerator& lGenerator)
     {
         connect(&lGenerator, &VLayoutGenerator::Error, this, &MainWindowsNoGUI::ErrorConsoleMode);
     }
+    lGenerator.SetPreviousRevision(layoutRevision);
     lGenerator.Generate();
 
     switch (lGenerator.State())
@@ -200,6 +202,7 @@ bool MainWindowsNoGUI::LayoutSettings(VLayoutGenerator& lGenerator)
             papers = lGenerator.GetPapersItems();// Blank sheets
             details = lGenerator.GetAllDetailsItems();// All details items
             detailsOnLayout = lGenerator.GetAllDetails();// All details items
+            layoutRevision = lGenerator.GetRevision();
             shadows = CreateShadows(papers);
             scenes = CreateScenes(papers, shadows, details);
             PrepareSceneList();
@@ -245,8 +248,6 @@ void MainWindowsNoGUI::ErrorConsoleMode(const LayoutErrors &state)
         default:
             break;
     }
-
-    qApp->exit(V_EX_DATAERR);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -729,14 +730,61 @@ QVector<VLayoutPiece> MainWindowsNoGUI::PrepareDetailsForLayout(const QHash<quin
     QVector<VLayoutPiece> listDetails;
     if (not details.isEmpty())
     {
+        // Pieces are independent and are created in parallel. Everything that needs GUI thread is read here.
+        const VLayoutPieceContext context = VLayoutPiece::CaptureContext(qApp->getCurrentDocument());
+
+        QVector<VLayoutPieceSource> sources;
+        sources.reserve(details.size());
         QHash<quint32, VPiece>::const_iterator i = details.constBegin();
         while (i != details.constEnd())
         {
             VAbstractTool *tool = qobject_cast<VAbstractTool*>(VAbstractPattern::getTool(i.key()));
             SCASSERT(tool != nullptr)
-            listDetails.append(VLayoutPiece::Create(i.value(), tool->getData()));
+            VLayoutPieceSource source;
+            source.piece = i.value();
+            source.id = i.key();
+            source.pattern = tool->getData();
+            sources.append(source);
+            ++i;
+        }
+
+        listDetails = VLayoutPiece::CreateInParallel(sources, context);
+    }
+
+    return listDetails;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief PrepareDetailsForLayout make layout pieces of an evaluation, see VPattern::EvaluateGradations(). An evaluation
+ * has no tools, pieces are built in its container.
+ * @param evaluation container of the evaluation.
+ */
+QVector<VLayoutPiece> MainWindowsNoGUI::PrepareDetailsForLayout(const VContainer *evaluation)
+{
+    SCASSERT(evaluation != nullptr)
+
+    QVector<VLayoutPiece> listDetails;
+    const QHash<quint32, VPiece> *details = evaluation->DataPieces();
+    if (not details->isEmpty())
+    {
+        const VLayoutPieceContext context = VLayoutPiece::CaptureContext(qApp->getCurrentDocument(),
+                                                                         evaluation->Gradation());
+
+        QVector<VLayoutPieceSource> sources;
+        sources.reserve(details->size());
+        QHash<quint32, VPiece>::const_iterator i = details->constBegin();
+        while (i != details->constEnd())
+        {
+            VLayoutPieceSource source;
+            source.piece = i.value();
+            source.id = i.key();
+            source.pattern = evaluation;
+            sources.append(source);
             ++i;
         }
+
+        listDetails = VLayoutPiece::CreateInParallel(sources, context);
     }
 
     return listDetails;
@@ -1598,7 +1646,7 @@ QString MainWindowsNoGUI::FileName() const
 //---------------------------------------------------------------------------------------------------------------------
 void MainWindowsNoGUI::SetSizeHeightForIndividualM() const
 {
-    const QHash<QString, QSharedPointer<VInternalVariable> > * vars = pattern->DataVariables();
+    const VVersionedHash<QString, QSharedPointer<VInternalVariable> > *vars = pattern->DataVariables();
 
     if (vars->contains(size_M))
     {
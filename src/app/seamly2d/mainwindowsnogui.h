@@ -101,6 +101,9 @@ public slots:
 
     QVector<QVector<VLayoutPiece> > detailsOnLayout;
 
+    /** @brief layoutRevision last generated layout, start point for incremental layout. */
+    VLayoutRevision layoutRevision;
+
     QAction *undoAction;
     QAction *redoAction;
     QAction *actionDockWidgetToolOptions;
@@ -115,6 +118,7 @@ public slots:
     QSizeF paperSize;
 
     static QVector<VLayoutPiece> PrepareDetailsForLayout(const QHash<quint32, VPiece> &details);
+    static QVector<VLayoutPiece> PrepareDetailsForLayout(const VContainer *evaluation);
 
     void ExportData(const QVector<VLayoutPiece> &listDetails, const DialogSaveLayout &dialog);
 
@@ -70,6 +70,7 @@
 #include "../qmuparser/qmuparsererror.h"
 #include "../qmuparser/qmutokenparser.h"
 #include "../vgeometry/varc.h"
+#include "../vgeometry/vpointf.h"
 #include "../vgeometry/vellipticalarc.h"
 #include "../vgeometry/vsplinepath.h"
 #include "../vgeometry/vcubicbezier.h"
@@ -88,9 +89,17 @@
 #include <QtNumeric>
 #include <QDebug>
 #include <QFileInfo>
+#include <QLoggingCategory>
+#include <QRunnable>
+#include <QThreadPool>
+#include <algorithm>
 
 const QString VPattern::AttrReadOnly = QStringLiteral("readOnly");
 
+// Enable with QT_LOGGING_RULES="v.xml.incremental.debug=true" to see how many tools each incremental parse
+// recalculates.
+Q_LOGGING_CATEGORY(vXMLIncremental, "v.xml.incremental", QtWarningMsg)
+
 namespace
 {
 //---------------------------------------------------------------------------------------------------------------------
@@ -98,6 +107,181 @@ QString FileComment()
 {
     return QString("Pattern created with Seamly2D v%1 (https://seamly.net).").arg(APP_VERSION_STR);
 }
+
+//---------------------------------------------------------------------------------------------------------------------
+bool SamePoints(const QVector<QPointF> &points1, const QVector<QPointF> &points2)
+{
+    if (points1.size() != points2.size())
+    {
+        return false;
+    }
+
+    for (int i = 0; i < points1.size(); ++i)
+    {
+        if (QLineF(points1.at(i), points2.at(i)).length() > VGObject::accuracyPointOnLine)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool SameGeometry(const QSharedPointer<VGObject> &obj1, const QSharedPointer<VGObject> &obj2)
+{
+    if (obj1->getType() != obj2->getType() or obj1->name() != obj2->name())
+    {
+        return false;
+    }
+
+    if (obj1->getType() == GOType::Point)
+    {
+        const QSharedPointer<VPointF> p1 = qSharedPointerDynamicCast<VPointF>(obj1);
+        const QSharedPointer<VPointF> p2 = qSharedPointerDynamicCast<VPointF>(obj2);
+        return not p1.isNull() and not p2.isNull()
+                and qAbs(p1->x() - p2->x()) <= VGObject::accuracyPointOnLine
+                and qAbs(p1->y() - p2->y()) <= VGObject::accuracyPointOnLine;
+    }
+
+    const QSharedPointer<VAbstractCurve> c1 = qSharedPointerDynamicCast<VAbstractCurve>(obj1);
+    const QSharedPointer<VAbstractCurve> c2 = qSharedPointerDynamicCast<VAbstractCurve>(obj2);
+    if (c1.isNull() or c2.isNull())
+    {
+        return c1.isNull() and c2.isNull();
+    }
+
+    return SamePoints(c1->GetPoints(), c2->GetPoints());
+}
+
+/**
+ * @brief The VParseResult struct keeps what a parse has left in the container. Values are read right away because the
+ * next full parse clears pieces shared by all copies of the container.
+ */
+struct VParseResult
+{
+    QHash<quint32, QSharedPointer<VGObject> > objects;
+    QHash<QString, qreal>                     variables;
+    QHash<quint32, QVector<QPointF> >         mainPaths;
+    QHash<quint32, QVector<QPointF> >         seamAllowances;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+VParseResult ParseResult(const VContainer *data)
+{
+    VParseResult result;
+    result.objects = data->DataGObjects();
+
+    const QHash<QString, QSharedPointer<VInternalVariable> > variables = data->DataVariables()->toHash();
+    QHash<QString, QSharedPointer<VInternalVariable> >::const_iterator v = variables.constBegin();
+    while (v != variables.constEnd())
+    {
+        const VInternalVariable *variable = v.value().data();
+        result.variables.insert(v.key(), variable->GetValue());
+        ++v;
+    }
+
+    const QHash<quint32, VPiece> *pieces = data->DataPieces();
+    QHash<quint32, VPiece>::const_iterator p = pieces->constBegin();
+    while (p != pieces->constEnd())
+    {
+        result.mainPaths.insert(p.key(), p.value().MainPathPoints(data));
+        if (p.value().IsSeamAllowance())
+        {
+            result.seamAllowances.insert(p.key(), p.value().SeamAllowancePoints(data));
+        }
+        ++p;
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QStringList ParseDifferences(const VParseResult &expected, const VParseResult &actual)
+{
+    QStringList differences;
+    if (expected.objects.size() != actual.objects.size())
+    {
+        differences << QString("%1 objects instead of %2.").arg(actual.objects.size()).arg(expected.objects.size());
+    }
+
+    QHash<quint32, QSharedPointer<VGObject> >::const_iterator i = expected.objects.constBegin();
+    while (i != expected.objects.constEnd())
+    {
+        if (not actual.objects.contains(i.key()) or not SameGeometry(i.value(), actual.objects.value(i.key())))
+        {
+            differences << QString("Object %1 differs.").arg(i.key());
+        }
+        ++i;
+    }
+
+    if (expected.variables.size() != actual.variables.size())
+    {
+        differences << QString("%1 variables instead of %2.").arg(actual.variables.size())
+                       .arg(expected.variables.size());
+    }
+
+    QHash<QString, qreal>::const_iterator v = expected.variables.constBegin();
+    while (v != expected.variables.constEnd())
+    {
+        if (not actual.variables.contains(v.key())
+                or not VFuzzyComparePossibleNulls(v.value(), actual.variables.value(v.key())))
+        {
+            differences << QString("Variable %1 differs.").arg(v.key());
+        }
+        ++v;
+    }
+
+    if (expected.mainPaths.size() != actual.mainPaths.size())
+    {
+        differences << QString("%1 pieces instead of %2.").arg(actual.mainPaths.size())
+                       .arg(expected.mainPaths.size());
+    }
+
+    QHash<quint32, QVector<QPointF> >::const_iterator p = expected.mainPaths.constBegin();
+    while (p != expected.mainPaths.constEnd())
+    {
+        if (not actual.mainPaths.contains(p.key()) or not SamePoints(p.value(), actual.mainPaths.value(p.key()))
+                or not SamePoints(expected.seamAllowances.value(p.key()), actual.seamAllowances.value(p.key())))
+        {
+            differences << QString("Piece %1 differs.").arg(p.key());
+        }
+        ++p;
+    }
+    return differences;
+}
+
+/**
+ * @brief The VGradationJob class parses a copy of the document for one gradation in a thread pool.
+ */
+class VGradationJob : public QRunnable
+{
+public:
+    VGradationJob(VPattern *evaluation, QString *error)
+        : evaluation(evaluation),
+          error(error)
+    {}
+
+    virtual void run() Q_DECL_OVERRIDE
+    {
+        try
+        {
+            evaluation->Parse(Document::LiteParse);
+        }
+        catch (const VException &e)
+        {
+            *error = e.ErrorMessage();
+        }
+        catch (const qmu::QmuParserError &e)
+        {
+            *error = e.GetMsg();
+        }
+    }
+
+private:
+    Q_DISABLE_COPY(VGradationJob)
+
+    VPattern *evaluation;
+    QString  *error;
+};
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -107,7 +291,11 @@ VPattern::VPattern(VContainer *data, Draw *mode, VMainGraphicsScene *draftScene,
       data(data),
       mode(mode),
       draftScene(draftScene),
-      pieceScene(pieceScene)
+      pieceScene(pieceScene),
+      toolJournals(),
+      recalculateTools(),
+      incrementalParse(false),
+      evaluation(false)
 {
     SCASSERT(draftScene != nullptr)
     SCASSERT(pieceScene != nullptr)
@@ -181,6 +369,10 @@ void VPattern::Parse(const Document &parse)
                                      << TagPatternName << TagPatternNum << TagCompanyName << TagCustomerName
                                      << TagPatternLabel;
     PrepareForParse(parse);
+    if (not evaluation)
+    {
+        qApp->SetCurveApproximationScale(GetCurveApproximationScale());
+    }
     QDomNode domNode = documentElement().firstChild();
     while (domNode.isNull() == false)
     {
@@ -347,6 +539,10 @@ void VPattern::UpdateToolData(const quint32 &id, VContainer *data)
 {
     Q_ASSERT_X(id != 0, Q_FUNC_INFO, "id == 0"); //-V712 //-V654
     SCASSERT(data != nullptr)
+    if (evaluation)
+    {
+        return; // Tools belong to the document the evaluation was copied from
+    }
     ToolExists(id);
     VDataTool *tool = tools.value(id);
     SCASSERT(tool != nullptr)
@@ -516,16 +712,28 @@ void VPattern::LiteParseTree(const Document &parse)
     // Save current draft block name
     QString draftBlockName = activeDraftBlock;
 
+    const QSet<quint32> changed = changedTools;
+    changedTools.clear();
+
+    // New approximation scale (from preferences or pattern properties) changes every curve, Parse() applies it.
+    const bool scaleChanged = not qFuzzyCompare(qApp->GetCurveApproximationScale(), GetCurveApproximationScale());
+
     try
     {
         emit SetEnabledGUI(true);
         switch (parse)
         {
             case Document::LitePPParse:
-                ParseCurrentPP();
+                if (changed.isEmpty() or not IncrementalParse(changed, parse))
+                {
+                    ParseCurrentPP();
+                }
                 break;
             case Document::LiteParse:
-                Parse(parse);
+                if (changed.isEmpty() or scaleChanged or not IncrementalParse(changed, parse))
+                {
+                    Parse(parse);
+                }
                 break;
             case Document::FullParse:
                 qCWarning(vXML, "Lite parsing doesn't support full parsing");
@@ -740,14 +948,6 @@ void VPattern::ParseDrawMode(const QDomNode &node, const Document &parse, const
     {
         scene = pieceScene;
     }
-    const QStringList tags = QStringList() << TagPoint
-                                           << TagLine
-                                           << TagSpline
-                                           << TagArc
-                                           << TagTools
-                                           << TagOperation
-                                           << TagElArc
-                                           << TagPath;
     const QDomNodeList nodeList = node.childNodes();
     const qint32 num = nodeList.size();
     for (qint32 i = 0; i < num; ++i)
@@ -755,45 +955,110 @@ void VPattern::ParseDrawMode(const QDomNode &node, const Document &parse, const
         QDomElement domElement = nodeList.at(i).toElement();
         if (domElement.isNull() == false)
         {
-            switch (tags.indexOf(domElement.tagName()))
+            if (mode == Draw::Calculation)
             {
-                case 0: // TagPoint
-                    qCDebug(vXML, "Tag point.");
-                    ParsePointElement(scene, domElement, parse, domElement.attribute(AttrType, ""));
-                    break;
-                case 1: // TagLine
-                    qCDebug(vXML, "Tag line.");
-                    ParseLineElement(scene, domElement, parse);
-                    break;
-                case 2: // TagSpline
-                    qCDebug(vXML, "Tag spline.");
-                    ParseSplineElement(scene, domElement, parse, domElement.attribute(AttrType, ""));
-                    break;
-                case 3: // TagArc
-                    qCDebug(vXML, "Tag arc.");
-                    ParseArcElement(scene, domElement, parse, domElement.attribute(AttrType, ""));
-                    break;
-                case 4: // TagTools
-                    qCDebug(vXML, "Tag tools.");
-                    ParseToolsElement(scene, domElement, parse, domElement.attribute(AttrType, ""));
-                    break;
-                case 5: // TagOperation
-                    qCDebug(vXML, "Tag operation.");
-                    ParseOperationElement(scene, domElement, parse, domElement.attribute(AttrType, ""));
-                    break;
-                case 6: // TagElArc
-                    qCDebug(vXML, "Tag elliptical arc.");
-                    ParseEllipticalArcElement(scene, domElement, parse, domElement.attribute(AttrType, ""));
-                    break;
-                case 7: // TagPath
-                    qCDebug(vXML, "Tag path.");
-                    ParsePathElement(scene, domElement, parse);
-                    break;
-                default:
-                    VException e(tr("Wrong tag name '%1'.").arg(domElement.tagName()));
-                    throw e;
+                ParseCalculationElement(scene, domElement, parse);
             }
+            else
+            {
+                ParseDrawModeElement(scene, domElement, parse);
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ParseCalculationElement parse tool of calculation mode and record its journal.
+ *
+ * Journal keeps objects and variables the tool has read and written. During incremental parsing a tool that doesn't
+ * need recalculation puts its previous results back to the container instead of being created again.
+ * @param scene scene.
+ * @param domElement tag in xml tree.
+ * @param parse parser file mode.
+ */
+void VPattern::ParseCalculationElement(VMainGraphicsScene *scene, QDomElement &domElement, const Document &parse)
+{
+    const quint32 id = GetParametrId(domElement);
+    if (incrementalParse and not recalculateTools.contains(id) and toolJournals.contains(id))
+    {
+        data->Replay(toolJournals.value(id));
+        if (tools.contains(id))
+        {
+            UpdateToolData(id, data);
         }
+        return;
+    }
+
+    VContainerJournal journal;
+    data->SetJournal(&journal);
+    try
+    {
+        ParseDrawModeElement(scene, domElement, parse);
+    }
+    catch (...)
+    {
+        data->SetJournal(nullptr);
+        throw;
+    }
+    data->SetJournal(nullptr);
+    toolJournals.insert(id, journal);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ParseDrawModeElement parse one tag of draw mode.
+ * @param scene scene.
+ * @param domElement tag in xml tree.
+ * @param parse parser file mode.
+ */
+void VPattern::ParseDrawModeElement(VMainGraphicsScene *scene, QDomElement &domElement, const Document &parse)
+{
+    static const QStringList tags = QStringList() << TagPoint
+                                                  << TagLine
+                                                  << TagSpline
+                                                  << TagArc
+                                                  << TagTools
+                                                  << TagOperation
+                                                  << TagElArc
+                                                  << TagPath;
+    switch (tags.indexOf(domElement.tagName()))
+    {
+        case 0: // TagPoint
+            qCDebug(vXML, "Tag point.");
+            ParsePointElement(scene, domElement, parse, domElement.attribute(AttrType, ""));
+            break;
+        case 1: // TagLine
+            qCDebug(vXML, "Tag line.");
+            ParseLineElement(scene, domElement, parse);
+            break;
+        case 2: // TagSpline
+            qCDebug(vXML, "Tag spline.");
+            ParseSplineElement(scene, domElement, parse, domElement.attribute(AttrType, ""));
+            break;
+        case 3: // TagArc
+            qCDebug(vXML, "Tag arc.");
+            ParseArcElement(scene, domElement, parse, domElement.attribute(AttrType, ""));
+            break;
+        case 4: // TagTools
+            qCDebug(vXML, "Tag tools.");
+            ParseToolsElement(scene, domElement, parse, domElement.attribute(AttrType, ""));
+            break;
+        case 5: // TagOperation
+            qCDebug(vXML, "Tag operation.");
+            ParseOperationElement(scene, domElement, parse, domElement.attribute(AttrType, ""));
+            break;
+        case 6: // TagElArc
+            qCDebug(vXML, "Tag elliptical arc.");
+            ParseEllipticalArcElement(scene, domElement, parse, domElement.attribute(AttrType, ""));
+            break;
+        case 7: // TagPath
+            qCDebug(vXML, "Tag path.");
+            ParsePathElement(scene, domElement, parse);
+            break;
+        default:
+            VException e(tr("Wrong tag name '%1'.").arg(domElement.tagName()));
+            throw e;
     }
 }
 
@@ -1192,6 +1457,414 @@ void VPattern::ParseCurrentPP()
     emit CheckLayout();
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief AffectedTools find tools that must be recalculated after changing some of them.
+ *
+ * Dependencies come from journals of the last parse: a tool depends on each tool that has written an object or a
+ * variable it has read.
+ * @param changed ids of changed tools.
+ * @return changed tools and all their dependents.
+ */
+QSet<quint32> VPattern::AffectedTools(const QSet<quint32> &changed) const
+{
+    QHash<quint32, quint32> objectOwner;
+    QHash<QString, quint32> variableWriter;
+    QHash<quint32, VContainerJournal>::const_iterator i = toolJournals.constBegin();
+    while (i != toolJournals.constEnd())
+    {
+        const QList<quint32> objects = i.value().writtenObjects.keys();
+        for (auto object : objects)
+        {
+            objectOwner.insert(object, i.key());
+        }
+
+        const QList<QString> variables = i.value().writtenVariables.keys();
+        for (auto &variable : variables)
+        {
+            variableWriter.insert(variable, i.key());
+        }
+        ++i;
+    }
+
+    QMultiHash<quint32, quint32> dependents;
+    i = toolJournals.constBegin();
+    while (i != toolJournals.constEnd())
+    {
+        QSet<quint32> parents;
+        for (auto object : i.value().readObjects)
+        {
+            if (objectOwner.contains(object))
+            {
+                parents.insert(objectOwner.value(object));
+            }
+        }
+
+        for (auto &variable : i.value().readVariables)
+        {
+            if (variableWriter.contains(variable))
+            {
+                parents.insert(variableWriter.value(variable));
+            }
+        }
+
+        parents.remove(i.key());
+        for (auto parent : parents)
+        {
+            dependents.insert(parent, i.key());
+        }
+        ++i;
+    }
+
+    QSet<quint32> affected = changed;
+    QList<quint32> queue = changed.toList();
+    while (not queue.isEmpty())
+    {
+        const QList<quint32> children = dependents.values(queue.takeFirst());
+        for (auto child : children)
+        {
+            if (not affected.contains(child))
+            {
+                affected.insert(child);
+                queue.append(child);
+            }
+        }
+    }
+    return affected;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GradationDependentTools find tools that read a variable no tool writes, i.e. a measurement or an increment.
+ * Only they can give another result for another size and height.
+ */
+QSet<quint32> VPattern::GradationDependentTools() const
+{
+    QSet<QString> written;
+    QHash<quint32, VContainerJournal>::const_iterator i = toolJournals.constBegin();
+    while (i != toolJournals.constEnd())
+    {
+        const QList<QString> variables = i.value().writtenVariables.keys();
+        for (auto &variable : variables)
+        {
+            written.insert(variable);
+        }
+        ++i;
+    }
+
+    QSet<quint32> dependent;
+    i = toolJournals.constBegin();
+    while (i != toolJournals.constEnd())
+    {
+        for (auto &variable : i.value().readVariables)
+        {
+            if (not written.contains(variable))
+            {
+                dependent.insert(i.key());
+                break;
+            }
+        }
+        ++i;
+    }
+    return dependent;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief MarkGradationChanged tell the document that values of measurements were changed by a new size or height.
+ *
+ * Marks tools that depend on gradation. The next lite parse recalculates them with their dependents and puts back
+ * results of all other tools.
+ */
+void VPattern::MarkGradationChanged()
+{
+    const QSet<quint32> dependent = GradationDependentTools();
+    for (auto id : dependent)
+    {
+        MarkToolChanged(id);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief EvaluateGradations calculate the pattern for several sizes and heights at once.
+ *
+ * Each gradation gets a snapshot of the container with own size and height and a deep copy of the document. The copy
+ * visits tools in the order of the last parse, like an incremental parse after a change of gradation: tools that
+ * don't depend on gradation put back their recorded results, others are calculated again. Evaluations run in a
+ * thread pool and leave the document, its container, its tools and the process-wide size and height untouched. Call
+ * from GUI thread after a parse.
+ * @param gradations sizes and heights in pattern units.
+ * @param errors receives error of each evaluation, empty string if it has succeeded.
+ * @param threads maximal number of evaluations at once, 0 means one per processor core.
+ * @return containers with results in the order of gradations.
+ */
+QList<VContainer> VPattern::EvaluateGradations(const QVector<VGradation> &gradations, QStringList &errors,
+                                               int threads) const
+{
+    const QSet<quint32> recalculate = AffectedTools(GradationDependentTools());
+    qCDebug(vXMLIncremental, "Evaluate %d gradations, recalculate %d of %d tools.", gradations.size(),
+            recalculate.size(), toolJournals.size());
+
+    QVector<QSharedPointer<VContainer>> containers;
+    QVector<QSharedPointer<VPattern>> evaluations;
+    QVector<QString> messages(gradations.size());
+    QThreadPool pool;
+    if (threads > 0)
+    {
+        pool.setMaxThreadCount(threads);
+    }
+    for (int i = 0; i < gradations.size(); ++i)
+    {
+        QSharedPointer<VContainer> container(new VContainer(data->Snapshot()));
+        container->SetGradation(gradations.at(i));
+        containers.append(container);
+
+        // Copies of a document share nodes, it is not safe to read them from several threads
+        QSharedPointer<VPattern> copy(new VPattern(container.data(), mode, draftScene, pieceScene));
+        static_cast<QDomDocument &>(*copy) = cloneNode(true).toDocument();
+        copy->RefreshElementIdCache();
+        copy->toolJournals = toolJournals;
+        copy->recalculateTools = recalculate;
+        copy->incrementalParse = true;
+        copy->evaluation = true;
+        evaluations.append(copy);
+
+        pool.start(new VGradationJob(copy.data(), &messages[i]));
+    }
+    pool.waitForDone();
+
+    QList<VContainer> results;
+    errors.clear();
+    for (int i = 0; i < containers.size(); ++i)
+    {
+        results.append(*containers.at(i));
+        errors.append(messages.at(i));
+    }
+    return results;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief IncrementalParse lite parse that recalculates only changed tools and their dependents.
+ *
+ * Other tools of calculation mode put back results recorded by the last parse. Modeling objects and details are parsed
+ * as usual.
+ * @param changed ids of changed tools.
+ * @param parse parser file mode.
+ * @return false if there is no journal for some changed tool. Nothing was parsed in this case.
+ */
+bool VPattern::IncrementalParse(const QSet<quint32> &changed, const Document &parse)
+{
+    for (auto id : changed)
+    {
+        if (not toolJournals.contains(id))
+        {
+            return false;
+        }
+    }
+
+    recalculateTools = AffectedTools(changed);
+    qCDebug(vXMLIncremental, "Recalculate %d of %d tools.", recalculateTools.size(), toolJournals.size());
+
+    incrementalParse = true;
+    try
+    {
+        if (parse == Document::LitePPParse)
+        {
+            ParseCurrentPP();
+        }
+        else
+        {
+            Parse(parse);
+        }
+    }
+    catch (...)
+    {
+        incrementalParse = false;
+        recalculateTools.clear();
+        throw;
+    }
+    incrementalParse = false;
+    recalculateTools.clear();
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief TestIncrementalParse check that incremental parsing gives the same pattern as full parsing.
+ *
+ * Each tool with a length formula in turn gets a longer length and the pattern is recalculated incrementally. The
+ * result is compared with a full parse of the edited document, then the formula is restored. Full parsing recreates
+ * all tools and scene items, so this is only for test mode.
+ * @return found differences, empty if there are none.
+ */
+QStringList VPattern::TestIncrementalParse()
+{
+    QList<quint32> ids = toolJournals.keys();
+    std::sort(ids.begin(), ids.end());
+
+    QStringList differences;
+    try
+    {
+        for (auto id : ids)
+        {
+            QDomElement domElement = elementById(id);
+            const QString formula = domElement.attribute(AttrLength);
+            if (formula.isEmpty())
+            {
+                continue;
+            }
+
+            SetAttribute(domElement, AttrLength, QStringLiteral("(%1)+1").arg(formula));
+            const QStringList found = VerifyIncrementalParse(QSet<quint32>() << id);
+            for (auto &difference : found)
+            {
+                differences << QString("Tool %1: %2").arg(id).arg(difference);
+            }
+
+            SetAttribute(domElement, AttrLength, formula);
+            Parse(Document::FullParse);
+        }
+    }
+    catch (const VException &e)
+    {
+        differences << QString("Couldn't restore the pattern. %1").arg(e.ErrorMessage());
+    }
+    return differences;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief CompareWithFullParse compare current state of the pattern with a full parse of the document. Full parsing
+ * recreates all tools and scene items, so this is only for test mode.
+ * @return found differences, empty if there are none.
+ */
+QStringList VPattern::CompareWithFullParse()
+{
+    const VParseResult current = ParseResult(data);
+    try
+    {
+        Parse(Document::FullParse);
+    }
+    catch (const VException &e)
+    {
+        return QStringList() << QString("Full parse has failed. %1").arg(e.ErrorMessage());
+    }
+    return ParseDifferences(ParseResult(data), current);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief TestEvaluateGradations check that evaluation of gradations in a thread pool gives the same pattern as
+ * switching the process-wide size and height to each gradation in turn and parsing the whole document. Full parsing
+ * recreates all tools and scene items, so this is only for test mode.
+ * @param gradations sizes and heights in pattern units.
+ * @return found differences, empty if there are none.
+ */
+QStringList VPattern::TestEvaluateGradations(const QVector<VGradation> &gradations)
+{
+    QStringList errors;
+    const QList<VContainer> parallel = EvaluateGradations(gradations, errors);
+
+    const VGradation current = data->Gradation();
+    QStringList differences;
+    for (int i = 0; i < gradations.size(); ++i)
+    {
+        const QString gradation = QString("Size %1, height %2: ").arg(gradations.at(i).size)
+                .arg(gradations.at(i).height);
+
+        VContainer::SetSize(gradations.at(i).size);
+        VContainer::SetHeight(gradations.at(i).height);
+
+        // A gradation may break the pattern, then both evaluations must fail
+        VParseResult sequential;
+        bool sequentialFailed = false;
+        try
+        {
+            Parse(Document::FullParse);
+            sequential = ParseResult(data);
+        }
+        catch (const VException &)
+        {
+            sequentialFailed = true;
+        }
+
+        const bool parallelFailed = not errors.at(i).isEmpty();
+        if (sequentialFailed or parallelFailed)
+        {
+            if (sequentialFailed != parallelFailed)
+            {
+                differences << gradation + QString("Only one of the evaluations has failed. %1").arg(errors.at(i));
+            }
+            continue;
+        }
+
+        const QStringList found = ParseDifferences(sequential, ParseResult(&parallel.at(i)));
+        for (auto &difference : found)
+        {
+            differences << gradation + difference;
+        }
+    }
+
+    VContainer::SetSize(current.size);
+    VContainer::SetHeight(current.height);
+    try
+    {
+        Parse(Document::FullParse);
+    }
+    catch (const VException &e)
+    {
+        differences << QString("Couldn't restore the pattern. %1").arg(e.ErrorMessage());
+    }
+    return differences;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief VerifyIncrementalParse recalculate changed tools incrementally, then parse the whole document from scratch
+ * and compare objects, variables and pieces of both parses.
+ * @param changed ids of changed tools.
+ * @return found differences, empty if there are none.
+ */
+QStringList VPattern::VerifyIncrementalParse(const QSet<quint32> &changed)
+{
+    // An edit may break the pattern, then both parses must fail
+    VParseResult incremental;
+    bool incrementalFailed = false;
+    try
+    {
+        if (not IncrementalParse(changed, Document::LiteParse))
+        {
+            return QStringList() << QString("No journal for a changed tool.");
+        }
+        incremental = ParseResult(data);
+    }
+    catch (const VException &)
+    {
+        incrementalFailed = true;
+    }
+
+    VParseResult full;
+    bool fullFailed = false;
+    try
+    {
+        Parse(Document::FullParse);
+        full = ParseResult(data);
+    }
+    catch (const VException &)
+    {
+        fullFailed = true;
+    }
+
+    if (incrementalFailed or fullFailed)
+    {
+        return incrementalFailed == fullFailed ? QStringList()
+                                               : QStringList() << QString("Only one of the parses has failed.");
+    }
+    return ParseDifferences(full, incremental);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 QString VPattern::GetLabelBase(quint32 index) const
 {
@@ -3895,10 +4568,16 @@ void VPattern::PrepareForParse(const Document &parse)
         tools.clear();
         cursor = 0;
         history.clear();
+
+        toolJournals.clear();
+        changedTools.clear();
     }
     else if (parse == Document::LiteParse)
     {
-        VContainer::ClearUniqueNames();
+        if (not evaluation)
+        {
+            VContainer::ClearUniqueNames(); // Names are process-wide, an evaluation finds the same ones
+        }
         data->ClearVariables(VarType::Increment);
         data->ClearVariables(VarType::LineAngle);
         data->ClearVariables(VarType::LineLength);
@@ -4043,6 +4722,10 @@ QRectF VPattern::ToolBoundingRect(const QRectF &rec, const quint32 &id) const
 void VPattern::IncrementReferens(quint32 id) const
 {
     Q_ASSERT_X(id != 0, Q_FUNC_INFO, "id == 0");
+    if (evaluation)
+    {
+        return;
+    }
     ToolExists(id);
     VDataTool *tool = tools.value(id);
     SCASSERT(tool != nullptr)
@@ -4057,6 +4740,10 @@ void VPattern::IncrementReferens(quint32 id) const
 void VPattern::DecrementReferens(quint32 id) const
 {
     Q_ASSERT_X(id != 0, Q_FUNC_INFO, "id == 0");
+    if (evaluation)
+    {
+        return;
+    }
     ToolExists(id);
     VDataTool *tool = tools.value(id);
     SCASSERT(tool != nullptr)
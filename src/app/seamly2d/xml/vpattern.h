@@ -75,6 +75,12 @@ class VPattern : public VAbstractPattern
     void           Parse(const Document &parse);
 
     void           setCurrentData();
+    void           MarkGradationChanged();
+    QStringList    TestIncrementalParse();
+    QStringList    CompareWithFullParse();
+    QList<VContainer> EvaluateGradations(const QVector<VGradation> &gradations, QStringList &errors,
+                                         int threads = 0) const;
+    QStringList    TestEvaluateGradations(const QVector<VGradation> &gradations);
     virtual void   UpdateToolData(const quint32 &id, VContainer *data) Q_DECL_OVERRIDE;
 
     virtual void   IncrementReferens(quint32 id) const Q_DECL_OVERRIDE;
@@ -138,10 +144,23 @@ public slots:
     VMainGraphicsScene *draftScene;
     VMainGraphicsScene *pieceScene;
 
+    /** @brief toolJournals reads and writes of each calculation tool during the last parse. */
+    QHash<quint32, VContainerJournal> toolJournals;
+
+    /** @brief recalculateTools tools an incremental parse must create again. */
+    QSet<quint32>  recalculateTools;
+
+    bool           incrementalParse;
+
+    /** @brief evaluation the document is a copy that evaluates one gradation, see EvaluateGradations(). */
+    bool           evaluation;
+
     VNodeDetail    ParseDetailNode(const QDomElement &domElement) const;
 
     void           ParseDrawElement(const QDomNode& node, const Document &parse);
     void           ParseDrawMode(const QDomNode& node, const Document &parse, const Draw &mode);
+    void           ParseCalculationElement(VMainGraphicsScene *scene, QDomElement &domElement, const Document &parse);
+    void           ParseDrawModeElement(VMainGraphicsScene *scene, QDomElement &domElement, const Document &parse);
     void           ParseDetailElement(QDomElement &domElement, const Document &parse);
     void           ParseDetailNodes(const QDomElement &domElement, VPiece &detail, qreal width, bool closed) const;
     void           ParsePieceDataTag(const QDomElement &domElement, VPiece &detail) const;
@@ -179,6 +198,10 @@ public slots:
     template <typename T>
     QRectF         ToolBoundingRect(const QRectF &rec, const quint32 &id) const;
     void           ParseCurrentPP();
+    QSet<quint32>  AffectedTools(const QSet<quint32> &changed) const;
+    QSet<quint32>  GradationDependentTools() const;
+    bool           IncrementalParse(const QSet<quint32> &changed, const Document &parse);
+    QStringList    VerifyIncrementalParse(const QSet<quint32> &changed);
     QString        GetLabelBase(quint32 index)const;
 
     void ParseToolBasePoint(VMainGraphicsScene *scene, const QDomElement &domElement, const Document &parse);
@@ -57,6 +57,7 @@
 #include "../ifc/exception/vexceptionconversionerror.h"
 #include "../ifc/exception/vexceptionemptyparameter.h"
 #include "../ifc/exception/vexceptionwrongid.h"
+#include "../ifc/xml/vabstractconverter.h"
 #include "../vmisc/logging.h"
 #include "../vmisc/vsysexits.h"
 #include "../vmisc/diagnostic.h"
@@ -658,6 +659,8 @@ void MApplication::ParseCommandLine(const SocketConnection &connection, const QS
     }
 
     testMode = parser.isSet(testOption);
+    // Test mode checks each step of converting an old file
+    VAbstractConverter::SetIntermediateValidation(testMode);
 
     if (not testMode && connection == SocketConnection::Client)
     {
@@ -70,6 +70,8 @@
 #include "../exception/vexceptionwrongid.h"
 #include "vdomdocument.h"
 
+bool VAbstractConverter::intermediateValidation = false;
+
 //---------------------------------------------------------------------------------------------------------------------
 VAbstractConverter::VAbstractConverter(const QString &fileName)
     : VDomDocument(),
@@ -109,7 +111,18 @@ QString VAbstractConverter::Convert()
     qDebug() << " m_ver = " << m_ver;
     qDebug() << " MaxVer = " << MaxVer();
 
-    m_ver < MaxVer() ? ApplyPatches() : DowngradeToCurrentMaxVersion();
+    // Patches change the document only in memory. Write and validate the final result once.
+    if (m_ver < MaxVer())
+    {
+        ApplyPatches();
+        Save();
+        ValidateXML(XSDSchema(MaxVer()), m_convertedFileName);
+    }
+    else
+    {
+        DowngradeToCurrentMaxVersion();
+        Save();
+    }
 
     return m_convertedFileName;
 }
@@ -349,6 +362,41 @@ void VAbstractConverter::Save()
     }
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ValidateIntermediate validate the document after a patch without saving it. Does nothing unless intermediate
+ * validation is enabled.
+ * @param ver format version the document was converted to.
+ */
+void VAbstractConverter::ValidateIntermediate(int ver) const
+{
+    if (not intermediateValidation)
+    {
+        return;
+    }
+
+    ValidateXML(XSDSchema(ver), *this, m_convertedFileName);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief IsIntermediateValidation return true if the document is validated after each patch.
+ */
+bool VAbstractConverter::IsIntermediateValidation()
+{
+    return intermediateValidation;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetIntermediateValidation enable validation after each patch. Helps to find a broken patch, but slows down
+ * conversion, so it is off by default and turned on by tests.
+ */
+void VAbstractConverter::SetIntermediateValidation(bool value)
+{
+    intermediateValidation = value;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void VAbstractConverter::SetVersion(const QString &version)
 {
@@ -83,6 +83,9 @@ class VAbstractConverter :public VDomDocument
 
     static int      GetVersion(const QString &version);
 
+    static bool     IsIntermediateValidation();
+    static void     SetIntermediateValidation(bool value);
+
 protected:
     int             m_ver;
     QString         m_convertedFileName;
@@ -91,6 +94,7 @@ class VAbstractConverter :public VDomDocument
     Q_NORETURN void InvalidVersion(int ver) const;
     void            Save();
     void            SetVersion(const QString &version);
+    void            ValidateIntermediate(int ver) const;
 
     virtual int     MinVer() const =0;
     virtual int     MaxVer() const =0;
@@ -114,6 +118,8 @@ class VAbstractConverter :public VDomDocument
 
     QTemporaryFile  m_tmpFile;
 
+    static bool     intermediateValidation;
+
     static void     ValidateVersion(const QString &version);
 
     void            ReserveFile() const;
@@ -129,6 +129,7 @@ const QString VAbstractPattern::AttrQuantity            = QStringLiteral("quanti
 const QString VAbstractPattern::AttrOnFold              = QStringLiteral("onFold");
 const QString VAbstractPattern::AttrDateFormat          = QStringLiteral("dateFormat");
 const QString VAbstractPattern::AttrTimeFormat          = QStringLiteral("timeFormat");
+const QString VAbstractPattern::AttrCurveApproximationScale = QStringLiteral("curveApproximationScale");
 const QString VAbstractPattern::AttrArrows              = QStringLiteral("arrows");
 const QString VAbstractPattern::AttrNodeReverse         = QStringLiteral("reverse");
 const QString VAbstractPattern::AttrNodeExcluded        = QStringLiteral("excluded");
@@ -256,7 +257,8 @@ VAbstractPattern::VAbstractPattern(QObject *parent)
       toolsOnRemove(QVector<VDataTool*>()),
       history(QVector<VToolRecord>()),
       patternPieces(QStringList()),
-      modified(false)
+      modified(false),
+      changedTools()
 {}
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -789,6 +791,18 @@ VPieceNode VAbstractPattern::ParseSANode(const QDomElement &domElement)
     return node;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief MarkToolChanged tell the document that only options of this tool were changed.
+ *
+ * Next lite parsing may recalculate only this tool and tools that depend on it. The mark is dropped by next parsing.
+ * @param id tool id.
+ */
+void VAbstractPattern::MarkToolChanged(quint32 id)
+{
+    changedTools.insert(id);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void VAbstractPattern::AddToolOnRemove(VDataTool *tool)
 {
@@ -1423,6 +1437,66 @@ void VAbstractPattern::SetLabelTimeFormat(const QString &format)
     emit patternChanged(false);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GetCurveApproximationScale return approximation scale stored in the pattern file. If the pattern doesn't
+ * define own value the global one from settings is used.
+ */
+qreal VAbstractPattern::GetCurveApproximationScale() const
+{
+    const qreal globalScale = qApp->Settings()->GetCurveApproximationScale();
+    const QDomElement pattern = documentElement();
+    if (pattern.isNull() || not pattern.hasAttribute(AttrCurveApproximationScale))
+    {
+        return globalScale;
+    }
+
+    try
+    {
+        const qreal scale = GetParametrDouble(pattern, AttrCurveApproximationScale, QString().setNum(globalScale));
+        return qBound(minCurveApproximationScale, scale, maxCurveApproximationScale);
+    }
+    catch (const VExceptionConversionError &)
+    {
+        return globalScale;
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VAbstractPattern::SetCurveApproximationScale(qreal scale)
+{
+    QDomElement pattern = documentElement();
+    SetAttribute(pattern, AttrCurveApproximationScale,
+                 qBound(minCurveApproximationScale, scale, maxCurveApproximationScale));
+    modified = true;
+    emit patternChanged(false);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief HasCurveApproximationScale return true if the pattern defines own approximation scale.
+ */
+bool VAbstractPattern::HasCurveApproximationScale() const
+{
+    const QDomElement pattern = documentElement();
+    return not pattern.isNull() && pattern.hasAttribute(AttrCurveApproximationScale);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ResetCurveApproximationScale removes own approximation scale, the pattern follows preferences again.
+ */
+void VAbstractPattern::ResetCurveApproximationScale()
+{
+    if (HasCurveApproximationScale())
+    {
+        QDomElement pattern = documentElement();
+        pattern.removeAttribute(AttrCurveApproximationScale);
+        modified = true;
+        emit patternChanged(false);
+    }
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void VAbstractPattern::SetPatternLabelTemplate(const QVector<VLabelTemplateLine> &lines)
 {
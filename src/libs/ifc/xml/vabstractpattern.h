@@ -58,6 +58,7 @@
 #include <QMetaObject>
 #include <QObject>
 #include <QPair>
+#include <QSet>
 #include <QString>
 #include <QStringList>
 #include <QVector>
@@ -128,6 +129,7 @@ class VAbstractPattern : public QObject, public VDomDocument
     virtual QString GenerateSuffix() const=0;
 
     virtual void   UpdateToolData(const quint32 &id, VContainer *data)=0;
+    void           MarkToolChanged(quint32 id);
 
     static VDataTool* getTool(quint32 id);
     static void       AddTool(quint32 id, VDataTool *tool);
@@ -180,6 +182,11 @@ class VAbstractPattern : public QObject, public VDomDocument
     QString        GetLabelTimeFormat() const;
     void           SetLabelTimeFormat(const QString &format);
 
+    qreal          GetCurveApproximationScale() const;
+    void           SetCurveApproximationScale(qreal scale);
+    bool           HasCurveApproximationScale() const;
+    void           ResetCurveApproximationScale();
+
     void                        SetPatternLabelTemplate(const QVector<VLabelTemplateLine> &lines);
     QVector<VLabelTemplateLine> GetPatternLabelTemplate() const;
 
@@ -259,6 +266,7 @@ class VAbstractPattern : public QObject, public VDomDocument
     static const QString AttrOnFold;
     static const QString AttrDateFormat;
     static const QString AttrTimeFormat;
+    static const QString AttrCurveApproximationScale;
     static const QString AttrArrows;
     static const QString AttrNodeReverse;
     static const QString AttrNodeExcluded;
@@ -419,6 +427,9 @@ public slots:
     /** @brief modified keep state of the document for cases that do not cover QUndoStack*/
     mutable bool   modified;
 
+    /** @brief changedTools tools whose options were changed since last parsing. */
+    QSet<quint32>  changedTools;
+
     /** @brief tools list with pointer on tools. */
     static QHash<quint32, VDataTool*> tools;
     /** @brief patternLabelLines list to speed up reading a template by many pieces. */
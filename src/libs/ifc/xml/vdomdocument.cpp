@@ -67,10 +67,16 @@
 #include <QByteArray>
 #include <QDomNodeList>
 #include <QDomText>
+#include <QBuffer>
 #include <QFile>
+#include <QHash>
 #include <QIODevice>
 #include <QMessageLogger>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QObject>
+#include <QSet>
+#include <QSharedPointer>
 #include <QSourceLocation>
 #include <QStringList>
 #include <QTemporaryFile>
@@ -81,6 +87,7 @@
 #include <QXmlSchema>
 #include <QXmlSchemaValidator>
 #include <QtDebug>
+#include <QXmlStreamReader>
 #include <QXmlStreamWriter>
 
 namespace
@@ -140,6 +147,117 @@ void SaveNodeCanonically(QXmlStreamWriter &stream, const QDomNode &domNode)
         stream.writeCharacters(domNode.nodeValue());
     }
 }
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief The SharedStrings class keeps one copy of each tag name, attribute name and short attribute value. Patterns
+ * repeat them thousands of times, so implicit sharing saves most of the memory spent on strings in the tree.
+ */
+class SharedStrings
+{
+public:
+    QString Name(const QStringRef &ref);
+    QString Value(const QStringRef &ref);
+
+private:
+    QSet<QString> m_strings{};
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+QString SharedStrings::Name(const QStringRef &ref)
+{
+    const QString str = ref.toString();
+    const auto i = m_strings.constFind(str);
+    if (i != m_strings.constEnd())
+    {
+        return *i;
+    }
+
+    m_strings.insert(str);
+    return str;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QString SharedStrings::Value(const QStringRef &ref)
+{
+    // Long values are formulas and notes, they rarely repeat
+    const int maxSharedLength = 16;
+    return ref.size() <= maxSharedLength ? Name(ref) : ref.toString();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief BuildDomTree build the DOM tree straight from the stream reader, without setContent() and its whole file
+ * string. The result is the same tree QDomDocument::setContent() creates: whitespace only text is dropped, comments and
+ * processing instructions are kept, namespace declarations stay ordinary attributes.
+ * @return false if the reader met an error.
+ */
+bool BuildDomTree(QDomDocument &doc, QXmlStreamReader &reader)
+{
+    // Like setContent() without namespace processing, otherwise the reader takes xmlns attributes away from elements
+    reader.setNamespaceProcessing(false);
+
+    SharedStrings strings;
+    QDomNode parent; // Null while on the document level
+    auto Append = [&doc, &parent](const QDomNode &node)
+    {
+        return parent.isNull() ? doc.appendChild(node) : parent.appendChild(node);
+    };
+
+    while (not reader.atEnd())
+    {
+        switch (reader.readNext())
+        {
+            case QXmlStreamReader::StartDocument:
+                if (not reader.documentVersion().isEmpty())
+                {
+                    QString data = QStringLiteral("version=\"%1\"").arg(reader.documentVersion().toString());
+                    if (not reader.documentEncoding().isEmpty())
+                    {
+                        data += QStringLiteral(" encoding=\"%1\"").arg(reader.documentEncoding().toString());
+                    }
+                    Append(doc.createProcessingInstruction(QStringLiteral("xml"), data));
+                }
+                break;
+            case QXmlStreamReader::StartElement:
+            {
+                QDomElement element = doc.createElement(strings.Name(reader.qualifiedName()));
+                const QXmlStreamAttributes attributes = reader.attributes();
+                for (int i = 0; i < attributes.size(); ++i)
+                {
+                    const QXmlStreamAttribute &attribute = attributes.at(i);
+                    element.setAttribute(strings.Name(attribute.qualifiedName()), strings.Value(attribute.value()));
+                }
+                parent = Append(element);
+                break;
+            }
+            case QXmlStreamReader::EndElement:
+                parent = parent.parentNode();
+                break;
+            case QXmlStreamReader::Characters:
+                if (reader.isCDATA())
+                {
+                    Append(doc.createCDATASection(reader.text().toString()));
+                }
+                else if (not reader.isWhitespace())
+                {
+                    Append(doc.createTextNode(reader.text().toString()));
+                }
+                break;
+            case QXmlStreamReader::Comment:
+                Append(doc.createComment(reader.text().toString()));
+                break;
+            case QXmlStreamReader::ProcessingInstruction:
+                Append(doc.createProcessingInstruction(reader.processingInstructionTarget().toString(),
+                                                       reader.processingInstructionData().toString()));
+                break;
+            default:
+                break;
+        }
+    }
+
+    return not reader.hasError();
+}
 }
 
 //This class need for validation pattern file using XSD shema
@@ -199,6 +317,90 @@ void MessageHandler::handleMessage(QtMsgType type, const QString &description, c
     m_sourceLocation = sourceLocation;
 }
 
+namespace
+{
+/**
+ * @brief The CompiledSchema struct keeps a compiled schema for the process lifetime.
+ *
+ * Sharing a QXmlSchema between threads is not documented as safe, so validations with the same schema are serialized
+ * by the mutex. Different schemas are validated in parallel.
+ */
+struct CompiledSchema
+{
+    CompiledSchema()
+        : handler(),
+          schema(),
+          mutex()
+    {}
+
+    MessageHandler handler;
+    QXmlSchema     schema;
+    QMutex         mutex;
+
+private:
+    Q_DISABLE_COPY(CompiledSchema)
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+QMutex *SchemaCacheLock()
+{
+    static QMutex lock;
+    return &lock;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QHash<QString, QSharedPointer<CompiledSchema>> &SchemaCache()
+{
+    static QHash<QString, QSharedPointer<CompiledSchema>> cache;
+    return cache;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GetCompiledSchema return compiled schema from cache, compile it on first use.
+ * @param schema path to schema file.
+ */
+QSharedPointer<CompiledSchema> GetCompiledSchema(const QString &schema)
+{
+    QMutexLocker locker(SchemaCacheLock());
+    QSharedPointer<CompiledSchema> compiled = SchemaCache().value(schema);
+    if (not compiled.isNull())
+    {
+        return compiled;
+    }
+
+    QFile fileSchema(schema);
+    // cppcheck-suppress ConfigurationNotChecked
+    if (fileSchema.open(QIODevice::ReadOnly) == false)
+    {
+        const QString errorMsg(VDomDocument::tr("Can't open schema file %1:\n%2.").arg(schema)
+                               .arg(fileSchema.errorString()));
+        throw VException(errorMsg);
+    }
+
+    compiled = QSharedPointer<CompiledSchema>(new CompiledSchema());
+    compiled->schema.setMessageHandler(&compiled->handler);
+    if (compiled->schema.load(&fileSchema, QUrl::fromLocalFile(fileSchema.fileName()))==false)
+    {
+        VException e(compiled->handler.statusMessage());
+        e.AddMoreInformation(VDomDocument::tr("Could not load schema file '%1'.").arg(fileSchema.fileName()));
+        throw e;
+    }
+
+    if (compiled->schema.isValid() == false)
+    {
+        VException e(compiled->handler.statusMessage());
+        e.AddMoreInformation(VDomDocument::tr("Validation error file %3 in line %1 column %2")
+                             .arg(compiled->handler.line()).arg(compiled->handler.column()).arg(schema));
+        throw e;
+    }
+    qCDebug(vXML, "Schema %s compiled.", qUtf8Printable(schema));
+
+    SchemaCache().insert(schema, compiled);
+    return compiled;
+}
+}
+
 Q_LOGGING_CATEGORY(vXML, "v.xml")
 
 const QString VDomDocument::AttrId          = QStringLiteral("id");
@@ -212,6 +414,8 @@ const QString VDomDocument::TagVersion = QStringLiteral("version");
 const QString VDomDocument::TagUnit    = QStringLiteral("unit");
 const QString VDomDocument::TagLine    = QStringLiteral("line");
 
+bool VDomDocument::streamLoading = false;
+
 //---------------------------------------------------------------------------------------------------------------------
 VDomDocument::VDomDocument()
     : QDomDocument(),
@@ -219,78 +423,103 @@ VDomDocument::VDomDocument()
 {}
 
 //---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief elementById find element by id.
+ *
+ * Lookup uses the id index and never scans the document. The index is built when content is loaded and kept up to date
+ * by RegisterElementId() and UnregisterElementId().
+ * @param id id value.
+ * @param tagName kept for compatibility, lookup doesn't depend on it.
+ * @return element or null element if there is no element with this id in the document.
+ */
 QDomElement VDomDocument::elementById(quint32 id, const QString &tagName)
 {
-    if (id == 0)
+    Q_UNUSED(tagName)
+
+    if (id == NULL_ID)
     {
         return QDomElement();
     }
 
-    if (map.contains(id))
+    const auto i = map.constFind(id);
+    if (i != map.constEnd() && IsAttached(*i))
     {
-       const QDomElement e = map[id];
-       if (e.parentNode().nodeType() != QDomNode::BaseNode)
-       {
-           return e;
-       }
-       map.remove(id);
+        return *i;
     }
 
-    if (tagName.isEmpty())
+    return QDomElement();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief RefreshElementIdCache rebuild id index from scratch.
+ */
+void VDomDocument::RefreshElementIdCache()
+{
+    map.clear();
+    RegisterElementId(documentElement());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief RegisterElementId add element and all its children that have attribute id to the id index. Call after
+ * inserting a subtree into the document.
+ * @param domElement root of inserted subtree.
+ */
+void VDomDocument::RegisterElementId(const QDomElement &domElement)
+{
+    if (domElement.isNull())
     {
-        if (this->find(this->documentElement(), id))
-        {
-           return map[id];
-        }
+        return;
     }
-    else
+
+    if (domElement.hasAttribute(AttrId))
     {
-        const QDomNodeList list = elementsByTagName(tagName);
-        for (int i=0; i < list.size(); ++i)
+        try
         {
-            const QDomElement domElement = list.at(i).toElement();
-            if (not domElement.isNull() && domElement.hasAttribute(AttrId))
+            const quint32 elementId = GetParametrUInt(domElement, AttrId, NULL_ID_STR);
+            if (elementId != NULL_ID)
             {
-                try
-                {
-                    const quint32 elementId = GetParametrUInt(domElement, AttrId, NULL_ID_STR);
-
-                    this->map[elementId] = domElement;
-                    if (elementId == id)
-                    {
-                        return domElement;
-                    }
-                }
-                catch (const VExceptionConversionError &)
-                {
-                    // do nothing
-                }
+                map.insert(elementId, domElement);
             }
         }
+        catch (const VExceptionConversionError &)
+        {
+            // do nothing
+        }
     }
 
-    return QDomElement();
+    QDomElement child = domElement.firstChildElement();
+    while (not child.isNull())
+    {
+        RegisterElementId(child);
+        child = child.nextSiblingElement();
+    }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 /**
- * @brief Find element by id.
- * @param node node
- * @param id id value
- * @return true if found
+ * @brief UnregisterElementId remove element and all its children from the id index. Call after removing a subtree
+ * from the document.
+ * @param domElement root of removed subtree.
  */
-bool VDomDocument::find(const QDomElement &node, quint32 id)
+void VDomDocument::UnregisterElementId(const QDomElement &domElement)
 {
-    if (node.hasAttribute(AttrId))
+    if (domElement.isNull())
+    {
+        return;
+    }
+
+    if (domElement.hasAttribute(AttrId))
     {
         try
         {
-            const quint32 elementId = GetParametrUInt(node, AttrId, NULL_ID_STR);
-
-            this->map[elementId] = node;
-            if (elementId == id)
+            const quint32 elementId = GetParametrUInt(domElement, AttrId, NULL_ID_STR);
+            const auto i = map.find(elementId);
+            // Index may already point to a replacement with the same id
+            if (i != map.end() && *i == domElement)
             {
-                return true;
+                map.erase(i);
             }
         }
         catch (const VExceptionConversionError &)
@@ -299,18 +528,37 @@ bool VDomDocument::find(const QDomElement &node, quint32 id)
         }
     }
 
-    for (qint32 i=0; i<node.childNodes().length(); ++i)
+    QDomElement child = domElement.firstChildElement();
+    while (not child.isNull())
     {
-        const QDomNode n = node.childNodes().at(i);
-        if (n.isElement())
-        {
-            if (this->find(n.toElement(), id))
-            {
-                return true;
-            }
-        }
+        UnregisterElementId(child);
+        child = child.nextSiblingElement();
     }
-    return false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief clear remove all content and the id index.
+ */
+void VDomDocument::clear()
+{
+    QDomDocument::clear();
+    map.clear();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief IsAttached check if element still belongs to the document tree. Protects lookup from elements that were
+ * removed without UnregisterElementId().
+ */
+bool VDomDocument::IsAttached(const QDomElement &domElement) const
+{
+    QDomNode node = domElement;
+    while (not node.parentNode().isNull())
+    {
+        node = node.parentNode();
+    }
+    return node == *this;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -649,53 +897,73 @@ void VDomDocument::ValidateXML(const QString &schema, const QString &fileName)
         throw VException(errorMsg);
     }
 
-    QFile fileSchema(schema);
-    // cppcheck-suppress ConfigurationNotChecked
-    if (fileSchema.open(QIODevice::ReadOnly) == false)
-    {
-        pattern.close();
-        const QString errorMsg(tr("Can't open schema file %1:\n%2.").arg(schema).arg(fileSchema.errorString()));
-        throw VException(errorMsg);
-    }
+    ValidateXML(schema, &pattern, fileName);
+    pattern.close();
+}
 
-    MessageHandler messageHandler;
-    QXmlSchema sch;
-    sch.setMessageHandler(&messageHandler);
-    if (sch.load(&fileSchema, QUrl::fromLocalFile(fileSchema.fileName()))==false)
-    {
-        pattern.close();
-        fileSchema.close();
-        VException e(messageHandler.statusMessage());
-        e.AddMoreInformation(tr("Could not load schema file '%1'.").arg(fileSchema.fileName()));
-        throw e;
-    }
-    qCDebug(vXML, "Schema loaded.");
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ValidateXML validate xml data by xsd schema.
+ * @param schema path to schema file.
+ * @param xml opened device with xml data, for example a buffer with not saved document.
+ * @param fileName name of xml file for error messages.
+ */
+void VDomDocument::ValidateXML(const QString &schema, QIODevice *xml, const QString &fileName)
+{
+    SCASSERT(xml != nullptr)
 
-    bool errorOccurred = false;
-    if (sch.isValid() == false)
-    {
-        errorOccurred = true;
-    }
-    else
-    {
-        QXmlSchemaValidator validator(sch);
-        if (validator.validate(&pattern, QUrl::fromLocalFile(pattern.fileName())) == false)
-        {
-            errorOccurred = true;
-        }
-    }
+    const QSharedPointer<CompiledSchema> compiled = GetCompiledSchema(schema);
+    QMutexLocker locker(&compiled->mutex);
 
-    if (errorOccurred)
+    MessageHandler messageHandler;
+    QXmlSchemaValidator validator(compiled->schema);
+    validator.setMessageHandler(&messageHandler);
+    if (validator.validate(xml, QUrl::fromLocalFile(fileName)) == false)
     {
-        pattern.close();
-        fileSchema.close();
         VException e(messageHandler.statusMessage());
         e.AddMoreInformation(tr("Validation error file %3 in line %1 column %2").arg(messageHandler.line())
                              .arg(messageHandler.column()).arg(fileName));
         throw e;
     }
-    pattern.close();
-    fileSchema.close();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ValidateXML validate xml data in memory by xsd schema.
+ * @param schema path to schema file.
+ * @param data xml data.
+ * @param fileName name of xml file for error messages.
+ */
+void VDomDocument::ValidateXML(const QString &schema, const QByteArray &data, const QString &fileName)
+{
+    QBuffer buffer;
+    buffer.setData(data);
+    buffer.open(QIODevice::ReadOnly);
+    ValidateXML(schema, &buffer, fileName);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ValidateXML validate document by xsd schema without saving it. Line numbers in error messages refer to the
+ * document saved with indent 4.
+ * @param schema path to schema file.
+ * @param document xml document.
+ * @param fileName name of xml file for error messages.
+ */
+void VDomDocument::ValidateXML(const QString &schema, const QDomDocument &document, const QString &fileName)
+{
+    const int indent = 4;
+    ValidateXML(schema, document.toByteArray(indent), fileName);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ClearSchemaCache forget all compiled schemas. Needed only to measure cost of compilation.
+ */
+void VDomDocument::ClearSchemaCache()
+{
+    QMutexLocker locker(SchemaCacheLock());
+    SchemaCache().clear();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -710,9 +978,31 @@ void VDomDocument::setXMLContent(const QString &fileName)
     }
 
     QString errorMsg;
-    int errorLine = -1;
-    int errorColumn = -1;
-    if (QDomDocument::setContent(&file, &errorMsg, &errorLine, &errorColumn) == false)
+    qint64 errorLine = -1;
+    qint64 errorColumn = -1;
+    bool ok = false;
+    if (streamLoading)
+    {
+        clear();
+        QXmlStreamReader reader(&file);
+        ok = BuildDomTree(*this, reader);
+        if (not ok)
+        {
+            errorMsg = reader.errorString();
+            errorLine = reader.lineNumber();
+            errorColumn = reader.columnNumber();
+        }
+    }
+    else
+    {
+        int line = -1;
+        int column = -1;
+        ok = QDomDocument::setContent(&file, &errorMsg, &line, &column);
+        errorLine = line;
+        errorColumn = column;
+    }
+
+    if (not ok)
     {
         file.close();
         VException e(errorMsg);
@@ -720,6 +1010,28 @@ void VDomDocument::setXMLContent(const QString &fileName)
                              .arg(fileName));
         throw e;
     }
+
+    RefreshElementIdCache();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief IsStreamLoading return true if setXMLContent() reads files with QXmlStreamReader.
+ */
+bool VDomDocument::IsStreamLoading()
+{
+    return streamLoading;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetStreamLoading switch setXMLContent() to the streaming loader. It reads the file in chunks and builds the
+ * tree without an intermediate copy of the whole file, which is faster and needs less memory. Console mode turns it
+ * on, the GUI keeps QDomDocument::setContent().
+ */
+void VDomDocument::SetStreamLoading(bool value)
+{
+    streamLoading = value;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
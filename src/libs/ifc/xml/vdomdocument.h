@@ -72,6 +72,7 @@
 
 class QDomElement;
 class QDomNode;
+class QIODevice;
 template <typename T> class QVector;
 
 Q_DECLARE_LOGGING_CATEGORY(vXML)
@@ -119,6 +120,10 @@ class VDomDocument : public QDomDocument
     VDomDocument();
     virtual ~VDomDocument() Q_DECL_EQ_DEFAULT;
     QDomElement elementById(quint32 id, const QString &tagName = QString());
+    void        RefreshElementIdCache();
+    void        RegisterElementId(const QDomElement &domElement);
+    void        UnregisterElementId(const QDomElement &domElement);
+    void        clear();
 
     template <typename T>
     void SetAttribute(QDomElement &domElement, const QString &name, const T &value) const;
@@ -138,7 +143,13 @@ class VDomDocument : public QDomDocument
     Unit           MUnit() const;
 
     static void    ValidateXML(const QString &schema, const QString &fileName);
+    static void    ValidateXML(const QString &schema, QIODevice *xml, const QString &fileName);
+    static void    ValidateXML(const QString &schema, const QByteArray &data, const QString &fileName);
+    static void    ValidateXML(const QString &schema, const QDomDocument &document, const QString &fileName);
+    static void    ClearSchemaCache();
     virtual void   setXMLContent(const QString &fileName);
+    static bool    IsStreamLoading();
+    static void    SetStreamLoading(bool value);
     static QString UnitsHelpString();
 
     virtual bool   SaveDocument(const QString &fileName, QString &error);
@@ -166,10 +177,12 @@ class VDomDocument : public QDomDocument
 
 private:
     Q_DISABLE_COPY(VDomDocument)
-    /** @brief Map used for finding element by id. */
+    /** @brief Index of all elements with attribute id, used for finding element by id. */
     QHash<quint32, QDomElement> map;
 
-    bool           find(const QDomElement &node, quint32 id);
+    static bool    streamLoading;
+
+    bool           IsAttached(const QDomElement &domElement) const;
 
     bool SaveCanonicalXML(QIODevice *file, int indent, QString &error) const;
 };
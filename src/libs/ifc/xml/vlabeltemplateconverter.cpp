@@ -128,5 +128,4 @@ void VLabelTemplateConverter::ApplyPatches()
 void VLabelTemplateConverter::DowngradeToCurrentMaxVersion()
 {
     SetVersion(LabelTemplateMaxVerStr);
-    Save();
 }
@@ -84,8 +84,8 @@ Q_LOGGING_CATEGORY(PatternConverter, "patternConverter")
  */
 
 const QString VPatternConverter::PatternMinVerStr = QStringLiteral("0.1.0");
-const QString VPatternConverter::PatternMaxVerStr = QStringLiteral("0.6.2");
-const QString VPatternConverter::CurrentSchema    = QStringLiteral("://schema/pattern/v0.6.2.xsd");
+const QString VPatternConverter::PatternMaxVerStr = QStringLiteral("0.6.3");
+const QString VPatternConverter::CurrentSchema    = QStringLiteral("://schema/pattern/v0.6.3.xsd");
 
 //VPatternConverter::PatternMinVer; // <== DON'T FORGET TO UPDATE TOO!!!!
 //VPatternConverter::PatternMaxVer; // <== DON'T FORGET TO UPDATE TOO!!!!
@@ -297,7 +297,9 @@ QString VPatternConverter::XSDSchema(int ver) const
         case (0x000601):
             return QStringLiteral("://schema/pattern/v0.6.1.xsd");
         case (0x000602):
-            qCDebug(PatternConverter, "Current schema - ://schema/pattern/v0.6.2.xsd");
+            return QStringLiteral("://schema/pattern/v0.6.2.xsd");
+        case (0x000603):
+            qCDebug(PatternConverter, "Current schema - ://schema/pattern/v0.6.3.xsd");
             return CurrentSchema;
         default:
             InvalidVersion(ver);
@@ -313,149 +315,153 @@ void VPatternConverter::ApplyPatches()
     {
         case (0x000100):
             ToV0_1_1();
-            ValidateXML(XSDSchema(0x000101), m_convertedFileName);
+            ValidateIntermediate(0x000101);
             V_FALLTHROUGH
         case (0x000101):
             ToV0_1_2();
-            ValidateXML(XSDSchema(0x000102), m_convertedFileName);
+            ValidateIntermediate(0x000102);
             V_FALLTHROUGH
         case (0x000102):
             ToV0_1_3();
-            ValidateXML(XSDSchema(0x000103), m_convertedFileName);
+            ValidateIntermediate(0x000103);
             V_FALLTHROUGH
         case (0x000103):
             ToV0_1_4();
-            ValidateXML(XSDSchema(0x000104), m_convertedFileName);
+            ValidateIntermediate(0x000104);
             V_FALLTHROUGH
         case (0x000104):
             ToV0_2_0();
-            ValidateXML(XSDSchema(0x000200), m_convertedFileName);
+            ValidateIntermediate(0x000200);
             V_FALLTHROUGH
         case (0x000200):
             ToV0_2_1();
-            ValidateXML(XSDSchema(0x000201), m_convertedFileName);
+            ValidateIntermediate(0x000201);
             V_FALLTHROUGH
         case (0x000201):
             ToV0_2_2();
-            ValidateXML(XSDSchema(0x000202), m_convertedFileName);
+            ValidateIntermediate(0x000202);
             V_FALLTHROUGH
         case (0x000202):
             ToV0_2_3();
-            ValidateXML(XSDSchema(0x000203), m_convertedFileName);
+            ValidateIntermediate(0x000203);
             V_FALLTHROUGH
         case (0x000203):
             ToV0_2_4();
-            ValidateXML(XSDSchema(0x000204), m_convertedFileName);
+            ValidateIntermediate(0x000204);
             V_FALLTHROUGH
         case (0x000204):
             ToV0_2_5();
-            ValidateXML(XSDSchema(0x000205), m_convertedFileName);
+            ValidateIntermediate(0x000205);
             V_FALLTHROUGH
         case (0x000205):
             ToV0_2_6();
-            ValidateXML(XSDSchema(0x000206), m_convertedFileName);
+            ValidateIntermediate(0x000206);
             V_FALLTHROUGH
         case (0x000206):
             ToV0_2_7();
-            ValidateXML(XSDSchema(0x000207), m_convertedFileName);
+            ValidateIntermediate(0x000207);
             V_FALLTHROUGH
         case (0x000207):
             ToV0_3_0();
-            ValidateXML(XSDSchema(0x000300), m_convertedFileName);
+            ValidateIntermediate(0x000300);
             V_FALLTHROUGH
         case (0x000300):
             ToV0_3_1();
-            ValidateXML(XSDSchema(0x000301), m_convertedFileName);
+            ValidateIntermediate(0x000301);
             V_FALLTHROUGH
         case (0x000301):
             ToV0_3_2();
-            ValidateXML(XSDSchema(0x000302), m_convertedFileName);
+            ValidateIntermediate(0x000302);
             V_FALLTHROUGH
         case (0x000302):
             ToV0_3_3();
-            ValidateXML(XSDSchema(0x000303), m_convertedFileName);
+            ValidateIntermediate(0x000303);
             V_FALLTHROUGH
         case (0x000303):
             ToV0_3_4();
-            ValidateXML(XSDSchema(0x000304), m_convertedFileName);
+            ValidateIntermediate(0x000304);
             V_FALLTHROUGH
         case (0x000304):
             ToV0_3_5();
-            ValidateXML(XSDSchema(0x000305), m_convertedFileName);
+            ValidateIntermediate(0x000305);
             V_FALLTHROUGH
         case (0x000305):
             ToV0_3_6();
-            ValidateXML(XSDSchema(0x000306), m_convertedFileName);
+            ValidateIntermediate(0x000306);
             V_FALLTHROUGH
         case (0x000306):
             ToV0_3_7();
-            ValidateXML(XSDSchema(0x000307), m_convertedFileName);
+            ValidateIntermediate(0x000307);
             V_FALLTHROUGH
         case (0x000307):
             ToV0_3_8();
-            ValidateXML(XSDSchema(0x000308), m_convertedFileName);
+            ValidateIntermediate(0x000308);
             V_FALLTHROUGH
         case (0x000308):
             ToV0_3_9();
-            ValidateXML(XSDSchema(0x000309), m_convertedFileName);
+            ValidateIntermediate(0x000309);
             V_FALLTHROUGH
         case (0x000309):
             ToV0_4_0();
-            ValidateXML(XSDSchema(0x000400), m_convertedFileName);
+            ValidateIntermediate(0x000400);
             V_FALLTHROUGH
         case (0x000400):
             ToV0_4_1();
-            ValidateXML(XSDSchema(0x000401), m_convertedFileName);
+            ValidateIntermediate(0x000401);
             V_FALLTHROUGH
         case (0x000401):
             ToV0_4_2();
-            ValidateXML(XSDSchema(0x000402), m_convertedFileName);
+            ValidateIntermediate(0x000402);
             V_FALLTHROUGH
         case (0x000402):
             ToV0_4_3();
-            ValidateXML(XSDSchema(0x000403), m_convertedFileName);
+            ValidateIntermediate(0x000403);
             V_FALLTHROUGH
         case (0x000403):
             ToV0_4_4();
-            ValidateXML(XSDSchema(0x000404), m_convertedFileName);
+            ValidateIntermediate(0x000404);
             V_FALLTHROUGH
         case (0x000404):
             ToV0_4_5();
-            ValidateXML(XSDSchema(0x000405), m_convertedFileName);
+            ValidateIntermediate(0x000405);
             V_FALLTHROUGH
         case (0x000405):
             ToV0_4_6();
-            ValidateXML(XSDSchema(0x000406), m_convertedFileName);
+            ValidateIntermediate(0x000406);
             V_FALLTHROUGH
         case (0x000406):
             ToV0_4_7();
-            ValidateXML(XSDSchema(0x000407), m_convertedFileName);
+            ValidateIntermediate(0x000407);
             V_FALLTHROUGH
         case (0x000407):
             ToV0_4_8();
-            ValidateXML(XSDSchema(0x000408), m_convertedFileName);
+            ValidateIntermediate(0x000408);
             V_FALLTHROUGH
         case (0x000408):
             ToV0_5_0();
-            ValidateXML(XSDSchema(0x000500), m_convertedFileName);
+            ValidateIntermediate(0x000500);
             V_FALLTHROUGH
         case (0x000500):
             ToV0_5_1();
-            ValidateXML(XSDSchema(0x000501), m_convertedFileName);
+            ValidateIntermediate(0x000501);
             V_FALLTHROUGH
         case (0x000501):
             ToV0_6_0();
-            ValidateXML(XSDSchema(0x000600), m_convertedFileName);
+            ValidateIntermediate(0x000600);
             V_FALLTHROUGH
         case (0x000600):
             ToV0_6_1();
-            ValidateXML(XSDSchema(0x000601), m_convertedFileName);
+            ValidateIntermediate(0x000601);
             V_FALLTHROUGH
         case (0x000601):
             ToV0_6_2();
-            ValidateXML(XSDSchema(0x000602), m_convertedFileName);
+            ValidateIntermediate(0x000602);
             V_FALLTHROUGH
         case (0x000602):
+            ToV0_6_3();
+            ValidateIntermediate(0x000603);
+            V_FALLTHROUGH
+        case (0x000603):
             break;
         default:
             InvalidVersion(m_ver);
@@ -467,14 +473,13 @@ void VPatternConverter::ApplyPatches()
 void VPatternConverter::DowngradeToCurrentMaxVersion()
 {
     SetVersion(PatternMaxVerStr);
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 bool VPatternConverter::IsReadOnly() const
 {
     // Check if attribute readOnly was not changed in file format
-    Q_STATIC_ASSERT_X(VPatternConverter::PatternMaxVer == CONVERTER_VERSION_CHECK(0, 6, 2),
+    Q_STATIC_ASSERT_X(VPatternConverter::PatternMaxVer == CONVERTER_VERSION_CHECK(0, 6, 3),
                       "Check attribute readOnly.");
 
     // Possibly in future attribute readOnly will change position etc.
@@ -499,7 +504,6 @@ void VPatternConverter::ToV0_1_1()
                       "Time to refactor the code.");
 
     SetVersion(QStringLiteral("0.1.1"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -510,7 +514,6 @@ void VPatternConverter::ToV0_1_2()
                       "Time to refactor the code.");
 
     SetVersion(QStringLiteral("0.1.2"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -521,7 +524,6 @@ void VPatternConverter::ToV0_1_3()
                       "Time to refactor the code.");
 
     SetVersion(QStringLiteral("0.1.3"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -532,7 +534,6 @@ void VPatternConverter::ToV0_1_4()
                       "Time to refactor the code.");
 
     SetVersion(QStringLiteral("0.1.4"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -547,7 +548,6 @@ void VPatternConverter::ToV0_2_0()
     TagIncrementToV0_2_0();
     ConvertMeasurementsToV0_2_0();
     TagMeasurementsToV0_2_0();//Alwayse last!!!
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -559,7 +559,6 @@ void VPatternConverter::ToV0_2_1()
 
     SetVersion(QStringLiteral("0.2.1"));
     ConvertMeasurementsToV0_2_1();
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -570,7 +569,6 @@ void VPatternConverter::ToV0_2_2()
                       "Time to refactor the code.");
 
     SetVersion(QStringLiteral("0.2.2"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -581,7 +579,6 @@ void VPatternConverter::ToV0_2_3()
                       "Time to refactor the code.");
 
     SetVersion(QStringLiteral("0.2.3"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -593,7 +590,6 @@ void VPatternConverter::ToV0_2_4()
 
     FixToolUnionToV0_2_4();
     SetVersion(QStringLiteral("0.2.4"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -604,7 +600,6 @@ void VPatternConverter::ToV0_2_5()
                       "Time to refactor the code.");
 
     SetVersion(QStringLiteral("0.2.5"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -615,7 +610,6 @@ void VPatternConverter::ToV0_2_6()
                       "Time to refactor the code.");
 
     SetVersion(QStringLiteral("0.2.6"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -626,7 +620,6 @@ void VPatternConverter::ToV0_2_7()
                       "Time to refactor the code.");
 
     SetVersion(QStringLiteral("0.2.7"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -640,7 +633,6 @@ void VPatternConverter::ToV0_3_0()
     FixCutPoint();
     FixCutPoint();
     SetVersion(QStringLiteral("0.3.0"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -652,7 +644,6 @@ void VPatternConverter::ToV0_3_1()
 
     SetVersion(QStringLiteral("0.3.1"));
     RemoveColorToolCutV0_3_1();
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -663,7 +654,6 @@ void VPatternConverter::ToV0_3_2()
                       "Time to refactor the code.");
 
     SetVersion(QStringLiteral("0.3.2"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -674,7 +664,6 @@ void VPatternConverter::ToV0_3_3()
                       "Time to refactor the code.");
 
     SetVersion(QStringLiteral("0.3.3"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -685,7 +674,6 @@ void VPatternConverter::ToV0_3_4()
                       "Time to refactor the code.");
 
     SetVersion(QStringLiteral("0.3.4"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -696,7 +684,6 @@ void VPatternConverter::ToV0_3_5()
                       "Time to refactor the code.");
 
     SetVersion(QStringLiteral("0.3.5"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -707,7 +694,6 @@ void VPatternConverter::ToV0_3_6()
                       "Time to refactor the code.");
 
     SetVersion(QStringLiteral("0.3.6"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -718,7 +704,6 @@ void VPatternConverter::ToV0_3_7()
                       "Time to refactor the code.");
 
     SetVersion(QStringLiteral("0.3.7"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -729,7 +714,6 @@ void VPatternConverter::ToV0_3_8()
                       "Time to refactor the code.");
 
     SetVersion(QStringLiteral("0.3.8"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -740,7 +724,6 @@ void VPatternConverter::ToV0_3_9()
                       "Time to refactor the code.");
 
     SetVersion(QStringLiteral("0.3.9"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -754,7 +737,6 @@ void VPatternConverter::ToV0_4_0()
     TagRemoveAttributeTypeObjectInV0_4_0();
     TagDetailToV0_4_0();
     TagUnionDetailsToV0_4_0();
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -765,7 +747,6 @@ void VPatternConverter::ToV0_4_1()
                       "Time to refactor the code.");
 
     SetVersion(QStringLiteral("0.4.1"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -776,7 +757,6 @@ void VPatternConverter::ToV0_4_2()
                       "Time to refactor the code.");
 
     SetVersion(QStringLiteral("0.4.2"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -787,7 +767,6 @@ void VPatternConverter::ToV0_4_3()
                       "Time to refactor the code.");
 
     SetVersion(QStringLiteral("0.4.3"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -800,7 +779,6 @@ void VPatternConverter::ToV0_4_4()
     SetVersion(QStringLiteral("0.4.4"));
     LabelTagToV0_4_4(strData);
     LabelTagToV0_4_4(strPatternInfo);
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -810,7 +788,6 @@ void VPatternConverter::ToV0_4_5()
     Q_STATIC_ASSERT_X(VPatternConverter::PatternMinVer < CONVERTER_VERSION_CHECK(0, 4, 5),
                       "Time to refactor the code.");
     SetVersion(QStringLiteral("0.4.5"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -820,7 +797,6 @@ void VPatternConverter::ToV0_4_6()
     Q_STATIC_ASSERT_X(VPatternConverter::PatternMinVer < CONVERTER_VERSION_CHECK(0, 4, 6),
                       "Time to refactor the code.");
     SetVersion(QStringLiteral("0.4.6"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -830,7 +806,6 @@ void VPatternConverter::ToV0_4_7()
     Q_STATIC_ASSERT_X(VPatternConverter::PatternMinVer < CONVERTER_VERSION_CHECK(0, 4, 7),
                       "Time to refactor the code.");
     SetVersion(QStringLiteral("0.4.7"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -840,7 +815,6 @@ void VPatternConverter::ToV0_4_8()
     Q_STATIC_ASSERT_X(VPatternConverter::PatternMinVer < CONVERTER_VERSION_CHECK(0, 4, 8),
                       "Time to refactor the code.");
     SetVersion(QStringLiteral("0.4.8"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -850,7 +824,6 @@ void VPatternConverter::ToV0_5_0()
     Q_STATIC_ASSERT_X(VPatternConverter::PatternMinVer < CONVERTER_VERSION_CHECK(0, 5, 0),
                       "Time to refactor the code.");
     SetVersion(QStringLiteral("0.5.0"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -860,7 +833,6 @@ void VPatternConverter::ToV0_5_1()
     Q_STATIC_ASSERT_X(VPatternConverter::PatternMinVer < CONVERTER_VERSION_CHECK(0, 5, 1),
                       "Time to refactor the code.");
     SetVersion(QStringLiteral("0.5.1"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -874,7 +846,6 @@ void VPatternConverter::ToV0_6_0()
     PortPatternLabeltoV0_6_0(label);
     PortPieceLabelstoV0_6_0();
     RemoveUnusedTagsV0_6_0();
-    Save();
 }
 
 
@@ -1011,7 +982,6 @@ void VPatternConverter::ToV0_6_1()
             }
         }
     }
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -1021,7 +991,15 @@ void VPatternConverter::ToV0_6_2()
     Q_STATIC_ASSERT_X(VPatternConverter::PatternMinVer < CONVERTER_VERSION_CHECK(0, 6, 2),
                       "Time to refactor the code.");
     SetVersion(QStringLiteral("0.6.2"));
-    Save();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VPatternConverter::ToV0_6_3()
+{
+    // TODO. Delete if minimal supported version is 0.6.3
+    Q_STATIC_ASSERT_X(VPatternConverter::PatternMinVer < CONVERTER_VERSION_CHECK(0, 6, 3),
+                      "Time to refactor the code.");
+    SetVersion(QStringLiteral("0.6.3"));
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -76,7 +76,7 @@ class VPatternConverter : public VAbstractConverter
     static const QString PatternMaxVerStr;
     static const QString CurrentSchema;
     static Q_DECL_CONSTEXPR const int PatternMinVer = CONVERTER_VERSION_CHECK(0, 1, 0);
-    static Q_DECL_CONSTEXPR const int PatternMaxVer = CONVERTER_VERSION_CHECK(0, 6, 2);
+    static Q_DECL_CONSTEXPR const int PatternMaxVer = CONVERTER_VERSION_CHECK(0, 6, 3);
 
 protected:
     virtual int     MinVer() const Q_DECL_OVERRIDE;
@@ -131,6 +131,7 @@ class VPatternConverter : public VAbstractConverter
     void          ToV0_6_0();
     void          ToV0_6_1();
     void          ToV0_6_2();
+    void          ToV0_6_3();
 
     void          TagUnitToV0_2_0();
     void          TagIncrementToV0_2_0();
@@ -120,19 +120,19 @@ void VVITConverter::ApplyPatches()
     {
         case (0x000200):
             ToV0_3_0();
-            ValidateXML(XSDSchema(0x000300), m_convertedFileName);
+            ValidateIntermediate(0x000300);
             V_FALLTHROUGH
         case (0x000300):
             ToV0_3_1();
-            ValidateXML(XSDSchema(0x000301), m_convertedFileName);
+            ValidateIntermediate(0x000301);
             V_FALLTHROUGH
         case (0x000301):
             ToV0_3_2();
-            ValidateXML(XSDSchema(0x000302), m_convertedFileName);
+            ValidateIntermediate(0x000302);
             V_FALLTHROUGH
         case (0x000302):
             ToV0_3_3();
-            ValidateXML(XSDSchema(0x000303), m_convertedFileName);
+            ValidateIntermediate(0x000303);
             V_FALLTHROUGH
         case (0x000303):
             break;
@@ -146,7 +146,6 @@ void VVITConverter::ApplyPatches()
 void VVITConverter::DowngradeToCurrentMaxVersion()
 {
     SetVersion(MeasurementMaxVerStr);
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -333,7 +332,6 @@ void VVITConverter::ToV0_3_0()
     SetVersion(QStringLiteral("0.3.0"));
     AddNewTagsForV0_3_0();
     ConvertMeasurementsToV0_3_0();
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -345,7 +343,6 @@ void VVITConverter::ToV0_3_1()
 
     SetVersion(QStringLiteral("0.3.1"));
     GenderV0_3_1();
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -357,7 +354,6 @@ void VVITConverter::ToV0_3_2()
 
     SetVersion(QStringLiteral("0.3.2"));
     PM_SystemV0_3_2();
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -369,5 +365,4 @@ void VVITConverter::ToV0_3_3()
 
     SetVersion(QStringLiteral("0.3.3"));
     ConvertMeasurementsToV0_3_3();
-    Save();
 }
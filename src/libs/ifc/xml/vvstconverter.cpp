@@ -122,23 +122,23 @@ void VVSTConverter::ApplyPatches()
     {
         case (0x000300):
             ToV0_4_0();
-            ValidateXML(XSDSchema(0x000400), m_convertedFileName);
+            ValidateIntermediate(0x000400);
             V_FALLTHROUGH
         case (0x000400):
             ToV0_4_1();
-            ValidateXML(XSDSchema(0x000401), m_convertedFileName);
+            ValidateIntermediate(0x000401);
             V_FALLTHROUGH
         case (0x000401):
             ToV0_4_2();
-            ValidateXML(XSDSchema(0x000402), m_convertedFileName);
+            ValidateIntermediate(0x000402);
             V_FALLTHROUGH
         case (0x000402):
             ToV0_4_3();
-            ValidateXML(XSDSchema(0x000403), m_convertedFileName);
+            ValidateIntermediate(0x000403);
             V_FALLTHROUGH
         case (0x000403):
             ToV0_4_4();
-            ValidateXML(XSDSchema(0x000404), m_convertedFileName);
+            ValidateIntermediate(0x000404);
             V_FALLTHROUGH
         case (0x000404):
             break;
@@ -152,7 +152,6 @@ void VVSTConverter::ApplyPatches()
 void VVSTConverter::DowngradeToCurrentMaxVersion()
 {
     SetVersion(MeasurementMaxVerStr);
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -351,7 +350,6 @@ void VVSTConverter::ToV0_4_0()
     AddNewTagsForV0_4_0();
     RemoveTagsForV0_4_0();
     ConvertMeasurementsToV0_4_0();
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -363,7 +361,6 @@ void VVSTConverter::ToV0_4_1()
 
     SetVersion(QStringLiteral("0.4.1"));
     PM_SystemV0_4_1();
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -375,7 +372,6 @@ void VVSTConverter::ToV0_4_2()
 
     SetVersion(QStringLiteral("0.4.2"));
     ConvertMeasurementsToV0_4_2();
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -386,7 +382,6 @@ void VVSTConverter::ToV0_4_3()
                       "Time to refactor the code.");
 
     SetVersion(QStringLiteral("0.4.3"));
-    Save();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -397,5 +392,4 @@ void VVSTConverter::ToV0_4_4()
                       "Time to refactor the code.");
 
     SetVersion(QStringLiteral("0.4.4"));
-    Save();
 }
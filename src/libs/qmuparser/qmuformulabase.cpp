@@ -29,6 +29,7 @@
 #include <QStringData>
 #include <QStringDataPtr>
 #include <QStringList>
+#include <QVector>
 
 namespace qmu
 {
@@ -154,4 +155,44 @@ void QmuFormulaBase::RemoveAll(QMap<int, QString> &map, const QString &val)
     }
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief EvalBulk evaluate one formula for many sets of variable values.
+ *
+ * The formula is parsed once and evaluated for nBulkSize rows. Values are passed as columns: each column holds all
+ * values of one variable, row i of the result uses element i of every column. All variables of the formula must have
+ * a column, the variable factory is not used.
+ *
+ * @param formula expression in internal form.
+ * @param columns values of variables by name. Each column must have at least nBulkSize values.
+ * @param nBulkSize number of rows.
+ * @return nBulkSize values of the formula.
+ */
+QVector<qreal> QmuFormulaBase::EvalBulk(const QString &formula, QMap<QString, QVector<qreal> > columns, int nBulkSize)
+{
+    QVector<qreal> results(qMax(nBulkSize, 0));
+
+    ClearVar();
+    SetVarFactory(nullptr);
+
+    QMap<QString, QVector<qreal> >::iterator i = columns.begin();
+    while (i != columns.end())
+    {
+        if (i.value().size() < nBulkSize)
+        {
+            throw qmu::QmuParserError(ecINVALID_VAR_PTR, i.key(), formula, -1);
+        }
+        DefineVar(i.key(), i.value().data());
+        ++i;
+    }
+
+    SetExpr(formula);
+
+    if (not results.isEmpty())
+    {
+        Eval(results.data(), results.size());
+    }
+    return results;
+}
+
 }// namespace qmu
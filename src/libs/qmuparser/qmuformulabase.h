@@ -24,6 +24,7 @@
 
 #include <qcompilerdetection.h>
 #include <QString>
+#include <QVector>
 #include <QtGlobal>
 
 #include "../qmuparser/qmuparser_global.h"
@@ -45,6 +46,8 @@ class QMUPARSERSHARED_EXPORT QmuFormulaBase : public QmuParser
 
     static void RemoveAll(QMap<int, QString> &map, const QString &val);
 
+    QVector<qreal> EvalBulk(const QString &formula, QMap<QString, QVector<qreal> > columns, int nBulkSize);
+
 protected:
     static qreal* AddVariable(const QString &a_szName, void *a_pUserData);
     void          SetSepForTr(bool osSeparator, bool fromUser);
@@ -83,6 +83,7 @@ QmuParserBase::QmuParserBase()
       m_sInfixOprtChars(),
       m_nIfElseCounter(0),
       m_vStackBuffer(),
+      m_vVectorStack(),
       m_nFinalResultIdx(0),
       m_Tokens(QMap<int, QString>()),
       m_Numbers(QMap<int, QString>()),
@@ -119,6 +120,7 @@ QmuParserBase::QmuParserBase(const QmuParserBase &a_Parser)
       m_sInfixOprtChars(),
       m_nIfElseCounter(0),
       m_vStackBuffer(),
+      m_vVectorStack(),
       m_nFinalResultIdx(0),
       m_Tokens(QMap<int, QString>()),
       m_Numbers(QMap<int, QString>()),
@@ -1335,6 +1337,292 @@ QT_WARNING_POP
     return Stack[m_nFinalResultIdx];
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief IsVectorizable check if the RPN can be evaluated column by column.
+ *
+ * Columnar evaluation has no control flow per row, so if-then-else, assignments, string and bulk functions are left
+ * to ParseCmdCodeBulk().
+ */
+bool QmuParserBase::IsVectorizable() const
+{
+    for (const SToken *pTok = m_vRPN.GetBase(); pTok->Cmd != cmEND; ++pTok)
+    {
+        switch (pTok->Cmd)
+        {
+            case cmLE:
+            case cmGE:
+            case cmNEQ:
+            case cmEQ:
+            case cmLT:
+            case cmGT:
+            case cmADD:
+            case cmSUB:
+            case cmMUL:
+            case cmDIV:
+            case cmPOW:
+            case cmLAND:
+            case cmLOR:
+            case cmVAR:
+            case cmVAL:
+            case cmVARPOW2:
+            case cmVARPOW3:
+            case cmVARPOW4:
+            case cmVARMUL:
+                continue;
+            case cmFUNC:
+                if (pTok->Fun.argc == 1 || pTok->Fun.argc == 2)
+                {
+                    continue;
+                }
+                return false;
+            default:
+                return false;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Evaluate the RPN for many rows at once.
+ *
+ * Gives the same results as calling ParseCmdCodeBulk() for each row, but every token is applied to a block of
+ * s_VectorBlockSize rows in a plain loop over contiguous memory, which the compiler can turn into SIMD instructions.
+ * Each stack entry is a column of the block. Only RPN accepted by IsVectorizable() is supported.
+ *
+ * @param results array of nBulkSize values that receives the results.
+ * @param nBulkSize number of rows, each variable points to an array of this size.
+ */
+void QmuParserBase::ParseCmdCodeVector(qreal *results, int nBulkSize) const
+{
+    const int block = s_VectorBlockSize;
+    m_vVectorStack.resize(m_vRPN.GetMaxStackSize() * block);
+    qreal *Stack = m_vVectorStack.data();
+
+    for (int begin = 0; begin < nBulkSize; begin += block)
+    {
+        const int count = qMin(block, nBulkSize - begin);
+        int sidx(0);
+        for (const SToken *pTok = m_vRPN.GetBase(); pTok->Cmd!=cmEND ; ++pTok)
+        {
+            // Binary operators write to the column below the top of the stack, values push a new column.
+            qreal *x = nullptr;
+            const qreal *y = nullptr;
+            switch (pTok->Cmd)
+            {
+                case cmLE:
+                case cmGE:
+                case cmNEQ:
+                case cmEQ:
+                case cmLT:
+                case cmGT:
+                case cmADD:
+                case cmSUB:
+                case cmMUL:
+                case cmDIV:
+                case cmPOW:
+                case cmLAND:
+                case cmLOR:
+                    --sidx;
+                    x = Stack + sidx*block;
+                    y = x + block;
+                    break;
+                case cmVAL:
+                    ++sidx;
+                    x = Stack + sidx*block;
+                    break;
+                case cmVAR:
+                case cmVARPOW2:
+                case cmVARPOW3:
+                case cmVARPOW4:
+                case cmVARMUL:
+                    ++sidx;
+                    x = Stack + sidx*block;
+                    y = pTok->Val.ptr + begin;
+                    break;
+                default:
+                    x = Stack + sidx*block;
+                    break;
+            }
+
+QT_WARNING_PUSH
+QT_WARNING_DISABLE_GCC("-Wfloat-equal")
+QT_WARNING_DISABLE_CLANG("-Wundefined-reinterpret-cast")
+QT_WARNING_DISABLE_MSVC(4191)
+
+            switch (pTok->Cmd)
+            {
+                // built in binary operators
+                case cmLE:
+                    for (int i = 0; i < count; ++i)
+                    {
+                        x[i] = x[i] <= y[i];
+                    }
+                    continue;
+                case cmGE:
+                    for (int i = 0; i < count; ++i)
+                    {
+                        x[i] = x[i] >= y[i];
+                    }
+                    continue;
+                case cmNEQ:
+                    for (int i = 0; i < count; ++i)
+                    {
+                        x[i] = not QmuFuzzyComparePossibleNulls(x[i], y[i]);
+                    }
+                    continue;
+                case cmEQ:
+                    for (int i = 0; i < count; ++i)
+                    {
+                        x[i] = QmuFuzzyComparePossibleNulls(x[i], y[i]);
+                    }
+                    continue;
+                case cmLT:
+                    for (int i = 0; i < count; ++i)
+                    {
+                        x[i] = x[i] < y[i];
+                    }
+                    continue;
+                case cmGT:
+                    for (int i = 0; i < count; ++i)
+                    {
+                        x[i] = x[i] > y[i];
+                    }
+                    continue;
+                case cmADD:
+                    for (int i = 0; i < count; ++i)
+                    {
+                        x[i] += y[i];
+                    }
+                    continue;
+                case cmSUB:
+                    for (int i = 0; i < count; ++i)
+                    {
+                        x[i] -= y[i];
+                    }
+                    continue;
+                case cmMUL:
+                    for (int i = 0; i < count; ++i)
+                    {
+                        x[i] *= y[i];
+                    }
+                    continue;
+                case cmDIV:
+    #if defined(MUP_MATH_EXCEPTIONS)
+                    for (int i = 0; i < count; ++i)
+                    {
+                        if (y[i]==0)
+                        {
+                            Error(ecDIV_BY_ZERO);
+                        }
+                    }
+    #endif
+                    for (int i = 0; i < count; ++i)
+                    {
+                        x[i] /= y[i];
+                    }
+                    continue;
+                case cmPOW:
+                    for (int i = 0; i < count; ++i)
+                    {
+                        x[i] = qPow(x[i], y[i]);
+                    }
+                    continue;
+                case cmLAND:
+                    for (int i = 0; i < count; ++i)
+                    {
+                        x[i] = static_cast<bool>(x[i]) && static_cast<bool>(y[i]);
+                    }
+                    continue;
+                case cmLOR:
+                    for (int i = 0; i < count; ++i)
+                    {
+                        x[i] = static_cast<bool>(x[i]) || static_cast<bool>(y[i]);
+                    }
+                    continue;
+
+                // value and variable tokens
+                case cmVAR:
+                    for (int i = 0; i < count; ++i)
+                    {
+                        x[i] = y[i];
+                    }
+                    continue;
+                case cmVAL:
+                    for (int i = 0; i < count; ++i)
+                    {
+                        x[i] = pTok->Val.data2;
+                    }
+                    continue;
+                case cmVARPOW2:
+                    for (int i = 0; i < count; ++i)
+                    {
+                        x[i] = y[i]*y[i];
+                    }
+                    continue;
+                case cmVARPOW3:
+                    for (int i = 0; i < count; ++i)
+                    {
+                        x[i] = y[i]*y[i]*y[i];
+                    }
+                    continue;
+                case cmVARPOW4:
+                    for (int i = 0; i < count; ++i)
+                    {
+                        x[i] = y[i]*y[i]*y[i]*y[i];
+                    }
+                    continue;
+                case cmVARMUL:
+                {
+                    const qreal a = pTok->Val.data;
+                    const qreal b = pTok->Val.data2;
+                    for (int i = 0; i < count; ++i)
+                    {
+                        x[i] = y[i] * a + b;
+                    }
+                    continue;
+                }
+
+                // numeric functions with one or two arguments
+                case cmFUNC:
+                    if (pTok->Fun.argc == 1)
+                    {
+                        const fun_type1 fun = reinterpret_cast<fun_type1>(pTok->Fun.ptr);
+                        for (int i = 0; i < count; ++i)
+                        {
+                            x[i] = fun(x[i]);
+                        }
+                    }
+                    else
+                    {
+                        --sidx;
+                        x = Stack + sidx*block;
+                        y = x + block;
+                        const fun_type2 fun = reinterpret_cast<fun_type2>(pTok->Fun.ptr);
+                        for (int i = 0; i < count; ++i)
+                        {
+                            x[i] = fun(x[i], y[i]);
+                        }
+                    }
+                    continue;
+                default:
+                    Error(ecINTERNAL_ERROR, 3);
+                    return;
+            } // switch CmdCode
+
+QT_WARNING_POP
+
+        } // for all bytecode tokens
+
+        const qreal *column = Stack + m_nFinalResultIdx*block;
+        for (int i = 0; i < count; ++i)
+        {
+            results[begin + i] = column[i];
+        }
+    } // for all blocks
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void QmuParserBase::CreateRPN() const
 {
@@ -1625,6 +1913,25 @@ qreal QmuParserBase::ParseString() const
     }
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Install a previously compiled bytecode.
+ *
+ * The parser switches to bytecode evaluation right away, so next call of Eval() doesn't parse the expression string.
+ * Caller is responsible for the bytecode to match the current expression and for its variables to point to valid
+ * memory.
+ *
+ * @param a_ByteCode compiled bytecode, see GetByteCode().
+ * @param a_iFinalResultIdx number of results the bytecode leaves on the stack, see GetNumResults().
+ */
+void QmuParserBase::SetByteCode(const QmuParserByteCode &a_ByteCode, int a_iFinalResultIdx) const
+{
+    m_vRPN = a_ByteCode;
+    m_nFinalResultIdx = a_iFinalResultIdx;
+    m_vStackBuffer.resize(m_vRPN.GetMaxStackSize() * s_MaxNumOpenMPThreads);
+    m_pParseFormula = &QmuParserBase::ParseCmdCode;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
 * @brief Create an error containing the parse error position.
@@ -1907,9 +2214,29 @@ qreal* QmuParserBase::Eval(int &nStackSize) const
 }
 
 //---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Evaluate the expression for nBulkSize rows.
+ *
+ * Every variable must point to an array of nBulkSize values (structure of arrays), row i uses element i of each
+ * array. Simple arithmetic expressions are evaluated column by column, others row by row.
+ *
+ * @param results array that receives nBulkSize results.
+ * @param nBulkSize number of rows.
+ */
 void QmuParserBase::Eval(qreal *results, int nBulkSize) const
 {
-    CreateRPN();
+    // Bytecode left by a previous evaluation or installed with SetByteCode() is still valid
+    if (m_pParseFormula == &QmuParserBase::ParseString)
+    {
+        CreateRPN();
+        m_pParseFormula = &QmuParserBase::ParseCmdCode;
+    }
+
+    if (IsVectorizable())
+    {
+        ParseCmdCodeVector(results, nBulkSize);
+        return;
+    }
 
     int i = 0;
 
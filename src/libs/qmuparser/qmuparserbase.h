@@ -216,6 +216,11 @@ class QMUPARSERSHARED_EXPORT QmuParserBase
      */
     static const int s_MaxNumOpenMPThreads = 4;
 
+    /**
+     * @brief Number of rows evaluated together by the columnar bulk interpreter, see ParseCmdCodeVector().
+     */
+    static const int s_VectorBlockSize = 64;
+
     /**
      * @brief Pointer to the parser function.
      *
@@ -246,6 +251,7 @@ class QMUPARSERSHARED_EXPORT QmuParserBase
 
     // items merely used for caching state information
     mutable valbuf_type m_vStackBuffer; ///< This is merely a buffer used for the stack in the cmd parsing routine
+    mutable valbuf_type m_vVectorStack; ///< Stack of columns for bulk evaluation, see ParseCmdCodeVector()
     mutable int m_nFinalResultIdx;
     mutable QMap<int, QString> m_Tokens;///< Keep all tokens that we can translate
     mutable QMap<int, QString> m_Numbers;///< Keep all numbers what exist in formula
@@ -268,6 +274,10 @@ class QMUPARSERSHARED_EXPORT QmuParserBase
     qreal              ParseString() const;
     qreal              ParseCmdCode() const;
     qreal              ParseCmdCodeBulk(int nOffset, int nThreadID) const;
+    bool               IsVectorizable() const;
+    void               ParseCmdCodeVector(qreal *results, int nBulkSize) const;
+    const QmuParserByteCode& GetByteCode() const;
+    void               SetByteCode(const QmuParserByteCode &a_ByteCode, int a_iFinalResultIdx) const;
     // cppcheck-suppress functionStatic
     void               CheckName(const QString &a_sName, const QString &a_szCharSet) const;
     // cppcheck-suppress functionStatic
@@ -432,6 +442,15 @@ inline int QmuParserBase::GetNumResults() const
     return m_nFinalResultIdx;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Return the bytecode created by the last string parsing.
+ */
+inline const QmuParserByteCode& QmuParserBase::GetByteCode() const
+{
+    return m_vRPN;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
  * @brief Calculate the result.
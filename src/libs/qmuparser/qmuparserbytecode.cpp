@@ -511,6 +511,53 @@ void QmuParserByteCode::Finalize()
     }
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Redirect variable pointers of a compiled bytecode.
+ *
+ * The bytecode was compiled with variables that point into a contiguous buffer starting at a_pBase. Each variable
+ * pointer that points to element i of that buffer is replaced with a_vVars[i]. Pointers outside the buffer are left
+ * untouched. This allows to reuse bytecode for another set of variables without parsing the expression again.
+ *
+ * @param a_pBase Start of the buffer the bytecode was compiled against.
+ * @param a_vVars New variable addresses, one for each element of the buffer.
+ * @throw nothrow
+ */
+void QmuParserByteCode::RebindVariables(const qreal *a_pBase, const QVector<qreal *> &a_vVars)
+{
+    const quintptr base = reinterpret_cast<quintptr>(a_pBase);
+    const quintptr end = base + static_cast<quintptr>(a_vVars.size()) * sizeof(qreal);
+
+    auto Rebind = [base, end, &a_vVars](qreal *&ptr)
+    {
+        const quintptr address = reinterpret_cast<quintptr>(ptr);
+        if (address >= base && address < end)
+        {
+            ptr = a_vVars.at(static_cast<int>((address - base) / sizeof(qreal)));
+        }
+    };
+
+    for (int i=0; i<m_vRPN.size(); ++i)
+    {
+        SToken &tok = m_vRPN[i];
+        switch (tok.Cmd)
+        {
+            case cmVAR:
+            case cmVARPOW2:
+            case cmVARPOW3:
+            case cmVARPOW4:
+            case cmVARMUL:
+                Rebind(tok.Val.ptr);
+                break;
+            case cmASSIGN:
+                Rebind(tok.Oprt.ptr);
+                break;
+            default:
+                break;
+        }
+    }
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 const SToken* QmuParserByteCode::GetBase() const
 {
@@ -83,7 +83,7 @@ QT_WARNING_POP
  *
  * @author (C) 2004-2013 Ingo Berg
  */
-class QmuParserByteCode
+class QMUPARSERSHARED_EXPORT QmuParserByteCode
 {
 public:
     QmuParserByteCode();
@@ -100,6 +100,7 @@ class QmuParserByteCode
     void          AddStrFun(generic_fun_type a_pFun, int a_iArgc, int a_iIdx);
     void          EnableOptimizer(bool bStat);
     void          Finalize();
+    void          RebindVariables(const qreal *a_pBase, const QVector<qreal*> &a_vVars);
     void          clear();
     int           GetMaxStackSize() const;
     int           GetSize() const;
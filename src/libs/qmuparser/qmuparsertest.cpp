@@ -69,6 +69,7 @@ QmuParserTester::QmuParserTester(QObject *parent)
     AddTest ( &QmuParserTester::TestException );
     AddTest ( &QmuParserTester::TestStrArg );
     AddTest ( &QmuParserTester::TestBulkMode );
+    AddTest ( &QmuParserTester::TestBulkVectorized );
 
     QmuParserTester::c_iCount = 0;
 }
@@ -218,6 +219,44 @@ int QmuParserTester::TestBulkMode()
     return iStat;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+int QmuParserTester::TestBulkVectorized()
+{
+    int iStat = 0;
+    qWarning() << "testing vectorized bulkmode...";
+
+    // Arithmetic only, evaluated column by column
+    iStat += EqnTestBulkRows("a");
+    iStat += EqnTestBulkRows("3.5");
+    iStat += EqnTestBulkRows("a+b");
+    iStat += EqnTestBulkRows("c*(a+b)-a/b");
+    iStat += EqnTestBulkRows("a^2+b^3-c^4");
+    iStat += EqnTestBulkRows("2*a+1");
+    iStat += EqnTestBulkRows("a^b/100");
+    iStat += EqnTestBulkRows("(a<b)+(a>=c)*2+(a==b)*4+(a!=c)*8");
+    iStat += EqnTestBulkRows("a<b && b<=c || a>c");
+    iStat += EqnTestBulkRows("sin(a)*cos(b)+sqrt(b)");
+    iStat += EqnTestBulkRows("f1of2(a; b)-f2of2(a; b)");
+    iStat += EqnTestBulkRows("a+b; a*b");
+    iStat += EqnTestBulkRows("-a+const1");
+
+    // Evaluated row by row
+    iStat += EqnTestBulkRows("a<b ? a : b");
+    iStat += EqnTestBulkRows("min(a; b; c)");
+    iStat += EqnTestBulkRows("sum(a; b; c)*2");
+
+    if (iStat == 0)
+    {
+        qWarning() << "passed";
+    }
+    else
+    {
+        qWarning() << "\n  failed with " << iStat << " errors";
+    }
+
+    return iStat;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 int QmuParserTester::TestBinOprt()
 {
@@ -1521,6 +1560,81 @@ int QmuParserTester::EqnTestBulk(const QString &a_str, double a_fRes[4], bool a_
     return iRet;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Test an expression in Bulk Mode against evaluation of each row.
+ *
+ * The bulk size is not a multiple of the block size of the vectorized interpreter, so the last block is partial.
+ */
+int QmuParserTester::EqnTestBulkRows(const QString &a_str)
+{
+    QmuParserTester::c_iCount++;
+    int iRet(0);
+
+    try
+    {
+        const int nBulkSize = 150;
+        QVector<qreal> vVariableA(nBulkSize);
+        QVector<qreal> vVariableB(nBulkSize);
+        QVector<qreal> vVariableC(nBulkSize, 3);
+        QVector<qreal> vResults(nBulkSize);
+        for (int i = 0; i < nBulkSize; ++i)
+        {
+            vVariableA[i] = i * 0.5 - 10;
+            vVariableB[i] = 1 + i % 7;
+        }
+
+        QmuParser p;
+        p.DefineConst("const1", 1);
+        p.DefineFun("f1of2", f1of2);
+        p.DefineFun("f2of2", f2of2);
+        p.DefineVar("a", vVariableA.data());
+        p.DefineVar("b", vVariableB.data());
+        p.DefineVar("c", vVariableC.data());
+        p.SetExpr(a_str);
+        p.Eval(vResults.data(), nBulkSize);
+
+        qreal a = 0;
+        qreal b = 0;
+        qreal c = 0;
+        QmuParser p2;
+        p2.DefineConst("const1", 1);
+        p2.DefineFun("f1of2", f1of2);
+        p2.DefineFun("f2of2", f2of2);
+        p2.DefineVar("a", &a);
+        p2.DefineVar("b", &b);
+        p2.DefineVar("c", &c);
+        p2.SetExpr(a_str);
+
+        for (int i = 0; i < nBulkSize; ++i)
+        {
+            a = vVariableA.at(i);
+            b = vVariableB.at(i);
+            c = vVariableC.at(i);
+            const qreal fRes = p2.Eval();
+            if (fabs(fRes - vResults.at(i)) > fabs(fRes * 0.00001))
+            {
+                qWarning() << "\n  fail: " << a_str << " (incorrect result in row " << i << "; expected: " << fRes
+                           << " ;calculated: " << vResults.at(i) << ")";
+                iRet = 1;
+                break;
+            }
+        }
+    }
+    catch (QmuParserError &e)
+    {
+        qWarning() << "\n  fail: " << e.GetExpr() << " : " << e.GetMsg();
+        iRet = 1;
+    }
+    catch (...)
+    {
+        qWarning() << "\n  fail: " << a_str << " (unexpected exception)";
+        iRet = 1;  // exceptions other than ParserException are not allowed
+    }
+
+    return iRet;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
  * @brief Internal error in test class Test is going to be aborted.
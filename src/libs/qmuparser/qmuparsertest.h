@@ -80,6 +80,7 @@ private slots:
 
     // Test Bulkmode
     static int EqnTestBulk(const QString &a_str, double a_fRes[4], bool a_fPass);
+    static int EqnTestBulkRows(const QString &a_str);
 
     // Multiarg callbacks
     static qreal f1of1 ( qreal v )
@@ -322,6 +323,8 @@ private slots:
     int TestIfThenElse();
     // cppcheck-suppress functionStatic
     int TestBulkMode();
+    // cppcheck-suppress functionStatic
+    int TestBulkVectorized();
 
     static void Abort();
 };
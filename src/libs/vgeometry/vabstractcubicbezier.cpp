@@ -55,11 +55,85 @@
 #include <QMessageLogger>
 #include <QPoint>
 #include <QtDebug>
+#include <QtMath>
+#include <algorithm>
 
 #include "../vmisc/def.h"
+#include "../vmisc/vabstractapplication.h"
 #include "../vmisc/vmath.h"
 #include "../vgeometry/vpointf.h"
 
+namespace
+{
+// Nodes and weights of 8-point Gauss-Legendre quadrature on [-1, 1]. Nodes are symmetric, only positive are stored.
+const int     gaussLegendreHalfOrder = 4;
+const qreal   gaussLegendreNodes[gaussLegendreHalfOrder]   = {0.1834346424956498, 0.5255324099163290,
+                                                              0.7966664774136267, 0.9602898564975363};
+const qreal   gaussLegendreWeights[gaussLegendreHalfOrder] = {0.3626837833783620, 0.3137066458778873,
+                                                              0.2223810344533745, 0.1012285362903763};
+
+const int     lengthInitialSegments = 4;
+const int     lengthMaxDepth = 10;
+const qreal   lengthTolerance = 1e-6; // px
+const int     parmTMaxIterations = 32;
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Speed return length of the curve derivative at parameter t.
+ * @param p four points of the curve.
+ */
+qreal Speed(const QPointF *p, qreal t)
+{
+    const qreal mt = 1 - t;
+    const QPointF d = 3*mt*mt*(p[1] - p[0]) + 6*mt*t*(p[2] - p[1]) + 3*t*t*(p[3] - p[2]);
+    return qSqrt(d.x()*d.x() + d.y()*d.y());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GaussLegendreLength return length of the curve between parameters t0 and t1.
+ * @param p four points of the curve.
+ */
+qreal GaussLegendreLength(const QPointF *p, qreal t0, qreal t1)
+{
+    const qreal half = (t1 - t0) / 2;
+    const qreal middle = (t0 + t1) / 2;
+
+    qreal sum = 0;
+    for (int i = 0; i < gaussLegendreHalfOrder; ++i)
+    {
+        const qreal offset = half * gaussLegendreNodes[i];
+        sum += gaussLegendreWeights[i] * (Speed(p, middle - offset) + Speed(p, middle + offset));
+    }
+    return sum * half;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief AppendLengthSegment split interval [t0, t1] until quadrature of halves agrees with the whole and append
+ * the knots to the cumulative length table.
+ */
+void AppendLengthSegment(const QPointF *p, qreal t0, qreal t1, qreal length, int depth, QVector<qreal> &knots,
+                         QVector<qreal> &lengths)
+{
+    const qreal middle = (t0 + t1) / 2;
+    const qreal left = GaussLegendreLength(p, t0, middle);
+    const qreal right = GaussLegendreLength(p, middle, t1);
+
+    if (depth >= lengthMaxDepth || qAbs(left + right - length) <= lengthTolerance)
+    {
+        knots.append(middle);
+        lengths.append(lengths.last() + left);
+        knots.append(t1);
+        lengths.append(lengths.last() + right);
+        return;
+    }
+
+    AppendLengthSegment(p, t0, middle, left, depth + 1, knots, lengths);
+    AppendLengthSegment(p, middle, t1, right, depth + 1, knots, lengths);
+}
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 VAbstractCubicBezier::VAbstractCubicBezier(const GOType &type, const quint32 &idObject, const Draw &mode)
     : VAbstractBezier(type, idObject, mode)
@@ -88,6 +162,38 @@ VAbstractCubicBezier::~VAbstractCubicBezier()
 {
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GetPoints return list with curve points. Points are calculated once and cached until the curve changes.
+ * @return list of points.
+ */
+QVector<QPointF> VAbstractCubicBezier::GetPoints() const
+{
+    const qreal scale = qApp->GetCurveApproximationScale();
+
+    QVector<QPointF> points;
+    if (not GetCachedPoints(scale, points))
+    {
+        points = GetCubicBezierPoints(static_cast<QPointF>(GetP1()), static_cast<QPointF>(GetP2()),
+                                      static_cast<QPointF>(GetP3()), static_cast<QPointF>(GetP4()), scale);
+        SetCachedPoints(scale, points);
+    }
+    return points;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GetLength return length of curve.
+ * @return length.
+ */
+qreal VAbstractCubicBezier::GetLength() const
+{
+    QVector<qreal> knots;
+    QVector<qreal> lengths;
+    LengthTable(knots, lengths);
+    return lengths.last();
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
  * @brief CutSpline cut spline.
@@ -169,25 +275,56 @@ QString VAbstractCubicBezier::NameForHistory(const QString &toolName) const
 //---------------------------------------------------------------------------------------------------------------------
 qreal VAbstractCubicBezier::GetParmT(qreal length) const
 {
-    if (length < 0)
+    if (length <= 0)
     {
         return 0;
     }
-    else if (length > GetLength())
+
+    QVector<qreal> knots;
+    QVector<qreal> lengths;
+    LengthTable(knots, lengths);
+
+    if (length >= lengths.last())
     {
-        length = GetLength();
+        return 1;
     }
 
-    const qreal eps = 0.001 * length;
-    qreal parT = 0.5;
-    qreal step = parT;
-    qreal splLength = LengthT(parT);
+    const QPointF p[] = {static_cast<QPointF>(GetP1()), static_cast<QPointF>(GetP2()),
+                         static_cast<QPointF>(GetP3()), static_cast<QPointF>(GetP4())};
+
+    // Find segment of the table and refine parameter inside it with Newton method. Bisection is used as a fallback
+    // when Newton step leaves the segment.
+    const int segment = static_cast<int>(std::upper_bound(lengths.cbegin(), lengths.cend(), length)
+                                         - lengths.cbegin()) - 1;
+    qreal low = knots.at(segment);
+    qreal high = knots.at(segment + 1);
+    const qreal segmentLength = lengths.at(segment + 1) - lengths.at(segment);
 
-    while (qAbs(splLength - length) > eps)
+    qreal parT = low + (high - low) * (length - lengths.at(segment)) / segmentLength;
+    for (int i = 0; i < parmTMaxIterations; ++i)
     {
-        step /= 2.0;
-        splLength > length ? parT -= step : parT += step;
-        splLength = LengthT(parT);
+        const qreal error = lengths.at(segment) + GaussLegendreLength(p, knots.at(segment), parT) - length;
+        if (qAbs(error) <= lengthTolerance)
+        {
+            break;
+        }
+
+        if (error > 0)
+        {
+            high = parT;
+        }
+        else
+        {
+            low = parT;
+        }
+
+        const qreal speed = Speed(p, parT);
+        qreal next = speed > 0 ? parT - error / speed : low;
+        if (next <= low || next >= high)
+        {
+            next = (low + high) / 2;
+        }
+        parT = next;
     }
     return parT;
 }
@@ -223,6 +360,9 @@ qreal VAbstractCubicBezier::CalcSqDistance(qreal x1, qreal y1, qreal x2, qreal y
 //---------------------------------------------------------------------------------------------------------------------
 /**
  * @brief PointBezier_r find spline point using four point of spline.
+ *
+ * Adaptive subdivision from Anti-Grain Geometry. Angle and cusp conditions are not used, so a segment is finished
+ * as soon as it is flat enough. Tolerance is calculated once by caller instead of on each level of recursion.
  * @param x1 х coordinate first point.
  * @param y1 у coordinate first point.
  * @param x2 х coordinate first control point.
@@ -232,33 +372,14 @@ qreal VAbstractCubicBezier::CalcSqDistance(qreal x1, qreal y1, qreal x2, qreal y
  * @param x4 х coordinate last point.
  * @param y4 у coordinate last point.
  * @param level level of recursion. In the begin 0.
- * @param px list х coordinat spline points.
- * @param py list у coordinat spline points.
+ * @param toleranceSquare squared distance tolerance.
+ * @param points list of spline points.
  */
 void VAbstractCubicBezier::PointBezier_r(qreal x1, qreal y1, qreal x2, qreal y2, qreal x3, qreal y3, qreal x4, qreal y4,
-                                         qint16 level, QVector<qreal> &px, QVector<qreal> &py)
+                                         qint16 level, qreal toleranceSquare, QVector<QPointF> &points)
 {
-    if (px.size() >= 2)
-    {
-        for (int i=1; i < px.size(); ++i)
-        {
-            if (QPointF(px.at(i-1), py.at(i-1)) == QPointF(px.at(i), py.at(i)))
-            {
-                qDebug("All neighbors points in path must be unique.");
-            }
-        }
-    }
-
-    const double curve_collinearity_epsilon                 = 1e-30;
-    const double curve_angle_tolerance_epsilon              = 0.01;
-    const double m_angle_tolerance = 0.0;
+    const double curve_collinearity_epsilon = 1e-30;
     enum curve_recursion_limit_e { curve_recursion_limit = 32 };
-    const double m_cusp_limit = 0.0;
-    double m_approximation_scale = 1.0;
-    double m_distance_tolerance_square;
-
-    m_distance_tolerance_square = 0.5 / m_approximation_scale;
-    m_distance_tolerance_square *= m_distance_tolerance_square;
 
     if (level > curve_recursion_limit)
     {
@@ -280,7 +401,6 @@ void VAbstractCubicBezier::PointBezier_r(qreal x1, qreal y1, qreal x2, qreal y2,
     const double x1234 = (x123 + x234) / 2;
     const double y1234 = (y123 + y234) / 2;
 
-
     // Try to approximate the full cubic curve by a single straight line
     //------------------
     const double dx = x4-x1;
@@ -305,16 +425,8 @@ void VAbstractCubicBezier::PointBezier_r(qreal x1, qreal y1, qreal x2, qreal y2,
             else
             {
                 k   = 1 / k;
-                {
-                    const double da1 = x2 - x1;
-                    const double da2 = y2 - y1;
-                    d2  = k * (da1*dx + da2*dy);
-                }
-                {
-                    const double da1 = x3 - x1;
-                    const double da2 = y3 - y1;
-                    d3  = k * (da1*dx + da2*dy);
-                }
+                d2  = k * ((x2 - x1)*dx + (y2 - y1)*dy);
+                d3  = k * ((x3 - x1)*dx + (y3 - y1)*dy);
                 if (d2 > 0 && d2 < 1 && d3 > 0 && d3 < 1)
                 {
                     // Simple collinear case, 1---2---3---4
@@ -349,177 +461,59 @@ void VAbstractCubicBezier::PointBezier_r(qreal x1, qreal y1, qreal x2, qreal y2,
             }
             if (d2 > d3)
             {
-                if (d2 < m_distance_tolerance_square)
+                if (d2 < toleranceSquare)
                 {
-                    px.append(x2);
-                    py.append(y2);
+                    points.append(QPointF(x2, y2));
                     return;
                 }
             }
             else
             {
-                if (d3 < m_distance_tolerance_square)
+                if (d3 < toleranceSquare)
                 {
-                    px.append(x3);
-                    py.append(y3);
+                    points.append(QPointF(x3, y3));
                     return;
                 }
             }
             break;
         }
         case 1:
-        {
             // p1,p2,p4 are collinear, p3 is significant
             //----------------------
-            if (d3 * d3 <= m_distance_tolerance_square * (dx*dx + dy*dy))
+            if (d3 * d3 <= toleranceSquare * (dx*dx + dy*dy))
             {
-                if (m_angle_tolerance < curve_angle_tolerance_epsilon)
-                {
-                    px.append(x23);
-                    py.append(y23);
-                    return;
-                }
-
-                // Angle Condition
-                //----------------------
-                double da1 = fabs(atan2(y4 - y3, x4 - x3) - atan2(y3 - y2, x3 - x2));
-                if (da1 >= M_PI)
-                {
-                    da1 = M_2PI - da1;
-                }
-
-                if (da1 < m_angle_tolerance)
-                {
-                    px.append(x2);
-                    py.append(y2);
-
-                    px.append(x3);
-                    py.append(y3);
-                    return;
-                }
-
-                if (m_cusp_limit > 0.0 || m_cusp_limit < 0.0)
-                {
-                    if (da1 > m_cusp_limit)
-                    {
-                        px.append(x3);
-                        py.append(y3);
-                        return;
-                    }
-                }
+                points.append(QPointF(x23, y23));
+                return;
             }
             break;
-        }
         case 2:
-        {
             // p1,p3,p4 are collinear, p2 is significant
             //----------------------
-            if (d2 * d2 <= m_distance_tolerance_square * (dx*dx + dy*dy))
+            if (d2 * d2 <= toleranceSquare * (dx*dx + dy*dy))
             {
-                if (m_angle_tolerance < curve_angle_tolerance_epsilon)
-                {
-                    px.append(x23);
-                    py.append(y23);
-                    return;
-                }
-
-                // Angle Condition
-                //----------------------
-                double da1 = fabs(atan2(y3 - y2, x3 - x2) - atan2(y2 - y1, x2 - x1));
-                if (da1 >= M_PI)
-                {
-                    da1 = M_2PI - da1;
-                }
-
-                if (da1 < m_angle_tolerance)
-                {
-                    px.append(x2);
-                    py.append(y2);
-
-                    px.append(x3);
-                    py.append(y3);
-                    return;
-                }
-
-                if (m_cusp_limit > 0.0 || m_cusp_limit < 0.0)
-                {
-                    if (da1 > m_cusp_limit)
-                    {
-                        px.append(x2);
-                        py.append(y2);
-                        return;
-                    }
-                }
+                points.append(QPointF(x23, y23));
+                return;
             }
             break;
-        }
         case 3:
-        {
             // Regular case
             //-----------------
-            if ((d2 + d3)*(d2 + d3) <= m_distance_tolerance_square * (dx*dx + dy*dy))
+            if ((d2 + d3)*(d2 + d3) <= toleranceSquare * (dx*dx + dy*dy))
             {
-                // If the curvature doesn't exceed the distance_tolerance value
-                // we tend to finish subdivisions.
-                //----------------------
-                if (m_angle_tolerance < curve_angle_tolerance_epsilon)
-                {
-                    px.append(x23);
-                    py.append(y23);
-                    return;
-                }
-
-                // Angle & Cusp Condition
-                //----------------------
-                const double k   = atan2(y3 - y2, x3 - x2);
-                double da1 = fabs(k - atan2(y2 - y1, x2 - x1));
-                double da2 = fabs(atan2(y4 - y3, x4 - x3) - k);
-                if (da1 >= M_PI)
-                {
-                    da1 = M_2PI - da1;
-                }
-                if (da2 >= M_PI)
-                {
-                    da2 = M_2PI - da2;
-                }
-
-                if (da1 + da2 < m_angle_tolerance)
-                {
-                    // Finally we can stop the recursion
-                    //----------------------
-
-                    px.append(x23);
-                    py.append(y23);
-                    return;
-                }
-
-                if (m_cusp_limit > 0.0 || m_cusp_limit < 0.0)
-                {
-                    if (da1 > m_cusp_limit)
-                    {
-                        px.append(x2);
-                        py.append(y2);
-                        return;
-                    }
-
-                    if (da2 > m_cusp_limit)
-                    {
-                        px.append(x3);
-                        py.append(y3);
-                        return;
-                    }
-                }
+                // The curvature doesn't exceed the distance tolerance value, finish subdivisions.
+                points.append(QPointF(x23, y23));
+                return;
             }
             break;
-        }
         default:
             break;
     }
 
     // Continue subdivision
     //----------------------
-    PointBezier_r(x1, y1, x12, y12, x123, y123, x1234, y1234, static_cast<qint16>(level + 1), px, py);
-    PointBezier_r(x1234, y1234, x234, y234, x34, y34, x4, y4, static_cast<qint16>(level + 1), px, py);
+    const qint16 nextLevel = static_cast<qint16>(level + 1);
+    PointBezier_r(x1, y1, x12, y12, x123, y123, x1234, y1234, nextLevel, toleranceSquare, points);
+    PointBezier_r(x1234, y1234, x234, y234, x34, y34, x4, y4, nextLevel, toleranceSquare, points);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -529,74 +523,66 @@ void VAbstractCubicBezier::PointBezier_r(qreal x1, qreal y1, qreal x2, qreal y2,
  * @param p2 first control point.
  * @param p3 second control point.
  * @param p4 last spline point.
+ * @param approximationScale higher value gives more precise approximation. Distance tolerance is 0.5 px / scale.
  * @return list of points.
  */
 QVector<QPointF> VAbstractCubicBezier::GetCubicBezierPoints(const QPointF &p1, const QPointF &p2, const QPointF &p3,
-                                                            const QPointF &p4)
+                                                            const QPointF &p4, qreal approximationScale)
 {
+    const qreal tolerance = 0.5 / qBound(minCurveApproximationScale, approximationScale, maxCurveApproximationScale);
+
     QVector<QPointF> pvector;
-    QVector<qreal> x;
-    QVector<qreal> y;
-    QVector<qreal>& wx = x;
-    QVector<qreal>& wy = y;
-    x.append ( p1.x () );
-    y.append ( p1.y () );
-    PointBezier_r ( p1.x (), p1.y (), p2.x (), p2.y (),
-                    p3.x (), p3.y (), p4.x (), p4.y (), 0, wx, wy );
-    x.append ( p4.x () );
-    y.append ( p4.y () );
-    for ( qint32 i = 0; i < x.count(); ++i )
-    {
-        pvector.append( QPointF ( x.at(i), y.at(i)) );
-    }
+    pvector.append(p1);
+    PointBezier_r(p1.x(), p1.y(), p2.x(), p2.y(), p3.x(), p3.y(), p4.x(), p4.y(), 0, tolerance * tolerance, pvector);
+    pvector.append(p4);
     return pvector;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 /**
- * @brief LengthBezier return spline length using 4 spline point.
- * @param p1 first spline point
- * @param p2 first control point.
- * @param p3 second control point.
- * @param p4 last spline point.
- * @return length.
+ * @brief LengthT return length of the curve from the beginning to parameter t. Parameter is clamped to [0; 1].
  */
-qreal VAbstractCubicBezier::LengthBezier(const QPointF &p1, const QPointF &p2, const QPointF &p3, const QPointF &p4)
+qreal VAbstractCubicBezier::LengthT(qreal t) const
 {
-    return PathLength(GetCubicBezierPoints(p1, p2, p3, p4));
+    t = qBound(0.0, t, 1.0);
+
+    QVector<qreal> knots;
+    QVector<qreal> lengths;
+    LengthTable(knots, lengths);
+
+    const int upper = static_cast<int>(std::upper_bound(knots.cbegin(), knots.cend(), t) - knots.cbegin());
+    const int segment = qBound(0, upper - 1, knots.size() - 2);
+
+    const QPointF p[] = {static_cast<QPointF>(GetP1()), static_cast<QPointF>(GetP2()),
+                         static_cast<QPointF>(GetP3()), static_cast<QPointF>(GetP4())};
+    return lengths.at(segment) + GaussLegendreLength(p, knots.at(segment), t);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-qreal VAbstractCubicBezier::LengthT(qreal t) const
+/**
+ * @brief LengthTable return cumulative length table of the curve. Length is integrated numerically by Gauss-Legendre
+ * quadrature. The table is calculated once and cached until the curve changes.
+ * @param knots curve parameters from 0 to 1.
+ * @param lengths length of the curve from the beginning to each knot.
+ */
+void VAbstractCubicBezier::LengthTable(QVector<qreal> &knots, QVector<qreal> &lengths) const
 {
-    if (t < 0 || t > 1)
+    if (GetCachedLengthTable(knots, lengths))
     {
-        qDebug()<<"Wrong value t.";
-        return 0;
+        return;
     }
-    QLineF seg1_2 ( static_cast<QPointF>(GetP1 ()), GetControlPoint1 () );
-    seg1_2.setLength(seg1_2.length () * t);
-    const QPointF p12 = seg1_2.p2();
 
-    QLineF seg2_3 ( GetControlPoint1 (), GetControlPoint2 () );
-    seg2_3.setLength(seg2_3.length () * t);
-    const QPointF p23 = seg2_3.p2();
+    const QPointF p[] = {static_cast<QPointF>(GetP1()), static_cast<QPointF>(GetP2()),
+                         static_cast<QPointF>(GetP3()), static_cast<QPointF>(GetP4())};
 
-    QLineF seg12_23 ( p12, p23 );
-    seg12_23.setLength(seg12_23.length () * t);
-    const QPointF p123 = seg12_23.p2();
-
-    QLineF seg3_4 ( GetControlPoint2 (), static_cast<QPointF>(GetP4 ()) );
-    seg3_4.setLength(seg3_4.length () * t);
-    const QPointF p34 = seg3_4.p2();
-
-    QLineF seg23_34 ( p23, p34 );
-    seg23_34.setLength(seg23_34.length () * t);
-    const QPointF p234 = seg23_34.p2();
-
-    QLineF seg123_234 ( p123, p234 );
-    seg123_234.setLength(seg123_234.length () * t);
-    const QPointF p1234 = seg123_234.p2();
+    knots = QVector<qreal>(1, 0);
+    lengths = QVector<qreal>(1, 0);
+    for (int i = 0; i < lengthInitialSegments; ++i)
+    {
+        const qreal t0 = static_cast<qreal>(i) / lengthInitialSegments;
+        const qreal t1 = static_cast<qreal>(i + 1) / lengthInitialSegments;
+        AppendLengthSegment(p, t0, t1, GaussLegendreLength(p, t0, t1), 0, knots, lengths);
+    }
 
-    return LengthBezier ( static_cast<QPointF>(GetP1()), p12, p123, p1234);
+    SetCachedLengthTable(knots, lengths);
 }
@@ -77,6 +77,9 @@ class VAbstractCubicBezier : public VAbstractBezier
     virtual VPointF GetP3 () const =0;
     virtual VPointF GetP4 () const =0;
 
+    virtual QVector<QPointF> GetPoints() const Q_DECL_OVERRIDE;
+    virtual qreal            GetLength() const Q_DECL_OVERRIDE;
+
     QPointF CutSpline ( qreal length, QPointF &spl1p2, QPointF &spl1p3, QPointF &spl2p2, QPointF &spl2p3) const;
 
     virtual QString NameForHistory(const QString &toolName) const Q_DECL_OVERRIDE;
@@ -89,13 +92,15 @@ class VAbstractCubicBezier : public VAbstractBezier
 
     static qreal            CalcSqDistance(qreal x1, qreal y1, qreal x2, qreal y2);
     static void             PointBezier_r(qreal x1, qreal y1, qreal x2, qreal y2, qreal x3, qreal y3, qreal x4,
-                                          qreal y4, qint16 level, QVector<qreal> &px, QVector<qreal> &py);
+                                          qreal y4, qint16 level, qreal toleranceSquare, QVector<QPointF> &points);
     static QVector<QPointF> GetCubicBezierPoints(const QPointF &p1, const QPointF &p2, const QPointF &p3,
-                                                 const QPointF &p4);
-    static qreal            LengthBezier(const QPointF &p1, const QPointF &p2, const QPointF &p3, const QPointF &p4);
+                                                 const QPointF &p4, qreal approximationScale);
 
     virtual QPointF GetControlPoint1() const =0;
     virtual QPointF GetControlPoint2() const =0;
+
+private:
+    void LengthTable(QVector<qreal> &knots, QVector<qreal> &lengths) const;
 };
 
 #endif // VABSTRACTCUBICBEZIER_H
@@ -56,6 +56,7 @@
 #include "../vmisc/def.h"
 #include "../ifc/ifcdef.h"
 #include "../ifc/exception/vexception.h"
+#include "../vmisc/vabstractapplication.h"
 #include "vpointf.h"
 #include "vspline.h"
 
@@ -109,7 +110,14 @@ QPainterPath VAbstractCubicBezierPath::GetPath() const
  */
 QVector<QPointF> VAbstractCubicBezierPath::GetPoints() const
 {
+    const qreal scale = qApp->GetCurveApproximationScale();
+
     QVector<QPointF> pathPoints;
+    if (GetCachedPoints(scale, pathPoints))
+    {
+        return pathPoints;
+    }
+
     for (qint32 i = 1; i <= CountSubSpl(); ++i)
     {
         if (not pathPoints.isEmpty())
@@ -119,6 +127,7 @@ QVector<QPointF> VAbstractCubicBezierPath::GetPoints() const
 
         pathPoints += GetSpline(i).GetPoints();
     }
+    SetCachedPoints(scale, pathPoints);
     return pathPoints;
 }
 
@@ -435,3 +435,68 @@ qreal VAbstractCurve::PathLength(const QVector<QPointF> &path)
     }
     return splinePath.length();
 }
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GetCachedPoints return cached approximation of the curve.
+ * @param scale approximation scale the points are requested for.
+ * @param points cached points.
+ * @return false if cache is empty or was calculated with different scale.
+ */
+bool VAbstractCurve::GetCachedPoints(qreal scale, QVector<QPointF> &points) const
+{
+    QMutexLocker locker(&d->cacheMutex);
+    if (d->points.isEmpty() || not qFuzzyCompare(d->pointsScale, scale))
+    {
+        return false;
+    }
+    points = d->points;
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VAbstractCurve::SetCachedPoints(qreal scale, const QVector<QPointF> &points) const
+{
+    QMutexLocker locker(&d->cacheMutex);
+    d->points = points;
+    d->pointsScale = scale;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GetCachedLengthTable return cached cumulative length table of the curve.
+ * @param knots curve parameters.
+ * @param lengths length of the curve from the beginning to each knot.
+ * @return false if the table wasn't calculated yet.
+ */
+bool VAbstractCurve::GetCachedLengthTable(QVector<qreal> &knots, QVector<qreal> &lengths) const
+{
+    QMutexLocker locker(&d->cacheMutex);
+    if (d->lengthKnots.isEmpty())
+    {
+        return false;
+    }
+    knots = d->lengthKnots;
+    lengths = d->lengthTable;
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VAbstractCurve::SetCachedLengthTable(const QVector<qreal> &knots, const QVector<qreal> &lengths) const
+{
+    QMutexLocker locker(&d->cacheMutex);
+    d->lengthKnots = knots;
+    d->lengthTable = lengths;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ResetCache must be called each time geometry of the curve changes.
+ */
+void VAbstractCurve::ResetCache()
+{
+    d->points.clear();
+    d->pointsScale = 0;
+    d->lengthKnots.clear();
+    d->lengthTable.clear();
+}
@@ -122,6 +122,12 @@ class VAbstractCurve :public VGObject
     static const qreal lengthCurveDirectionArrow;
 protected:
     virtual void             CreateName() =0;
+
+    bool                     GetCachedPoints(qreal scale, QVector<QPointF> &points) const;
+    void                     SetCachedPoints(qreal scale, const QVector<QPointF> &points) const;
+    bool                     GetCachedLengthTable(QVector<qreal> &knots, QVector<qreal> &lengths) const;
+    void                     SetCachedLengthTable(const QVector<qreal> &knots, const QVector<qreal> &lengths) const;
+    void                     ResetCache();
 private:
     QSharedDataPointer<VAbstractCurveData> d;
 
@@ -52,7 +52,11 @@
 #ifndef VABSTRACTCURVE_P_H
 #define VABSTRACTCURVE_P_H
 
+#include <QMutex>
+#include <QMutexLocker>
+#include <QPointF>
 #include <QSharedData>
+#include <QVector>
 
 #include "../ifc/ifcdef.h"
 #include "../vmisc/diagnostic.h"
@@ -68,15 +72,31 @@ class VAbstractCurveData : public QSharedData
     VAbstractCurveData ()
         : duplicate(0),
           color(ColorBlack),
-          penStyle(LineTypeSolidLine)
+          penStyle(LineTypeSolidLine),
+          points(),
+          pointsScale(0),
+          lengthKnots(),
+          lengthTable(),
+          cacheMutex()
     {}
 
     VAbstractCurveData(const VAbstractCurveData &curve)
         : QSharedData(curve),
           duplicate(curve.duplicate),
           color(curve.color),
-          penStyle(curve.penStyle)
-    {}
+          penStyle(curve.penStyle),
+          points(),
+          pointsScale(0),
+          lengthKnots(),
+          lengthTable(),
+          cacheMutex()
+    {
+        QMutexLocker locker(&curve.cacheMutex);
+        points = curve.points;
+        pointsScale = curve.pointsScale;
+        lengthKnots = curve.lengthKnots;
+        lengthTable = curve.lengthTable;
+    }
 
     virtual ~VAbstractCurveData();
 
@@ -86,6 +106,21 @@ class VAbstractCurveData : public QSharedData
     QString color;
     QString penStyle;
 
+    /** @brief points cached approximation of the curve. Empty if the curve wasn't approximated yet. */
+    mutable QVector<QPointF> points;
+
+    /** @brief pointsScale approximation scale used for calculating the cached points. */
+    mutable qreal pointsScale;
+
+    /** @brief lengthKnots curve parameters that split the curve for numeric length integration. */
+    mutable QVector<qreal> lengthKnots;
+
+    /** @brief lengthTable length of the curve from the beginning to each knot. */
+    mutable QVector<qreal> lengthTable;
+
+    /** @brief cacheMutex guards the cache, because copies of a curve share data and can be used from threads. */
+    mutable QMutex cacheMutex;
+
 private:
     VAbstractCurveData &operator=(const VAbstractCurveData &) Q_DECL_EQ_DELETE;
 };
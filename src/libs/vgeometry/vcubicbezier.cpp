@@ -152,6 +152,7 @@ VPointF VCubicBezier::GetP1() const
 void VCubicBezier::SetP1(const VPointF &p)
 {
     d->p1 = p;
+    ResetCache();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -164,6 +165,7 @@ VPointF VCubicBezier::GetP2() const
 void VCubicBezier::SetP2(const VPointF &p)
 {
     d->p2 = p;
+    ResetCache();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -176,6 +178,7 @@ VPointF VCubicBezier::GetP3() const
 void VCubicBezier::SetP3(const VPointF &p)
 {
     d->p3 = p;
+    ResetCache();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -188,6 +191,7 @@ VPointF VCubicBezier::GetP4() const
 void VCubicBezier::SetP4(const VPointF &p)
 {
     d->p4 = p;
+    ResetCache();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -202,28 +206,6 @@ qreal VCubicBezier::GetEndAngle() const
     return QLineF(static_cast<QPointF>(GetP4()), static_cast<QPointF>(GetP3())).angle();
 }
 
-//---------------------------------------------------------------------------------------------------------------------
-/**
- * @brief GetLength return length of cubic bezier curve.
- * @return length.
- */
-qreal VCubicBezier::GetLength() const
-{
-    return LengthBezier (static_cast<QPointF>(GetP1()), static_cast<QPointF>(GetP2()),
-                         static_cast<QPointF>(GetP3()), static_cast<QPointF>(GetP4()));
-}
-
-//---------------------------------------------------------------------------------------------------------------------
-/**
- * @brief GetPoints return list with cubic bezier curve points.
- * @return list of points.
- */
-QVector<QPointF> VCubicBezier::GetPoints() const
-{
-    return GetCubicBezierPoints(static_cast<QPointF>(GetP1()), static_cast<QPointF>(GetP2()),
-                                static_cast<QPointF>(GetP3()), static_cast<QPointF>(GetP4()));
-}
-
 //---------------------------------------------------------------------------------------------------------------------
 qreal VCubicBezier::GetC1Length() const
 {
@@ -99,8 +99,6 @@ class VCubicBezier : public VAbstractCubicBezier
 
     virtual qreal            GetStartAngle() const Q_DECL_OVERRIDE;
     virtual qreal            GetEndAngle() const Q_DECL_OVERRIDE;
-    virtual qreal            GetLength() const Q_DECL_OVERRIDE;
-    virtual QVector<QPointF> GetPoints() const Q_DECL_OVERRIDE;
 
     virtual qreal GetC1Length() const Q_DECL_OVERRIDE;
     virtual qreal GetC2Length() const Q_DECL_OVERRIDE;
@@ -162,6 +162,8 @@ VCubicBezierPath::~VCubicBezierPath()
 //---------------------------------------------------------------------------------------------------------------------
 VPointF &VCubicBezierPath::operator[](int indx)
 {
+    // Caller can change the point through the reference
+    ResetCache();
     return d->path[indx];
 }
 
@@ -175,6 +177,7 @@ const VPointF &VCubicBezierPath::at(int indx) const
 void VCubicBezierPath::append(const VPointF &point)
 {
     d->path.append(point);
+    ResetCache();
     CreateName();
 }
 
@@ -194,6 +197,7 @@ qint32 VCubicBezierPath::CountPoints() const
 void VCubicBezierPath::Clear()
 {
     d->path.clear();
+    ResetCache();
     SetDuplicate(0);
 }
 
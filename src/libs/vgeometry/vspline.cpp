@@ -192,17 +192,6 @@ VSpline VSpline::Move(qreal length, qreal angle, const QString &prefix) const
 VSpline::~VSpline()
 {}
 
-//---------------------------------------------------------------------------------------------------------------------
-/**
- * @brief GetLength return length of spline.
- * @return length.
- */
-qreal VSpline::GetLength () const
-{
-    return LengthBezier ( static_cast<QPointF>(GetP1()), static_cast<QPointF>(GetP2()), static_cast<QPointF>(GetP3()),
-                          static_cast<QPointF>(GetP4()));
-}
-
 //---------------------------------------------------------------------------------------------------------------------
 QPointF VSpline::CutSpline(qreal length, VSpline &spl1, VSpline &spl2) const
 {
@@ -217,17 +206,6 @@ QPointF VSpline::CutSpline(qreal length, VSpline &spl1, VSpline &spl2) const
     return cutPoint;
 }
 
-//---------------------------------------------------------------------------------------------------------------------
-/**
- * @brief GetPoints return list with spline points.
- * @return list of points.
- */
-QVector<QPointF> VSpline::GetPoints () const
-{
-    return GetCubicBezierPoints(static_cast<QPointF>(GetP1()), static_cast<QPointF>(GetP2()),
-                                static_cast<QPointF>(GetP3()), static_cast<QPointF>(GetP4()));
-}
-
 //---------------------------------------------------------------------------------------------------------------------
 /**
  * @brief SplinePoints return list with spline points.
@@ -255,7 +233,7 @@ QVector<QPointF> VSpline::SplinePoints(const QPointF &p1, const QPointF &p4, qre
     p4p3.setAngle(angle2);
     QPointF p2 = p1p2.p2();
     QPointF p3 = p4p3.p2();
-    return GetCubicBezierPoints(p1, p2, p3, p4);
+    return GetCubicBezierPoints(p1, p2, p3, p4, qApp->GetCurveApproximationScale());
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -284,6 +262,7 @@ VPointF VSpline::GetP1() const
 void VSpline::SetP1(const VPointF &p)
 {
     d->p1 = p;
+    ResetCache();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -324,6 +303,7 @@ VPointF VSpline::GetP4() const
 void VSpline::SetP4(const VPointF &p)
 {
     d->p4 = p;
+    ResetCache();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -362,6 +342,7 @@ QString VSpline::GetEndAngleFormula() const
 void VSpline::SetStartAngle(qreal angle, const QString &formula)
 {
     d->angle1 = angle;
+    ResetCache();
     d->angle1F = formula;
 }
 
@@ -369,6 +350,7 @@ void VSpline::SetStartAngle(qreal angle, const QString &formula)
 void VSpline::SetEndAngle(qreal angle, const QString &formula)
 {
     d->angle2 = angle;
+    ResetCache();
     d->angle2F = formula;
 }
 
@@ -400,6 +382,7 @@ QString VSpline::GetC2LengthFormula() const
 void VSpline::SetC1Length(qreal length, const QString &formula)
 {
     d->c1Length = length;
+    ResetCache();
     d->c1LengthF = formula;
 }
 
@@ -407,6 +390,7 @@ void VSpline::SetC1Length(qreal length, const QString &formula)
 void VSpline::SetC2Length(qreal length, const QString &formula)
 {
     d->c2Length = length;
+    ResetCache();
     d->c2LengthF = formula;
 }
 
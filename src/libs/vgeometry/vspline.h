@@ -122,7 +122,6 @@ class VSpline :public VAbstractCubicBezier
     void    SetC1Length(qreal length, const QString &formula);
     void    SetC2Length(qreal length, const QString &formula);
 
-    virtual qreal   GetLength () const Q_DECL_OVERRIDE;
     qreal   GetKasm1() const;
     qreal   GetKasm2() const;
     qreal   GetKcurve() const;
@@ -130,7 +129,6 @@ class VSpline :public VAbstractCubicBezier
     using VAbstractCubicBezier::CutSpline;
     QPointF CutSpline ( qreal length, VSpline &spl1, VSpline &spl2) const;
 
-    virtual QVector<QPointF> GetPoints () const Q_DECL_OVERRIDE;
     // cppcheck-suppress unusedFunction
     static QVector<QPointF> SplinePoints(const QPointF &p1, const QPointF &p4, qreal angle1, qreal angle2, qreal kAsm1,
                                          qreal kAsm2, qreal kCurve);
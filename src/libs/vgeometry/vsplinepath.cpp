@@ -219,6 +219,7 @@ void VSplinePath::append(const VSplinePoint &point)
     }
 
     d->path.append(point);
+    ResetCache();
     CreateName();
 }
 
@@ -285,6 +286,7 @@ void VSplinePath::UpdatePoint(qint32 indexSpline, const SplinePointPosition &pos
     {
         d->path[indexSpline] = point;
     }
+    ResetCache();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -335,6 +337,8 @@ VSplinePath &VSplinePath::operator =(const VSplinePath &path)
  */
 VSplinePoint & VSplinePath::operator[](int indx)
 {
+    // Caller can change the point through the reference
+    ResetCache();
     return d->path[indx];
 }
 
@@ -480,5 +484,6 @@ QVector<VFSplinePoint> VSplinePath::GetFSplinePath() const
 void VSplinePath::Clear()
 {
     d->path.clear();
+    ResetCache();
     SetDuplicate(0);
 }
@@ -55,12 +55,157 @@
 #include "../vgeometry/vpointf.h"
 
 #include <QLineF>
+#include <QPolygonF>
 #include <QSet>
 #include <QVector>
 #include <QPainterPath>
+#include <QtMath>
+#include <algorithm>
+#include <functional>
 
 const qreal maxL = 2.4;
 
+namespace
+{
+/**
+ * @brief The SegmentGrid class puts segments of a path in a uniform grid to find segments that may intersect a
+ * line without checking all of them. Segment i goes from point i to point i+1, the last one closes the path.
+ */
+class SegmentGrid
+{
+public:
+    explicit SegmentGrid(const QVector<QPointF> &points);
+
+    QVector<qint32> Candidates(const QLineF &line, qint32 from, qint32 to) const;
+
+private:
+    Q_DISABLE_COPY(SegmentGrid)
+
+    QRectF                   rect;
+    int                      columns;
+    int                      rows;
+    qreal                    cellWidth;
+    qreal                    cellHeight;
+    QVector<QVector<qint32>> cells;
+    mutable QVector<int>     stamps;
+    mutable int              query;
+
+    int Column(qreal x) const;
+    int Row(qreal y) const;
+};
+
+// Small paths are faster to check directly
+const int gridMinPoints = 32;
+
+//---------------------------------------------------------------------------------------------------------------------
+SegmentGrid::SegmentGrid(const QVector<QPointF> &points)
+    : rect(QPolygonF(points).boundingRect()),
+      columns(1),
+      rows(1),
+      cellWidth(1),
+      cellHeight(1),
+      cells(),
+      stamps(points.size(), 0),
+      query(0)
+{
+    if (points.size() >= gridMinPoints)
+    {
+        const int side = qMax(1, qCeil(qSqrt(points.size())));
+        columns = side;
+        rows = side;
+    }
+
+    cellWidth = rect.width() > 0 ? rect.width()/columns : 1;
+    cellHeight = rect.height() > 0 ? rect.height()/rows : 1;
+    cells.resize(columns*rows);
+
+    for (qint32 i = 0; i < points.size(); ++i)
+    {
+        const QPointF &p1 = points.at(i);
+        const QPointF &p2 = points.at(i == points.size()-1 ? 0 : i+1);
+
+        const int c1 = Column(qMin(p1.x(), p2.x()));
+        const int c2 = Column(qMax(p1.x(), p2.x()));
+        const int r1 = Row(qMin(p1.y(), p2.y()));
+        const int r2 = Row(qMax(p1.y(), p2.y()));
+
+        for (int r = r1; r <= r2; ++r)
+        {
+            for (int c = c1; c <= c2; ++c)
+            {
+                cells[r*columns + c].append(i);
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Candidates segments in range [from; to] that lie near the line, from the last one to the first one.
+ *
+ * Bounding rect of the line is enlarged by accuracy of VGObject::IsPointOnLineviaPDP(), so segments that lie on the
+ * same line and touch the line are found too.
+ */
+QVector<qint32> SegmentGrid::Candidates(const QLineF &line, qint32 from, qint32 to) const
+{
+    QVector<qint32> candidates;
+    if (from > to)
+    {
+        return candidates;
+    }
+
+    ++query;
+
+    const qreal margin = VGObject::accuracyPointOnLine;
+    const int c1 = Column(qMin(line.x1(), line.x2()) - margin);
+    const int c2 = Column(qMax(line.x1(), line.x2()) + margin);
+    const int r1 = Row(qMin(line.y1(), line.y2()) - margin);
+    const int r2 = Row(qMax(line.y1(), line.y2()) + margin);
+
+    for (int r = r1; r <= r2; ++r)
+    {
+        for (int c = c1; c <= c2; ++c)
+        {
+            const QVector<qint32> &cell = cells.at(r*columns + c);
+            for (int k = 0; k < cell.size(); ++k)
+            {
+                const qint32 index = cell.at(k);
+                if (index >= from && index <= to && stamps.at(index) != query)
+                {
+                    stamps[index] = query;
+                    candidates.append(index);
+                }
+            }
+        }
+    }
+
+    std::sort(candidates.begin(), candidates.end(), std::greater<qint32>());
+    return candidates;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int SegmentGrid::Column(qreal x) const
+{
+    return qBound(0, static_cast<int>((x - rect.left())/cellWidth), columns-1);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int SegmentGrid::Row(qreal y) const
+{
+    return qBound(0, static_cast<int>((y - rect.top())/cellHeight), rows-1);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int UniqueCount(qint32 a, qint32 b, qint32 c, qint32 d)
+{
+    int count = 1;
+    count += b != a ? 1 : 0;
+    count += c != a && c != b ? 1 : 0;
+    count += d != a && d != b && d != c ? 1 : 0;
+    return count;
+}
+}
+
 #ifdef Q_COMPILER_RVALUE_REFS
 VAbstractPiece &VAbstractPiece::operator=(VAbstractPiece &&piece) Q_DECL_NOTHROW
 { Swap(piece); return *this; }
@@ -269,6 +414,7 @@ QVector<QPointF> VAbstractPiece::CheckLoops(const QVector<QPointF> &points)
     const bool pathClosed = (points.first() == points.last());
 
     QVector<QPointF> ekvPoints;
+    const SegmentGrid grid(points);
 
     qint32 i, j, jNext = 0;
     for (i = 0; i < count; ++i)
@@ -287,9 +433,11 @@ QVector<QPointF> VAbstractPiece::CheckLoops(const QVector<QPointF> &points)
         LoopIntersectType status = NoIntersection;
         const QLineF line1(points.at(i), points.at(i+1));
         // Because a path can contains several loops we will seek the last and only then remove the loop(s)
-        // That's why we parse from the end
-        for (j = count-1; j >= i+2; --j)
+        // That's why we parse from the end. Segments far from line1 can't intersect it and are skipped.
+        const QVector<qint32> candidates = grid.Candidates(line1, i+2, count-1);
+        for (int c = 0; c < candidates.size(); ++c)
         {
+            j = candidates.at(c);
             j == count-1 ? jNext = 0 : jNext = j+1;
             QLineF line2(points.at(j), points.at(jNext));
 
@@ -298,22 +446,8 @@ QVector<QPointF> VAbstractPiece::CheckLoops(const QVector<QPointF> &points)
                 continue;
             }
 
-            QVector<qint32> uniqueVertices;
-
-            auto AddUniqueIndex = [&uniqueVertices](qint32 i)
-            {
-                if (not uniqueVertices.contains(i))
-                {
-                    uniqueVertices.append(i);
-                }
-            };
-
-            AddUniqueIndex(i);
-            AddUniqueIndex(i+1);
-            AddUniqueIndex(j);
-
             // For closed path last point is equal to first. Using index of the first.
-            pathClosed && jNext == count-1 ? AddUniqueIndex(0) : AddUniqueIndex(jNext);
+            const int uniqueVertices = UniqueCount(i, i+1, j, pathClosed && jNext == count-1 ? 0 : jNext);
 
             const QLineF::IntersectType intersect = line1.intersect(line2, &crosPoint);
             if (intersect == QLineF::NoIntersection)
@@ -322,7 +456,7 @@ QVector<QPointF> VAbstractPiece::CheckLoops(const QVector<QPointF> &points)
               // Method IsPointOnLineviaPDP will check it.
                 if (VGObject::IsPointOnLineviaPDP(points.at(j), points.at(i), points.at(i+1))
                     // Lines are not neighbors
-                    && uniqueVertices.size() == 4)
+                    && uniqueVertices == 4)
                 {
                     // Left to catch case where segments are on the same line, but do not have real intersections.
                     QLineF tmpLine1 = line1;
@@ -352,7 +486,7 @@ QVector<QPointF> VAbstractPiece::CheckLoops(const QVector<QPointF> &points)
             }
             else if (intersect == QLineF::BoundedIntersection)
             {
-                if (uniqueVertices.size() == 4)
+                if (uniqueVertices == 4)
                 { // Break, but not if lines are neighbors
                     if ((line1.p1() != crosPoint
                         && line1.p2() != crosPoint
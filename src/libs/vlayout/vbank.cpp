@@ -52,6 +52,7 @@
 #include "vbank.h"
 
 #include <climits>
+#include <random>
 
 #include "../vmisc/diagnostic.h"
 #include "../vmisc/logging.h"
@@ -77,7 +78,7 @@ QT_WARNING_POP
 VBank::VBank()
     :details(QVector<VLayoutPiece>()), unsorted(QHash<int, qint64>()), big(QHash<int, qint64>()),
       middle(QHash<int, qint64>()), small(QHash<int, qint64>()), layoutWidth(0), caseType(Cases::CaseDesc),
-      prepare(false), diagonal(0)
+      prepare(false), diagonal(0), seed(0)
 {}
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -93,6 +94,12 @@ void VBank::SetLayoutWidth(const qreal &value)
     Reset();
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+QVector<VLayoutPiece> VBank::GetDetails() const
+{
+    return details;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void VBank::SetDetails(const QVector<VLayoutPiece> &details)
 {
@@ -208,6 +215,9 @@ bool VBank::Prepare()
         return prepare;
     }
 
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<qreal> jitter(0.8, 1.2);
+
     diagonal = 0;
     for (int i=0; i < details.size(); ++i)
     {
@@ -220,13 +230,18 @@ bool VBank::Prepare()
             diagonal = d;
         }
 
-        const qint64 square = details.at(i).Square();
+        qint64 square = details.at(i).Square();
         if (square <= 0)
         {
             qCDebug(lBank, "Preparing data for layout error: Detail squere <= 0");
             prepare = false;
             return prepare;
         }
+
+        if (seed != 0)
+        { // Square is only a sorting key, disturb it to try another order of details.
+            square = qMax(Q_INT64_C(1), qRound64(static_cast<qreal>(square) * jitter(generator)));
+        }
         unsorted.insert(i, square);
     }
 
@@ -247,12 +262,35 @@ void VBank::Reset()
     diagonal = 0;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+Cases VBank::GetCaseType() const
+{
+    return caseType;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void VBank::SetCaseType(Cases caseType)
 {
     this->caseType = caseType;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+quint32 VBank::GetSeed() const
+{
+    return seed;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetSeed changes order of details. 0 keeps order by square, other values shuffle details of similar square
+ * the same way each time.
+ */
+void VBank::SetSeed(quint32 seed)
+{
+    this->seed = seed;
+    Reset();
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 int VBank::AllDetailsCount() const
 {
@@ -77,6 +77,7 @@ class VBank
     qreal GetLayoutWidth() const;
     void SetLayoutWidth(const qreal &value);
 
+    QVector<VLayoutPiece> GetDetails() const;
     void SetDetails(const QVector<VLayoutPiece> &details);
     int  GetTiket();
     VLayoutPiece GetDetail(int i) const;
@@ -86,8 +87,12 @@ class VBank
 
     bool Prepare();
     void Reset();
+    Cases GetCaseType() const;
     void SetCaseType(Cases caseType);
 
+    quint32 GetSeed() const;
+    void    SetSeed(quint32 seed);
+
     int AllDetailsCount() const;
     int LeftArrange() const;
     int ArrangedCount() const;
@@ -108,6 +113,7 @@ class VBank
     Cases caseType;
     bool prepare;
     qreal diagonal;
+    quint32 seed;
 
     void PrepareGroup();
 
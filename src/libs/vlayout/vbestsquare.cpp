@@ -57,42 +57,27 @@
 VBestSquare::VBestSquare(const QSizeF &sheetSize, bool saveLength)
     :resI(0), resJ(0), resMatrix(QMatrix()), bestSize(QSizeF(sheetSize.width()+10, sheetSize.height()+10)),
       sheetWidth(sheetSize.width()), valideResult(false), resMirror(false), type (BestFrom::Rotation),
-      saveLength(saveLength)
+      saveLength(saveLength), resOrder(0)
 {}
 
 //---------------------------------------------------------------------------------------------------------------------
-void VBestSquare::NewResult(const QSizeF &candidate, int i, int j, const QTransform &matrix, bool mirror, BestFrom type)
+void VBestSquare::NewResult(const QSizeF &candidate, int i, int j, const QTransform &matrix, bool mirror, BestFrom type,
+                            int order)
 {
-    if (saveLength)
+    const QSizeF size = saveLength ? QSizeF(sheetWidth, candidate.height()) : candidate;
+    if (not IsBetter(Square(size), type, order))
     {
-        const QSizeF saveLengthSize(sheetWidth, candidate.height());
-        if (Square(saveLengthSize) <= Square(bestSize) && Square(saveLengthSize) > 0 && type >= this->type)
-        {
-            bestSize = saveLengthSize;
-        }
-        else
-        {
-            return;
-        }
-    }
-    else
-    {
-        if (Square(candidate) <= Square(bestSize) && Square(candidate) > 0 && type >= this->type)
-        {
-            bestSize = candidate;
-        }
-        else
-        {
-            return;
-        }
+        return;
     }
 
+    bestSize = size;
     resI = i;
     resJ = j;
     resMatrix = matrix;
     valideResult = true;
     resMirror = mirror;
     this->type = type;
+    resOrder = order;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -100,7 +85,8 @@ void VBestSquare::NewResult(const VBestSquare &best)
 {
     if (best.ValidResult() && saveLength == best.IsSaveLength())
     {
-        NewResult(best.BestSize(), best.GContourEdge(), best.DetailEdge(), best.Matrix(), best.Mirror(), best.Type());
+        NewResult(best.BestSize(), best.GContourEdge(), best.DetailEdge(), best.Matrix(), best.Mirror(), best.Type(),
+                  best.resOrder);
     }
 }
 
@@ -157,3 +143,35 @@ qint64 VBestSquare::Square(const QSizeF &size)
 {
     return static_cast<qint64>(size.width()*size.height());
 }
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief IsBetter compares candidate with the current best result.
+ *
+ * Smaller square wins. On equal square combined edges win over rotation, then the search order decides. This makes
+ * the result independent from the order in which candidates are merged.
+ */
+bool VBestSquare::IsBetter(qint64 square, BestFrom type, int order) const
+{
+    if (square <= 0)
+    {
+        return false;
+    }
+
+    if (not valideResult)
+    {
+        return square <= Square(bestSize);
+    }
+
+    if (square != Square(bestSize))
+    {
+        return square < Square(bestSize);
+    }
+
+    if (type != this->type)
+    {
+        return type > this->type;
+    }
+
+    return order < resOrder;
+}
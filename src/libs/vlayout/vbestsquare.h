@@ -63,7 +63,8 @@ class VBestSquare
 public:
     VBestSquare(const QSizeF &sheetSize, bool saveLength);
 
-    void NewResult(const QSizeF &candidate, int i, int j, const QTransform &matrix, bool mirror, BestFrom type);
+    void NewResult(const QSizeF &candidate, int i, int j, const QTransform &matrix, bool mirror, BestFrom type,
+                   int order = 0);
     void NewResult(const VBestSquare &best);
 
     QSizeF     BestSize() const;
@@ -76,6 +77,8 @@ class VBestSquare
 
     bool IsSaveLength() const;
 
+    static qint64 Square(const QSizeF &size);
+
 private:
     // All nedded information about best result
     int resI; // Edge of global contour
@@ -87,8 +90,9 @@ class VBestSquare
     bool resMirror;
     BestFrom type;
     bool saveLength;
+    int resOrder; // Position of the candidate in the search, makes the choice between equal results stable
 
-    static qint64 Square(const QSizeF &size);
+    bool IsBetter(qint64 square, BestFrom type, int order) const;
 };
 
 #endif // VBESTSQUARE_H
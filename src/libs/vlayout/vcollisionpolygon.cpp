@@ -0,0 +1,477 @@
+/***************************************************************************
+ *                                                                         *
+ *   @file   vcollisionpolygon.cpp                                         *
+ *   @author Seamly2D project                                              *
+ *   @date   10.16.2026                                                    *
+ *   Copyright (C) 2017  Seamly, LLC                                       *
+ *                                                                         *
+ *   https://github.com/fashionfreedom/seamly2d                            *
+ *                                                                         *
+ ***************************************************************************
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **************************************************************************/
+
+#include "vcollisionpolygon.h"
+
+#include <QtMath>
+
+namespace
+{
+// The grid doesn't make sense for very small polygons and must stay small for huge ones.
+const int maxGridSize = 64;
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Side returns the side of point p relative to directed line a->b.
+ * @return 1 or -1 for left and right side, 0 if point is closer to the line than VCollisionPolygon::accuracy.
+ */
+int Side(const QPointF &a, const QPointF &b, const QPointF &p)
+{
+    const qreal dx = b.x() - a.x();
+    const qreal dy = b.y() - a.y();
+    const qreal cross = dx*(p.y() - a.y()) - dy*(p.x() - a.x());
+    const qreal length = qSqrt(dx*dx + dy*dy);
+
+    if (qAbs(cross) <= VCollisionPolygon::accuracy * length)
+    {
+        return 0;
+    }
+    return cross > 0 ? 1 : -1;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SegmentsCross checks if two segments cross in points that are inner for both of them. Touching and
+ * collinear segments don't cross.
+ */
+bool SegmentsCross(const QPointF &a, const QPointF &b, const QPointF &c, const QPointF &d)
+{
+    const int s1 = Side(a, b, c);
+    const int s2 = Side(a, b, d);
+    if (s1 == 0 || s2 == 0 || s1 == s2)
+    {
+        return false;
+    }
+
+    const int s3 = Side(c, d, a);
+    const int s4 = Side(c, d, b);
+    return s3 != 0 && s4 != 0 && s3 != s4;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+qreal DistanceToSegmentSquared(const QPointF &p, const QPointF &a, const QPointF &b)
+{
+    const qreal dx = b.x() - a.x();
+    const qreal dy = b.y() - a.y();
+    const qreal length2 = dx*dx + dy*dy;
+
+    qreal t = 0;
+    if (length2 > 0)
+    {
+        t = qBound(0.0, ((p.x() - a.x())*dx + (p.y() - a.y())*dy) / length2, 1.0);
+    }
+
+    const qreal px = a.x() + t*dx - p.x();
+    const qreal py = a.y() + t*dy - p.y();
+    return px*px + py*py;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SegmentsTouch checks if two segments have at least one common point: they cross, a vertex of one lies on
+ * another or they overlap on a common line.
+ */
+bool SegmentsTouch(const QPointF &a, const QPointF &b, const QPointF &c, const QPointF &d)
+{
+    if (SegmentsCross(a, b, c, d))
+    {
+        return true;
+    }
+
+    const qreal accuracy2 = VCollisionPolygon::accuracy*VCollisionPolygon::accuracy;
+    return DistanceToSegmentSquared(a, c, d) <= accuracy2 || DistanceToSegmentSquared(b, c, d) <= accuracy2
+            || DistanceToSegmentSquared(c, a, b) <= accuracy2 || DistanceToSegmentSquared(d, a, b) <= accuracy2;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QRectF SegmentRect(const QPointF &a, const QPointF &b)
+{
+    return QRectF(QPointF(qMin(a.x(), b.x()), qMin(a.y(), b.y())), QPointF(qMax(a.x(), b.x()), qMax(a.y(), b.y())));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool RectsOverlap(const QRectF &r1, const QRectF &r2)
+{
+    const qreal e = VCollisionPolygon::accuracy;
+    return r1.left() - e <= r2.right() && r2.left() - e <= r1.right() &&
+           r1.top() - e <= r2.bottom() && r2.top() - e <= r1.bottom();
+}
+}
+
+// Less than hundredth of a pixel means the contours touch.
+const qreal VCollisionPolygon::accuracy = 0.01;
+
+//---------------------------------------------------------------------------------------------------------------------
+VCollisionPolygon::VCollisionPolygon()
+    : points(),
+      rect(),
+      columns(0),
+      rows(0),
+      cellWidth(0),
+      cellHeight(0),
+      cells(),
+      bands()
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+VCollisionPolygon::VCollisionPolygon(const QVector<QPointF> &points)
+    : points(points),
+      rect(),
+      columns(0),
+      rows(0),
+      cellWidth(0),
+      cellHeight(0),
+      cells(),
+      bands()
+{
+    // The polygon is always closed, the closing point is not needed.
+    if (this->points.size() > 1 && this->points.first() == this->points.last())
+    {
+        this->points.removeLast();
+    }
+
+    BuildIndex();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VCollisionPolygon::IsEmpty() const
+{
+    return points.size() < 3;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VCollisionPolygon::EdgesCount() const
+{
+    return points.size();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QRectF VCollisionPolygon::BoundingRect() const
+{
+    return rect;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QPointF> VCollisionPolygon::GetPoints() const
+{
+    return points;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief PointLocation finds where the point is. Inside means nonzero winding number (Qt::WindingFill).
+ */
+VCollisionPolygon::Location VCollisionPolygon::PointLocation(const QPointF &point) const
+{
+    if (IsEmpty() || not RectsOverlap(rect, QRectF(point, point)))
+    {
+        return Location::Outside;
+    }
+
+    const qreal accuracy2 = accuracy*accuracy;
+    const QVector<int> &band = bands.at(Row(point.y()));
+    int winding = 0;
+
+    for (int k = 0; k < band.size(); ++k)
+    {
+        const QPointF &a = EdgeP1(band.at(k));
+        const QPointF &b = EdgeP2(band.at(k));
+
+        if (DistanceToSegmentSquared(point, a, b) <= accuracy2)
+        {
+            return Location::Boundary;
+        }
+
+        const qreal isLeft = (b.x() - a.x())*(point.y() - a.y()) - (point.x() - a.x())*(b.y() - a.y());
+        if (a.y() <= point.y())
+        {
+            if (b.y() > point.y() && isLeft > 0)
+            {
+                ++winding;
+            }
+        }
+        else if (b.y() <= point.y() && isLeft < 0)
+        {
+            --winding;
+        }
+    }
+
+    return winding != 0 ? Location::Inside : Location::Outside;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief EdgesCross checks if edges of two polygons cross each other. Touching edges don't cross.
+ */
+bool VCollisionPolygon::EdgesCross(const VCollisionPolygon &polygon) const
+{
+    return FindEdges(polygon, false);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief EdgesTouch checks if edges of two polygons have at least one common point.
+ */
+bool VCollisionPolygon::EdgesTouch(const VCollisionPolygon &polygon) const
+{
+    return FindEdges(polygon, true);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Intersects mirrors QPainterPath::intersects(): true if edges cross or touch or one polygon has a part inside
+ * another. Polygons that share an edge or a vertex intersect.
+ */
+bool VCollisionPolygon::Intersects(const VCollisionPolygon &polygon) const
+{
+    if (IsEmpty() || polygon.IsEmpty() || not RectsOverlap(rect, polygon.BoundingRect()))
+    {
+        return false;
+    }
+
+    return EdgesTouch(polygon) || HasSampleInside(polygon) || polygon.HasSampleInside(*this);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Overlaps checks if interiors of two polygons have common area. Unlike Intersects() polygons that only touch
+ * each other don't overlap.
+ */
+bool VCollisionPolygon::Overlaps(const VCollisionPolygon &polygon) const
+{
+    if (IsEmpty() || polygon.IsEmpty() || not RectsOverlap(rect, polygon.BoundingRect()))
+    {
+        return false;
+    }
+
+    return EdgesCross(polygon) || HasSampleInside(polygon) || polygon.HasSampleInside(*this);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Contains mirrors QPainterPath::contains(const QPainterPath &): true if the polygon is completely inside and
+ * doesn't touch the boundary.
+ */
+bool VCollisionPolygon::Contains(const VCollisionPolygon &polygon) const
+{
+    if (IsEmpty() || polygon.IsEmpty() || not rect.adjusted(-accuracy, -accuracy, accuracy, accuracy)
+            .contains(polygon.BoundingRect()))
+    {
+        return false;
+    }
+
+    if (EdgesTouch(polygon))
+    {
+        return false;
+    }
+
+    const QVector<QPointF> samples = polygon.Samples();
+    for (int i = 0; i < samples.size(); ++i)
+    {
+        if (PointLocation(samples.at(i)) != Location::Inside)
+        {
+            return false;
+        }
+    }
+    return not samples.isEmpty();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief FindEdges looks for a pair of crossing (or touching) edges. Edges of the smaller polygon are tested against
+ * the grid of the bigger one.
+ */
+bool VCollisionPolygon::FindEdges(const VCollisionPolygon &polygon, bool touching) const
+{
+    if (IsEmpty() || polygon.IsEmpty() || not RectsOverlap(rect, polygon.BoundingRect()))
+    {
+        return false;
+    }
+
+    const bool thisIndexed = EdgesCount() >= polygon.EdgesCount();
+    const VCollisionPolygon &indexed = thisIndexed ? *this : polygon;
+    const VCollisionPolygon &walked = thisIndexed ? polygon : *this;
+
+    // Long edges occupy several cells, remember which edge was already tested against current one.
+    QVector<int> tested(indexed.EdgesCount(), -1);
+
+    for (int e = 0; e < walked.EdgesCount(); ++e)
+    {
+        const QPointF &p1 = walked.EdgeP1(e);
+        const QPointF &p2 = walked.EdgeP2(e);
+        const QRectF segmentRect = SegmentRect(p1, p2);
+        if (not RectsOverlap(segmentRect, indexed.rect))
+        {
+            continue;
+        }
+
+        const int c1 = indexed.Column(segmentRect.left());
+        const int c2 = indexed.Column(segmentRect.right());
+        const int r1 = indexed.Row(segmentRect.top());
+        const int r2 = indexed.Row(segmentRect.bottom());
+
+        for (int r = r1; r <= r2; ++r)
+        {
+            for (int c = c1; c <= c2; ++c)
+            {
+                const QVector<int> &cell = indexed.cells.at(r*indexed.columns + c);
+                for (int k = 0; k < cell.size(); ++k)
+                {
+                    const int i = cell.at(k);
+                    if (tested.at(i) == e)
+                    {
+                        continue;
+                    }
+                    tested[i] = e;
+
+                    const QPointF &p3 = indexed.EdgeP1(i);
+                    const QPointF &p4 = indexed.EdgeP2(i);
+                    if (touching ? SegmentsTouch(p1, p2, p3, p4) : SegmentsCross(p1, p2, p3, p4))
+                    {
+                        return true;
+                    }
+                }
+            }
+        }
+    }
+
+    return false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VCollisionPolygon::BuildIndex()
+{
+    cells.clear();
+    bands.clear();
+
+    if (IsEmpty())
+    {
+        rect = QRectF();
+        columns = 0;
+        rows = 0;
+        return;
+    }
+
+    qreal minX = points.first().x();
+    qreal maxX = minX;
+    qreal minY = points.first().y();
+    qreal maxY = minY;
+    for (int i = 1; i < points.size(); ++i)
+    {
+        minX = qMin(minX, points.at(i).x());
+        maxX = qMax(maxX, points.at(i).x());
+        minY = qMin(minY, points.at(i).y());
+        maxY = qMax(maxY, points.at(i).y());
+    }
+    rect = QRectF(QPointF(minX, minY), QPointF(maxX, maxY));
+
+    const int gridSize = qBound(1, qCeil(qSqrt(points.size())), maxGridSize);
+    columns = gridSize;
+    rows = gridSize;
+    cellWidth = qMax(rect.width()/columns, accuracy);
+    cellHeight = qMax(rect.height()/rows, accuracy);
+    cells.resize(columns*rows);
+    bands.resize(rows);
+
+    for (int i = 0; i < EdgesCount(); ++i)
+    {
+        // Expand by accuracy so touching queries near cell borders still see the edge.
+        const QRectF r = SegmentRect(EdgeP1(i), EdgeP2(i)).adjusted(-accuracy, -accuracy, accuracy, accuracy);
+        const int c1 = Column(r.left());
+        const int c2 = Column(r.right());
+        const int r1 = Row(r.top());
+        const int r2 = Row(r.bottom());
+
+        for (int row = r1; row <= r2; ++row)
+        {
+            bands[row].append(i);
+            for (int c = c1; c <= c2; ++c)
+            {
+                cells[row*columns + c].append(i);
+            }
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VCollisionPolygon::Column(qreal x) const
+{
+    return qBound(0, qFloor((x - rect.left())/cellWidth), columns-1);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VCollisionPolygon::Row(qreal y) const
+{
+    return qBound(0, qFloor((y - rect.top())/cellHeight), rows-1);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+const QPointF &VCollisionPolygon::EdgeP1(int i) const
+{
+    return points.at(i);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+const QPointF &VCollisionPolygon::EdgeP2(int i) const
+{
+    return points.at(i+1 < points.size() ? i+1 : 0);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief HasSampleInside checks vertices and middles of edges of the polygon. Middles are needed to find overlapping
+ * when all vertices of the polygon lie on the boundary of this one.
+ */
+bool VCollisionPolygon::HasSampleInside(const VCollisionPolygon &polygon) const
+{
+    if (not RectsOverlap(rect, polygon.BoundingRect()))
+    {
+        return false;
+    }
+
+    const QVector<QPointF> samples = polygon.Samples();
+    for (int i = 0; i < samples.size(); ++i)
+    {
+        if (PointLocation(samples.at(i)) == Location::Inside)
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QPointF> VCollisionPolygon::Samples() const
+{
+    QVector<QPointF> samples;
+    samples.reserve(points.size()*2);
+    for (int i = 0; i < EdgesCount(); ++i)
+    {
+        samples.append(EdgeP1(i));
+        samples.append((EdgeP1(i) + EdgeP2(i))/2.0);
+    }
+    return samples;
+}
@@ -0,0 +1,99 @@
+/***************************************************************************
+ *                                                                         *
+ *   @file   vcollisionpolygon.h                                           *
+ *   @author Seamly2D project                                              *
+ *   @date   10.16.2026                                                    *
+ *   Copyright (C) 2017  Seamly, LLC                                       *
+ *                                                                         *
+ *   https://github.com/fashionfreedom/seamly2d                            *
+ *                                                                         *
+ ***************************************************************************
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **************************************************************************/
+
+#ifndef VCOLLISIONPOLYGON_H
+#define VCOLLISIONPOLYGON_H
+
+#include <QPointF>
+#include <QRectF>
+#include <QTypeInfo>
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ * @brief The VCollisionPolygon class answers intersection and containment questions for closed polygons directly on
+ * their points.
+ *
+ * It replaces QPainterPath::intersects()/contains() in the layout search. Edges are put in a uniform grid and in
+ * horizontal bands, so an edge query only visits edges of the neighbouring cells and a point query only edges of
+ * one band. Like QPainterPath, Intersects() treats contours that only touch (share an edge or a vertex) as
+ * intersecting. Overlaps() ignores touching for callers that glue pieces exactly edge to edge.
+ */
+class VCollisionPolygon
+{
+public:
+    enum class Location : char
+    {
+        Outside = 0,
+        Inside = 1,
+        Boundary = 2
+    };
+
+    VCollisionPolygon();
+    explicit VCollisionPolygon(const QVector<QPointF> &points);
+
+    bool             IsEmpty() const;
+    int              EdgesCount() const;
+    QRectF           BoundingRect() const;
+    QVector<QPointF> GetPoints() const;
+
+    Location PointLocation(const QPointF &point) const;
+
+    bool EdgesCross(const VCollisionPolygon &polygon) const;
+    bool EdgesTouch(const VCollisionPolygon &polygon) const;
+    bool Intersects(const VCollisionPolygon &polygon) const;
+    bool Overlaps(const VCollisionPolygon &polygon) const;
+    bool Contains(const VCollisionPolygon &polygon) const;
+
+    static const qreal accuracy;
+
+private:
+    QVector<QPointF>       points;
+    QRectF                 rect;
+    int                    columns;
+    int                    rows;
+    qreal                  cellWidth;
+    qreal                  cellHeight;
+    QVector<QVector<int>>  cells;
+    QVector<QVector<int>>  bands;
+
+    void BuildIndex();
+
+    int Column(qreal x) const;
+    int Row(qreal y) const;
+
+    const QPointF &EdgeP1(int i) const;
+    const QPointF &EdgeP2(int i) const;
+
+    bool FindEdges(const VCollisionPolygon &polygon, bool touching) const;
+
+    bool HasSampleInside(const VCollisionPolygon &polygon) const;
+    QVector<QPointF> Samples() const;
+};
+
+Q_DECLARE_TYPEINFO(VCollisionPolygon, Q_MOVABLE_TYPE);
+
+#endif // VCOLLISIONPOLYGON_H
@@ -20,7 +20,10 @@ HEADERS += \
     $$PWD/vlayoutpiece.h \
     $$PWD/vlayoutpiece_p.h \
     $$PWD/vlayoutpiecepath.h \
-    $$PWD/vlayoutpiecepath_p.h
+    $$PWD/vlayoutpiecepath_p.h \
+    $$PWD/vcollisionpolygon.h \
+    $$PWD/vnfpcache.h \
+    $$PWD/vnfpnester.h
 
 SOURCES += \
     $$PWD/vlayoutgenerator.cpp \
@@ -34,6 +37,9 @@ SOURCES += \
     $$PWD/vgraphicsfillitem.cpp \
     $$PWD/vabstractpiece.cpp \
     $$PWD/vlayoutpiece.cpp \
-    $$PWD/vlayoutpiecepath.cpp
+    $$PWD/vlayoutpiecepath.cpp \
+    $$PWD/vcollisionpolygon.cpp \
+    $$PWD/vnfpcache.cpp \
+    $$PWD/vnfpnester.cpp
 
 *msvc*:SOURCES += $$PWD/stable.cpp
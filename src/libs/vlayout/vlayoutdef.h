@@ -64,6 +64,19 @@ enum class LayoutErrors : char
     EmptyPaperError
 };
 
+/**
+ * @brief The LayoutEngine enum selects how VLayoutPaper looks for a position of a piece.
+ *
+ * Contour glues edges of a piece to edges of the global contour, Nfp places pieces with bottom-left-fill rule
+ * using no-fit polygons.
+ */
+enum class LayoutEngine : char
+{
+    Contour = 0,
+    Nfp = 1,
+    UnknownEngine
+};
+
 enum class BestFrom : char
 {
     Rotation = 0,
@@ -51,14 +51,141 @@
 
 #include "vlayoutgenerator.h"
 
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QMultiHash>
 #include <QGraphicsRectItem>
 #include <QRectF>
+#include <QRunnable>
+#include <QScopedPointer>
+#include <QThread>
 #include <QThreadPool>
 
 #include "../vmisc/def.h"
 #include "../vmisc/vmath.h"
 #include "vlayoutpiece.h"
 #include "vlayoutpaper.h"
+#include "vnfpcache.h"
+
+namespace
+{
+const int layoutEventsTimeout = 100; // ms
+}
+
+/**
+ * @brief The VLayoutAttempt class runs one attempt of the best of N layout in a thread pool.
+ */
+class VLayoutAttempt : public QRunnable
+{
+public:
+    VLayoutAttempt(VLayoutGenerator *layoutGenerator, const VLayoutVariant &attemptVariant, int workers,
+                   VBank *attemptBank = nullptr, VNfpCache *attemptCache = nullptr);
+    virtual ~VLayoutAttempt() Q_DECL_OVERRIDE{}
+
+    virtual void run() Q_DECL_OVERRIDE;
+
+    void Stop();
+    bool IsCompleted() const;
+
+    LayoutErrors State() const;
+    QVector<VLayoutPaper> Papers() const;
+    bool IsStripEnabled() const;
+
+private:
+    Q_DISABLE_COPY(VLayoutAttempt)
+
+    VLayoutGenerator *generator;
+    VLayoutVariant variant;
+    int workersCount;
+    QScopedPointer<VBank> ownBank;
+    QScopedPointer<VNfpCache> ownCache;
+    VBank *bank;
+    VNfpCache *cache;
+    std::atomic_bool stop;
+    std::atomic_bool completed;
+    LayoutErrors state;
+    QVector<VLayoutPaper> papers;
+    bool stripEnabled;
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief VLayoutAttempt constructor. Without own bank and cache the attempt works on copies of generator's ones.
+ */
+VLayoutAttempt::VLayoutAttempt(VLayoutGenerator *layoutGenerator, const VLayoutVariant &attemptVariant, int workers,
+                               VBank *attemptBank, VNfpCache *attemptCache)
+    : generator(layoutGenerator),
+      variant(attemptVariant),
+      workersCount(workers),
+      ownBank(),
+      ownCache(),
+      bank(attemptBank),
+      cache(attemptCache),
+#ifdef Q_CC_MSVC
+      stop(ATOMIC_VAR_INIT(false)),
+      completed(ATOMIC_VAR_INIT(false)),
+#else
+      stop(false),
+      completed(false),
+#endif
+      state(LayoutErrors::NoError),
+      papers(),
+      stripEnabled(false)
+{
+    SCASSERT(generator != nullptr)
+    setAutoDelete(false);
+
+    if (bank == nullptr)
+    {
+        ownBank.reset(new VBank());
+        ownBank->SetLayoutWidth(generator->bank->GetLayoutWidth());
+        ownBank->SetDetails(generator->bank->GetDetails());
+        bank = ownBank.data();
+    }
+
+    if (cache == nullptr)
+    {
+        ownCache.reset(new VNfpCache());
+        cache = ownCache.data();
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VLayoutAttempt::run()
+{
+    state = generator->GeneratePapers(bank, cache, variant, workersCount, stop, papers, stripEnabled);
+    completed.store(not stop.load());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VLayoutAttempt::Stop()
+{
+    stop.store(true);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VLayoutAttempt::IsCompleted() const
+{
+    return completed.load();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+LayoutErrors VLayoutAttempt::State() const
+{
+    return state;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<VLayoutPaper> VLayoutAttempt::Papers() const
+{
+    return papers;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VLayoutAttempt::IsStripEnabled() const
+{
+    return stripEnabled;
+}
 
 //---------------------------------------------------------------------------------------------------------------------
 VLayoutGenerator::VLayoutGenerator(QObject *parent)
@@ -85,13 +212,25 @@ VLayoutGenerator::VLayoutGenerator(QObject *parent)
       stripOptimizationEnabled(false),
       multiplier(1),
       stripOptimization(false),
-      textAsPaths(false)
+      textAsPaths(false),
+      engine(LayoutEngine::Contour),
+      nfpCache(new VNfpCache()),
+      attempts(1),
+      timeBudget(0),
+      progress(0),
+      progressMutex(),
+      incremental(false),
+      incrementalThreshold(10),
+      pollingWait(false),
+      previous(),
+      revision()
 {}
 
 //---------------------------------------------------------------------------------------------------------------------
 VLayoutGenerator::~VLayoutGenerator()
 {
     delete bank;
+    delete nfpCache;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -124,6 +263,9 @@ void VLayoutGenerator::Generate()
 {
     stopGeneration.store(false);
     papers.clear();
+    nfpCache->Clear();
+    progress = 0;
+    stripOptimizationEnabled = false;
     state = LayoutErrors::NoError;
 
 #ifdef LAYOUT_DEBUG
@@ -135,90 +277,524 @@ void VLayoutGenerator::Generate()
 
     emit Start();
 
-    if (bank->Prepare())
+    LayoutErrors result = LayoutErrors::NoError;
+    if (not GenerateIncremental(result))
     {
-        const int width = PageWidth();
-        int height = PageHeight();
+        progress = 0; // Start again if the incremental pass was rejected
 
-        if (stripOptimization)
+        if (attempts > 1)
         {
-            const qreal b = bank->GetBiggestDiagonal() * multiplier + bank->GetLayoutWidth();
+            result = GenerateBestOf();
+        }
+        else
+        {
+            VLayoutVariant variant;
+            variant.caseType = bank->GetCaseType();
+            variant.shift = shift;
+            variant.rotationIncrease = rotationIncrease;
 
-            if (height >= b*2)
-            {
-                stripOptimizationEnabled = true;
-                height = qFloor(height / qFloor(height/b));
-            }
+            result = GeneratePapers(bank, nfpCache, variant, 0, stopGeneration, papers, stripOptimizationEnabled);
         }
+    }
+
+    if (result != LayoutErrors::NoError)
+    {
+        state = result;
+        emit Error(state);
+        return;
+    }
 
-        while (bank->AllDetailsCount() > 0)
+    if (state == LayoutErrors::NoError)
+    {
+        revision = VLayoutRevision();
+        for (int i = 0; i < papers.size(); ++i)
         {
-            if (stopGeneration.load())
-            {
-                break;
-            }
+            revision.details.append(papers.at(i).GetDetails());
+        }
+        revision.pageWidth = PageWidth();
+        revision.pageHeight = papers.isEmpty() ? PageHeight() : papers.first().GetHeight();
+        revision.layoutWidth = bank->GetLayoutWidth();
+    }
+
+    if (stripOptimizationEnabled)
+    {
+        GatherPages();
+    }
+
+    if (IsUnitePages())
+    {
+        UnitePages();
+    }
+
+    emit Finished();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GeneratePapers arrange all details of the bank on as many papers as needed.
+ *
+ * Reads only settings of the generator, everything an attempt changes is passed as arguments. That allows to run
+ * several attempts at the same time, see GenerateBestOf().
+ * @param workersCount count of threads each paper may use to search position of a detail, 0 - one per core.
+ * @return NoError also if the generation was stopped, result then contains only papers finished so far.
+ */
+LayoutErrors VLayoutGenerator::GeneratePapers(VBank *detailsBank, VNfpCache *cache,
+                                              const VLayoutVariant &variant, int workersCount, std::atomic_bool &stop,
+                                              QVector<VLayoutPaper> &result, bool &stripEnabled)
+{
+    SCASSERT(detailsBank != nullptr)
+
+    result.clear();
+    stripEnabled = false;
+
+    detailsBank->SetCaseType(variant.caseType);
+    detailsBank->SetSeed(variant.seed);
+
+    if (not detailsBank->Prepare())
+    {
+        return LayoutErrors::PrepareLayoutError;
+    }
+
+    const int width = PageWidth();
+    const int height = SheetHeight(detailsBank, stripEnabled);
+
+    while (detailsBank->AllDetailsCount() > 0)
+    {
+        if (stop.load())
+        {
+            break;
+        }
+
+        VLayoutPaper paper = NewPaper(height, width, variant, workersCount, cache,
+                                      static_cast<quint32>(result.count()));
+        ArrangeOnPaper(detailsBank, paper, stop);
+
+        if (stop.load())
+        {
+            break;
+        }
+
+        if (paper.Count() > 0)
+        {
+            result.append(paper);
+        }
+        else
+        {
+            return LayoutErrors::EmptyPaperError;
+        }
+    }
+
+    return LayoutErrors::NoError;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GenerateIncremental keep details that didn't change since the previous revision where they were and arrange
+ * only new and changed ones.
+ *
+ * Sheets of the previous revision are filled with the NFP engine, because details can be placed into holes left by
+ * removed ones only this way. Details that don't fit there go to new sheets as usual.
+ * @param result error of generation, valid only if the function returns true.
+ * @return false if the previous revision can't be used or the result is worse than the threshold allows. In this
+ * case nothing is changed and the full generation must be run.
+ */
+bool VLayoutGenerator::GenerateIncremental(LayoutErrors &result)
+{
+    result = LayoutErrors::NoError;
+
+    if (not incremental || previous.details.isEmpty())
+    {
+        return false;
+    }
+
+    bank->SetSeed(0);
+    if (not bank->Prepare())
+    {
+        result = LayoutErrors::PrepareLayoutError;
+        return true;
+    }
+
+    bool stripEnabled = false;
+    const int width = PageWidth();
+    const int height = SheetHeight(bank, stripEnabled);
+
+    if (width != previous.pageWidth || height != previous.pageHeight
+            || not VFuzzyComparePossibleNulls(bank->GetLayoutWidth(), previous.layoutWidth))
+    {
+        return false; // Old positions don't fit new sheets
+    }
+
+    const QVector<VLayoutPiece> details = bank->GetDetails();
+    QMultiHash<quint32, int> indexes;
+    for (int i = 0; i < details.size(); ++i)
+    {
+        indexes.insert(details.at(i).GetId(), i);
+    }
+
+    VLayoutVariant variant;
+    variant.caseType = bank->GetCaseType();
+    variant.shift = shift;
+    variant.rotationIncrease = rotationIncrease;
+
+    QVector<bool> kept(details.size(), false);
+    int keptCount = 0;
+    QVector<VLayoutPaper> sheets;
+
+    for (int s = 0; s < previous.details.size(); ++s)
+    {
+        VLayoutPaper paper = NewPaper(height, width, variant, 0, nfpCache, static_cast<quint32>(sheets.count()));
+        paper.SetEngine(LayoutEngine::Nfp, nfpCache);
 
-            VLayoutPaper paper(height, width);
-            paper.SetShift(shift);
-            paper.SetLayoutWidth(bank->GetLayoutWidth());
-            paper.SetPaperIndex(static_cast<quint32>(papers.count()));
-            paper.SetRotate(rotate);
-            paper.SetRotationIncrease(rotationIncrease);
-            paper.SetSaveLength(saveLength);
-            do
+        const QVector<VLayoutPiece> &placed = previous.details.at(s);
+        for (int p = 0; p < placed.size(); ++p)
+        {
+            const QList<int> candidates = indexes.values(placed.at(p).GetId());
+            for (int c = 0; c < candidates.size(); ++c)
             {
-                const int index = bank->GetTiket();
-                if (paper.ArrangeDetail(bank->GetDetail(index), stopGeneration))
+                const int index = candidates.at(c);
+                if (not kept.at(index) && details.at(index).IsSameShape(placed.at(p)))
                 {
+                    VLayoutPiece detail = details.at(index);
+                    detail.SetMirror(placed.at(p).IsMirror());
+                    detail.SetMatrix(placed.at(p).GetMatrix());
+                    paper.AddFixedDetail(detail);
+
+                    kept[index] = true;
                     bank->Arranged(index);
-                    emit Arranged(bank->ArrangedCount());
-                }
-                else
-                {
-                    bank->NotArranged(index);
+                    ++keptCount;
+                    break;
                 }
+            }
+        }
+
+        if (paper.Count() > 0)
+        {
+            sheets.append(paper);
+        }
+    }
+
+    if (keptCount == 0)
+    {
+        return false;
+    }
+
+    ReportProgress(keptCount);
+
+    // Fill holes on old sheets first
+    for (int s = 0; s < sheets.size() && bank->AllDetailsCount() > 0 && not stopGeneration.load(); ++s)
+    {
+        ArrangeOnPaper(bank, sheets[s], stopGeneration);
+    }
+
+    while (bank->AllDetailsCount() > 0 && not stopGeneration.load())
+    {
+        VLayoutPaper paper = NewPaper(height, width, variant, 0, nfpCache, static_cast<quint32>(sheets.count()));
+        ArrangeOnPaper(bank, paper, stopGeneration);
+
+        if (stopGeneration.load())
+        {
+            break;
+        }
+
+        if (paper.Count() == 0)
+        {
+            result = LayoutErrors::EmptyPaperError;
+            return true;
+        }
+        sheets.append(paper);
+    }
+
+    if (not stopGeneration.load())
+    {
+        QVector<QVector<VLayoutPiece>> arranged;
+        for (int i = 0; i < sheets.size(); ++i)
+        {
+            arranged.append(sheets.at(i).GetDetails());
+        }
+
+        const qreal before = Utilization(previous.details, width);
+        if (Utilization(arranged, width) < before * (1.0 - incrementalThreshold/100.0))
+        {
+            return false;
+        }
+    }
+
+    papers = sheets;
+    stripOptimizationEnabled = stripEnabled;
+    return true;
+}
 
-                if (stopGeneration.load())
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ArrangeOnPaper put on the paper as many details from the bank as it can take.
+ */
+void VLayoutGenerator::ArrangeOnPaper(VBank *detailsBank, VLayoutPaper &paper, std::atomic_bool &stop)
+{
+    do
+    {
+        const int index = detailsBank->GetTiket();
+        if (paper.ArrangeDetail(detailsBank->GetDetail(index), stop))
+        {
+            detailsBank->Arranged(index);
+            ReportProgress(detailsBank->ArrangedCount());
+        }
+        else
+        {
+            detailsBank->NotArranged(index);
+        }
+
+        if (stop.load())
+        {
+            break;
+        }
+    } while(detailsBank->LeftArrange() > 0);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+VLayoutPaper VLayoutGenerator::NewPaper(int height, int width, const VLayoutVariant &variant, int workersCount,
+                                        VNfpCache *cache, quint32 index) const
+{
+    VLayoutPaper paper(height, width);
+    paper.SetShift(variant.shift);
+    paper.SetLayoutWidth(bank->GetLayoutWidth());
+    paper.SetPaperIndex(index);
+    paper.SetRotate(rotate);
+    paper.SetRotationIncrease(variant.rotationIncrease);
+    paper.SetSaveLength(saveLength);
+    paper.SetWorkersCount(workersCount);
+    paper.SetPollingWait(pollingWait);
+    paper.SetEngine(engine, cache);
+    return paper;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SheetHeight height of a paper to arrange on. With strip optimization the page is cut into strips.
+ */
+int VLayoutGenerator::SheetHeight(VBank *detailsBank, bool &stripEnabled) const
+{
+    int height = PageHeight();
+    stripEnabled = false;
+
+    if (stripOptimization)
+    {
+        const qreal b = detailsBank->GetBiggestDiagonal() * multiplier + detailsBank->GetLayoutWidth();
+
+        if (height >= b*2)
+        {
+            stripEnabled = true;
+            height = qFloor(height / qFloor(height/b));
+        }
+    }
+
+    return height;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GenerateBestOf run several attempts with different variants at the same time and keep the best layout.
+ *
+ * The first attempt always uses options set by user. Once the time budget is spent all attempts that still run are
+ * stopped, but only if at least one attempt has already finished, so we never end up with nothing.
+ */
+LayoutErrors VLayoutGenerator::GenerateBestOf()
+{
+    const QVector<VLayoutVariant> variants = Variants();
+    const int ideal = qMax(1, QThread::idealThreadCount());
+    const int parallel = qMin(variants.size(), ideal);
+    // Split cores between attempts instead of letting each paper start a worker per core
+    const int workersCount = qMax(1, ideal / parallel);
+
+    QVector<VLayoutAttempt *> tasks;
+    tasks.reserve(variants.size());
+    for (int i = 0; i < variants.size(); ++i)
+    {
+        if (i == 0)
+        {
+            tasks.append(new VLayoutAttempt(this, variants.at(i), workersCount, bank, nfpCache));
+        }
+        else
+        {
+            tasks.append(new VLayoutAttempt(this, variants.at(i), workersCount));
+        }
+    }
+
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(parallel);
+    for (int i = 0; i < tasks.size(); ++i)
+    {
+        threadPool.start(tasks.at(i));
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    bool stopped = false;
+
+    while (not threadPool.waitForDone(layoutEventsTimeout))
+    {
+        QCoreApplication::processEvents();
+
+        if (stopped)
+        {
+            continue;
+        }
+
+        bool overBudget = false;
+        if (timeBudget > 0 && timer.elapsed() >= timeBudget * 1000)
+        {
+            for (int i = 0; i < tasks.size(); ++i)
+            {
+                if (tasks.at(i)->IsCompleted())
                 {
+                    overBudget = true;
                     break;
                 }
-            } while(bank->LeftArrange() > 0);
-
-            if (stopGeneration.load())
-            {
-                break;
             }
+        }
 
-            if (paper.Count() > 0)
+        if (stopGeneration.load() || overBudget)
+        {
+            stopped = true;
+            threadPool.clear();
+            for (int i = 0; i < tasks.size(); ++i)
             {
-                papers.append(paper);
+                tasks.at(i)->Stop();
             }
-            else
+        }
+    }
+
+    int best = -1;
+    for (int i = 0; i < tasks.size(); ++i)
+    {
+        const VLayoutAttempt *task = tasks.at(i);
+        if (task->IsCompleted() && task->State() == LayoutErrors::NoError
+                && (best == -1 || IsBetterLayout(task->Papers(), tasks.at(best)->Papers())))
+        {
+            best = i;
+        }
+    }
+
+    // Nothing finished: the user stopped the generation or all attempts failed. Behave like a single pass.
+    const VLayoutAttempt *winner = tasks.at(best == -1 ? 0 : best);
+    const LayoutErrors result = winner->State();
+    papers = winner->Papers();
+    stripOptimizationEnabled = winner->IsStripEnabled();
+
+    qDeleteAll(tasks);
+    return result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<VLayoutVariant> VLayoutGenerator::Variants() const
+{
+    QVector<VLayoutVariant> variants;
+
+    VLayoutVariant base;
+    base.caseType = bank->GetCaseType();
+    base.shift = shift;
+    base.rotationIncrease = rotationIncrease;
+    variants.append(base);
+
+    const Cases cases[] = {Cases::CaseDesc, Cases::CaseTwoGroup, Cases::CaseThreeGroup};
+
+    QVector<int> increases;
+    increases.append(rotationIncrease);
+    if (rotate)
+    {
+        const int other[] = {90, 180, 45};
+        for (int increase : other)
+        {
+            if (not increases.contains(increase))
             {
-                state = LayoutErrors::EmptyPaperError;
-                emit Error(state);
-                return;
+                increases.append(increase);
             }
         }
     }
-    else
+
+    QVector<quint32> shifts;
+    shifts.append(shift);
+    if (shift > 1)
     {
-        state = LayoutErrors::PrepareLayoutError;
-        emit Error(state);
-        return;
+        shifts.append(shift / 2);
+        shifts.append(shift * 2);
     }
 
-    if (stripOptimizationEnabled)
+    const int casesCount = static_cast<int>(sizeof(cases) / sizeof(cases[0]));
+    for (int i = 1; i < attempts; ++i)
     {
-        GatherPages();
+        VLayoutVariant variant;
+        variant.caseType = cases[i % casesCount];
+        variant.rotationIncrease = increases.at((i / casesCount) % increases.size());
+        variant.shift = shifts.at((i / (casesCount * increases.size())) % shifts.size());
+        variant.seed = static_cast<quint32>(i);
+        variants.append(variant);
     }
 
-    if (IsUnitePages())
+    return variants;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ReportProgress emit Arranged only if arranged is the new best count. Safe to call from several attempts,
+ * the lock also keeps emitted values in growing order.
+ */
+void VLayoutGenerator::ReportProgress(int arranged)
+{
+    QMutexLocker locker(&progressMutex);
+    if (arranged > progress)
     {
-        UnitePages();
+        progress = arranged;
+        emit Arranged(arranged);
     }
+}
 
-    emit Finished();
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief IsBetterLayout fewer papers win, on equal count the shorter marker wins.
+ */
+bool VLayoutGenerator::IsBetterLayout(const QVector<VLayoutPaper> &layout, const QVector<VLayoutPaper> &best)
+{
+    if (layout.size() != best.size())
+    {
+        return layout.size() < best.size();
+    }
+
+    auto MarkerLength = [](const QVector<VLayoutPaper> &papers)
+    {
+        qreal length = 0;
+        for (int i = 0; i < papers.size(); ++i)
+        {
+            length += papers.at(i).DetailsBoundingRect().bottom();
+        }
+        return length;
+    };
+
+    return MarkerLength(layout) < MarkerLength(best);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Utilization area of details divided by used area of sheets. Used length of a sheet is the bottom of its
+ * details.
+ */
+qreal VLayoutGenerator::Utilization(const QVector<QVector<VLayoutPiece>> &details, int width)
+{
+    qreal detailsArea = 0;
+    qreal usedArea = 0;
+
+    for (int i = 0; i < details.size(); ++i)
+    {
+        qreal bottom = 0;
+        for (int j = 0; j < details.at(i).size(); ++j)
+        {
+            const VLayoutPiece &detail = details.at(i).at(j);
+            detailsArea += static_cast<qreal>(detail.Square());
+            bottom = qMax(bottom, detail.DetailBoundingRect().bottom());
+        }
+        usedArea += bottom * width;
+    }
+
+    return qFuzzyIsNull(usedArea) ? 0 : detailsArea/usedArea;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -265,7 +841,6 @@ void VLayoutGenerator::Abort()
 {
     stopGeneration.store(true);
     state = LayoutErrors::ProcessStoped;
-    QThreadPool::globalInstance()->clear();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -292,6 +867,107 @@ void VLayoutGenerator::SetTestAsPaths(bool value)
     textAsPaths = value;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+LayoutEngine VLayoutGenerator::GetEngine() const
+{
+    return engine;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VLayoutGenerator::SetEngine(LayoutEngine value)
+{
+    engine = value == LayoutEngine::Nfp ? LayoutEngine::Nfp : LayoutEngine::Contour;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VLayoutGenerator::GetAttempts() const
+{
+    return attempts;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VLayoutGenerator::SetAttempts(int value)
+{
+    attempts = qBound(1, value, 64);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VLayoutGenerator::GetTimeBudget() const
+{
+    return timeBudget;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetTimeBudget set time in seconds after which best of N generation stops running attempts, 0 - no limit.
+ */
+void VLayoutGenerator::SetTimeBudget(int value)
+{
+    timeBudget = qMax(0, value);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VLayoutGenerator::IsIncremental() const
+{
+    return incremental;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetIncremental start from the previous revision instead of an empty layout, see SetPreviousRevision().
+ */
+void VLayoutGenerator::SetIncremental(bool value)
+{
+    incremental = value;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VLayoutGenerator::GetIncrementalThreshold() const
+{
+    return incrementalThreshold;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetIncrementalThreshold set in percent how much the fabric utilization may drop compared with the previous
+ * revision before the incremental result is thrown away in favor of the full generation.
+ */
+void VLayoutGenerator::SetIncrementalThreshold(int value)
+{
+    incrementalThreshold = qBound(0, value, 100);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VLayoutGenerator::IsPollingWait() const
+{
+    return pollingWait;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetPollingWait make papers wait for the candidate search the old way, see VLayoutPaper::SetPollingWait().
+ * Only for benchmarks.
+ */
+void VLayoutGenerator::SetPollingWait(bool value)
+{
+    pollingWait = value;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GetRevision layout of the last successful generation.
+ */
+VLayoutRevision VLayoutGenerator::GetRevision() const
+{
+    return revision;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VLayoutGenerator::SetPreviousRevision(const VLayoutRevision &value)
+{
+    previous = value;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 quint8 VLayoutGenerator::GetMultiplier() const
 {
@@ -55,6 +55,7 @@
 #include <qcompilerdetection.h>
 #include <QList>
 #include <QMetaObject>
+#include <QMutex>
 #include <QObject>
 #include <QString>
 #include <QVector>
@@ -64,6 +65,7 @@
 
 #include "vbank.h"
 #include "vlayoutdef.h"
+#include "vlayoutpiece.h"
 
 class QMarginsF;
 
@@ -74,7 +76,42 @@ class QMarginsF;
 #endif
 
 class QGraphicsItem;
+class VLayoutAttempt;
 class VLayoutPaper;
+class VNfpCache;
+
+/**
+ * @brief The VLayoutVariant struct keeps options that differ between attempts of the best of N layout.
+ */
+struct VLayoutVariant
+{
+    VLayoutVariant()
+        : caseType(Cases::CaseDesc), shift(0), rotationIncrease(180), seed(0)
+    {}
+
+    Cases   caseType;
+    quint32 shift;
+    int     rotationIncrease;
+    /** @brief seed order of details, see VBank::SetSeed(). */
+    quint32 seed;
+};
+
+/**
+ * @brief The VLayoutRevision struct keeps a finished layout, so the next generation can start from it.
+ *
+ * Sheets are saved before gathering strips and uniting pages, as they were arranged.
+ */
+struct VLayoutRevision
+{
+    VLayoutRevision()
+        : details(), pageWidth(0), pageHeight(0), layoutWidth(0)
+    {}
+
+    QVector<QVector<VLayoutPiece>> details;
+    int   pageWidth;
+    int   pageHeight;
+    qreal layoutWidth;
+};
 
 class VLayoutGenerator :public QObject
 {
@@ -134,6 +171,27 @@ class VLayoutGenerator :public QObject
     bool IsTestAsPaths() const;
     void SetTestAsPaths(bool value);
 
+    LayoutEngine GetEngine() const;
+    void         SetEngine(LayoutEngine value);
+
+    int  GetAttempts() const;
+    void SetAttempts(int value);
+
+    int  GetTimeBudget() const;
+    void SetTimeBudget(int value);
+
+    bool IsIncremental() const;
+    void SetIncremental(bool value);
+
+    int  GetIncrementalThreshold() const;
+    void SetIncrementalThreshold(int value);
+
+    bool IsPollingWait() const;
+    void SetPollingWait(bool value);
+
+    VLayoutRevision GetRevision() const;
+    void            SetPreviousRevision(const VLayoutRevision &value);
+
 signals:
     void Start();
     void Arranged(int count);
@@ -145,6 +203,7 @@ public slots:
 
 private:
     Q_DISABLE_COPY(VLayoutGenerator)
+    friend class VLayoutAttempt;
     QVector<VLayoutPaper> papers;
     VBank *bank;
     qreal paperHeight;
@@ -163,6 +222,31 @@ public slots:
     quint8 multiplier;
     bool stripOptimization;
     bool textAsPaths;
+    LayoutEngine engine;
+    VNfpCache *nfpCache;
+    int attempts;
+    int timeBudget;
+    int progress;
+    QMutex progressMutex;
+    bool incremental;
+    int incrementalThreshold;
+    bool pollingWait;
+    VLayoutRevision previous;
+    VLayoutRevision revision;
+
+    LayoutErrors GeneratePapers(VBank *detailsBank, VNfpCache *cache, const VLayoutVariant &variant, int workersCount,
+                                std::atomic_bool &stop, QVector<VLayoutPaper> &result, bool &stripEnabled);
+    LayoutErrors GenerateBestOf();
+    bool         GenerateIncremental(LayoutErrors &result);
+    void         ArrangeOnPaper(VBank *detailsBank, VLayoutPaper &paper, std::atomic_bool &stop);
+    VLayoutPaper NewPaper(int height, int width, const VLayoutVariant &variant, int workersCount,
+                          VNfpCache *cache, quint32 index) const;
+    int          SheetHeight(VBank *detailsBank, bool &stripEnabled) const;
+    QVector<VLayoutVariant> Variants() const;
+    void ReportProgress(int arranged);
+
+    static bool IsBetterLayout(const QVector<VLayoutPaper> &layout, const QVector<VLayoutPaper> &best);
+    static qreal Utilization(const QVector<QVector<VLayoutPiece>> &details, int width);
 
     int PageHeight() const;
     int PageWidth() const;
@@ -70,8 +70,19 @@
 #include "vcontour.h"
 #include "vlayoutpiece.h"
 #include "vlayoutpaper_p.h"
+#include "vnfpcache.h"
+#include "vnfpnester.h"
 #include "vposition.h"
 
+namespace
+{
+// How often (in ms) the GUI event loop gets a chance to run while the candidate search is in progress.
+const int layoutEventsTimeout = 20;
+
+// Sleep between checks of the old polling wait, see VLayoutPaper::SetPollingWait().
+const int layoutPollingSleep = 250;
+}
+
 #ifdef Q_COMPILER_RVALUE_REFS
 VLayoutPaper &VLayoutPaper::operator=(VLayoutPaper &&paper) Q_DECL_NOTHROW { Swap(paper); return *this; }
 #endif
@@ -212,6 +223,61 @@ void VLayoutPaper::SetPaperIndex(quint32 index)
     d->paperIndex = index;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+int VLayoutPaper::GetWorkersCount() const
+{
+    return d->workersCount;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetWorkersCount limits threads used to arrange one detail. Several sheets arranged at the same time should
+ * share cores instead of each taking all of them.
+ */
+void VLayoutPaper::SetWorkersCount(int count)
+{
+    d->workersCount = qMax(0, count);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VLayoutPaper::IsPollingWait() const
+{
+    return d->pollingWait;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetPollingWait wait for the candidate search the old way: check the pool and sleep 250 ms until it is idle.
+ * Only for benchmarks to compare with waiting for completion.
+ */
+void VLayoutPaper::SetPollingWait(bool value)
+{
+    d->pollingWait = value;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+LayoutEngine VLayoutPaper::GetEngine() const
+{
+    return d->engine;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetEngine selects the layout engine. NFP engine needs the cache, without it the contour engine is used.
+ */
+void VLayoutPaper::SetEngine(LayoutEngine engine, VNfpCache *nfpCache)
+{
+    d->nfpCache = nfpCache;
+    if (engine == LayoutEngine::Nfp && nfpCache != nullptr)
+    {
+        d->engine = LayoutEngine::Nfp;
+    }
+    else
+    {
+        d->engine = LayoutEngine::Contour;
+    }
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 bool VLayoutPaper::ArrangeDetail(const VLayoutPiece &detail, std::atomic_bool &stop)
 {
@@ -239,9 +305,38 @@ bool VLayoutPaper::ArrangeDetail(const VLayoutPiece &detail, std::atomic_bool &s
 
     d->frame = 0;
 
+    if (d->engine == LayoutEngine::Nfp)
+    {
+        return AddToSheetNfp(detail, stop);
+    }
+
     return AddToSheet(detail, stop);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief AddFixedDetail put the detail on the sheet where its matrix already places it, without any search.
+ *
+ * Only the NFP engine can arrange next details around such a detail, the contour engine keeps one outline of
+ * everything placed and can't have holes in it.
+ * @return false if the sheet doesn't use the NFP engine.
+ */
+bool VLayoutPaper::AddFixedDetail(const VLayoutPiece &detail)
+{
+    if (d->engine != LayoutEngine::Nfp || d->nfpCache == nullptr)
+    {
+        return false;
+    }
+
+    VNfpPlacement placement;
+    placement.shape = d->nfpCache->ShapeId(detail.GetLayoutAllowancePoints()); // Already moved, no own offset
+    placement.angle = 0;
+
+    d->details.append(detail);
+    d->nfpPlacements.append(placement);
+    return true;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 int VLayoutPaper::Count() const
 {
@@ -252,51 +347,63 @@ int VLayoutPaper::Count() const
 bool VLayoutPaper::AddToSheet(const VLayoutPiece &detail, std::atomic_bool &stop)
 {
     VBestSquare bestResult(d->globalContour.GetSize(), d->saveLength);
-    QThreadPool *thread_pool = QThreadPool::globalInstance();
-    thread_pool->setExpiryTimeout(1000);
-    QVector<VPosition *> threads;
 
-    int detailEdgesCount = 0;
+    const int workersCount = d->workersCount > 0 ? d->workersCount : qMax(1, QThread::idealThreadCount());
+    VPositionScheduler scheduler(d->globalContour, detail, &stop, d->localRotate, d->localRotationIncrease,
+                                 d->saveLength, workersCount);
+
+    // Dedicated pool lets us wait exactly for our own tasks instead of polling the global pool.
+    QThreadPool threadPool;
+    threadPool.setMaxThreadCount(workersCount);
+    QVector<VPosition *> threads;
 
-    if (d->globalContour.GetContour().isEmpty())
+    for (int w = 0; w < workersCount; ++w)
     {
-        detailEdgesCount = detail.DetailEdgesCount();
+        VPosition *thread = new VPosition(&scheduler, w);
+        //Info for debug
+        #ifdef LAYOUT_DEBUG
+            thread->setPaperIndex(d->paperIndex);
+            thread->setFrame(d->frame);
+            thread->setDetailsCount(d->details.count());
+            thread->setDetails(d->details);
+        #endif
+
+        thread->setAutoDelete(false);
+        threads.append(thread);
+        threadPool.start(thread);
     }
-    else
+
+    d->frame = d->frame + static_cast<quint32>(scheduler.JobsCount()*3);
+
+    if (d->pollingWait)
     {
-        detailEdgesCount = detail.LayoutEdgesCount();
+        do
+        {
+            QCoreApplication::processEvents();
+            QThread::msleep(layoutPollingSleep);
+        }
+        while (threadPool.activeThreadCount() > 0 && not stop.load());
     }
-
-    for (int j=1; j <= d->globalContour.GlobalEdgesCount(); ++j)
+    else
     {
-        for (int i=1; i<= detailEdgesCount; ++i)
+        // Wait for done. waitForDone() returns as soon as the last task finishes, the timeout only limits how long
+        // the event loop stays blocked.
+        while (not threadPool.waitForDone(layoutEventsTimeout))
         {
-            VPosition *thread = new VPosition(d->globalContour, j, detail, i, &stop, d->localRotate,
-                                              d->localRotationIncrease,
-                                              d->saveLength);
-            //Info for debug
-            #ifdef LAYOUT_DEBUG
-                thread->setPaperIndex(d->paperIndex);
-                thread->setFrame(d->frame);
-                thread->setDetailsCount(d->details.count());
-                thread->setDetails(d->details);
-            #endif
-
-            thread->setAutoDelete(false);
-            threads.append(thread);
-            thread_pool->start(thread);
-
-            d->frame = d->frame + 3 + static_cast<quint32>(360/d->localRotationIncrease*2);
+            QCoreApplication::processEvents();
+
+            if (stop.load())
+            {
+                break;
+            }
         }
     }
 
-    // Wait for done
-    do
+    if (stop.load())
     {
-        QCoreApplication::processEvents();
-        QThread::msleep(250);
+        threadPool.clear(); // Remove not started tasks
     }
-    while(thread_pool->activeThreadCount() > 0 && not stop.load());
+    threadPool.waitForDone(); // Tasks check the stop flag and return quickly
 
     if (stop.load())
     {
@@ -305,6 +412,7 @@ bool VLayoutPaper::AddToSheet(const VLayoutPiece &detail, std::atomic_bool &stop
         return false;
     }
 
+    // Reduce results of all workers. The choice doesn't depend on the order, see VBestSquare::NewResult().
     for (int i=0; i < threads.size(); ++i)
     {
         bestResult.NewResult(threads.at(i)->getBestResult());
@@ -316,6 +424,31 @@ bool VLayoutPaper::AddToSheet(const VLayoutPiece &detail, std::atomic_bool &stop
     return SaveResult(bestResult, detail);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+bool VLayoutPaper::AddToSheetNfp(const VLayoutPiece &detail, std::atomic_bool &stop)
+{
+    const VNfpNester nester(d->nfpCache, d->globalContour.GetWidth(), d->globalContour.GetHeight());
+
+    VLayoutPiece workDetail;
+    VNfpPlacement placement;
+    if (not nester.Arrange(detail, d->nfpPlacements, d->localRotate, d->localRotationIncrease, stop, workDetail,
+                           placement))
+    {
+        return false;
+    }
+
+    d->details.append(workDetail);
+    d->nfpPlacements.append(placement);
+
+#ifdef LAYOUT_DEBUG
+#   ifdef SHOW_BEST
+    VPosition::DrawDebug(d->globalContour, workDetail, UINT_MAX, d->paperIndex, d->details.count(), d->details);
+#   endif
+#endif
+
+    return true;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 bool VLayoutPaper::SaveResult(const VBestSquare &bestResult, const VLayoutPiece &detail)
 {
@@ -396,6 +529,7 @@ QVector<VLayoutPiece> VLayoutPaper::GetDetails() const
 void VLayoutPaper::SetDetails(const QList<VLayoutPiece> &details)
 {
     d->details = details.toVector();
+    d->nfpPlacements.clear(); // Only for output, NFP engine cannot continue arranging such sheet
 }
 
 //---------------------------------------------------------------------------------------------------------------------
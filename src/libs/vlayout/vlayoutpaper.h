@@ -61,6 +61,7 @@
 #include "vlayoutdef.h"
 
 class VBestSquare;
+class VNfpCache;
 class VLayoutPaperData;
 class VLayoutPiece;
 class QGraphicsRectItem;
@@ -108,7 +109,17 @@ class VLayoutPaper
 
     void SetPaperIndex(quint32 index);
 
+    int  GetWorkersCount() const;
+    void SetWorkersCount(int count);
+
+    bool IsPollingWait() const;
+    void SetPollingWait(bool value);
+
+    LayoutEngine GetEngine() const;
+    void         SetEngine(LayoutEngine engine, VNfpCache *nfpCache = nullptr);
+
     bool ArrangeDetail(const VLayoutPiece &detail, std::atomic_bool &stop);
+    bool AddFixedDetail(const VLayoutPiece &detail);
     int  Count() const;
     Q_REQUIRED_RESULT QGraphicsRectItem *GetPaperItem(bool autoCrop, bool textAsPaths) const;
     Q_REQUIRED_RESULT QList<QGraphicsItem *> GetItemDetails(bool textAsPaths) const;
@@ -122,6 +133,7 @@ class VLayoutPaper
     QSharedDataPointer<VLayoutPaperData> d;
 
     bool AddToSheet(const VLayoutPiece &detail, std::atomic_bool &stop);
+    bool AddToSheetNfp(const VLayoutPiece &detail, std::atomic_bool &stop);
 
     bool SaveResult(const VBestSquare &bestResult, const VLayoutPiece &detail);
 
@@ -58,6 +58,8 @@
 
 #include "vlayoutpiece.h"
 #include "vcontour.h"
+#include "vlayoutdef.h"
+#include "vnfpnester.h"
 
 QT_WARNING_PUSH
 QT_WARNING_DISABLE_GCC("-Weffc++")
@@ -76,7 +78,12 @@ class VLayoutPaperData : public QSharedData
           localRotate(true),
           globalRotationIncrease(180),
           localRotationIncrease(180),
-          saveLength(false)
+          saveLength(false),
+          workersCount(0),
+          pollingWait(false),
+          engine(LayoutEngine::Contour),
+          nfpCache(nullptr),
+          nfpPlacements()
     {}
 
     VLayoutPaperData(int height,
@@ -90,7 +97,12 @@ class VLayoutPaperData : public QSharedData
           localRotate(true),
           globalRotationIncrease(180),
           localRotationIncrease(180),
-          saveLength(false)
+          saveLength(false),
+          workersCount(0),
+          pollingWait(false),
+          engine(LayoutEngine::Contour),
+          nfpCache(nullptr),
+          nfpPlacements()
     {}
 
     VLayoutPaperData(const VLayoutPaperData &paper)
@@ -104,7 +116,12 @@ class VLayoutPaperData : public QSharedData
           localRotate(paper.localRotate),
           globalRotationIncrease(paper.globalRotationIncrease),
           localRotationIncrease(paper.localRotationIncrease),
-          saveLength(paper.saveLength)
+          saveLength(paper.saveLength),
+          workersCount(paper.workersCount),
+          pollingWait(paper.pollingWait),
+          engine(paper.engine),
+          nfpCache(paper.nfpCache),
+          nfpPlacements(paper.nfpPlacements)
     {}
 
     ~VLayoutPaperData() {}
@@ -124,6 +141,20 @@ class VLayoutPaperData : public QSharedData
     int localRotationIncrease;
     bool saveLength;
 
+    /** @brief workersCount threads for the candidate search, 0 means one per core. */
+    int workersCount;
+
+    /** @brief pollingWait wait for the candidate search the old way, see VLayoutPaper::SetPollingWait(). */
+    bool pollingWait;
+
+    LayoutEngine engine;
+
+    /** @brief nfpCache no-fit polygons shared by all sheets of a layout, owned by the generator. */
+    VNfpCache *nfpCache;
+
+    /** @brief nfpPlacements how NFP engine placed each of details, in the same order. */
+    QVector<VNfpPlacement> nfpPlacements;
+
 private:
     VLayoutPaperData& operator=(const VLayoutPaperData&) Q_DECL_EQ_DELETE;
 };
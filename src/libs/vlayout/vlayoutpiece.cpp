@@ -62,6 +62,9 @@
 #include <QPainterPath>
 #include <QPoint>
 #include <QPolygonF>
+#include <QRunnable>
+#include <QScopedPointer>
+#include <QThreadPool>
 #include <QTransform>
 #include <Qt>
 #include <QtDebug>
@@ -71,6 +74,7 @@
 #include "../vmisc/vmath.h"
 #include "../vmisc/vabstractapplication.h"
 #include "../vpatterndb/calculator.h"
+#include "../vpatterndb/vpiecegeometry.h"
 #include "../vgeometry/vpointf.h"
 #include "vlayoutdef.h"
 #include "vlayoutpiece_p.h"
@@ -80,7 +84,8 @@
 namespace
 {
 //---------------------------------------------------------------------------------------------------------------------
-QVector<VLayoutPiecePath> ConvertInternalPaths(const VPiece &piece, const VContainer *pattern)
+QVector<VLayoutPiecePath> ConvertInternalPaths(const VPiece &piece, const VPieceGeometry &geometry,
+                                               const VContainer *pattern)
 {
     SCASSERT(pattern != nullptr)
 
@@ -88,10 +93,11 @@ QVector<VLayoutPiecePath> ConvertInternalPaths(const VPiece &piece, const VConta
     const QVector<quint32> pathsId = piece.GetInternalPaths();
     for (int i = 0; i < pathsId.size(); ++i)
     {
-        const VPiecePath path = pattern->GetPiecePath(pathsId.at(i));
-        if (path.GetType() == PiecePathType::InternalPath)
+        if (geometry.internalPaths.contains(pathsId.at(i)))
         {
-            paths.append(VLayoutPiecePath(path.PathPoints(pattern), path.IsCutPath(), path.GetPenType()));
+            const VPiecePath path = pattern->GetPiecePath(pathsId.at(i));
+            paths.append(VLayoutPiecePath(geometry.internalPaths.value(pathsId.at(i)), path.IsCutPath(),
+                                          path.GetPenType()));
         }
     }
     return paths;
@@ -363,6 +369,60 @@ QStringList PieceLabelText(const QVector<QPointF> &labelShape, const VTextManage
     }
     return text;
 }
+
+//---------------------------------------------------------------------------------------------------------------------
+void TranslatePoints(QVector<QPointF> &points, qreal dx, qreal dy)
+{
+    const QPointF offset(dx, dy);
+    for (int i = 0; i < points.size(); ++i)
+    {
+        points[i] += offset;
+    }
+}
+
+/**
+ * @brief The VCreatePieceTask class makes one layout piece in a thread pool.
+ */
+class VCreatePieceTask : public QRunnable
+{
+public:
+    VCreatePieceTask(const VLayoutPieceSource &source, const VLayoutPieceContext &context)
+        : source(source),
+          context(context),
+          result(),
+          error()
+    {}
+
+    virtual void run() Q_DECL_OVERRIDE
+    {
+        try
+        {
+            result = VLayoutPiece::Create(source.piece, source.id, source.pattern, context);
+        }
+        catch (const VException &e)
+        {
+            error.reset(e.clone());
+        }
+    }
+
+    const VLayoutPiece &Result() const
+    {
+        return result;
+    }
+
+    const VException *Error() const
+    {
+        return error.data();
+    }
+
+private:
+    Q_DISABLE_COPY(VCreatePieceTask)
+
+    const VLayoutPieceSource   source;
+    const VLayoutPieceContext &context;
+    VLayoutPiece               result;
+    QScopedPointer<VException> error;
+};
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -403,18 +463,66 @@ VLayoutPiece::~VLayoutPiece()
 {}
 
 //---------------------------------------------------------------------------------------------------------------------
-VLayoutPiece VLayoutPiece::Create(const VPiece &piece, const VContainer *pattern)
+/**
+ * @brief CaptureContext read everything Create() needs from the application and the document. Call on GUI thread.
+ * @param doc the document.
+ */
+VLayoutPieceContext VLayoutPiece::CaptureContext(VAbstractPattern *doc)
+{
+    SCASSERT(doc != nullptr)
+
+    VLayoutPieceContext context;
+    context.labelFont = qApp->Settings()->getLabelFont();
+    context.showSecondNotch = qApp->Settings()->showSecondNotch();
+    context.placeholders = VTextManager::PatternPlaceholders(doc);
+
+    VTextManager tm;
+    tm.Update(doc);
+    context.patternLabelLines = tm.GetAllSourceLines();
+
+    return context;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief CaptureContext read context for pieces of an evaluation, see VContainer::SetGradation(). Labels show size and
+ * height of the evaluation instead of the current ones. Call on GUI thread.
+ * @param doc the document.
+ * @param gradation size and height of the evaluation.
+ */
+VLayoutPieceContext VLayoutPiece::CaptureContext(VAbstractPattern *doc, const VGradation &gradation)
+{
+    VLayoutPieceContext context = CaptureContext(doc);
+    context.placeholders.insert(pl_size, QString::number(gradation.size));
+    context.placeholders.insert(pl_height, QString::number(gradation.height));
+    context.patternLabelLines = VTextManager::PatternLabelLines(doc, context.placeholders);
+
+    return context;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Create make layout piece. Uses only the container and the context, so pieces can be created in parallel.
+ * @param piece the piece.
+ * @param id id of the piece.
+ * @param pattern container the piece is built in.
+ * @param context see CaptureContext().
+ */
+VLayoutPiece VLayoutPiece::Create(const VPiece &piece, quint32 id, const VContainer *pattern,
+                                  const VLayoutPieceContext &context)
 {
     VLayoutPiece det;
 
+    det.SetId(id);
     det.SetMx(piece.GetMx());
     det.SetMy(piece.GetMy());
 
-    det.SetCountourPoints(piece.MainPathPoints(pattern), piece.IsHideMainPath());
-    det.SetSeamAllowancePoints(piece.SeamAllowancePoints(pattern), piece.IsSeamAllowance(),
+    const VPieceGeometry geometry = pattern->GetPieceGeometry(id, piece, context.showSecondNotch);
+    det.SetCountourPoints(geometry.mainPathPoints, piece.IsHideMainPath());
+    det.SetSeamAllowancePoints(geometry.seamAllowancePoints, piece.IsSeamAllowance(),
                                piece.IsSeamAllowanceBuiltIn());
-    det.SetInternalPaths(ConvertInternalPaths(piece, pattern));
-    det.setNotches(piece.createNotchLines(pattern));
+    det.SetInternalPaths(ConvertInternalPaths(piece, geometry, pattern));
+    det.setNotches(geometry.notches);
 
     det.SetName(piece.GetName());
 
@@ -427,14 +535,13 @@ VLayoutPiece VLayoutPiece::Create(const VPiece &piece, const VContainer *pattern
     const VPieceLabelData& data = piece.GetPatternPieceData();
     if (data.IsVisible() == true)
     {
-        det.SetPieceText(piece.GetName(), data, qApp->Settings()->getLabelFont(), pattern);
+        det.SetPieceText(piece.GetName(), data, context.labelFont, context.placeholders, pattern);
     }
 
     const VPatternLabelData& geom = piece.GetPatternInfo();
     if (geom.IsVisible() == true)
     {
-        VAbstractPattern* pDoc = qApp->getCurrentDocument();
-        det.SetPatternInfo(pDoc, geom, qApp->Settings()->getLabelFont(), pattern);
+        det.SetPatternInfo(context.patternLabelLines, geom, context.labelFont, pattern);
     }
 
     const VGrainlineData& grainlineGeom = piece.GetGrainlineGeometry();
@@ -443,17 +550,69 @@ VLayoutPiece VLayoutPiece::Create(const VPiece &piece, const VContainer *pattern
         det.SetGrainline(grainlineGeom, pattern);
     }
 
-    det.SetSAWidth(qApp->toPixel(piece.GetSAWidth()));
+    det.SetSAWidth(ToPixel(piece.GetSAWidth(), *pattern->GetPatternUnit()));
     det.SetForbidFlipping(piece.IsForbidFlipping());
 
     return det;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief CreateInParallel make layout pieces in a thread pool.
+ * @param sources pieces to make layout pieces from.
+ * @param context see CaptureContext().
+ * @return layout pieces in the order of sources. If making any of them has failed, the error of the first such source
+ * is rethrown.
+ */
+QVector<VLayoutPiece> VLayoutPiece::CreateInParallel(const QVector<VLayoutPieceSource> &sources,
+                                                     const VLayoutPieceContext &context)
+{
+    QVector<VCreatePieceTask *> tasks;
+    tasks.reserve(sources.size());
+    for (int i = 0; i < sources.size(); ++i)
+    {
+        VCreatePieceTask *task = new VCreatePieceTask(sources.at(i), context);
+        task->setAutoDelete(false);
+        tasks.append(task);
+    }
+
+    QThreadPool threadPool;
+    for (int i = 0; i < tasks.size(); ++i)
+    {
+        threadPool.start(tasks.at(i));
+    }
+    threadPool.waitForDone();
+
+    // Collect in the order of tasks, so the result doesn't depend on which task has finished first
+    QScopedPointer<VException> error;
+    QVector<VLayoutPiece> pieces;
+    pieces.reserve(tasks.size());
+    for (int i = 0; i < tasks.size(); ++i)
+    {
+        if (tasks.at(i)->Error() != nullptr)
+        {
+            error.reset(tasks.at(i)->Error()->clone());
+            break;
+        }
+        pieces.append(tasks.at(i)->Result());
+    }
+
+    qDeleteAll(tasks.begin(), tasks.end());
+
+    if (not error.isNull())
+    {
+        error->raise();
+    }
+
+    return pieces;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 // cppcheck-suppress unusedFunction
 QVector<QPointF> VLayoutPiece::GetContourPoints() const
 {
-    return Map(d->contour);
+    PrepareGeometry();
+    return d->mappedContour;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -461,13 +620,15 @@ void VLayoutPiece::SetCountourPoints(const QVector<QPointF> &points, bool hideMa
 {
     d->contour = RemoveDublicates(points, false);
     SetHideMainPath(hideMainPath);
+    InvalidateGeometry();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 // cppcheck-suppress unusedFunction
 QVector<QPointF> VLayoutPiece::GetSeamAllowancePoints() const
 {
-    return Map(d->seamAllowance);
+    PrepareGeometry();
+    return d->mappedSeamAllowance;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -487,13 +648,15 @@ void VLayoutPiece::SetSeamAllowancePoints(const QVector<QPointF> &points, bool s
             qWarning()<<"Seam allowance is empty.";
             SetSeamAllowance(false);
         }
+        InvalidateGeometry();
     }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 QVector<QPointF> VLayoutPiece::GetLayoutAllowancePoints() const
 {
-    return Map(d->layoutAllowance);
+    PrepareGeometry();
+    return d->mappedLayoutAllowance;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -517,7 +680,7 @@ QStringList VLayoutPiece::GetPieceText() const
 
 //---------------------------------------------------------------------------------------------------------------------
 void VLayoutPiece::SetPieceText(const QString& qsName, const VPieceLabelData& data, const QFont &font,
-                                const VContainer *pattern)
+                                const QMap<QString, QString> &placeholders, const VContainer *pattern)
 {
     QPointF ptPos;
     qreal labelWidth = 0;
@@ -551,7 +714,7 @@ void VLayoutPiece::SetPieceText(const QString& qsName, const VPieceLabelData& da
     // generate text
     d->m_tmDetail.SetFont(font);
     d->m_tmDetail.SetFontSize(data.GetFontSize());
-    d->m_tmDetail.Update(qsName, data);
+    d->m_tmDetail.Update(qsName, data, placeholders);
     // this will generate the lines of text
     d->m_tmDetail.SetFontSize(data.GetFontSize());
     d->m_tmDetail.FitFontSize(labelWidth, labelHeight);
@@ -577,7 +740,7 @@ QStringList VLayoutPiece::GetPatternText() const
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-void VLayoutPiece::SetPatternInfo(VAbstractPattern* pDoc, const VPatternLabelData& geom, const QFont &font,
+void VLayoutPiece::SetPatternInfo(const QList<TextLine> &lines, const VPatternLabelData& geom, const QFont &font,
                                   const VContainer *pattern)
 {
     QPointF ptPos;
@@ -611,7 +774,7 @@ void VLayoutPiece::SetPatternInfo(VAbstractPattern* pDoc, const VPatternLabelDat
     d->m_tmPattern.SetFont(font);
     d->m_tmPattern.SetFontSize(geom.GetFontSize());
 
-    d->m_tmPattern.Update(pDoc);
+    d->m_tmPattern.SetSourceLines(lines);
 
     // generate lines of text
     d->m_tmPattern.SetFontSize(geom.GetFontSize());
@@ -667,6 +830,22 @@ QVector<QPointF> VLayoutPiece::GetGrainline() const
     return Map(d->grainlinePoints);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+quint32 VLayoutPiece::GetId() const
+{
+    return d->id;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetId remember the pattern piece this detail belongs to. Incremental layout uses it to find the detail in
+ * the previous layout.
+ */
+void VLayoutPiece::SetId(quint32 id)
+{
+    d->id = id;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 QTransform VLayoutPiece::GetMatrix() const
 {
@@ -676,7 +855,11 @@ QTransform VLayoutPiece::GetMatrix() const
 //---------------------------------------------------------------------------------------------------------------------
 void VLayoutPiece::SetMatrix(const QTransform &matrix)
 {
-    d->matrix = matrix;
+    if (d->matrix != matrix)
+    {
+        d->matrix = matrix;
+        InvalidateGeometry();
+    }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -697,6 +880,16 @@ void VLayoutPiece::Translate(qreal dx, qreal dy)
     QTransform m;
     m.translate(dx, dy);
     d->matrix *= m;
+
+    if (d->mappedValid)
+    {// Translation doesn't change the shape, shifting the cached geometry is enough
+        TranslatePoints(d->mappedContour, dx, dy);
+        TranslatePoints(d->mappedSeamAllowance, dx, dy);
+        TranslatePoints(d->mappedLayoutAllowance, dx, dy);
+        d->contourRect.translate(dx, dy);
+        d->seamAllowanceRect.translate(dx, dy);
+        d->layoutAllowanceRect.translate(dx, dy);
+    }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -707,6 +900,7 @@ void VLayoutPiece::Rotate(const QPointF &originPoint, qreal degrees)
     m.rotate(-degrees);
     m.translate(-originPoint.x(), -originPoint.y());
     d->matrix *= m;
+    InvalidateGeometry();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -740,6 +934,32 @@ void VLayoutPiece::Mirror(const QLineF &edge)
     d->matrix *= m;
 
     d->mirror = !d->mirror;
+    InvalidateGeometry();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief PrepareGeometry maps contour, seam allowance and layout allowance for current transformation once. All
+ * getters of transformed geometry reuse the result until the next transformation.
+ *
+ * Const getters call it lazily. Call it explicitly before sharing the piece between threads.
+ */
+void VLayoutPiece::PrepareGeometry() const
+{
+    if (d->mappedValid)
+    {
+        return;
+    }
+
+    d->mappedContour = Map(d->contour);
+    d->mappedSeamAllowance = Map(d->seamAllowance);
+    d->mappedLayoutAllowance = Map(d->layoutAllowance);
+
+    d->contourRect = BoundingRect(d->mappedContour);
+    d->seamAllowanceRect = BoundingRect(d->mappedSeamAllowance);
+    d->layoutAllowanceRect = BoundingRect(d->mappedLayoutAllowance);
+
+    d->mappedValid = true;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -757,50 +977,48 @@ int VLayoutPiece::LayoutEdgesCount() const
 //---------------------------------------------------------------------------------------------------------------------
 QLineF VLayoutPiece::DetailEdge(int i) const
 {
-    return Edge(DetailPath(), i);
+    return Edge(MappedDetailPath(), i);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 QLineF VLayoutPiece::LayoutEdge(int i) const
 {
-    return Edge(d->layoutAllowance, i);
+    PrepareGeometry();
+    return Edge(d->mappedLayoutAllowance, i);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 int VLayoutPiece::DetailEdgeByPoint(const QPointF &p1) const
 {
-    return EdgeByPoint(DetailPath(), p1);
+    return EdgeByPoint(MappedDetailPath(), p1);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 int VLayoutPiece::LayoutEdgeByPoint(const QPointF &p1) const
 {
-    return EdgeByPoint(d->layoutAllowance, p1);
+    PrepareGeometry();
+    return EdgeByPoint(d->mappedLayoutAllowance, p1);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 QRectF VLayoutPiece::DetailBoundingRect() const
 {
-    QVector<QPointF> points;
+    PrepareGeometry();
     if (IsSeamAllowance() && not IsSeamAllowanceBuiltIn())
     {
-        points = GetSeamAllowancePoints();
+        return d->seamAllowanceRect;
     }
     else
     {
-        points = GetContourPoints();
+        return d->contourRect;
     }
-
-    points.append(points.first());
-    return QPolygonF(points).boundingRect();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 QRectF VLayoutPiece::LayoutBoundingRect() const
 {
-    QVector<QPointF> points = GetLayoutAllowancePoints();
-    points.append(points.first());
-    return QPolygonF(points).boundingRect();
+    PrepareGeometry();
+    return d->layoutAllowanceRect;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -830,6 +1048,20 @@ bool VLayoutPiece::isNull() const
     }
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief IsSameShape compare untransformed outlines. Labels, notches and internal paths lie inside the piece and
+ * don't matter for the layout.
+ */
+bool VLayoutPiece::IsSameShape(const VLayoutPiece &detail) const
+{
+    return IsSeamAllowance() == detail.IsSeamAllowance()
+            && IsSeamAllowanceBuiltIn() == detail.IsSeamAllowanceBuiltIn()
+            && IsForbidFlipping() == detail.IsForbidFlipping()
+            && d->contour == detail.d->contour
+            && d->seamAllowance == detail.d->seamAllowance;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 qint64 VLayoutPiece::Square() const
 {
@@ -870,6 +1102,7 @@ void VLayoutPiece::SetLayoutAllowancePoints()
     {
         d->layoutAllowance.clear();
     }
+    InvalidateGeometry();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -1208,57 +1441,71 @@ bool VLayoutPiece::IsMirror() const
 //---------------------------------------------------------------------------------------------------------------------
 void VLayoutPiece::SetMirror(bool value)
 {
-    d->mirror = value;
+    if (d->mirror != value)
+    {
+        d->mirror = value;
+        InvalidateGeometry();
+    }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-QLineF VLayoutPiece::Edge(const QVector<QPointF> &path, int i) const
+/**
+ * @brief MappedDetailPath returns transformed seam allowance if the piece uses it for layout, otherwise contour.
+ */
+const QVector<QPointF> &VLayoutPiece::MappedDetailPath() const
 {
-    if (i < 1 || i > path.count())
-    { // Doesn't exist such edge
-        return QLineF();
-    }
-
-    int i1, i2;
-    if (i < path.count())
+    PrepareGeometry();
+    if (IsSeamAllowance() && not IsSeamAllowanceBuiltIn())
     {
-        i1 = i-1;
-        i2 = i;
+        return d->mappedSeamAllowance;
     }
     else
     {
-        i1 = path.count()-1;
-        i2 = 0;
+        return d->mappedContour;
     }
+}
 
-    if (d->mirror)
+//---------------------------------------------------------------------------------------------------------------------
+void VLayoutPiece::InvalidateGeometry()
+{
+    d->mappedValid = false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Edge returns edge i of already transformed points. Transformed points of a mirrored piece are already
+ * reversed, so edges keep the same direction as for unmirrored piece.
+ */
+QLineF VLayoutPiece::Edge(const QVector<QPointF> &points, int i)
+{
+    if (i < 1 || i > points.count())
+    { // Doesn't exist such edge
+        return QLineF();
+    }
+
+    if (i < points.count())
     {
-        const int oldI1 = i1;
-        const int size = path.size()-1; //-V807
-        i1 = size - i2;
-        i2 = size - oldI1;
-        return QLineF(d->matrix.map(path.at(i2)), d->matrix.map(path.at(i1)));
+        return QLineF(points.at(i-1), points.at(i));
     }
     else
     {
-        return QLineF(d->matrix.map(path.at(i1)), d->matrix.map(path.at(i2)));
+        return QLineF(points.last(), points.first());
     }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-int VLayoutPiece::EdgeByPoint(const QVector<QPointF> &path, const QPointF &p1) const
+int VLayoutPiece::EdgeByPoint(const QVector<QPointF> &points, const QPointF &p1)
 {
     if (p1.isNull())
     {
         return 0;
     }
 
-    if (path.count() < 3)
+    if (points.count() < 3)
     {
         return 0;
     }
 
-    const QVector<QPointF> points = Map(path);
     for (int i=0; i < points.size(); i++)
     {
         if (points.at(i) == p1)
@@ -1268,3 +1515,13 @@ int VLayoutPiece::EdgeByPoint(const QVector<QPointF> &path, const QPointF &p1) c
     }
     return 0; // Did not find edge
 }
+
+//---------------------------------------------------------------------------------------------------------------------
+QRectF VLayoutPiece::BoundingRect(const QVector<QPointF> &points)
+{
+    if (points.isEmpty())
+    {
+        return QRectF();
+    }
+    return QPolygonF(points).boundingRect();
+}
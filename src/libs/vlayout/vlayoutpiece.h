@@ -54,7 +54,10 @@
 
 #include <qcompilerdetection.h>
 #include <QDate>
+#include <QFont>
 #include <QLineF>
+#include <QList>
+#include <QMap>
 #include <QMatrix>
 #include <QPointF>
 #include <QRectF>
@@ -69,6 +72,7 @@
 #include "../vpatterndb/floatItemData/vpiecelabeldata.h"
 #include "../vpatterndb/vcontainer.h"
 #include "vabstractpiece.h"
+#include "vtextmanager.h"
 
 class VLayoutPieceData;
 class VLayoutPiecePath;
@@ -76,6 +80,29 @@ class QGraphicsItem;
 class QGraphicsPathItem;
 class VTextManager;
 
+/**
+ * @brief The VLayoutPieceContext struct settings and document data labels of pieces are made of. Capture it on GUI
+ * thread, after that VLayoutPiece::Create() can run in any thread.
+ */
+struct VLayoutPieceContext
+{
+    QFont                  labelFont{};
+    /** @brief placeholders label placeholders of the pattern. */
+    QMap<QString, QString> placeholders{};
+    QList<TextLine>        patternLabelLines{};
+    bool                   showSecondNotch{true};
+};
+
+/**
+ * @brief The VLayoutPieceSource struct a piece VLayoutPiece::CreateInParallel() makes layout piece from.
+ */
+struct VLayoutPieceSource
+{
+    VPiece            piece{};
+    quint32           id{NULL_ID};
+    const VContainer *pattern{nullptr};
+};
+
 class VLayoutPiece :public VAbstractPiece
 {
     Q_DECLARE_TR_FUNCTIONS(VLayoutPiece)
@@ -93,7 +120,15 @@ class VLayoutPiece :public VAbstractPiece
 
 	  void                      Swap(VLayoutPiece &detail) Q_DECL_NOTHROW;
 
-    static VLayoutPiece       Create(const VPiece &piece, const VContainer *pattern);
+    static VLayoutPieceContext CaptureContext(VAbstractPattern *doc);
+    static VLayoutPieceContext CaptureContext(VAbstractPattern *doc, const VGradation &gradation);
+    static VLayoutPiece       Create(const VPiece &piece, quint32 id, const VContainer *pattern,
+                                     const VLayoutPieceContext &context);
+    static QVector<VLayoutPiece> CreateInParallel(const QVector<VLayoutPieceSource> &sources,
+                                                  const VLayoutPieceContext &context);
+
+    quint32                   GetId() const;
+    void                      SetId(quint32 id);
 
     QVector<QPointF>          GetContourPoints() const;
     void                      SetCountourPoints(const QVector<QPointF> &points, bool hideMainPath = false);
@@ -115,11 +150,12 @@ class VLayoutPiece :public VAbstractPiece
     QPointF                   GetPieceTextPosition() const;
     QStringList               GetPieceText() const;
     void                      SetPieceText(const QString &qsName, const VPieceLabelData& data,
-                                           const QFont& font,  const VContainer *pattern);
+                                           const QFont& font, const QMap<QString, QString> &placeholders,
+                                           const VContainer *pattern);
 
     QPointF                   GetPatternTextPosition() const;
     QStringList               GetPatternText() const;
-    void                      SetPatternInfo(VAbstractPattern *pDoc, const VPatternLabelData& geom,
+    void                      SetPatternInfo(const QList<TextLine> &lines, const VPatternLabelData& geom,
                                              const QFont& font, const VContainer *pattern);
 
     void                      SetGrainline(const VGrainlineData& geom, const VContainer *pattern);
@@ -138,6 +174,8 @@ class VLayoutPiece :public VAbstractPiece
     void                      Rotate(const QPointF &originPoint, qreal degrees);
     void                      Mirror(const QLineF &edge);
 
+    void                      PrepareGeometry() const;
+
     int                       DetailEdgesCount() const;
     int                       LayoutEdgesCount() const;
 
@@ -152,6 +190,7 @@ class VLayoutPiece :public VAbstractPiece
     qreal                     Diagonal() const;
 
     bool                      isNull() const;
+    bool                      IsSameShape(const VLayoutPiece &detail) const;
     qint64                    Square() const;
     QPainterPath              ContourPath() const;
 
@@ -175,8 +214,12 @@ class VLayoutPiece :public VAbstractPiece
     template <class T>
     QVector<T>                           Map(const QVector<T> &points) const;
 
-    QLineF                               Edge(const QVector<QPointF> &path, int i) const;
-    int                                  EdgeByPoint(const QVector<QPointF> &path, const QPointF &p1) const;
+    const QVector<QPointF>              &MappedDetailPath() const;
+    void                                 InvalidateGeometry();
+
+    static QLineF                        Edge(const QVector<QPointF> &points, int i);
+    static int                           EdgeByPoint(const QVector<QPointF> &points, const QPointF &p1);
+    static QRectF                        BoundingRect(const QVector<QPointF> &points);
 };
 
 Q_DECLARE_TYPEINFO(VLayoutPiece, Q_MOVABLE_TYPE);
@@ -54,6 +54,7 @@
 
 #include <QSharedData>
 #include <QPointF>
+#include <QRectF>
 #include <QVector>
 #include <QTransform>
 
@@ -85,7 +86,15 @@ class VLayoutPieceData : public QSharedData
           patternInfo(),
           grainlinePoints(),
           m_tmDetail(),
-          m_tmPattern()
+          m_tmPattern(),
+          id(NULL_ID),
+          mappedValid(false),
+          mappedContour(),
+          mappedSeamAllowance(),
+          mappedLayoutAllowance(),
+          contourRect(),
+          seamAllowanceRect(),
+          layoutAllowanceRect()
     {}
 
     VLayoutPieceData(const VLayoutPieceData &detail)
@@ -102,7 +111,15 @@ class VLayoutPieceData : public QSharedData
           patternInfo(detail.patternInfo),
           grainlinePoints(detail.grainlinePoints),
           m_tmDetail(detail.m_tmDetail),
-          m_tmPattern(detail.m_tmPattern)
+          m_tmPattern(detail.m_tmPattern),
+          id(detail.id),
+          mappedValid(detail.mappedValid),
+          mappedContour(detail.mappedContour),
+          mappedSeamAllowance(detail.mappedSeamAllowance),
+          mappedLayoutAllowance(detail.mappedLayoutAllowance),
+          contourRect(detail.contourRect),
+          seamAllowanceRect(detail.seamAllowanceRect),
+          layoutAllowanceRect(detail.layoutAllowanceRect)
     {}
 
     ~VLayoutPieceData() {}
@@ -120,6 +137,20 @@ class VLayoutPieceData : public QSharedData
     QVector<QPointF>           grainlinePoints;    //! @brief grainlineInfo line
     VTextManager               m_tmDetail;         //! @brief m_tmDetail text manager for laying out detail info
     VTextManager               m_tmPattern;        //! @brief m_tmPattern text manager for laying out pattern info */
+    quint32                    id;                 //! @brief id of the pattern piece the detail was created from.
+
+    /**
+     * Contour, seam allowance and layout allowance mapped through matrix (and reversed for mirror). Filled lazily
+     * by const getters, so a piece shared between threads must be prepared with VLayoutPiece::PrepareGeometry()
+     * first.
+     */
+    mutable bool               mappedValid;
+    mutable QVector<QPointF>   mappedContour;
+    mutable QVector<QPointF>   mappedSeamAllowance;
+    mutable QVector<QPointF>   mappedLayoutAllowance;
+    mutable QRectF             contourRect;
+    mutable QRectF             seamAllowanceRect;
+    mutable QRectF             layoutAllowanceRect;
 
 private:
     VLayoutPieceData &operator=(const VLayoutPieceData &) Q_DECL_EQ_DELETE;
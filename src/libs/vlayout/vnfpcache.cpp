@@ -0,0 +1,640 @@
+/***************************************************************************
+ *                                                                         *
+ *   @file   vnfpcache.cpp                                                 *
+ *   @author Seamly2D project                                              *
+ *   @date   10.16.2026                                                    *
+ *   Copyright (C) 2017  Seamly, LLC                                       *
+ *                                                                         *
+ *   https://github.com/fashionfreedom/seamly2d                            *
+ *                                                                         *
+ ***************************************************************************
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **************************************************************************/
+
+#include "vnfpcache.h"
+#include "vcollisionpolygon.h"
+
+#include <QLineF>
+#include <QTransform>
+#include <QtAlgorithms>
+#include <algorithm>
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+inline qreal Cross(const QPointF &o, const QPointF &a, const QPointF &b)
+{
+    return (a.x() - o.x())*(b.y() - o.y()) - (a.y() - o.y())*(b.x() - o.x());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+inline qreal Cross(const QPointF &a, const QPointF &b)
+{
+    return a.x()*b.y() - a.y()*b.x();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool LessXY(const QPointF &p1, const QPointF &p2)
+{
+    return p1.x() < p2.x() || (qFuzzyCompare(p1.x(), p2.x()) && p1.y() < p2.y());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief StartFromLowest rotates the order of a convex polygon so that it begins from the vertex with the lowest y
+ * (and the lowest x among them). Edges then follow in increasing polar angle.
+ */
+QVector<QPointF> StartFromLowest(const QVector<QPointF> &polygon)
+{
+    int start = 0;
+    for (int i = 1; i < polygon.size(); ++i)
+    {
+        const QPointF &p = polygon.at(i);
+        const QPointF &s = polygon.at(start);
+        if (p.y() < s.y() || (qFuzzyCompare(p.y(), s.y()) && p.x() < s.x()))
+        {
+            start = i;
+        }
+    }
+
+    QVector<QPointF> ordered;
+    ordered.reserve(polygon.size());
+    for (int i = 0; i < polygon.size(); ++i)
+    {
+        ordered.append(polygon.at((start + i) % polygon.size()));
+    }
+    return ordered;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QPointF> Negated(const QVector<QPointF> &points)
+{
+    QVector<QPointF> negated;
+    negated.reserve(points.size());
+    for (int i = 0; i < points.size(); ++i)
+    {
+        negated.append(-points.at(i));
+    }
+    return negated;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+qreal SignedArea2(const QVector<QPointF> &points)
+{
+    qreal area = 0;
+    for (int i = 0; i < points.size(); ++i)
+    {
+        area += Cross(points.at(i), points.at((i + 1) % points.size()));
+    }
+    return area;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SimpleOutline removes the closing point, repeated points and points on a straight line, so every vertex
+ * makes a real turn. The result has positive orientation.
+ */
+QVector<QPointF> SimpleOutline(const QVector<QPointF> &points)
+{
+    QVector<QPointF> outline = points;
+    bool changed = true;
+    while (changed && outline.size() >= 3)
+    {
+        changed = false;
+        for (int i = 0; i < outline.size() && outline.size() >= 3; ++i)
+        {
+            const QPointF &prev = outline.at((i + outline.size() - 1) % outline.size());
+            const QPointF &cur = outline.at(i);
+            const QPointF &next = outline.at((i + 1) % outline.size());
+            const QLineF edge(prev, next);
+
+            if (QLineF(prev, cur).length() <= VCollisionPolygon::accuracy
+                    || qAbs(Cross(prev, cur, next)) <= VCollisionPolygon::accuracy*edge.length())
+            {
+                outline.remove(i);
+                changed = true;
+                --i;
+            }
+        }
+    }
+
+    if (SignedArea2(outline) < 0)
+    {
+        std::reverse(outline.begin(), outline.end());
+    }
+    return outline;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool InTriangle(const QPointF &p, const QPointF &a, const QPointF &b, const QPointF &c)
+{
+    return Cross(a, b, p) >= 0 && Cross(b, c, p) >= 0 && Cross(c, a, p) >= 0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Triangulate splits a simple polygon with positive orientation by ear clipping.
+ * @return false if no ear was found, that happens for self-intersecting outlines.
+ */
+bool Triangulate(const QVector<QPointF> &points, QVector<QVector<int>> &triangles)
+{
+    QVector<int> left;
+    left.reserve(points.size());
+    for (int i = 0; i < points.size(); ++i)
+    {
+        left.append(i);
+    }
+
+    int i = 0;
+    int tested = 0;
+    while (left.size() > 3)
+    {
+        if (tested > left.size())
+        {
+            return false;
+        }
+
+        i %= left.size();
+        const int prev = left.at((i + left.size() - 1) % left.size());
+        const int cur = left.at(i);
+        const int next = left.at((i + 1) % left.size());
+        const QPointF &a = points.at(prev);
+        const QPointF &b = points.at(cur);
+        const QPointF &c = points.at(next);
+
+        bool ear = Cross(a, b, c) > 0;
+        for (int k = 0; ear && k < left.size(); ++k)
+        {
+            const QPointF &p = points.at(left.at(k));
+            if (p != a && p != b && p != c && InTriangle(p, a, b, c))
+            {
+                ear = false;
+            }
+        }
+
+        if (ear)
+        {
+            triangles.append(QVector<int>() << prev << cur << next);
+            left.remove(i);
+            tested = 0;
+        }
+        else
+        {
+            ++i;
+            ++tested;
+        }
+    }
+
+    triangles.append(left);
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool ConvexTurn(const QPointF &prev, const QPointF &cur, const QPointF &next)
+{
+    // Straight angle after a merge is still convex, rounding must not make it reflex.
+    return Cross(prev, cur, next) >= -1e-9*QLineF(prev, cur).length()*QLineF(cur, next).length();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief MergeTriangles joins polygons that share an edge while the result stays convex (Hertel-Mehlhorn).
+ */
+QVector<QVector<int>> MergeTriangles(const QVector<QPointF> &points, QVector<QVector<int>> polygons)
+{
+    QHash<QPair<int, int>, int> owners; // directed edge -> polygon
+    for (int i = 0; i < polygons.size(); ++i)
+    {
+        const QVector<int> &polygon = polygons.at(i);
+        for (int k = 0; k < polygon.size(); ++k)
+        {
+            owners.insert(qMakePair(polygon.at(k), polygon.at((k + 1) % polygon.size())), i);
+        }
+    }
+
+    QVector<bool> alive(polygons.size(), true);
+    for (int i = 0; i < polygons.size(); ++i)
+    {
+        bool merged = alive.at(i); // Already joined to another polygon
+        while (merged)
+        {
+            merged = false;
+            const QVector<int> polygon = polygons.at(i);
+            for (int k = 0; k < polygon.size() && not merged; ++k)
+            {
+                const int u = polygon.at(k);
+                const int v = polygon.at((k + 1) % polygon.size());
+                const int j = owners.value(qMakePair(v, u), -1);
+                if (j < 0 || j == i || not alive.at(j))
+                {
+                    continue;
+                }
+
+                // Walk this polygon from v to u, then the other one from u to v without both ends
+                const QVector<int> &other = polygons.at(j);
+                const int m = other.indexOf(u);
+                QVector<int> joined;
+                joined.reserve(polygon.size() + other.size() - 2);
+                for (int n = 0; n < polygon.size(); ++n)
+                {
+                    joined.append(polygon.at((k + 1 + n) % polygon.size()));
+                }
+                for (int n = 1; n < other.size() - 1; ++n)
+                {
+                    joined.append(other.at((m + n) % other.size()));
+                }
+
+                const int size = joined.size();
+                const int iv = 0;
+                const int iu = polygon.size() - 1;
+                if (not ConvexTurn(points.at(joined.at(size - 1)), points.at(joined.at(iv)), points.at(joined.at(1)))
+                        || not ConvexTurn(points.at(joined.at(iu - 1)), points.at(joined.at(iu)),
+                                          points.at(joined.at((iu + 1) % size))))
+                {
+                    continue;
+                }
+
+                for (int n = 0; n < other.size(); ++n)
+                {
+                    owners.insert(qMakePair(other.at(n), other.at((n + 1) % other.size())), i);
+                }
+                owners.remove(qMakePair(u, v));
+                owners.remove(qMakePair(v, u));
+                polygons[i] = joined;
+                alive[j] = false;
+                merged = true;
+            }
+        }
+    }
+
+    QVector<QVector<int>> result;
+    for (int i = 0; i < polygons.size(); ++i)
+    {
+        if (alive.at(i))
+        {
+            result.append(polygons.at(i));
+        }
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+uint PointsHash(const QVector<QPointF> &points)
+{
+    // Identical points must give identical hashes, rounding only makes the hash insensitive to the last bits.
+    uint hash = qHash(points.size());
+    for (int i = 0; i < points.size(); ++i)
+    {
+        hash = hash*31 + qHash(qRound64(points.at(i).x()*1000.0));
+        hash = hash*31 + qHash(qRound64(points.at(i).y()*1000.0));
+    }
+    return hash;
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool operator==(const VNfpKey &k1, const VNfpKey &k2)
+{
+    return k1.fixedShape == k2.fixedShape && k1.fixedAngle == k2.fixedAngle && k1.movingShape == k2.movingShape
+            && k1.movingAngle == k2.movingAngle;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+uint qHash(const VNfpKey &key, uint seed)
+{
+    return qHash(qMakePair(qMakePair(key.fixedShape, key.fixedAngle), qMakePair(key.movingShape, key.movingAngle)),
+                 seed);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// Pairs of parts grow as a square, more parts cost more than a better fit gives.
+const int VNfpCache::maxParts = 16;
+
+//---------------------------------------------------------------------------------------------------------------------
+VNfpCache::VNfpCache()
+    : shapes(),
+      shapeIndex(),
+      shapeParts(),
+      parts(),
+      nfps(),
+      hits(0),
+      misses(0)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ShapeId returns id of the shape with these points, a new shape gets a new id.
+ * @param points layout allowance of a piece without rotation.
+ */
+int VNfpCache::ShapeId(const QVector<QPointF> &points)
+{
+    const uint hash = PointsHash(points);
+
+    QMultiHash<uint, int>::const_iterator i = shapeIndex.constFind(hash);
+    while (i != shapeIndex.constEnd() && i.key() == hash)
+    {
+        if (shapes.at(i.value()) == points)
+        {
+            return i.value();
+        }
+        ++i;
+    }
+
+    shapes.append(points);
+    shapeParts.append(QVector<QVector<QPointF>>());
+    const int id = shapes.size() - 1;
+    shapeIndex.insert(hash, id);
+    return id;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Outline returns the shape rotated the same way as VLayoutPiece::Rotate() does around origin.
+ */
+QVector<QPointF> VNfpCache::Outline(int shape, int angle) const
+{
+    Q_ASSERT(shape >= 0 && shape < shapes.size());
+    return Rotated(shapes.at(shape), angle);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Parts returns convex parts of the shape rotated the same way as VLayoutPiece::Rotate() does around origin.
+ */
+QVector<QVector<QPointF>> VNfpCache::Parts(int shape, int angle)
+{
+    Q_ASSERT(shape >= 0 && shape < shapes.size());
+
+    const QPair<int, int> key = qMakePair(shape, angle);
+    QHash<QPair<int, int>, QVector<QVector<QPointF>>>::const_iterator i = parts.constFind(key);
+    if (i != parts.constEnd())
+    {
+        return i.value();
+    }
+
+    // Rotation keeps parts convex, so the outline is split only once
+    if (shapeParts.at(shape).isEmpty())
+    {
+        shapeParts[shape] = ConvexParts(shapes.at(shape));
+    }
+
+    QVector<QVector<QPointF>> rotated = shapeParts.at(shape);
+    for (int k = 0; k < rotated.size(); ++k)
+    {
+        rotated[k] = Rotated(rotated.at(k), angle);
+    }
+    parts.insert(key, rotated);
+    return rotated;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Nfp returns no-fit polygon of the moving shape around the fixed one as a list of convex polygons, the NFP is
+ * their union. Both shapes are rotated around origin and not translated, a placed fixed shape needs the polygons
+ * translated by its offset.
+ */
+QVector<QVector<QPointF>> VNfpCache::Nfp(int fixedShape, int fixedAngle, int movingShape, int movingAngle)
+{
+    const VNfpKey key(fixedShape, fixedAngle, movingShape, movingAngle);
+    QHash<VNfpKey, QVector<QVector<QPointF>>>::const_iterator i = nfps.constFind(key);
+    if (i != nfps.constEnd())
+    {
+        ++hits;
+        return i.value();
+    }
+
+    ++misses;
+    const QVector<QVector<QPointF>> fixedParts = Parts(fixedShape, fixedAngle);
+    const QVector<QVector<QPointF>> movingParts = Parts(movingShape, movingAngle);
+
+    QVector<QVector<QPointF>> nfp;
+    nfp.reserve(fixedParts.size()*movingParts.size());
+    for (int f = 0; f < fixedParts.size(); ++f)
+    {
+        for (int m = 0; m < movingParts.size(); ++m)
+        {
+            nfp.append(MinkowskiSum(fixedParts.at(f), Negated(movingParts.at(m))));
+        }
+    }
+    nfps.insert(key, nfp);
+    return nfp;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VNfpCache::Clear()
+{
+    shapes.clear();
+    shapeIndex.clear();
+    shapeParts.clear();
+    parts.clear();
+    nfps.clear();
+    hits = 0;
+    misses = 0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VNfpCache::Hits() const
+{
+    return hits;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VNfpCache::Misses() const
+{
+    return misses;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QPointF> VNfpCache::Rotated(const QVector<QPointF> &points, int angle)
+{
+    if (angle % 360 == 0)
+    {
+        return points;
+    }
+
+    QTransform m;
+    m.rotate(-angle);
+
+    QVector<QPointF> rotated;
+    rotated.reserve(points.size());
+    for (int i = 0; i < points.size(); ++i)
+    {
+        rotated.append(m.map(points.at(i)));
+    }
+    return rotated;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ConvexHull monotone chain algorithm. Collinear points are dropped, the result has positive orientation
+ * (counterclockwise in y-up coordinates) and is not closed.
+ */
+QVector<QPointF> VNfpCache::ConvexHull(QVector<QPointF> points)
+{
+    std::sort(points.begin(), points.end(), LessXY);
+
+    if (points.size() < 3)
+    {
+        return points;
+    }
+
+    QVector<QPointF> hull(2*points.size());
+    int k = 0;
+
+    // Lower hull
+    for (int i = 0; i < points.size(); ++i)
+    {
+        while (k >= 2 && Cross(hull.at(k-2), hull.at(k-1), points.at(i)) <= 0)
+        {
+            --k;
+        }
+        hull[k++] = points.at(i);
+    }
+
+    // Upper hull
+    for (int i = points.size()-2, t = k+1; i >= 0; --i)
+    {
+        while (k >= t && Cross(hull.at(k-2), hull.at(k-1), points.at(i)) <= 0)
+        {
+            --k;
+        }
+        hull[k++] = points.at(i);
+    }
+
+    hull.resize(k-1); // Last point is the same as first
+    return hull;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ConvexParts splits the outline into convex polygons with positive orientation. Falls back to the convex hull
+ * if the outline is self-intersecting or gives more than maxParts parts.
+ */
+QVector<QVector<QPointF>> VNfpCache::ConvexParts(const QVector<QPointF> &points)
+{
+    QVector<QPointF> outline = points;
+    if (outline.size() > 1 && outline.first() == outline.last())
+    {
+        outline.removeLast();
+    }
+    outline = SimpleOutline(outline);
+
+    if (outline.size() < 3)
+    {
+        return QVector<QVector<QPointF>>() << ConvexHull(points);
+    }
+
+    // Convex partition needs at least reflex/2 + 1 parts, don't triangulate if it cannot fit the limit anyway
+    int reflex = 0;
+    for (int i = 0; i < outline.size(); ++i)
+    {
+        if (Cross(outline.at((i + outline.size() - 1) % outline.size()), outline.at(i),
+                  outline.at((i + 1) % outline.size())) < 0)
+        {
+            ++reflex;
+        }
+    }
+
+    if (reflex == 0)
+    {
+        return QVector<QVector<QPointF>>() << outline;
+    }
+
+    QVector<QVector<int>> triangles;
+    if (reflex/2 + 1 > maxParts || not Triangulate(outline, triangles))
+    {
+        return QVector<QVector<QPointF>>() << ConvexHull(points);
+    }
+
+    // Triangles of a self-intersecting outline don't cover it exactly
+    qreal area = 0;
+    for (int i = 0; i < triangles.size(); ++i)
+    {
+        const QVector<int> &t = triangles.at(i);
+        area += Cross(outline.at(t.at(0)), outline.at(t.at(1)), outline.at(t.at(2)));
+    }
+    const qreal outlineArea = SignedArea2(outline);
+    if (qAbs(area - outlineArea) > outlineArea*1e-6)
+    {
+        return QVector<QVector<QPointF>>() << ConvexHull(points);
+    }
+
+    const QVector<QVector<int>> polygons = MergeTriangles(outline, triangles);
+    if (polygons.size() > maxParts)
+    {
+        return QVector<QVector<QPointF>>() << ConvexHull(points);
+    }
+
+    QVector<QVector<QPointF>> result;
+    result.reserve(polygons.size());
+    for (int i = 0; i < polygons.size(); ++i)
+    {
+        QVector<QPointF> part;
+        part.reserve(polygons.at(i).size());
+        for (int k = 0; k < polygons.at(i).size(); ++k)
+        {
+            part.append(outline.at(polygons.at(i).at(k)));
+        }
+        result.append(part);
+    }
+    return result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief MinkowskiSum of two convex polygons with positive orientation (see ConvexHull()). Merges edges of both
+ * polygons in order of their polar angle, so works in O(n+m).
+ */
+QVector<QPointF> VNfpCache::MinkowskiSum(const QVector<QPointF> &p, const QVector<QPointF> &q)
+{
+    if (p.isEmpty() || q.isEmpty())
+    {
+        return QVector<QPointF>();
+    }
+
+    const QVector<QPointF> a = StartFromLowest(p);
+    const QVector<QPointF> b = StartFromLowest(q);
+    const int n = a.size();
+    const int m = b.size();
+
+    QVector<QPointF> sum;
+    sum.reserve(n + m);
+
+    int i = 0;
+    int j = 0;
+    while (i < n || j < m)
+    {
+        sum.append(a.at(i % n) + b.at(j % m));
+
+        const QPointF edgeA = a.at((i + 1) % n) - a.at(i % n);
+        const QPointF edgeB = b.at((j + 1) % m) - b.at(j % m);
+        const qreal cross = Cross(edgeA, edgeB);
+
+        // When one polygon is over the other one takes the rest of edges
+        const bool nextA = i < n && (j >= m || cross >= 0);
+        const bool nextB = j < m && (i >= n || cross <= 0);
+        if (nextA)
+        {
+            ++i;
+        }
+        if (nextB)
+        {
+            ++j;
+        }
+    }
+
+    return sum;
+}
@@ -0,0 +1,109 @@
+/***************************************************************************
+ *                                                                         *
+ *   @file   vnfpcache.h                                                   *
+ *   @author Seamly2D project                                              *
+ *   @date   10.16.2026                                                    *
+ *   Copyright (C) 2017  Seamly, LLC                                       *
+ *                                                                         *
+ *   https://github.com/fashionfreedom/seamly2d                            *
+ *                                                                         *
+ ***************************************************************************
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **************************************************************************/
+
+#ifndef VNFPCACHE_H
+#define VNFPCACHE_H
+
+#include <QHash>
+#include <QPair>
+#include <QPointF>
+#include <QVector>
+#include <QtGlobal>
+
+/**
+ * @brief The VNfpKey struct identifies a no-fit polygon by both shapes and their rotations.
+ */
+struct VNfpKey
+{
+    VNfpKey()
+        : fixedShape(-1), fixedAngle(0), movingShape(-1), movingAngle(0)
+    {}
+
+    VNfpKey(int fixedShape, int fixedAngle, int movingShape, int movingAngle)
+        : fixedShape(fixedShape), fixedAngle(fixedAngle), movingShape(movingShape), movingAngle(movingAngle)
+    {}
+
+    int fixedShape;
+    int fixedAngle;
+    int movingShape;
+    int movingAngle;
+};
+
+bool operator==(const VNfpKey &k1, const VNfpKey &k2);
+uint qHash(const VNfpKey &key, uint seed = 0);
+
+/**
+ * @brief The VNfpCache class computes and keeps no-fit polygons for the NFP layout engine.
+ *
+ * A no-fit polygon (NFP) of a fixed and a moving shape is the set of translations of the moving shape that make it
+ * touch or overlap the fixed one. Translations strictly inside the NFP overlap, translations on its boundary touch.
+ *
+ * The layout allowance of each shape is split once into convex parts (ear clipping, then neighbour triangles are
+ * merged while the result stays convex). The NFP is the union of Minkowski sums of every fixed part and every
+ * reflected moving part, so a concave piece can take a pocket of another one. The union is not computed, the cache
+ * returns the convex polygons and the caller tests them one by one. Shapes that cannot be split (self-intersecting
+ * outline) or give more than maxParts parts fall back to their convex hull, which is conservative: such a piece
+ * never overlaps others, but doesn't nest either.
+ *
+ * Shapes are interned by their points, so copies of the same piece (see the layout multiplier) share all cached
+ * polygons.
+ */
+class VNfpCache
+{
+public:
+    VNfpCache();
+
+    int ShapeId(const QVector<QPointF> &points);
+
+    QVector<QPointF>          Outline(int shape, int angle) const;
+    QVector<QVector<QPointF>> Parts(int shape, int angle);
+    QVector<QVector<QPointF>> Nfp(int fixedShape, int fixedAngle, int movingShape, int movingAngle);
+
+    void Clear();
+
+    int Hits() const;
+    int Misses() const;
+
+    static QVector<QPointF> Rotated(const QVector<QPointF> &points, int angle);
+    static QVector<QPointF> ConvexHull(QVector<QPointF> points);
+    static QVector<QVector<QPointF>> ConvexParts(const QVector<QPointF> &points);
+    static QVector<QPointF> MinkowskiSum(const QVector<QPointF> &p, const QVector<QPointF> &q);
+
+    static const int maxParts;
+
+private:
+    Q_DISABLE_COPY(VNfpCache)
+
+    QVector<QVector<QPointF>>                         shapes;
+    QMultiHash<uint, int>                             shapeIndex;
+    QVector<QVector<QVector<QPointF>>>                shapeParts;
+    QHash<QPair<int, int>, QVector<QVector<QPointF>>> parts;
+    QHash<VNfpKey, QVector<QVector<QPointF>>>         nfps;
+    int                                               hits;
+    int                                               misses;
+};
+
+#endif // VNFPCACHE_H
@@ -0,0 +1,331 @@
+/***************************************************************************
+ *                                                                         *
+ *   @file   vnfpnester.cpp                                                *
+ *   @author Seamly2D project                                              *
+ *   @date   10.16.2026                                                    *
+ *   Copyright (C) 2017  Seamly, LLC                                       *
+ *                                                                         *
+ *   https://github.com/fashionfreedom/seamly2d                            *
+ *                                                                         *
+ ***************************************************************************
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **************************************************************************/
+
+#include "vnfpnester.h"
+
+#include <QLineF>
+#include <QPolygonF>
+#include <QtMath>
+#include <algorithm>
+
+#include "../vmisc/def.h"
+#include "vcollisionpolygon.h"
+#include "vlayoutpiece.h"
+#include "vnfpcache.h"
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+bool LessYX(const QPointF &p1, const QPointF &p2)
+{
+    if (qAbs(p1.y() - p2.y()) > VCollisionPolygon::accuracy)
+    {
+        return p1.y() < p2.y();
+    }
+    return p1.x() < p2.x();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QLineF> Edges(const QVector<QPointF> &polygon)
+{
+    QVector<QLineF> edges;
+    edges.reserve(polygon.size());
+    for (int i = 0; i < polygon.size(); ++i)
+    {
+        edges.append(QLineF(polygon.at(i), polygon.at((i + 1) % polygon.size())));
+    }
+    return edges;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QPointF> Translated(QVector<QPointF> points, const QPointF &offset)
+{
+    for (int i = 0; i < points.size(); ++i)
+    {
+        points[i] += offset;
+    }
+    return points;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void AppendCandidate(QVector<QPointF> &candidates, const QRectF &ifp, const QPointF &point)
+{
+    const qreal e = VCollisionPolygon::accuracy;
+    if (point.x() >= ifp.left() - e && point.x() <= ifp.right() + e
+            && point.y() >= ifp.top() - e && point.y() <= ifp.bottom() + e)
+    {
+        candidates.append(QPointF(qBound(ifp.left(), point.x(), ifp.right()),
+                                  qBound(ifp.top(), point.y(), ifp.bottom())));
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void AppendIntersections(QVector<QPointF> &candidates, const QRectF &ifp, const QVector<QLineF> &edges1,
+                         const QVector<QLineF> &edges2)
+{
+    for (int i = 0; i < edges1.size(); ++i)
+    {
+        for (int j = 0; j < edges2.size(); ++j)
+        {
+            QPointF point;
+            if (edges1.at(i).intersect(edges2.at(j), &point) == QLineF::BoundedIntersection)
+            {
+                AppendCandidate(candidates, ifp, point);
+            }
+        }
+    }
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+VNfpNester::VNfpNester(VNfpCache *cache, int width, int height)
+    : cache(cache),
+      width(width),
+      height(height)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Arrange finds position for the detail among already placed pieces.
+ * @param detail piece to place, its current matrix is the base for rotations.
+ * @param placed pieces already placed on this sheet.
+ * @param rotate allow rotation of the detail.
+ * @param rotationIncrease step of rotation in degrees.
+ * @param stop flag of aborted generation.
+ * @param result the detail moved to the found position.
+ * @param placement how the detail was moved, needed to place next pieces.
+ * @return true if the detail fits the sheet.
+ */
+bool VNfpNester::Arrange(const VLayoutPiece &detail, const QVector<VNfpPlacement> &placed, bool rotate,
+                         int rotationIncrease, std::atomic_bool &stop, VLayoutPiece &result,
+                         VNfpPlacement &placement) const
+{
+    SCASSERT(cache != nullptr)
+
+    if ((rotationIncrease >= 1 && rotationIncrease <= 180 && 360 % rotationIncrease == 0) == false)
+    {
+        rotationIncrease = 180;
+    }
+
+    const int shape = cache->ShapeId(detail.GetLayoutAllowancePoints());
+    const int steps = rotate ? 360/rotationIncrease : 1;
+
+    QVector<VCollisionPolygon> placedPolygons;
+    placedPolygons.reserve(placed.size());
+    for (int i = 0; i < placed.size(); ++i)
+    {
+        const VNfpPlacement &p = placed.at(i);
+        placedPolygons.append(VCollisionPolygon(Translated(cache->Outline(p.shape, p.angle), p.offset)));
+    }
+
+    bool found = false;
+    qreal bestBottom = 0;
+    qreal bestLeft = 0;
+
+    for (int step = 0; step < steps; ++step)
+    {
+        if (stop.load())
+        {
+            return false;
+        }
+
+        const int angle = step*rotationIncrease;
+
+        VLayoutPiece workDetail = detail;
+        if (angle != 0)
+        {
+            workDetail.Rotate(QPointF(), angle);
+        }
+
+        // Inner-fit rectangle: all translations that keep the detail on the sheet.
+        const QRectF rect = workDetail.DetailBoundingRect();
+        const QPointF topLeft(-rect.left(), -rect.top());
+        const QPointF bottomRight(width - rect.right(), height - rect.bottom());
+        if (bottomRight.x() < topLeft.x() || bottomRight.y() < topLeft.y())
+        {
+            continue; // Too big for the sheet
+        }
+
+        QVector<QVector<QPointF>> nfps;
+        for (int i = 0; i < placed.size(); ++i)
+        {
+            const VNfpPlacement &p = placed.at(i);
+            const QVector<QVector<QPointF>> nfp = cache->Nfp(p.shape, p.angle, shape, angle);
+            for (int k = 0; k < nfp.size(); ++k)
+            {
+                nfps.append(Translated(nfp.at(k), p.offset));
+            }
+        }
+
+        QPointF position;
+        if (not BottomLeft(QRectF(topLeft, bottomRight), nfps, cache->Outline(shape, angle), placedPolygons, position))
+        {
+            continue;
+        }
+
+        const qreal bottom = position.y() + rect.bottom();
+        const qreal left = position.x() + rect.left();
+        if (not found || bottom < bestBottom - VCollisionPolygon::accuracy
+                || (qAbs(bottom - bestBottom) <= VCollisionPolygon::accuracy && left < bestLeft))
+        {
+            found = true;
+            bestBottom = bottom;
+            bestLeft = left;
+
+            workDetail.Translate(position.x(), position.y());
+            result = workDetail;
+
+            placement.shape = shape;
+            placement.angle = angle;
+            placement.offset = position;
+        }
+    }
+
+    return found;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief BottomLeft finds the first candidate that is not inside any part of the no-fit polygons. A candidate on the
+ * border between two parts can still be inside their union, so the found position is checked on real outlines.
+ */
+bool VNfpNester::BottomLeft(const QRectF &ifp, const QVector<QVector<QPointF>> &nfps, const QVector<QPointF> &outline,
+                            const QVector<VCollisionPolygon> &placed, QPointF &position)
+{
+    QVector<QRectF> rects;
+    rects.reserve(nfps.size());
+    for (int i = 0; i < nfps.size(); ++i)
+    {
+        rects.append(QPolygonF(nfps.at(i)).boundingRect());
+    }
+
+    QVector<QPointF> candidates = Candidates(ifp, nfps, rects);
+    std::sort(candidates.begin(), candidates.end(), LessYX);
+
+    for (int c = 0; c < candidates.size(); ++c)
+    {
+        const QPointF &candidate = candidates.at(c);
+        bool free = true;
+        for (int i = 0; i < nfps.size(); ++i)
+        {
+            if (rects.at(i).contains(candidate) && StrictlyInside(nfps.at(i), candidate))
+            {
+                free = false;
+                break;
+            }
+        }
+
+        if (free && not Overlaps(Translated(outline, candidate), placed))
+        {
+            position = candidate;
+            return true;
+        }
+    }
+
+    return false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QPointF> VNfpNester::Candidates(const QRectF &ifp, const QVector<QVector<QPointF>> &nfps,
+                                        const QVector<QRectF> &rects)
+{
+    QVector<QPointF> candidates;
+    candidates << ifp.topLeft() << ifp.topRight() << ifp.bottomLeft() << ifp.bottomRight();
+
+    QVector<QPointF> ifpPolygon;
+    ifpPolygon << ifp.topLeft() << ifp.topRight() << ifp.bottomRight() << ifp.bottomLeft();
+    const QVector<QLineF> ifpEdges = Edges(ifpPolygon);
+
+    QVector<QVector<QLineF>> edges;
+    edges.reserve(nfps.size());
+    for (int i = 0; i < nfps.size(); ++i)
+    {
+        const QVector<QPointF> &nfp = nfps.at(i);
+        for (int k = 0; k < nfp.size(); ++k)
+        {
+            AppendCandidate(candidates, ifp, nfp.at(k));
+        }
+
+        edges.append(Edges(nfp));
+        AppendIntersections(candidates, ifp, edges.at(i), ifpEdges);
+    }
+
+    // Pockets between two placed pieces
+    for (int i = 0; i < nfps.size(); ++i)
+    {
+        for (int j = i + 1; j < nfps.size(); ++j)
+        {
+            if (rects.at(i).intersects(rects.at(j)))
+            {
+                AppendIntersections(candidates, ifp, edges.at(i), edges.at(j));
+            }
+        }
+    }
+
+    return candidates;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VNfpNester::Overlaps(const QVector<QPointF> &outline, const QVector<VCollisionPolygon> &placed)
+{
+    const VCollisionPolygon polygon(outline);
+    for (int i = 0; i < placed.size(); ++i)
+    {
+        if (polygon.Overlaps(placed.at(i)))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief StrictlyInside checks if the point is inside a convex polygon with positive orientation farther than
+ * accuracy from its edges. Points on the boundary mean touching, which is allowed.
+ */
+bool VNfpNester::StrictlyInside(const QVector<QPointF> &polygon, const QPointF &point)
+{
+    if (polygon.size() < 3)
+    {
+        return false;
+    }
+
+    for (int i = 0; i < polygon.size(); ++i)
+    {
+        const QPointF &p1 = polygon.at(i);
+        const QPointF &p2 = polygon.at((i + 1) % polygon.size());
+        const QPointF edge = p2 - p1;
+        const qreal length = qSqrt(edge.x()*edge.x() + edge.y()*edge.y());
+        const qreal cross = edge.x()*(point.y() - p1.y()) - edge.y()*(point.x() - p1.x());
+
+        if (cross <= VCollisionPolygon::accuracy*length)
+        {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,95 @@
+/***************************************************************************
+ *                                                                         *
+ *   @file   vnfpnester.h                                                  *
+ *   @author Seamly2D project                                              *
+ *   @date   10.16.2026                                                    *
+ *   Copyright (C) 2017  Seamly, LLC                                       *
+ *                                                                         *
+ *   https://github.com/fashionfreedom/seamly2d                            *
+ *                                                                         *
+ ***************************************************************************
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **************************************************************************/
+
+#ifndef VNFPNESTER_H
+#define VNFPNESTER_H
+
+#include <QPointF>
+#include <QRectF>
+#include <QTypeInfo>
+#include <QVector>
+#include <QtGlobal>
+#include <atomic>
+
+class VCollisionPolygon;
+class VLayoutPiece;
+class VNfpCache;
+
+/**
+ * @brief The VNfpPlacement struct remembers how the NFP engine placed a piece on a sheet.
+ */
+struct VNfpPlacement
+{
+    VNfpPlacement()
+        : shape(-1), angle(0), offset()
+    {}
+
+    /** @brief shape id of the piece in VNfpCache. */
+    int     shape;
+
+    /** @brief angle rotation of the piece around origin. */
+    int     angle;
+
+    /** @brief offset translation applied after rotation. */
+    QPointF offset;
+};
+
+Q_DECLARE_TYPEINFO(VNfpPlacement, Q_MOVABLE_TYPE);
+
+/**
+ * @brief The VNfpNester class places one piece on a sheet with bottom-left-fill rule using no-fit polygons.
+ *
+ * Candidate positions are vertices of the no-fit polygons of already placed pieces, their intersections with each
+ * other and with the inner-fit rectangle of the sheet. The first candidate in order of y, then x, that is not inside
+ * any no-fit polygon and doesn't make outlines overlap wins. Sheet grows down from its top edge, so "bottom" here
+ * means the lowest y. Among all allowed rotations the one that ends higher, then more left, is taken.
+ */
+class VNfpNester
+{
+public:
+    VNfpNester(VNfpCache *cache, int width, int height);
+
+    bool Arrange(const VLayoutPiece &detail, const QVector<VNfpPlacement> &placed, bool rotate,
+                 int rotationIncrease, std::atomic_bool &stop, VLayoutPiece &result,
+                 VNfpPlacement &placement) const;
+
+private:
+    Q_DISABLE_COPY(VNfpNester)
+
+    VNfpCache *cache;
+    int        width;
+    int        height;
+
+    static bool BottomLeft(const QRectF &ifp, const QVector<QVector<QPointF>> &nfps, const QVector<QPointF> &outline,
+                           const QVector<VCollisionPolygon> &placed, QPointF &position);
+
+    static QVector<QPointF> Candidates(const QRectF &ifp, const QVector<QVector<QPointF>> &nfps,
+                                       const QVector<QRectF> &rects);
+    static bool Overlaps(const QVector<QPointF> &outline, const QVector<VCollisionPolygon> &placed);
+    static bool StrictlyInside(const QVector<QPointF> &polygon, const QPointF &point);
+};
+
+#endif // VNFPNESTER_H
@@ -64,71 +64,289 @@
 #include <QRectF>
 #include <QSizeF>
 #include <QStaticStringData>
+#include <QTransform>
 #include <QString>
 #include <QStringData>
 #include <QStringDataPtr>
 #include <Qt>
+#include <climits>
 
 #include "../vmisc/def.h"
 #include "../vmisc/vmath.h"
 
 //---------------------------------------------------------------------------------------------------------------------
-VPosition::VPosition(const VContour &gContour, int j, const VLayoutPiece &detail, int i, std::atomic_bool *stop,
-                     bool rotate, int rotationIncrease, bool saveLength)
-    : QRunnable(),
-      bestResult(VBestSquare(gContour.GetSize(), saveLength)),
-      gContour(gContour),
+VPositionScheduler::VPositionScheduler(const VContour &gContour, const VLayoutPiece &detail, std::atomic_bool *stop,
+                                       bool rotate, int rotationIncrease, bool saveLength, int workersCount)
+    : gContour(gContour),
+      gPolygon(gContour.GetContour()),
       detail(detail),
-      i(i),
-      j(j),
-      paperIndex(0),
-      frame(0),
-      detailsCount(0),
-      details(),
+      gRect(gContour.BoundingRect()),
       stop(stop),
-      rotate(rotate),
+      saveLength(saveLength),
       rotationIncrease(rotationIncrease),
-      angle_between(0)
+      detailEdgesCount(0),
+      stepsCount(1),
+      jobsCount(0),
+      workersCount(qMax(1, workersCount)),
+      ranges(),
+      bestKey(LLONG_MAX)
 {
     if ((rotationIncrease >= 1 && rotationIncrease <= 180 && 360 % rotationIncrease == 0) == false)
     {
         this->rotationIncrease = 180;
     }
+
+    // Workers read the shared detail concurrently, its lazy geometry cache must be filled before they start.
+    this->detail.PrepareGeometry();
+
+    if (gContour.GetContour().isEmpty())
+    {
+        detailEdgesCount = detail.DetailEdgesCount();
+    }
+    else
+    {
+        detailEdgesCount = detail.LayoutEdgesCount();
+    }
+
+    if (rotate || gContour.GetContour().isEmpty())
+    {
+        stepsCount += 360/this->rotationIncrease;
+    }
+
+    jobsCount = gContour.GlobalEdgesCount() * detailEdgesCount * stepsCount;
+
+    // Each worker starts with an equal share, the balance is restored by stealing.
+    ranges.reset(new JobRange[static_cast<size_t>(this->workersCount)]);
+    const int share = jobsCount / this->workersCount;
+    const int rest = jobsCount % this->workersCount;
+    int begin = 0;
+    for (int w = 0; w < this->workersCount; ++w)
+    {
+        const int size = share + (w < rest ? 1 : 0);
+        ranges[w].next.store(begin);
+        ranges[w].end = begin + size;
+        begin += size;
+    }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-void VPosition::run()
+const VContour &VPositionScheduler::GetContour() const
+{
+    return gContour;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+const VCollisionPolygon &VPositionScheduler::GetContourPolygon() const
+{
+    return gPolygon;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+const VLayoutPiece &VPositionScheduler::GetDetail() const
+{
+    return detail;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+std::atomic_bool *VPositionScheduler::GetStop() const
+{
+    return stop;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VPositionScheduler::IsSaveLength() const
+{
+    return saveLength;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VPositionScheduler::GetRotationIncrease() const
+{
+    return rotationIncrease;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VPositionScheduler::JobsCount() const
+{
+    return jobsCount;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VPositionScheduler::WorkersCount() const
+{
+    return workersCount;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief TakeJob gives the next job for the worker. First from own range, then from the busiest one.
+ * @param worker index of the worker.
+ * @param job index of the job.
+ * @return false if there are no more jobs.
+ */
+bool VPositionScheduler::TakeJob(int worker, int &job)
 {
-    if (stop->load())
+    if (TakeFrom(worker, job))
     {
-        return;
+        return true;
     }
 
-    // We should use copy of the detail.
-    VLayoutPiece workDetail = detail;
+    forever
+    {
+        int victim = -1;
+        int maxLeft = 0;
+        for (int w = 0; w < workersCount; ++w)
+        {
+            const int left = ranges[w].end - ranges[w].next.load();
+            if (left > maxLeft)
+            {
+                maxLeft = left;
+                victim = w;
+            }
+        }
+
+        if (victim < 0)
+        {
+            return false;
+        }
 
-    int dEdge = i;// For mirror detail edge will be different
-    if (CheckCombineEdges(workDetail, j, dEdge))
+        if (TakeFrom(victim, job))
+        {
+            return true;
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VPositionScheduler::DecodeJob(int job, int &j, int &i, int &step) const
+{
+    step = job % stepsCount;
+    const int pair = job / stepsCount;
+    j = pair / detailEdgesCount + 1;
+    i = pair % detailEdgesCount + 1;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief CannotWin checks if candidate is already worse than the best result of all workers.
+ *
+ * The new global contour includes all points of the old contour and all points of the detail, so the bounding rect
+ * of them both is never bigger than the real result.
+ * @param detailRect bounding rect of the detail in candidate position.
+ * @param type type of the candidate.
+ * @return true if candidate can be skipped.
+ */
+bool VPositionScheduler::CannotWin(const QRectF &detailRect, BestFrom type) const
+{
+    const QRectF rect = gRect.isNull() ? detailRect : gRect.united(detailRect);
+    const QSizeF size = saveLength ? QSizeF(gContour.GetWidth(), rect.height()) : rect.size();
+    return Key(VBestSquare::Square(size), type) > bestKey.load();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VPositionScheduler::PublishResult(const VBestSquare &result)
+{
+    if (not result.ValidResult())
     {
-        #ifdef LAYOUT_DEBUG
-        #   ifdef SHOW_CANDIDATE_BEST
-                DrawDebug(gContour, workDetail, frame+2, paperIndex, detailsCount, details);
-        #   endif
-        #endif
+        return;
+    }
 
-        SaveCandidate(bestResult, workDetail, j, dEdge, BestFrom::Combine);
+    const qint64 key = Key(VBestSquare::Square(result.BestSize()), result.Type());
+    qint64 current = bestKey.load();
+    while (key < current && not bestKey.compare_exchange_weak(current, key))
+    {
+        // current was updated by compare_exchange_weak, try again
     }
-    frame = frame + 3;
+}
 
-    if (rotate)
+//---------------------------------------------------------------------------------------------------------------------
+bool VPositionScheduler::TakeFrom(int worker, int &job)
+{
+    JobRange &range = ranges[worker];
+    if (range.next.load() >= range.end)
     {
-        Rotate(rotationIncrease);
+        return false;
     }
-    else
+
+    job = range.next.fetch_add(1);
+    return job < range.end;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+qint64 VPositionScheduler::Key(qint64 square, BestFrom type)
+{
+    // Must follow the order of VBestSquare::IsBetter(): smaller square wins, on equal square combine beats rotation.
+    const qint64 rank = type == BestFrom::Combine ? 0 : 1;
+    return (square << 1) | rank;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+VPosition::VPosition(VPositionScheduler *scheduler, int worker)
+    : QRunnable(),
+      scheduler(scheduler),
+      worker(worker),
+      bestResult(VBestSquare(scheduler->GetContour().GetSize(), scheduler->IsSaveLength())),
+      gContour(scheduler->GetContour()),
+      paperIndex(0),
+      frame(0),
+      detailsCount(0),
+      details(),
+      stop(scheduler->GetStop())
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VPosition::run()
+{
+    // We should use copy of the detail. Only the matrix changes between jobs, so the data detaches once per worker.
+    VLayoutPiece workDetail = scheduler->GetDetail();
+    const QTransform matrix = workDetail.GetMatrix();
+    const bool mirror = workDetail.IsMirror();
+    const quint32 startFrame = frame;
+
+    int job = 0;
+    while (not stop->load() && scheduler->TakeJob(worker, job))
     {
-        if (gContour.GetContour().isEmpty())
+        int j = 0;
+        int i = 0;
+        int step = 0;
+        scheduler->DecodeJob(job, j, i, step);
+
+        workDetail.SetMatrix(matrix);
+        workDetail.SetMirror(mirror);
+        frame = startFrame + static_cast<quint32>(job)*3;
+
+        if (step == 0)
+        {
+            int dEdge = i;// For mirror detail edge will be different
+            if (CheckCombineEdges(workDetail, j, dEdge))
+            {
+                #ifdef LAYOUT_DEBUG
+                #   ifdef SHOW_CANDIDATE_BEST
+                        DrawDebug(gContour, workDetail, frame+2, paperIndex, detailsCount, details);
+                #   endif
+                #endif
+
+                SaveCandidate(bestResult, workDetail, j, dEdge, BestFrom::Combine, job);
+            }
+        }
+        else
         {
-            Rotate(rotationIncrease);
+            const int angle = (step-1)*scheduler->GetRotationIncrease();
+            if (SkipRotation(j, i, angle))
+            {
+                continue;
+            }
+
+            if (CheckRotationEdges(workDetail, j, i, angle))
+            {
+                #ifdef LAYOUT_DEBUG
+                #   ifdef SHOW_CANDIDATE_BEST
+                        DrawDebug(gContour, workDetail, frame, paperIndex, detailsCount, details);
+                #   endif
+                #endif
+
+                SaveCandidate(bestResult, workDetail, j, i, BestFrom::Rotation, job);
+            }
         }
     }
 }
@@ -277,12 +495,13 @@ int VPosition::Bias(int length, int maxLength)
 
 //---------------------------------------------------------------------------------------------------------------------
 void VPosition::SaveCandidate(VBestSquare &bestResult, const VLayoutPiece &detail, int globalI, int detJ,
-                              BestFrom type)
+                              BestFrom type, int order)
 {
     QVector<QPointF> newGContour = gContour.UniteWithContour(detail, globalI, detJ, type);
     newGContour.append(newGContour.first());
     const QSizeF size = QPolygonF(newGContour).boundingRect().size();
-    bestResult.NewResult(size, globalI, detJ, detail.GetMatrix(), detail.IsMirror(), type);
+    bestResult.NewResult(size, globalI, detJ, detail.GetMatrix(), detail.IsMirror(), type, order);
+    scheduler->PublishResult(bestResult);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -387,8 +606,14 @@ bool VPosition::CheckRotationEdges(VLayoutPiece &detail, int j, int dEdge, int a
     #endif
 #endif
 
+    const QRectF detailRect = detail.DetailBoundingRect();
+    if (scheduler->CannotWin(detailRect, BestFrom::Rotation))
+    {
+        return false;
+    }
+
     CrossingType type = CrossingType::Intersection;
-    if (SheetContains(detail.DetailBoundingRect()))
+    if (SheetContains(detailRect))
     {
         type = Crossing(detail);
     }
@@ -412,15 +637,16 @@ bool VPosition::CheckRotationEdges(VLayoutPiece &detail, int j, int dEdge, int a
 //---------------------------------------------------------------------------------------------------------------------
 VPosition::CrossingType VPosition::Crossing(const VLayoutPiece &detail) const
 {
-    const QRectF gRect = gContour.BoundingRect();
+    const VCollisionPolygon &gPolygon = scheduler->GetContourPolygon();
+    const QRectF gRect = gPolygon.BoundingRect();
     if (not gRect.intersects(detail.LayoutBoundingRect()) && not gRect.contains(detail.DetailBoundingRect()))
     {
         // This we can determine efficiently.
         return CrossingType::NoIntersection;
     }
 
-    const QPainterPath gPath = gContour.ContourPath();
-    if (not gPath.intersects(detail.LayoutAllowancePath()) && not gPath.contains(detail.ContourPath()))
+    if (not gPolygon.Intersects(VCollisionPolygon(detail.GetLayoutAllowancePoints()))
+            && not gPolygon.Contains(VCollisionPolygon(DetailPoints(detail))))
     {
         return CrossingType::NoIntersection;
     }
@@ -430,6 +656,16 @@ VPosition::CrossingType VPosition::Crossing(const VLayoutPiece &detail) const
     }
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QPointF> VPosition::DetailPoints(const VLayoutPiece &detail)
+{
+    if (detail.IsSeamAllowance() && not detail.IsSeamAllowanceBuiltIn())
+    {
+        return detail.GetSeamAllowancePoints();
+    }
+    return detail.GetContourPoints();
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 bool VPosition::SheetContains(const QRectF &rect) const
 {
@@ -438,7 +674,7 @@ bool VPosition::SheetContains(const QRectF &rect) const
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-void VPosition::CombineEdges(VLayoutPiece &detail, const QLineF &globalEdge, const int &dEdge)
+void VPosition::CombineEdges(VLayoutPiece &detail, const QLineF &globalEdge, const int &dEdge) const
 {
     QLineF detailEdge;
     if (gContour.GetContour().isEmpty())
@@ -456,7 +692,7 @@ void VPosition::CombineEdges(VLayoutPiece &detail, const QLineF &globalEdge, con
 
     detailEdge.translate(dx, dy); // Use values for translate detail edge.
 
-    angle_between = globalEdge.angleTo(detailEdge); // Seek angle between two edges.
+    const qreal angle_between = globalEdge.angleTo(detailEdge); // Seek angle between two edges.
 
     // Now we move detail to position near to global contour edge.
     detail.Translate(dx, dy);
@@ -491,36 +727,20 @@ void VPosition::RotateEdges(VLayoutPiece &detail, const QLineF &globalEdge, int
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-void VPosition::Rotate(int increase)
+/**
+ * @brief SkipRotation zero angle gives the same position as combining edges if edges are already parallel.
+ */
+bool VPosition::SkipRotation(int j, int i, int angle) const
 {
-    int startAngle = 0;
-    if (VFuzzyComparePossibleNulls(angle_between, 360))
+    if (angle != 0)
     {
-        startAngle = increase;
+        return false;
     }
-    for (int angle = startAngle; angle < 360; angle = angle+increase)
-    {
-        if (stop->load())
-        {
-            return;
-        }
-
-        // We should use copy of the detail.
-        VLayoutPiece workDetail = detail;
 
-        if (CheckRotationEdges(workDetail, j, i, angle))
-        {
-            #ifdef LAYOUT_DEBUG
-            #   ifdef SHOW_CANDIDATE_BEST
-                    ++frame;
-                    DrawDebug(gContour, workDetail, frame, paperIndex, detailsCount, details);
-            #   endif
-            #endif
-
-            SaveCandidate(bestResult, workDetail, j, i, BestFrom::Rotation);
-        }
-        ++frame;
-    }
+    const VLayoutPiece &detail = scheduler->GetDetail();
+    const QLineF detailEdge = gContour.GetContour().isEmpty() ? detail.DetailEdge(i) : detail.LayoutEdge(i);
+    const qreal angle_between = gContour.GlobalEdge(j).angleTo(detailEdge);
+    return VFuzzyComparePossibleNulls(angle_between, 360);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
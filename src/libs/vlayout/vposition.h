@@ -53,21 +53,84 @@
 #define VPOSITION_H
 
 #include <qcompilerdetection.h>
+#include <QRectF>
 #include <QRunnable>
 #include <QVector>
 #include <QtGlobal>
 #include <atomic>
+#include <memory>
 
 #include "vbestsquare.h"
+#include "vcollisionpolygon.h"
 #include "vcontour.h"
 #include "vlayoutdef.h"
 #include "vlayoutpiece.h"
 
+/**
+ * @brief The VPositionScheduler class describes one layout search and distributes it between workers.
+ *
+ * The search space (global edge, detail edge, step) is split into small jobs. Step 0 is the "combine edges" check,
+ * steps 1..n are the rotation angles. Each worker receives its own range of jobs and, after finishing it, steals jobs
+ * from the worker with the most work left. Workers also share the key of the best result found so far, which allows
+ * to skip candidates that cannot win anymore.
+ */
+class VPositionScheduler
+{
+public:
+    VPositionScheduler(const VContour &gContour, const VLayoutPiece &detail, std::atomic_bool *stop, bool rotate,
+                       int rotationIncrease, bool saveLength, int workersCount);
+
+    const VContour          &GetContour() const;
+    const VCollisionPolygon &GetContourPolygon() const;
+    const VLayoutPiece      &GetDetail() const;
+    std::atomic_bool   *GetStop() const;
+    bool                IsSaveLength() const;
+    int                 GetRotationIncrease() const;
+
+    int JobsCount() const;
+    int WorkersCount() const;
+
+    bool TakeJob(int worker, int &job);
+    void DecodeJob(int job, int &j, int &i, int &step) const;
+
+    bool CannotWin(const QRectF &detailRect, BestFrom type) const;
+    void PublishResult(const VBestSquare &result);
+
+private:
+    Q_DISABLE_COPY(VPositionScheduler)
+
+    struct JobRange
+    {
+        std::atomic<int> next;
+        int              end;
+    };
+
+    const VContour     gContour;
+    const VCollisionPolygon gPolygon;
+    const VLayoutPiece detail;
+    const QRectF       gRect;
+    std::atomic_bool  *stop;
+    bool               saveLength;
+    int                rotationIncrease;
+    int                detailEdgesCount;
+    int                stepsCount;
+    int                jobsCount;
+    int                workersCount;
+    std::unique_ptr<JobRange[]> ranges;
+    std::atomic<qint64> bestKey;
+
+    bool TakeFrom(int worker, int &job);
+    static qint64 Key(qint64 square, BestFrom type);
+};
+
+/**
+ * @brief The VPosition class is a layout search worker. It takes jobs from the scheduler and keeps its own best
+ * result. Results of all workers are reduced when the search is finished.
+ */
 class VPosition : public QRunnable
 {
 public:
-    VPosition(const VContour &gContour, int j, const VLayoutPiece &detail, int i, std::atomic_bool *stop, bool rotate,
-              int rotationIncrease, bool saveLength);
+    VPosition(VPositionScheduler *scheduler, int worker);
     virtual ~VPosition() Q_DECL_OVERRIDE{}
 
     quint32 getPaperIndex() const;
@@ -90,22 +153,15 @@ class VPosition : public QRunnable
 
 private:
     Q_DISABLE_COPY(VPosition)
+    VPositionScheduler *scheduler;
+    int worker;
     VBestSquare bestResult;
     const VContour gContour;
-    const VLayoutPiece detail;
-    int i;
-    int j;
     quint32 paperIndex;
     quint32 frame;
     quint32 detailsCount;
     QVector<VLayoutPiece> details;
     std::atomic_bool *stop;
-    bool rotate;
-    int rotationIncrease;
-    /**
-     * @brief angle_between keep angle between global edge and detail edge. Need for optimization rotation.
-     */
-    qreal angle_between;
 
     enum class CrossingType : char
     {
@@ -123,7 +179,8 @@ class VPosition : public QRunnable
 
     virtual void run() Q_DECL_OVERRIDE;
 
-    void SaveCandidate(VBestSquare &bestResult, const VLayoutPiece &detail, int globalI, int detJ, BestFrom type);
+    void SaveCandidate(VBestSquare &bestResult, const VLayoutPiece &detail, int globalI, int detJ, BestFrom type,
+                       int order);
 
     bool CheckCombineEdges(VLayoutPiece &detail, int j, int &dEdge);
     bool CheckRotationEdges(VLayoutPiece &detail, int j, int dEdge, int angle) const;
@@ -131,14 +188,16 @@ class VPosition : public QRunnable
     CrossingType Crossing(const VLayoutPiece &detail) const;
     bool         SheetContains(const QRectF &rect) const;
 
-    void CombineEdges(VLayoutPiece &detail, const QLineF &globalEdge, const int &dEdge);
+    static QVector<QPointF> DetailPoints(const VLayoutPiece &detail);
+
+    void CombineEdges(VLayoutPiece &detail, const QLineF &globalEdge, const int &dEdge) const;
     void RotateEdges(VLayoutPiece &detail, const QLineF &globalEdge, int dEdge, int angle) const;
 
+    bool SkipRotation(int j, int i, int angle) const;
+
     static QPainterPath ShowDirection(const QLineF &edge);
     static QPainterPath DrawContour(const QVector<QPointF> &points);
     static QPainterPath DrawDetails(const QVector<VLayoutPiece> &details);
-
-    void Rotate(int increase);
 };
 
 #endif // VPOSITION_H
@@ -337,10 +337,22 @@ void VTextManager::FitFontSize(qreal fW, qreal fH)
  * @param data reference to the detail data
  */
 void VTextManager::Update(const QString& qsName, const VPieceLabelData& data)
+{
+    Update(qsName, data, PreparePlaceholders(qApp->getCurrentDocument()));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief VTextManager::Update updates the text lines with detail data. Doesn't touch the application or the document,
+ * so can be called from any thread.
+ * @param qsName detail name
+ * @param data reference to the detail data
+ * @param placeholders placeholders of the pattern, see PatternPlaceholders()
+ */
+void VTextManager::Update(const QString& qsName, const VPieceLabelData& data, QMap<QString, QString> placeholders)
 {
     m_liLines.clear();
 
-    QMap<QString, QString> placeholders = PreparePlaceholders(qApp->getCurrentDocument());
     InitPiecePlaceholders(placeholders, qsName, data);
 
     QVector<VLabelTemplateLine> lines = data.GetLabelTemplate();
@@ -383,3 +395,42 @@ void VTextManager::Update(VAbstractPattern *pDoc)
 
     m_liLines = m_patternLabelLines;
 }
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief VTextManager::SetSourceLines set text lines prepared by another text manager
+ * @param lines text lines
+ */
+void VTextManager::SetSourceLines(const QList<TextLine> &lines)
+{
+    m_liLines = lines;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief VTextManager::PatternPlaceholders label placeholders of the pattern, piece placeholders are left empty
+ * @param doc pointer to the abstract pattern object
+ */
+QMap<QString, QString> VTextManager::PatternPlaceholders(const VAbstractPattern *doc)
+{
+    return PreparePlaceholders(doc);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief VTextManager::PatternLabelLines text lines of the pattern label made with the given placeholders. Unlike
+ * Update() doesn't use the lines cached for the current size and height.
+ * @param doc pointer to the abstract pattern object
+ * @param placeholders placeholders of the pattern, see PatternPlaceholders()
+ */
+QList<TextLine> VTextManager::PatternLabelLines(const VAbstractPattern *doc, const QMap<QString, QString> &placeholders)
+{
+    SCASSERT(doc != nullptr)
+
+    QVector<VLabelTemplateLine> lines = doc->GetPatternLabelTemplate();
+    for (int i=0; i<lines.size(); ++i)
+    {
+        lines[i].line = ReplacePlaceholders(placeholders, lines.at(i).line);
+    }
+    return PrepareLines(lines);
+}
@@ -32,6 +32,7 @@
 #include <QDate>
 #include <QFont>
 #include <QList>
+#include <QMap>
 #include <QString>
 #include <QStringList>
 #include <Qt>
@@ -84,7 +85,13 @@ class VTextManager
     const TextLine& GetSourceLine(int i) const;
 
     void Update(const QString& qsName, const VPieceLabelData& data);
+    void Update(const QString& qsName, const VPieceLabelData& data, QMap<QString, QString> placeholders);
     void Update(VAbstractPattern* pDoc);
+    void SetSourceLines(const QList<TextLine> &lines);
+
+    static QMap<QString, QString> PatternPlaceholders(const VAbstractPattern *doc);
+    static QList<TextLine>        PatternLabelLines(const VAbstractPattern *doc,
+                                                    const QMap<QString, QString> &placeholders);
 
 private:
     QFont           m_font;
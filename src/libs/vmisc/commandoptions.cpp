@@ -109,8 +109,18 @@ const QString SINGLE_OPTION_GAPWIDTH        = QStringLiteral("G");
 const QString LONG_OPTION_GROUPPING         = QStringLiteral("groups");
 const QString SINGLE_OPTION_GROUPPING       = QStringLiteral("g");
 
+const QString LONG_OPTION_ENGINE            = QStringLiteral("engine");
+const QString LONG_OPTION_ATTEMPTS          = QStringLiteral("attempts");
+const QString LONG_OPTION_TIMEBUDGET        = QStringLiteral("timebudget");
+
+const QString LONG_OPTION_BATCH             = QStringLiteral("batch");
+const QString LONG_OPTION_BATCHJOBS         = QStringLiteral("jobs");
+const QString LONG_OPTION_BATCHREPORT       = QStringLiteral("batchreport");
+
 const QString LONG_OPTION_TEST              = QStringLiteral("test");
 const QString SINGLE_OPTION_TEST            = QStringLiteral("t");
+const QString LONG_OPTION_TESTINCREMENTAL   = QStringLiteral("testincremental");
+const QString LONG_OPTION_TESTGRADATIONS    = QStringLiteral("testgradations");
 
 const QString LONG_OPTION_GRADATIONSIZE     = QStringLiteral("gsize");
 const QString SINGLE_OPTION_GRADATIONSIZE   = QStringLiteral("x");
@@ -154,7 +164,12 @@ QStringList AllKeys()
          << LONG_OPTION_SHIFTUNITS << SINGLE_OPTION_SHIFTUNITS
          << LONG_OPTION_GAPWIDTH << SINGLE_OPTION_GAPWIDTH
          << LONG_OPTION_GROUPPING << SINGLE_OPTION_GROUPPING
-         << LONG_OPTION_TEST << SINGLE_OPTION_TEST
+         << LONG_OPTION_ENGINE
+         << LONG_OPTION_ATTEMPTS
+         << LONG_OPTION_TIMEBUDGET
+         << LONG_OPTION_BATCH << LONG_OPTION_BATCHJOBS << LONG_OPTION_BATCHREPORT
+         << LONG_OPTION_TEST << SINGLE_OPTION_TEST << LONG_OPTION_TESTINCREMENTAL
+         << LONG_OPTION_TESTGRADATIONS
          << LONG_OPTION_GRADATIONSIZE << SINGLE_OPTION_GRADATIONSIZE
          << LONG_OPTION_GRADATIONHEIGHT << SINGLE_OPTION_GRADATIONHEIGHT
          << LONG_OPTION_IGNORE_MARGINS << SINGLE_OPTION_IGNORE_MARGINS
@@ -106,8 +106,18 @@ extern const QString SINGLE_OPTION_GAPWIDTH;
 extern const QString LONG_OPTION_GROUPPING;
 extern const QString SINGLE_OPTION_GROUPPING;
 
+extern const QString LONG_OPTION_ENGINE;
+extern const QString LONG_OPTION_ATTEMPTS;
+extern const QString LONG_OPTION_TIMEBUDGET;
+
+extern const QString LONG_OPTION_BATCH;
+extern const QString LONG_OPTION_BATCHJOBS;
+extern const QString LONG_OPTION_BATCHREPORT;
+
 extern const QString LONG_OPTION_TEST;
 extern const QString SINGLE_OPTION_TEST;
+extern const QString LONG_OPTION_TESTINCREMENTAL;
+extern const QString LONG_OPTION_TESTGRADATIONS;
 
 extern const QString LONG_OPTION_GRADATIONSIZE;
 extern const QString SINGLE_OPTION_GRADATIONSIZE;
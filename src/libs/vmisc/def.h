@@ -254,6 +254,14 @@ enum class Vis : ToolVisHolderType
 enum class VarType : char { Measurement, Increment, LineLength, CurveLength, CurveCLength, LineAngle, CurveAngle,
                             ArcRadius, Unknown };
 
+/**
+ * @brief Curve approximation scale controls how finely curves are flattened into polylines. The allowed deviation of
+ * the polyline from the curve is 0.5 px divided by the scale.
+ */
+static const qreal defCurveApproximationScale = 1.0;
+static const qreal minCurveApproximationScale = 0.1;
+static const qreal maxCurveApproximationScale = 10.0;
+
 static const int heightStep = 6;
 enum class GHeights : unsigned char { ALL,
                                       H50=50,   H56=56,   H62=62,   H68=68,   H74=74,   H80=80,   H86=86,   H92=92,
@@ -77,6 +77,7 @@ VAbstractApplication::VAbstractApplication(int &argc, char **argv)
       pmsTranslator(nullptr),
       _patternUnit(Unit::Cm),
       _patternType(MeasurementsType::Unknown),
+      curveApproximationScale(defCurveApproximationScale),
       patternFilePath(),
       currentScene(nullptr),
       sceneView(nullptr),
@@ -241,6 +242,21 @@ QUndoStack *VAbstractApplication::getUndoStack() const
     return undoStack;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GetCurveApproximationScale return approximation scale used for flattening curves of the current pattern.
+ */
+qreal VAbstractApplication::GetCurveApproximationScale() const
+{
+    return curveApproximationScale;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VAbstractApplication::SetCurveApproximationScale(qreal value)
+{
+    curveApproximationScale = qBound(minCurveApproximationScale, value, maxCurveApproximationScale);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 Unit VAbstractApplication::patternUnit() const
 {
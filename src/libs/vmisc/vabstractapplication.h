@@ -100,6 +100,9 @@ class VAbstractApplication : public QApplication
     MeasurementsType patternType() const;
     void             setPatternType(const MeasurementsType &patternType);
 
+    qreal            GetCurveApproximationScale() const;
+    void             SetCurveApproximationScale(qreal value);
+
     virtual void     OpenSettings()=0;
     VCommonSettings *Settings();
 
@@ -157,6 +160,7 @@ class VAbstractApplication : public QApplication
     Q_DISABLE_COPY(VAbstractApplication)
     Unit               _patternUnit;
     MeasurementsType   _patternType;
+    qreal              curveApproximationScale;
     QString            patternFilePath;
 
     QGraphicsScene     **currentScene;
@@ -125,6 +125,7 @@ const QString settingDefaultNotchType                    = QStringLiteral("patte
 const QString settingDoubleNotch                         = QStringLiteral("pattern/doubleNotch");
 
 const QString settingPatternDefaultSeamAllowance         = QStringLiteral("pattern/defaultSeamAllowance");
+const QString settingPatternCurveApproximationScale      = QStringLiteral("pattern/curveApproximationScale");
 const QString settingPatternLabelFont                    = QStringLiteral("pattern/labelFont");
 const QString settingPatternGuiFont                      = QStringLiteral("pattern/guiFont");
 const QString settingPatternPointNameFont                = QStringLiteral("pattern/pointNameFont");
@@ -951,6 +952,25 @@ void VCommonSettings::setDefaultNotchWidth(const qreal &value)
     setValue(settingDefaultNotchWidth, value);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+qreal VCommonSettings::GetCurveApproximationScale() const
+{
+    bool ok = false;
+    const qreal scale = value(settingPatternCurveApproximationScale, defCurveApproximationScale).toReal(&ok);
+    if (not ok || scale < minCurveApproximationScale || scale > maxCurveApproximationScale)
+    {
+        return defCurveApproximationScale;
+    }
+    return scale;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VCommonSettings::SetCurveApproximationScale(qreal value)
+{
+    setValue(settingPatternCurveApproximationScale,
+             qBound(minCurveApproximationScale, value, maxCurveApproximationScale));
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 QString VCommonSettings::getDefaultNotchType() const
 {
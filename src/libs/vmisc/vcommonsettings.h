@@ -224,6 +224,9 @@ class VCommonSettings : public QSettings
     QString              getDefaultNotchType() const;
     void                 setDefaultNotchType(const QString &value);
 
+    qreal                GetCurveApproximationScale() const;
+    void                 SetCurveApproximationScale(qreal value);
+
     void                 SetCSVWithHeader(bool withHeader);
     bool                 GetCSVWithHeader() const;
     bool                 GetDefCSVWithHeader() const;
@@ -103,6 +103,11 @@ const QString settingIgnoreFields           = QStringLiteral("layout/ignoreField
 const QString settingStripOptimization      = QStringLiteral("layout/stripOptimization");
 const QString settingMultiplier             = QStringLiteral("layout/multiplier");
 const QString settingTextAsPaths            = QStringLiteral("layout/textAsPaths");
+const QString settingLayoutEngine           = QStringLiteral("layout/engine");
+const QString settingLayoutAttempts         = QStringLiteral("layout/attempts");
+const QString settingLayoutTimeBudget       = QStringLiteral("layout/timeBudget");
+const QString settingLayoutIncremental      = QStringLiteral("layout/incremental");
+const QString settingLayoutIncThreshold     = QStringLiteral("layout/incrementalThreshold");
 
 const QString settingTiledPDFMargins        = QStringLiteral("tiledPDF/margins");
 const QString settingTiledPDFPaperHeight    = QStringLiteral("tiledPDF/paperHeight");
@@ -635,6 +640,112 @@ void VSettings::SetTextAsPaths(bool value)
     setValue(settingTextAsPaths, value);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+LayoutEngine VSettings::GetLayoutEngine() const
+{
+    const LayoutEngine def = GetDefLayoutEngine();
+    bool ok = false;
+    const int engine = value(settingLayoutEngine, static_cast<int>(def)).toInt(&ok);
+    if (ok && engine >= 0 && engine < static_cast<int>(LayoutEngine::UnknownEngine))
+    {
+        return static_cast<LayoutEngine>(engine);
+    }
+    else
+    {
+        return def;
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+LayoutEngine VSettings::GetDefLayoutEngine()
+{
+    return LayoutEngine::Contour;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VSettings::SetLayoutEngine(const LayoutEngine &value)
+{
+    setValue(settingLayoutEngine, static_cast<int>(value));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VSettings::GetLayoutAttempts() const
+{
+    bool ok = false;
+    const int attempts = value(settingLayoutAttempts, GetDefLayoutAttempts()).toInt(&ok);
+    return ok && attempts >= 1 ? attempts : GetDefLayoutAttempts();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VSettings::GetDefLayoutAttempts()
+{
+    return 1;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VSettings::SetLayoutAttempts(int value)
+{
+    setValue(settingLayoutAttempts, value);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VSettings::GetLayoutTimeBudget() const
+{
+    bool ok = false;
+    const int budget = value(settingLayoutTimeBudget, GetDefLayoutTimeBudget()).toInt(&ok);
+    return ok && budget >= 0 ? budget : GetDefLayoutTimeBudget();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VSettings::GetDefLayoutTimeBudget()
+{
+    return 0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VSettings::SetLayoutTimeBudget(int value)
+{
+    setValue(settingLayoutTimeBudget, value);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VSettings::GetLayoutIncremental() const
+{
+    return value(settingLayoutIncremental, GetDefLayoutIncremental()).toBool();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VSettings::GetDefLayoutIncremental()
+{
+    return false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VSettings::SetLayoutIncremental(bool value)
+{
+    setValue(settingLayoutIncremental, value);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VSettings::GetLayoutIncrementalThreshold() const
+{
+    bool ok = false;
+    const int threshold = value(settingLayoutIncThreshold, GetDefLayoutIncrementalThreshold()).toInt(&ok);
+    return ok && threshold >= 0 && threshold <= 100 ? threshold : GetDefLayoutIncrementalThreshold();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+int VSettings::GetDefLayoutIncrementalThreshold()
+{
+    return 10;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VSettings::SetLayoutIncrementalThreshold(int value)
+{
+    setValue(settingLayoutIncThreshold, value);
+}
+
 // settings for the tiled PDFs
 //---------------------------------------------------------------------------------------------------------------------
 /**
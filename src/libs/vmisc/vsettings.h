@@ -60,6 +60,7 @@
 
 #include "../vmisc/def.h"
 #include "../vlayout/vbank.h"
+#include "../vlayout/vlayoutdef.h"
 #include "vcommonsettings.h"
 
 template <class T> class QSharedPointer;
@@ -179,6 +180,26 @@ class VSettings : public VCommonSettings
     static bool GetDefTextAsPaths();
     void SetTextAsPaths(bool value);
 
+    LayoutEngine GetLayoutEngine() const;
+    static LayoutEngine GetDefLayoutEngine();
+    void SetLayoutEngine(const LayoutEngine &value);
+
+    int GetLayoutAttempts() const;
+    static int GetDefLayoutAttempts();
+    void SetLayoutAttempts(int value);
+
+    int GetLayoutTimeBudget() const;
+    static int GetDefLayoutTimeBudget();
+    void SetLayoutTimeBudget(int value);
+
+    bool GetLayoutIncremental() const;
+    static bool GetDefLayoutIncremental();
+    void SetLayoutIncremental(bool value);
+
+    int GetLayoutIncrementalThreshold() const;
+    static int GetDefLayoutIncrementalThreshold();
+    void SetLayoutIncrementalThreshold(int value);
+
     // settings for the tiled PDFs
     QMarginsF GetTiledPDFMargins(const Unit &unit) const;
     void SetTiledPDFMargins(const QMarginsF &value, const Unit &unit);
@@ -51,15 +51,92 @@
 
 #include "calculator.h"
 
+#include <QAtomicInt>
+#include <QReadLocker>
+#include <QReadWriteLock>
 #include <QStaticStringData>
 #include <QStringData>
 #include <QStringDataPtr>
 #include <QStringList>
+#include <QVector>
+#include <QWriteLocker>
 
 #include "../vmisc/def.h"
 #include "../qmuparser/qmuparsererror.h"
+#include "../qmuparser/qmuparserbytecode.h"
 #include "variables/vinternalvariable.h"
 #include <QSharedPointer>
+
+/**
+ * @brief The CompiledFormula struct keeps bytecode of a formula that has passed full parsing.
+ *
+ * Variables in the bytecode point to slots. Before evaluation a copy of the bytecode is rebound to variables listed in
+ * names.
+ */
+struct CompiledFormula
+{
+    CompiledFormula()
+        : byteCode(),
+          finalResultIdx(0),
+          slots(),
+          names(),
+          positions(),
+          tokens(),
+          numbers()
+    {}
+
+    qmu::QmuParserByteCode byteCode;
+    int                    finalResultIdx;
+    QVector<qreal>         slots;     // Values of variables at compile time, only their addresses matter.
+    QStringList            names;     // Variable name for each slot.
+    QVector<int>           positions; // Position of each variable in formula, for error messages.
+    QMap<int, QString>     tokens;
+    QMap<int, QString>     numbers;
+};
+
+namespace
+{
+// Formula dialogs evaluate each typed version of a formula, don't let them grow the cache forever.
+const int maxCachedFormulas = 20000;
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief VariableValue read value through the const interface. It doesn't detach or write to the variable, so copies
+ * of a container can evaluate formulas on several threads at once.
+ */
+qreal VariableValue(const QSharedPointer<const VInternalVariable> &variable)
+{
+    return variable->GetValue();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QReadWriteLock &CacheLock()
+{
+    static QReadWriteLock lock;
+    return lock;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QHash<QString, QSharedPointer<const CompiledFormula>> &Cache()
+{
+    static QHash<QString, QSharedPointer<const CompiledFormula>> cache;
+    return cache;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QAtomicInt &CacheHitsCounter()
+{
+    static QAtomicInt hits;
+    return hits;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QAtomicInt &CacheMissesCounter()
+{
+    static QAtomicInt misses;
+    return misses;
+}
+}
 //---------------------------------------------------------------------------------------------------------------------
 /**
  * @brief Calculator class wraper for QMuParser. Make easy initialization math parser.
@@ -75,7 +152,8 @@
  *
  */
 Calculator::Calculator()
-    :QmuFormulaBase()
+    :QmuFormulaBase(),
+      values()
 {
     InitCharSets();
     setAllowSubexpressions(false);//Only one expression per time
@@ -87,25 +165,48 @@ Calculator::Calculator()
 /**
  * @brief eval calculate formula.
  *
- * First we try eval expression without adding variables. If it fail, we take tokens from expression and add variables
- * to parser and try again.
+ * First we look for compiled bytecode of the formula in the formula cache. If found, we only bind variables to the
+ * bytecode and evaluate it. Otherwise we try eval expression without adding variables. If it fail, we take tokens
+ * from expression and add variables to parser and try again. Bytecode of successfully parsed formula goes to the
+ * cache.
  *
  * @param formula string of formula.
  * @return value of formula.
  */
-qreal Calculator::EvalFormula(const QHash<QString, QSharedPointer<VInternalVariable>> *vars, const QString &formula)
+qreal Calculator::EvalFormula(const VVersionedHash<QString, QSharedPointer<VInternalVariable>> *vars,
+                              const QString &formula)
 {
-    // Parser doesn't know any variable on this stage. So, we just use variable factory that for each unknown variable
-    // set value to 0.
-    SetVarFactory(AddVariable, this);
     SetSepForEval();//Reset separators options
 
+    QSharedPointer<const CompiledFormula> compiled;
+    {
+        QReadLocker locker(&CacheLock());
+        compiled = Cache().value(formula);
+    }
+
+    if (not compiled.isNull())
+    {
+        CacheHitsCounter().ref();
+        return EvalCompiled(vars, formula, *compiled);
+    }
+
+    CacheMissesCounter().ref();
+
+    // Forget variables of previous formula. Parser doesn't know any variable on this stage. So, we just use variable
+    // factory that for each unknown variable set value to 0.
+    ClearVar();
+    SetVarFactory(AddVariable, this);
+
     SetExpr(formula);
 
     qreal result = 0;
     result = Eval();
 
-    QMap<int, QString> tokens = this->GetTokens();
+    QSharedPointer<CompiledFormula> newCompiled(new CompiledFormula);
+    newCompiled->tokens = this->GetTokens();
+    newCompiled->numbers = this->GetNumbers();
+
+    QMap<int, QString> tokens = newCompiled->tokens;
 
     // Remove "-" from tokens list if exist. If don't do that unary minus operation will broken.
     RemoveAll(tokens, QStringLiteral("-"));
@@ -119,36 +220,128 @@ qreal Calculator::EvalFormula(const QHash<QString, QSharedPointer<VInternalVaria
         RemoveAll(tokens, builInFunctions.at(i));
     }
 
-    if (tokens.isEmpty())
+    if (not tokens.isEmpty())
     {
-        return result; // We have found only numbers in expression.
+        // Add variables to parser because we have deal with expression with variables.
+        InitVariables(vars, tokens, formula, newCompiled.data());
+        result = Eval();
     }
+    // else we have found only numbers in expression.
 
-    // Add variables to parser because we have deal with expression with variables.
-    InitVariables(vars, tokens, formula);
-    return Eval();
+    newCompiled->byteCode = GetByteCode();
+    newCompiled->finalResultIdx = GetNumResults();
+
+    QWriteLocker locker(&CacheLock());
+    if (Cache().size() >= maxCachedFormulas)
+    {
+        Cache().clear();
+    }
+    Cache().insert(formula, newCompiled);
+
+    return result;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief EvalFormulaBulk calculate formula for many sets of values of variables, e.g. for all sizes of a multisize
+ * table.
+ *
+ * Variables listed in columns take value of row i from element i of their column, all other variables keep their
+ * current value for all rows. The formula is checked with EvalFormula() first, so errors are the same as for a single
+ * evaluation.
+ *
+ * @param vars list of variables.
+ * @param formula string of formula.
+ * @param columns values of variables by name, each column must have at least nBulkSize values.
+ * @param nBulkSize number of rows.
+ * @return nBulkSize values of formula.
+ */
+QVector<qreal> Calculator::EvalFormulaBulk(const VVersionedHash<QString, QSharedPointer<VInternalVariable> > *vars,
+                                           const QString &formula, const QMap<QString, QVector<qreal> > &columns,
+                                           int nBulkSize)
+{
+    EvalFormula(vars, formula);
+
+    QMap<QString, QVector<qreal> > bulkColumns;
+    const QList<QString> tokens = GetTokens().values();
+    for (auto &token : tokens)
+    {
+        if (bulkColumns.contains(token))
+        {
+            continue;
+        }
+
+        if (columns.contains(token))
+        {
+            bulkColumns.insert(token, columns.value(token));
+        }
+        else if (vars->contains(token))
+        {
+            bulkColumns.insert(token, QVector<qreal>(nBulkSize, VariableValue(vars->value(token))));
+        }
+    }
+
+    return EvalBulk(formula, bulkColumns, nBulkSize);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief CacheHits return how many times EvalFormula has found a formula in the formula cache.
+ */
+int Calculator::CacheHits()
+{
+    return CacheHitsCounter().load();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief CacheMisses return how many times EvalFormula had to parse a formula.
+ */
+int Calculator::CacheMisses()
+{
+    return CacheMissesCounter().load();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ClearCache drop all compiled formulas and reset hit/miss counters.
+ */
+void Calculator::ClearCache()
+{
+    QWriteLocker locker(&CacheLock());
+    Cache().clear();
+    CacheHitsCounter().store(0);
+    CacheMissesCounter().store(0);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 /**
  * @brief Calculator::InitVariables add variables to parser.
  *
- * For optimization purpose we try don't add variables that we don't need.
+ * For optimization purpose we try don't add variables that we don't need. Each variable is bound to own slot of
+ * compiled formula, so the bytecode can be rebound to other variables later.
  *
  * @param vars list of variables.
  * @param tokens all tokens (measurements names, variables with lengths) that parser have found in expression.
  * @param formula expression, need for throwing better error message.
+ * @param compiled formula cache entry that receives names and slots of variables.
  */
-void Calculator::InitVariables(const QHash<QString, QSharedPointer<VInternalVariable> > *vars,
-                               const QMap<int, QString> &tokens, const QString &formula)
+void Calculator::InitVariables(const VVersionedHash<QString, QSharedPointer<VInternalVariable> > *vars,
+                               const QMap<int, QString> &tokens, const QString &formula, CompiledFormula *compiled)
 {
+    SCASSERT(compiled != nullptr)
+
     QMap<int, QString>::const_iterator i = tokens.constBegin();
     while (i != tokens.constEnd())
     {
         bool found = false;
         if (vars->contains(i.value()))
         {
-            DefineVar(i.value(), vars->value(i.value())->GetValue());
+            if (not compiled->names.contains(i.value()))
+            {
+                compiled->names.append(i.value());
+                compiled->positions.append(i.key());
+            }
             found = true;
         }
 
@@ -163,4 +356,51 @@ void Calculator::InitVariables(const QHash<QString, QSharedPointer<VInternalVari
         }
         ++i;
     }
+
+    // Slots must not reallocate after variables were defined
+    compiled->slots.resize(compiled->names.size());
+    for (int n = 0; n < compiled->names.size(); ++n)
+    {
+        compiled->slots[n] = VariableValue(vars->value(compiled->names.at(n)));
+        DefineVar(compiled->names.at(n), &compiled->slots[n]);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief EvalCompiled evaluate cached bytecode of formula with current values of variables.
+ * @param vars list of variables.
+ * @param formula expression, need for throwing better error message.
+ * @param compiled formula cache entry.
+ * @return value of formula.
+ */
+qreal Calculator::EvalCompiled(const VVersionedHash<QString, QSharedPointer<VInternalVariable> > *vars,
+                               const QString &formula, const CompiledFormula &compiled)
+{
+    // Bytecode reads copies of the values, variables themselves stay untouched
+    values.resize(compiled.names.size());
+    QVector<qreal *> bindings;
+    bindings.reserve(compiled.names.size());
+    for (int n = 0; n < compiled.names.size(); ++n)
+    {
+        const QSharedPointer<VInternalVariable> var = vars->value(compiled.names.at(n));
+        if (var.isNull())
+        {
+            throw qmu::QmuParserError (qmu::ecUNASSIGNABLE_TOKEN, compiled.names.at(n), formula,
+                                       compiled.positions.at(n));
+        }
+        values[n] = VariableValue(var);
+        bindings.append(values.data() + n);
+    }
+
+    SetExpr(formula);
+
+    qmu::QmuParserByteCode byteCode(compiled.byteCode);
+    byteCode.RebindVariables(compiled.slots.constData(), bindings);
+    SetByteCode(byteCode, compiled.finalResultIdx);
+
+    m_Tokens = compiled.tokens;
+    m_Numbers = compiled.numbers;
+
+    return Eval();
 }
@@ -56,16 +56,23 @@
 #include <QHash>
 #include <QMap>
 #include <QString>
+#include <QVector>
 #include <QtGlobal>
 
 #include "../qmuparser/qmuformulabase.h"
 
 //class VInternalVariable;
 #include "variables/vinternalvariable.h"
+#include "vversionedhash.h"
+
+struct CompiledFormula;
+
 /**
  * @brief The Calculator class for calculation formula.
  *
  * Main purpose make easy evaluate value of formula and get tokens.
+ * Bytecode of parsed formulas is kept in a process-wide cache shared by all instances, so evaluating the same formula
+ * again only binds current values of variables. See CacheHits(), CacheMisses() and ClearCache().
  * Note. If created to many parser for different purpes in the same time parser can work wrong.
  * Example:
  * DialogEditWrongFormula *dialog = new DialogEditWrongFormula(data);
@@ -86,12 +93,25 @@ class Calculator:public qmu::QmuFormulaBase
     Calculator();
     virtual ~Calculator() Q_DECL_EQ_DEFAULT;
 
-    qreal EvalFormula(const QHash<QString, QSharedPointer<VInternalVariable> > *vars, const QString &formula);
+    qreal EvalFormula(const VVersionedHash<QString, QSharedPointer<VInternalVariable> > *vars,
+                      const QString &formula);
+    QVector<qreal> EvalFormulaBulk(const VVersionedHash<QString, QSharedPointer<VInternalVariable> > *vars,
+                                   const QString &formula, const QMap<QString, QVector<qreal> > &columns,
+                                   int nBulkSize);
+
+    static int  CacheHits();
+    static int  CacheMisses();
+    static void ClearCache();
 private:
     Q_DISABLE_COPY(Calculator)
 
-    void InitVariables(const QHash<QString, QSharedPointer<VInternalVariable> > *vars, const QMap<int, QString> &tokens,
-                       const QString &formula);
+    /** @brief values copies of variable values the current bytecode reads. */
+    QVector<qreal> values;
+
+    void  InitVariables(const VVersionedHash<QString, QSharedPointer<VInternalVariable> > *vars,
+                        const QMap<int, QString> &tokens, const QString &formula, CompiledFormula *compiled);
+    qreal EvalCompiled(const VVersionedHash<QString, QSharedPointer<VInternalVariable> > *vars, const QString &formula,
+                       const CompiledFormula &compiled);
 };
 
 #endif // CALCULATOR_H
@@ -56,6 +56,7 @@
 
 #include "../vmisc/def.h"
 #include "../ifc/ifcdef.h"
+#include "../vgeometry/vabstractcubicbezierpath.h"
 #include "../vgeometry/vabstractcurve.h"
 #include "../vgeometry/vspline.h"
 #include "vcurvevariable.h"
@@ -68,38 +69,46 @@ VCurveAngle::VCurveAngle()
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-VCurveAngle::VCurveAngle(const quint32 &id, const quint32 &parentId, const VAbstractCurve *curve, CurveAngle angle)
+/**
+ * @brief VCurveAngle start or end angle of a curve. The angle is calculated on first request.
+ */
+VCurveAngle::VCurveAngle(const quint32 &id, const quint32 &parentId, const QSharedPointer<VAbstractCurve> &curve,
+                         CurveAngle angle)
     :VCurveVariable(id, parentId)
 {
     SetType(VarType::CurveAngle);
-    SCASSERT(curve != nullptr)
+    SCASSERT(not curve.isNull())
     if (angle == CurveAngle::StartAngle)
     {
-        SetValue(curve->GetStartAngle());
+        SetLazyValue([curve]() {return curve->GetStartAngle();});
         SetName(angle1_V + curve->name());
     }
     else
     {
-        SetValue(curve->GetEndAngle());
+        SetLazyValue([curve]() {return curve->GetEndAngle();});
         SetName(angle2_V + curve->name());
     }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-VCurveAngle::VCurveAngle(const quint32 &id, const quint32 &parentId, const QString &baseCurveName, const VSpline &spl,
-                         CurveAngle angle, qint32 segment)
+/**
+ * @brief VCurveAngle start or end angle of a segment of a curve path. The angle is calculated on first request.
+ */
+VCurveAngle::VCurveAngle(const quint32 &id, const quint32 &parentId,
+                         const QSharedPointer<VAbstractCubicBezierPath> &curve, CurveAngle angle, qint32 segment)
     :VCurveVariable(id, parentId)
 {
     SetType(VarType::CurveAngle);
+    SCASSERT(not curve.isNull())
     if (angle == CurveAngle::StartAngle)
     {
-        SetValue(spl.GetStartAngle());
-        SetName(angle1_V + baseCurveName + QLatin1String("_") + seg_ + QString().setNum(segment));
+        SetLazyValue([curve, segment]() {return curve->GetSpline(segment).GetStartAngle();});
+        SetName(angle1_V + curve->name() + QLatin1String("_") + seg_ + QString().setNum(segment));
     }
     else
     {
-        SetValue(spl.GetEndAngle());
-        SetName(angle2_V + baseCurveName + QLatin1String("_") + seg_ + QString().setNum(segment));
+        SetLazyValue([curve, segment]() {return curve->GetSpline(segment).GetEndAngle();});
+        SetName(angle2_V + curve->name() + QLatin1String("_") + seg_ + QString().setNum(segment));
     }
 }
 
@@ -53,13 +53,14 @@
 #define VCURVEANGLE_H
 
 #include <qcompilerdetection.h>
+#include <QSharedPointer>
 #include <QString>
 #include <QtGlobal>
 
 #include "vcurvevariable.h"
 
 class VAbstractCurve;
-class VSpline;
+class VAbstractCubicBezierPath;
 
 enum class CurveAngle : char { StartAngle, EndAngle };
 
@@ -67,8 +68,9 @@ class VCurveAngle : public VCurveVariable
 {
 public:
     VCurveAngle();
-    VCurveAngle(const quint32 &id, const quint32 &parentId, const VAbstractCurve *curve, CurveAngle angle);
-    VCurveAngle(const quint32 &id, const quint32 &parentId, const QString &baseCurveName, const VSpline &spl,
+    VCurveAngle(const quint32 &id, const quint32 &parentId, const QSharedPointer<VAbstractCurve> &curve,
+                CurveAngle angle);
+    VCurveAngle(const quint32 &id, const quint32 &parentId, const QSharedPointer<VAbstractCubicBezierPath> &curve,
                 CurveAngle angle, qint32 segment);
     VCurveAngle(const VCurveAngle &var);
     VCurveAngle &operator=(const VCurveAngle &var);
@@ -56,6 +56,7 @@
 
 #include "../vmisc/def.h"
 #include "../ifc/ifcdef.h"
+#include "../vgeometry/vabstractcubicbezierpath.h"
 #include "../vgeometry/vabstractcurve.h"
 #include "../vgeometry/vspline.h"
 #include "vcurvevariable.h"
@@ -68,39 +69,55 @@ VCurveCLength::VCurveCLength()
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-VCurveCLength::VCurveCLength(const quint32 &id, const quint32 &parentId, const VAbstractBezier *curve,
+/**
+ * @brief VCurveCLength length of the first or the second control line of a curve. The length is calculated on first
+ * request.
+ */
+VCurveCLength::VCurveCLength(const quint32 &id, const quint32 &parentId, const QSharedPointer<VAbstractBezier> &curve,
                              CurveCLength cType, Unit patternUnit)
     : VCurveVariable(id, parentId)
 {
     SetType(VarType::CurveCLength);
-    SCASSERT(curve != nullptr)
+    SCASSERT(not curve.isNull())
     if (cType == CurveCLength::C1)
     {
-        SetValue(FromPixel(curve->GetC1Length(), patternUnit));
+        SetLazyValue([curve, patternUnit]() {return FromPixel(curve->GetC1Length(), patternUnit);});
         SetName(c1Length_V + curve->name());
     }
     else
     {
-        SetValue(FromPixel(curve->GetC2Length(), patternUnit));
+        SetLazyValue([curve, patternUnit]() {return FromPixel(curve->GetC2Length(), patternUnit);});
         SetName(c2Length_V + curve->name());
     }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-VCurveCLength::VCurveCLength(const quint32 &id, const quint32 &parentId, const QString &baseCurveName,
-                             const VSpline &spl, CurveCLength cType, Unit patternUnit, qint32 segment)
+/**
+ * @brief VCurveCLength length of the first or the second control line of a segment of a curve path. The length is
+ * calculated on first request.
+ */
+VCurveCLength::VCurveCLength(const quint32 &id, const quint32 &parentId,
+                             const QSharedPointer<VAbstractCubicBezierPath> &curve, CurveCLength cType,
+                             Unit patternUnit, qint32 segment)
     : VCurveVariable(id, parentId)
 {
     SetType(VarType::CurveCLength);
+    SCASSERT(not curve.isNull())
     if (cType == CurveCLength::C1)
     {
-        SetValue(FromPixel(spl.GetC1Length(), patternUnit));
-        SetName(c1Length_V + baseCurveName + QLatin1String("_") + seg_ + QString().setNum(segment));
+        SetLazyValue([curve, patternUnit, segment]()
+        {
+            return FromPixel(curve->GetSpline(segment).GetC1Length(), patternUnit);
+        });
+        SetName(c1Length_V + curve->name() + QLatin1String("_") + seg_ + QString().setNum(segment));
     }
     else
     {
-        SetValue(FromPixel(spl.GetC2Length(), patternUnit));
-        SetName(c2Length_V + baseCurveName + QLatin1String("_") + seg_ + QString().setNum(segment));
+        SetLazyValue([curve, patternUnit, segment]()
+        {
+            return FromPixel(curve->GetSpline(segment).GetC2Length(), patternUnit);
+        });
+        SetName(c2Length_V + curve->name() + QLatin1String("_") + seg_ + QString().setNum(segment));
     }
 }
 
@@ -53,6 +53,7 @@
 #define VCURVECLENGTH_H
 
 #include <qcompilerdetection.h>
+#include <QSharedPointer>
 #include <QString>
 #include <QtGlobal>
 
@@ -61,16 +62,16 @@
 enum class CurveCLength : char { C1, C2 };
 
 class VAbstractBezier;
-class VSpline;
+class VAbstractCubicBezierPath;
 
 class VCurveCLength : public VCurveVariable
 {
 public:
     VCurveCLength();
-    VCurveCLength(const quint32 &id, const quint32 &parentId, const VAbstractBezier *curve, CurveCLength cType,
-                  Unit patternUnit);
-    VCurveCLength(const quint32 &id, const quint32 &parentId, const QString &baseCurveName, const VSpline &spl,
-                 CurveCLength cType, Unit patternUnit, qint32 segment);
+    VCurveCLength(const quint32 &id, const quint32 &parentId, const QSharedPointer<VAbstractBezier> &curve,
+                  CurveCLength cType, Unit patternUnit);
+    VCurveCLength(const quint32 &id, const quint32 &parentId, const QSharedPointer<VAbstractCubicBezierPath> &curve,
+                  CurveCLength cType, Unit patternUnit, qint32 segment);
     VCurveCLength(const VCurveCLength &var);
     VCurveCLength &operator=(const VCurveCLength &var);
     virtual ~VCurveCLength() Q_DECL_OVERRIDE;
@@ -55,6 +55,7 @@
 #include <QMessageLogger>
 
 #include "../ifc/ifcdef.h"
+#include "../vgeometry/vabstractcubicbezierpath.h"
 #include "../vgeometry/vabstractcurve.h"
 #include "../vgeometry/vspline.h"
 #include "vcurvevariable.h"
@@ -67,25 +68,34 @@ VCurveLength::VCurveLength()
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-VCurveLength::VCurveLength(const quint32 &id, const quint32 &parentId, const VAbstractCurve *curve, Unit patternUnit)
+/**
+ * @brief VCurveLength length of a curve. The length is calculated on first request.
+ */
+VCurveLength::VCurveLength(const quint32 &id, const quint32 &parentId, const QSharedPointer<VAbstractCurve> &curve,
+                           Unit patternUnit)
     :VCurveVariable(id, parentId)
 {
     SetType(VarType::CurveLength);
-    SCASSERT(curve != nullptr)
+    SCASSERT(not curve.isNull())
     SetName(curve->name());
-    SetValue(FromPixel(curve->GetLength(), patternUnit));
+    SetLazyValue([curve, patternUnit]() {return FromPixel(curve->GetLength(), patternUnit);});
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-VCurveLength::VCurveLength(const quint32 &id, const quint32 &parentId, const QString &baseCurveName, const VSpline &spl,
-                           Unit patternUnit, qint32 segment)
+/**
+ * @brief VCurveLength length of a segment of a curve path. The length is calculated on first request.
+ */
+VCurveLength::VCurveLength(const quint32 &id, const quint32 &parentId,
+                           const QSharedPointer<VAbstractCubicBezierPath> &curve, Unit patternUnit, qint32 segment)
     :VCurveVariable(id, parentId)
 {
-    SCASSERT(not baseCurveName.isEmpty())
-
+    SCASSERT(not curve.isNull())
     SetType(VarType::CurveLength);
-    SetName(baseCurveName + QLatin1String("_") + seg_ + QString().setNum(segment));
-    SetValue(FromPixel(spl.GetLength(), patternUnit));
+    SetName(curve->name() + QLatin1String("_") + seg_ + QString().setNum(segment));
+    SetLazyValue([curve, patternUnit, segment]()
+    {
+        return FromPixel(curve->GetSpline(segment).GetLength(), patternUnit);
+    });
 }
 
 //---------------------------------------------------------------------------------------------------------------------
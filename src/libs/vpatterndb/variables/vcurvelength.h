@@ -53,6 +53,7 @@
 #define VCURVELENGTH_H
 
 #include <qcompilerdetection.h>
+#include <QSharedPointer>
 #include <QString>
 #include <QtGlobal>
 
@@ -61,14 +62,15 @@
 #include "vcurvevariable.h"
 
 class VAbstractCurve;
-class VSpline;
+class VAbstractCubicBezierPath;
 
 class VCurveLength : public VCurveVariable
 {
 public:
     VCurveLength();
-    VCurveLength(const quint32 &id, const quint32 &parentId, const VAbstractCurve *curve, Unit patternUnit);
-    VCurveLength(const quint32 &id, const quint32 &parentId, const QString &baseCurveName, const VSpline &spl,
+    VCurveLength(const quint32 &id, const quint32 &parentId, const QSharedPointer<VAbstractCurve> &curve,
+                 Unit patternUnit);
+    VCurveLength(const quint32 &id, const quint32 &parentId, const QSharedPointer<VAbstractCubicBezierPath> &curve,
                  Unit patternUnit, qint32 segment);
     VCurveLength(const VCurveLength &var);
     VCurveLength &operator=(const VCurveLength &var);
@@ -50,8 +50,22 @@
  *************************************************************************/
 
 #include "vinternalvariable.h"
+
+#include <QMutex>
+#include <QMutexLocker>
+
 #include "vinternalvariable_p.h"
 
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+QMutex &LazyValueMutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+}
+
 #ifdef Q_COMPILER_RVALUE_REFS
 VInternalVariable &VInternalVariable::operator=(VInternalVariable &&var) Q_DECL_NOTHROW { Swap(var); return *this; }
 #endif
@@ -100,12 +114,14 @@ bool VInternalVariable::IsNotUsed() const
 //---------------------------------------------------------------------------------------------------------------------
 qreal VInternalVariable::GetValue() const
 {
+    CalculateValue();
     return d->value;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 qreal *VInternalVariable::GetValue()
 {
+    CalculateValue();
     return &d->value;
 }
 
@@ -113,6 +129,43 @@ qreal *VInternalVariable::GetValue()
 void VInternalVariable::SetValue(const qreal &value)
 {
     d->value = value;
+    d->calculate = nullptr;
+    d->pending.storeRelease(0);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetLazyValue postpone calculation of the value until somebody asks for it.
+ *
+ * Most of internal variables are never used in formulas, but some of them are expensive to calculate (e.g. length of
+ * a curve). The function is called once, on the first GetValue(), and the result is kept.
+ *
+ * @param calculate function that returns the value. It must own everything it needs, the variable can outlive the
+ * object it describes.
+ */
+void VInternalVariable::SetLazyValue(const std::function<qreal ()> &calculate)
+{
+    d->value = 0;
+    d->calculate = calculate;
+    d->pending.storeRelease(1);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VInternalVariable::CalculateValue() const
+{
+    if (d->pending.loadAcquire() == 0)
+    {
+        return;
+    }
+
+    // Copies of a variable share the data, so they can ask for the value from different threads at the same time
+    QMutexLocker locker(&LazyValueMutex());
+    if (d->pending.loadAcquire() != 0)
+    {
+        d->value = d->calculate();
+        d->calculate = nullptr;
+        d->pending.storeRelease(0);
+    }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
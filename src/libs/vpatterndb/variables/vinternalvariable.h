@@ -56,6 +56,7 @@
 #include <QString>
 #include <QTypeInfo>
 #include <QtGlobal>
+#include <functional>
 
 #include "../vmisc/def.h"
 
@@ -90,8 +91,11 @@ class VInternalVariable
     virtual bool IsNotUsed() const;
 protected:
     void SetValue(const qreal &value);
+    void SetLazyValue(const std::function<qreal ()> &calculate);
 private:
     QSharedDataPointer<VInternalVariableData> d;
+
+    void CalculateValue() const;
 };
 
 Q_DECLARE_TYPEINFO(VInternalVariable, Q_MOVABLE_TYPE);
@@ -52,7 +52,10 @@
 #ifndef VINTERNALVARIABLE_P_H
 #define VINTERNALVARIABLE_P_H
 
+#include <QAtomicInt>
 #include <QSharedData>
+#include <functional>
+
 #include "../vmisc/def.h"
 #include "../vmisc/diagnostic.h"
 
@@ -65,11 +68,12 @@ class VInternalVariableData : public QSharedData
 public:
 
     VInternalVariableData()
-        :type(VarType::Unknown), value(0), name(QString())
+        :type(VarType::Unknown), value(0), name(QString()), calculate(), pending(0)
     {}
 
     VInternalVariableData(const VInternalVariableData &var)
-        :QSharedData(var), type(var.type), value(var.value), name(var.name)
+        :QSharedData(var), type(var.type), value(var.value), name(var.name), calculate(var.calculate),
+          pending(var.pending.loadAcquire())
     {}
 
     virtual ~VInternalVariableData();
@@ -77,10 +81,16 @@ class VInternalVariableData : public QSharedData
     VarType type;
 
     /** @brief value variable's value */
-    qreal   value;
+    mutable qreal value;
 
     QString name;
 
+    /** @brief calculate calculates value on first request, see VInternalVariable::SetLazyValue() */
+    mutable std::function<qreal ()> calculate;
+
+    /** @brief pending 1 while value is not calculated yet */
+    mutable QAtomicInt pending;
+
 private:
     VInternalVariableData &operator=(const VInternalVariableData &) Q_DECL_EQ_DELETE;
 };
@@ -52,6 +52,8 @@
 #include "vcontainer.h"
 
 #include <limits.h>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QVector>
 #include <QtDebug>
 
@@ -91,6 +93,20 @@ qreal VContainer::_size = 50;
 qreal VContainer::_height = 176;
 QSet<QString> VContainer::uniqueNames = QSet<QString>();
 
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief StaticsMutex guards the id counter and unique names. They are process-wide, but evaluations of gradations
+ * parse copies of a pattern on several threads.
+ */
+QMutex &StaticsMutex()
+{
+    static QMutex mutex;
+    return mutex;
+}
+}
+
 #ifdef Q_COMPILER_RVALUE_REFS
 VContainer &VContainer::operator=(VContainer &&data) Q_DECL_NOTHROW
 { Swap(data); return *this; }
@@ -104,7 +120,8 @@ void VContainer::Swap(VContainer &data) Q_DECL_NOTHROW
  * @brief VContainer create empty container
  */
 VContainer::VContainer(const VTranslateVars *trVars, const Unit *patternUnit)
-    :d(new VContainerData(trVars, patternUnit))
+    :d(new VContainerData(trVars, patternUnit)),
+      journal(nullptr)
 {}
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -129,9 +146,25 @@ VContainer &VContainer::operator =(const VContainer &data)
  * @param data container
  */
 VContainer::VContainer(const VContainer &data)
-    :d(data.d)
+    :d(data.d),
+      journal(nullptr)
 {}
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Snapshot copy of the container that can be read in another thread while this one changes.
+ *
+ * A plain copy shares pieces and piece paths with the original, changes of them are visible to the copy. The
+ * snapshot gets own copies of these hashes. Both copies are implicitly shared, so it still costs little.
+ */
+VContainer VContainer::Snapshot() const
+{
+    VContainer snapshot(*this);
+    snapshot.d->pieces = QSharedPointer<QHash<quint32, VPiece>>(new QHash<quint32, VPiece>(*d->pieces));
+    snapshot.d->piecePaths = QSharedPointer<QHash<quint32, VPiecePath>>(new QHash<quint32, VPiecePath>(*d->piecePaths));
+    return snapshot;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 VContainer::~VContainer()
 {
@@ -148,6 +181,10 @@ VContainer::~VContainer()
 // cppcheck-suppress unusedFunction
 const QSharedPointer<VGObject> VContainer::GetGObject(quint32 id)const
 {
+    if (journal != nullptr)
+    {
+        journal->readObjects.insert(id);
+    }
     return GetObject(d->gObjects, id);
 }
 
@@ -168,11 +205,12 @@ const QSharedPointer<VGObject> VContainer::GetFakeGObject(quint32 id)
  * @return Object
  */
 template <typename key, typename val>
-const val VContainer::GetObject(const QHash<key, val> &obj, key id) const
+const val VContainer::GetObject(const VVersionedHash<key, val> &obj, key id) const
 {
-    if (obj.contains(id))
+    const val value = obj.value(id);
+    if (not value.isNull())
     {
-        return obj.value(id);
+        return value;
     }
     else
     {
@@ -206,6 +244,20 @@ VPiecePath VContainer::GetPiecePath(quint32 id) const
     }
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GetPieceGeometry return geometry of a piece. Geometry is calculated again only if the piece or something it
+ * is built from has changed since the last request from any copy of the container.
+ * @param id id of the piece.
+ * @param piece the piece.
+ * @param showSecondNotch value of the setting to show the second notch.
+ */
+VPieceGeometry VContainer::GetPieceGeometry(quint32 id, const VPiece &piece, bool showSecondNotch) const
+{
+    const VContainer data(*this); // Checking the cache must not get into journal of this container
+    return d->pieceGeometry->Geometry(id, piece, &data, showSecondNotch);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
  * @brief AddGObject add new GObject to container
@@ -216,8 +268,14 @@ quint32 VContainer::AddGObject(VGObject *obj)
 {
     SCASSERT(obj != nullptr)
     QSharedPointer<VGObject> pointer(obj);
-    uniqueNames.insert(obj->name());
-    return AddObject(d->gObjects, pointer);
+    AddUniqueName(obj->name());
+    const quint32 id = AddObject(d->gObjects, pointer);
+
+    if (journal != nullptr)
+    {
+        journal->writtenObjects.insert(id, pointer);
+    }
+    return id;
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -239,6 +297,7 @@ quint32 VContainer::AddPiecePath(const VPiecePath &path)
 //---------------------------------------------------------------------------------------------------------------------
 quint32 VContainer::getId()
 {
+    QMutexLocker locker(&StaticsMutex());
     return _id;
 }
 
@@ -252,6 +311,7 @@ quint32 VContainer::getNextId()
     //TODO. Current count of ids are very big and allow us save time before someone will reach its max value.
     //Better way, of cource, is to seek free ids inside the set of values and reuse them.
     //But for now better to keep it as it is now.
+    QMutexLocker locker(&StaticsMutex());
     if (_id == UINT_MAX)
     {
         qCritical()<<(tr("Number of free id exhausted."));
@@ -267,6 +327,7 @@ quint32 VContainer::getNextId()
  */
 void VContainer::UpdateId(quint32 newId)
 {
+    QMutexLocker locker(&StaticsMutex());
     if (newId > _id)
     {
        _id = newId;
@@ -280,10 +341,15 @@ void VContainer::UpdateId(quint32 newId)
 void VContainer::Clear()
 {
     qCDebug(vCon, "Clearing container data.");
-    _id = NULL_ID;
+    {
+        QMutexLocker locker(&StaticsMutex());
+        _id = NULL_ID;
+    }
 
+    d->gradation.clear();
     d->pieces->clear();
     d->piecePaths->clear();
+    d->pieceGeometry->Clear();
     ClearVariables();
     ClearGObjects();
     ClearUniqueNames();
@@ -293,7 +359,10 @@ void VContainer::Clear()
 void VContainer::ClearForFullParse()
 {
     qCDebug(vCon, "Clearing container data for full parse.");
-    _id = NULL_ID;
+    {
+        QMutexLocker locker(&StaticsMutex());
+        _id = NULL_ID;
+    }
 
     d->pieces->clear();
     d->piecePaths->clear();
@@ -322,24 +391,10 @@ void VContainer::ClearCalculationGObjects()
 {
     if (not d->gObjects.isEmpty()) //-V807
     {
-        QVector<quint32> keys;
-        QHash<quint32, QSharedPointer<VGObject> >::iterator i;
-        for (i = d->gObjects.begin(); i != d->gObjects.end(); ++i)
-        {
-            if (i.value()->getMode() == Draw::Calculation)
-            {
-                i.value().clear();
-                keys.append(i.key());
-            }
-        }
-        // We can't delete objects in previous loop it will destroy the iterator.
-        if (not keys.isEmpty())
+        d->gObjects.removeIf([](quint32, const QSharedPointer<VGObject> &obj)
         {
-            for (int i = 0; i < keys.size(); ++i)
-            {
-                d->gObjects.remove(keys.at(i));
-            }
-        }
+            return obj->getMode() == Draw::Calculation;
+        });
     }
 }
 
@@ -351,23 +406,21 @@ void VContainer::ClearVariables(const VarType &type)
         if (type == VarType::Unknown)
         {
             d->variables.clear();
+            for (int i = 0; i < d->typedVariables.size(); ++i)
+            {
+                d->typedVariables[i].clear();
+            }
         }
         else
         {
-            QVector<QString> keys;
-            QHash<QString, QSharedPointer<VInternalVariable> >::iterator i;
-            for (i = d->variables.begin(); i != d->variables.end(); ++i)
-            {
-                if (i.value()->GetType() == type)
-                {
-                    keys.append(i.key());
-                }
-            }
-
-            for (int i = 0; i < keys.size(); ++i)
+            VVersionedHash<QString, QSharedPointer<VInternalVariable>> &typed =
+                    d->typedVariables[static_cast<int>(type)];
+            const QList<QString> names = typed.keys();
+            for (auto &name : names)
             {
-                d->variables.remove(keys.at(i));
+                d->variables.remove(name);
             }
+            typed.clear();
         }
     }
 }
@@ -425,13 +478,13 @@ void VContainer::AddCurve(const QSharedPointer<VAbstractCurve> &curve, const qui
         throw VException(tr("Can't create a curve with type '%1'").arg(static_cast<int>(curveType)));
     }
 
-    VCurveLength *length = new VCurveLength(id, parentId, curve.data(), *GetPatternUnit());
+    VCurveLength *length = new VCurveLength(id, parentId, curve, *GetPatternUnit());
     AddVariable(length->GetName(), length);
 
-    VCurveAngle *startAngle = new VCurveAngle(id, parentId, curve.data(), CurveAngle::StartAngle);
+    VCurveAngle *startAngle = new VCurveAngle(id, parentId, curve, CurveAngle::StartAngle);
     AddVariable(startAngle->GetName(), startAngle);
 
-    VCurveAngle *endAngle = new VCurveAngle(id, parentId, curve.data(), CurveAngle::EndAngle);
+    VCurveAngle *endAngle = new VCurveAngle(id, parentId, curve, CurveAngle::EndAngle);
     AddVariable(endAngle->GetName(), endAngle);
 }
 
@@ -440,10 +493,10 @@ void VContainer::AddSpline(const QSharedPointer<VAbstractBezier> &curve, quint32
 {
     AddCurve(curve, id, parentId);
 
-    VCurveCLength *c1Length = new VCurveCLength(id, parentId, curve.data(), CurveCLength::C1, *GetPatternUnit());
+    VCurveCLength *c1Length = new VCurveCLength(id, parentId, curve, CurveCLength::C1, *GetPatternUnit());
     AddVariable(c1Length->GetName(), c1Length);
 
-    VCurveCLength *c2Length = new VCurveCLength(id, parentId, curve.data(), CurveCLength::C2, *GetPatternUnit());
+    VCurveCLength *c2Length = new VCurveCLength(id, parentId, curve, CurveCLength::C2, *GetPatternUnit());
     AddVariable(c2Length->GetName(), c2Length);
 }
 
@@ -453,25 +506,22 @@ void VContainer::AddCurveWithSegments(const QSharedPointer<VAbstractCubicBezierP
 {
     AddSpline(curve, id, parentId);
 
+    // Values of segments are calculated on first request, most of them are never used
     for (qint32 i = 1; i <= curve->CountSubSpl(); ++i)
     {
-        const VSpline spl = curve->GetSpline(i);
-
-        VCurveLength *length = new VCurveLength(id, parentId, curve->name(), spl, *GetPatternUnit(), i);
+        VCurveLength *length = new VCurveLength(id, parentId, curve, *GetPatternUnit(), i);
         AddVariable(length->GetName(), length);
 
-        VCurveAngle *startAngle = new VCurveAngle(id, parentId, curve->name(), spl, CurveAngle::StartAngle, i);
+        VCurveAngle *startAngle = new VCurveAngle(id, parentId, curve, CurveAngle::StartAngle, i);
         AddVariable(startAngle->GetName(), startAngle);
 
-        VCurveAngle *endAngle = new VCurveAngle(id, parentId, curve->name(), spl, CurveAngle::EndAngle, i);
+        VCurveAngle *endAngle = new VCurveAngle(id, parentId, curve, CurveAngle::EndAngle, i);
         AddVariable(endAngle->GetName(), endAngle);
 
-        VCurveCLength *c1Length = new VCurveCLength(id, parentId, curve->name(), spl, CurveCLength::C1,
-                                                    *GetPatternUnit(), i);
+        VCurveCLength *c1Length = new VCurveCLength(id, parentId, curve, CurveCLength::C1, *GetPatternUnit(), i);
         AddVariable(c1Length->GetName(), c1Length);
 
-        VCurveCLength *c2Length = new VCurveCLength(id, parentId, curve->name(), spl, CurveCLength::C2,
-                                                    *GetPatternUnit(), i);
+        VCurveCLength *c2Length = new VCurveCLength(id, parentId, curve, CurveCLength::C2, *GetPatternUnit(), i);
         AddVariable(c2Length->GetName(), c2Length);
     }
 }
@@ -479,13 +529,19 @@ void VContainer::AddCurveWithSegments(const QSharedPointer<VAbstractCubicBezierP
 //---------------------------------------------------------------------------------------------------------------------
 void VContainer::RemoveVariable(const QString &name)
 {
-    d->variables.remove(name);
+    const QSharedPointer<VInternalVariable> var = d->variables.value(name);
+    if (not var.isNull())
+    {
+        d->typedVariables[static_cast<int>(var->GetType())].remove(name);
+        d->variables.remove(name);
+    }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 void VContainer::RemovePiece(quint32 id)
 {
     d->pieces->remove(id);
+    d->pieceGeometry->Remove(id);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -496,12 +552,12 @@ void VContainer::RemovePiece(quint32 id)
  * @return id of object in container
  */
 template <typename key, typename val>
-quint32 VContainer::AddObject(QHash<key, val> &obj, val value)
+quint32 VContainer::AddObject(VVersionedHash<key, val> &obj, val value)
 {
     SCASSERT(value != nullptr)
     const quint32 id = getNextId();
     value->setId(id);
-    obj[id] = value;
+    obj.insert(id, value);
     return id;
 }
 
@@ -528,8 +584,7 @@ void VContainer::UpdatePiecePath(quint32 id, const VPiecePath &path)
  */
 void VContainer::removeCustomVariable(const QString &name)
 {
-    d->variables[name].clear();
-    d->variables.remove(name);
+    RemoveVariable(name);
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -583,6 +638,7 @@ const QMap<QString, QSharedPointer<VCurveAngle> > VContainer::curveAnglesData()
 //---------------------------------------------------------------------------------------------------------------------
 bool VContainer::IsUnique(const QString &name)
 {
+    QMutexLocker locker(&StaticsMutex());
     return (!uniqueNames.contains(name) && !builInFunctions.contains(name));
 }
 
@@ -590,10 +646,65 @@ bool VContainer::IsUnique(const QString &name)
 QStringList VContainer::AllUniqueNames()
 {
     QStringList names = builInFunctions;
+    QMutexLocker locker(&StaticsMutex());
 	names.append(uniqueNames.values());
     return names;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetJournal start recording reads and writes of this container.
+ * @param journal journal that receives records, nullptr stops recording. Caller keeps ownership.
+ */
+void VContainer::SetJournal(VContainerJournal *journal)
+{
+    this->journal = journal;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief JournalVariableReads record variables used by a formula.
+ *
+ * Formulas read variables through DataVariables(), so the container can't see which of them were used.
+ * @param names tokens of the formula.
+ */
+void VContainer::JournalVariableReads(const QList<QString> &names) const
+{
+    if (journal != nullptr)
+    {
+        for (int i = 0; i < names.size(); ++i)
+        {
+            journal->readVariables.insert(names.at(i));
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Replay put back objects and variables recorded in a journal, the same instances a tool has created.
+ * @param journal journal of the tool.
+ */
+void VContainer::Replay(const VContainerJournal &journal)
+{
+    auto object = journal.writtenObjects.constBegin();
+    while (object != journal.writtenObjects.constEnd())
+    {
+        d->gObjects.insert(object.key(), object.value());
+        AddUniqueName(object.value()->name());
+        UpdateId(object.key());
+        ++object;
+    }
+
+    auto variable = journal.writtenVariables.constBegin();
+    while (variable != journal.writtenVariables.constEnd())
+    {
+        d->variables.insert(variable.key(), variable.value());
+        d->typedVariables[static_cast<int>(variable.value()->GetType())].insert(variable.key(), variable.value());
+        AddUniqueName(variable.key());
+        ++variable;
+    }
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 const Unit *VContainer::GetPatternUnit() const
 {
@@ -612,14 +723,12 @@ const QMap<QString, QSharedPointer<T> > VContainer::DataVar(const VarType &type)
 {
     QMap<QString, QSharedPointer<T> > map;
     //Sorting QHash by id
+    const QHash<QString, QSharedPointer<VInternalVariable> > variables = DataVariables(type)->toHash();
     QHash<QString, QSharedPointer<VInternalVariable> >::const_iterator i;
-    for (i = d->variables.constBegin(); i != d->variables.constEnd(); ++i)
+    for (i = variables.constBegin(); i != variables.constEnd(); ++i)
     {
-        if (i.value()->GetType() == type)
-        {
-            QSharedPointer<T> var = GetVariable<T>(i.key());
-            map.insert(d->trVars->VarToUser(i.key()), var);
-        }
+        QSharedPointer<T> var = GetVariable<T>(i.key());
+        map.insert(d->trVars->VarToUser(i.key()), var);
     }
     return map;
 }
@@ -627,14 +736,16 @@ const QMap<QString, QSharedPointer<T> > VContainer::DataVar(const VarType &type)
 //---------------------------------------------------------------------------------------------------------------------
 void VContainer::ClearUniqueNames()
 {
+    QMutexLocker locker(&StaticsMutex());
     uniqueNames.clear();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
 void VContainer::ClearUniqueIncrementNames()
 {
+    QMutexLocker locker(&StaticsMutex());
 	const QList<QString> list = uniqueNames.values();
-    ClearUniqueNames();
+    uniqueNames.clear();
 
     for(int i = 0; i < list.size(); ++i)
     {
@@ -697,14 +808,69 @@ qreal *VContainer::rheight()
     return &_height;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SetGradation give the container own size and height, so it can be evaluated next to the pattern or to other
+ * evaluations.
+ *
+ * Measurements of the container are replaced with copies that read the new size and height, copies of the container
+ * share them. From now on the container also puts new instances of objects and variables instead of writing into the
+ * old ones, which other containers may share. Own geometry cache keeps pieces of other gradations from pushing out
+ * each other.
+ * @param gradation size and height in pattern units.
+ */
+void VContainer::SetGradation(const VGradation &gradation)
+{
+    d->gradation = QSharedPointer<VGradation>(new VGradation(gradation));
+    d->pieceGeometry = QSharedPointer<VPieceGeometryCache>(new VPieceGeometryCache());
+
+    VVersionedHash<QString, QSharedPointer<VInternalVariable>> &typed =
+            d->typedVariables[static_cast<int>(VarType::Measurement)];
+    const QHash<QString, QSharedPointer<VInternalVariable>> measurements = typed.toHash();
+    auto i = measurements.constBegin();
+    while (i != measurements.constEnd())
+    {
+        const QSharedPointer<VMeasurement> measurement = qSharedPointerDynamicCast<VMeasurement>(i.value());
+        if (not measurement.isNull())
+        {
+            QSharedPointer<VMeasurement> copy(new VMeasurement(*measurement));
+            copy->SetSize(&d->gradation->size);
+            copy->SetHeight(&d->gradation->height);
+            d->variables.insert(i.key(), copy);
+            typed.insert(i.key(), copy);
+        }
+        ++i;
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Gradation return size and height measurements of the container read.
+ */
+VGradation VContainer::Gradation() const
+{
+    if (d->gradation.isNull())
+    {
+        return VGradation(_size, _height);
+    }
+    return *d->gradation;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VContainer::AddUniqueName(const QString &name)
+{
+    QMutexLocker locker(&StaticsMutex());
+    uniqueNames.insert(name);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 /**
  * @brief data container with datagObjects return container of gObjects
- * @return pointer on container of gObjects
+ * @return copy of container of gObjects
  */
-const QHash<quint32, QSharedPointer<VGObject> > *VContainer::DataGObjects() const
+const QHash<quint32, QSharedPointer<VGObject> > VContainer::DataGObjects() const
 {
-    return &d->gObjects;
+    return d->gObjects.toHash();
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -714,11 +880,21 @@ const QHash<quint32, VPiece> *VContainer::DataPieces() const
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-const QHash<QString, QSharedPointer<VInternalVariable> > *VContainer::DataVariables() const
+const VVersionedHash<QString, QSharedPointer<VInternalVariable> > *VContainer::DataVariables() const
 {
     return &d->variables;
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief DataVariables variables of one type. The index is kept up to date on each change, so this costs nothing.
+ * @param type type of variables.
+ */
+const VVersionedHash<QString, QSharedPointer<VInternalVariable> > *VContainer::DataVariables(const VarType &type) const
+{
+    return &d->typedVariables.at(static_cast<int>(type));
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 VContainerData::~VContainerData()
 {}
@@ -64,6 +64,7 @@
 #include <QString>
 #include <QStringList>
 #include <QTypeInfo>
+#include <QVector>
 #include <QtGlobal>
 #include <new>
 
@@ -77,11 +78,34 @@
 #include "variables.h"
 #include "variables/vinternalvariable.h"
 #include "vpiece.h"
+#include "vpiecegeometry.h"
 #include "vpiecepath.h"
 #include "vtranslatevars.h"
+#include "vversionedhash.h"
 
 class VEllipticalArc;
 
+/**
+ * @brief The VGradation struct size and height multisize measurements are calculated for.
+ */
+struct VGradation
+{
+    VGradation()
+        : size(0),
+          height(0)
+    {}
+
+    VGradation(qreal size, qreal height)
+        : size(size),
+          height(height)
+    {}
+
+    qreal size;
+    qreal height;
+};
+
+Q_DECLARE_TYPEINFO(VGradation, Q_PRIMITIVE_TYPE);
+
 QT_WARNING_PUSH
 QT_WARNING_DISABLE_GCC("-Weffc++")
 QT_WARNING_DISABLE_INTEL(2021)
@@ -92,10 +116,13 @@ class VContainerData : public QSharedData //-V690
 public:
 
     VContainerData(const VTranslateVars *trVars, const Unit *patternUnit)
-        : gObjects(QHash<quint32, QSharedPointer<VGObject> >()),
-          variables(QHash<QString, QSharedPointer<VInternalVariable> > ()),
+        : gObjects(VVersionedHash<quint32, QSharedPointer<VGObject> >()),
+          variables(VVersionedHash<QString, QSharedPointer<VInternalVariable> > ()),
+          typedVariables(static_cast<int>(VarType::Unknown) + 1),
           pieces(QSharedPointer<QHash<quint32, VPiece>>(new QHash<quint32, VPiece>())),
           piecePaths(QSharedPointer<QHash<quint32, VPiecePath>>(new QHash<quint32, VPiecePath>())),
+          pieceGeometry(QSharedPointer<VPieceGeometryCache>(new VPieceGeometryCache())),
+          gradation(),
           trVars(trVars),
           patternUnit(patternUnit)
     {}
@@ -104,8 +131,11 @@ class VContainerData : public QSharedData //-V690
         : QSharedData(data),
           gObjects(data.gObjects),
           variables(data.variables),
+          typedVariables(data.typedVariables),
           pieces(data.pieces),
           piecePaths(data.piecePaths),
+          pieceGeometry(data.pieceGeometry),
+          gradation(data.gradation),
           trVars(data.trVars),
           patternUnit(data.patternUnit)
     {}
@@ -113,18 +143,34 @@ class VContainerData : public QSharedData //-V690
     virtual ~VContainerData();
 
     /**
-     * @brief gObjects graphicals objects of pattern.
+     * @brief gObjects graphicals objects of pattern. Each tool keeps a copy of container, so copies must share
+     * structure.
      */
-    QHash<quint32, QSharedPointer<VGObject> > gObjects;
+    VVersionedHash<quint32, QSharedPointer<VGObject> > gObjects;
 
     /**
      * @brief variables container for measurements, increments, lines lengths, lines angles, arcs lengths, curve lengths
      */
-    QHash<QString, QSharedPointer<VInternalVariable>> variables;
+    VVersionedHash<QString, QSharedPointer<VInternalVariable>> variables;
+
+    /**
+     * @brief typedVariables the same variables split by type, index is static_cast<int>(VarType). Typed listings and
+     * ClearVariables() visit only variables of one type.
+     */
+    QVector<VVersionedHash<QString, QSharedPointer<VInternalVariable>>> typedVariables;
 
     QSharedPointer<QHash<quint32, VPiece>> pieces;
     QSharedPointer<QHash<quint32, VPiecePath>> piecePaths;
 
+    /** @brief pieceGeometry geometry of pieces, shared by the scene, the layout and the export. */
+    QSharedPointer<VPieceGeometryCache> pieceGeometry;
+
+    /**
+     * @brief gradation own size and height of an evaluation, see VContainer::SetGradation(). Null if measurements read
+     * the process-wide ones.
+     */
+    QSharedPointer<VGradation> gradation;
+
     const VTranslateVars *trVars;
     const Unit *patternUnit;
 
@@ -134,6 +180,20 @@ class VContainerData : public QSharedData //-V690
 
 QT_WARNING_POP
 
+/**
+ * @brief The VContainerJournal struct records what one tool reads from and writes to a container.
+ *
+ * Reads give dependencies between tools, writes allow to put results of a tool back to a container without running
+ * the tool again.
+ */
+struct VContainerJournal
+{
+    QSet<quint32>                                     readObjects;
+    QSet<QString>                                     readVariables;
+    QHash<quint32, QSharedPointer<VGObject>>          writtenObjects;
+    QHash<QString, QSharedPointer<VInternalVariable>> writtenVariables;
+};
+
 /**
  * @brief The VContainer class container of all variables.
  */
@@ -146,6 +206,7 @@ class VContainer
     ~VContainer();
 
     VContainer &operator=(const VContainer &data);
+    VContainer Snapshot() const;
 #ifdef Q_COMPILER_RVALUE_REFS
 	VContainer &operator=(VContainer &&data) Q_DECL_NOTHROW;
 #endif
@@ -158,6 +219,7 @@ class VContainer
     static const QSharedPointer<VGObject> GetFakeGObject(quint32 id);
     VPiece             GetPiece(quint32 id) const;
     VPiecePath         GetPiecePath(quint32 id) const;
+    VPieceGeometry     GetPieceGeometry(quint32 id, const VPiece &piece, bool showSecondNotch) const;
     template <typename T>
     QSharedPointer<T>  GetVariable(QString name) const;
     static quint32     getId();
@@ -204,11 +266,15 @@ class VContainer
     static qreal       height();
     static qreal      *rheight();
 
+    void               SetGradation(const VGradation &gradation);
+    VGradation         Gradation() const;
+
     void               removeCustomVariable(const QString& name);
 
-    const QHash<quint32, QSharedPointer<VGObject> >         *DataGObjects() const;
-    const QHash<quint32, VPiece>                            *DataPieces() const;
-    const QHash<QString, QSharedPointer<VInternalVariable>> *DataVariables() const;
+    const QHash<quint32, QSharedPointer<VGObject> >                  DataGObjects() const;
+    const QHash<quint32, VPiece>                                     *DataPieces() const;
+    const VVersionedHash<QString, QSharedPointer<VInternalVariable>> *DataVariables() const;
+    const VVersionedHash<QString, QSharedPointer<VInternalVariable>> *DataVariables(const VarType &type) const;
 
     const QMap<QString, QSharedPointer<VMeasurement> >  DataMeasurements() const;
     const QMap<QString, QSharedPointer<VIncrement> >    variablesData() const;
@@ -222,6 +288,10 @@ class VContainer
     static bool        IsUnique(const QString &name);
     static QStringList AllUniqueNames();
 
+    void               SetJournal(VContainerJournal *journal);
+    void               JournalVariableReads(const QList<QString> &names) const;
+    void               Replay(const VContainerJournal &journal);
+
     const Unit *GetPatternUnit() const;
     const VTranslateVars *GetTrVars() const;
 
@@ -236,20 +306,25 @@ class VContainer
 
     QSharedDataPointer<VContainerData> d;
 
+    /** @brief journal records access to container while a tool is being created. Not shared with copies. */
+    VContainerJournal *journal;
+
     void AddCurve(const QSharedPointer<VAbstractCurve> &curve, const quint32 &id, quint32 parentId = NULL_ID);
 
+    static void AddUniqueName(const QString &name);
+
     template <class T>
     uint qHash( const QSharedPointer<T> &p );
 
     template <typename key, typename val>
     // cppcheck-suppress functionStatic
-    const val GetObject(const QHash<key, val> &obj, key id) const;
+    const val GetObject(const VVersionedHash<key, val> &obj, key id) const;
 
     template <typename T>
     void UpdateObject(const quint32 &id, const QSharedPointer<T> &point);
 
     template <typename key, typename val>
-    static quint32 AddObject(QHash<key, val> &obj, val value);
+    static quint32 AddObject(VVersionedHash<key, val> &obj, val value);
 
     template <typename T>
     const QMap<QString, QSharedPointer<T> > DataVar(const VarType &type) const;
@@ -271,6 +346,11 @@ const QSharedPointer<T> VContainer::GeometricObject(const quint32 &id) const
         throw VExceptionBadId(tr("Can't find object"), id);
     }
 
+    if (journal != nullptr)
+    {
+        journal->readObjects.insert(id);
+    }
+
     QSharedPointer<VGObject> gObj = QSharedPointer<VGObject>();
     if (d->gObjects.contains(id))
     {
@@ -303,6 +383,11 @@ template <typename T>
 QSharedPointer<T> VContainer::GetVariable(QString name) const
 {
     SCASSERT(name.isEmpty()==false)
+    if (journal != nullptr)
+    {
+        journal->readVariables.insert(name);
+    }
+
     if (d->variables.contains(name))
     {
         try
@@ -333,7 +418,8 @@ void VContainer::AddVariable(const QString& name, T *var)
 template <typename T>
 void VContainer::AddVariable(const QString& name, const QSharedPointer<T> &var)
 {
-    if (d->variables.contains(name))
+    // An evaluation with own gradation doesn't write into a variable it shares with other containers
+    if (d->variables.contains(name) and d->gradation.isNull())
     {
         if (d->variables.value(name)->GetType() == var->GetType())
         {
@@ -351,10 +437,20 @@ void VContainer::AddVariable(const QString& name, const QSharedPointer<T> &var)
     }
     else
     {
+        if (d->variables.contains(name))
+        {
+            d->typedVariables[static_cast<int>(d->variables.value(name)->GetType())].remove(name);
+        }
         d->variables.insert(name, var);
+        d->typedVariables[static_cast<int>(var->GetType())].insert(name, var);
     }
 
-    uniqueNames.insert(name);
+    AddUniqueName(name);
+
+    if (journal != nullptr)
+    {
+        journal->writtenVariables.insert(name, d->variables.value(name));
+    }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -383,7 +479,7 @@ void VContainer::UpdateGObject(quint32 id, const QSharedPointer<T> &obj)
 {
     SCASSERT(not obj.isNull())
     UpdateObject(id, obj);
-    uniqueNames.insert(obj->name());
+    AddUniqueName(obj->name());
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -398,7 +494,8 @@ void VContainer::UpdateObject(const quint32 &id, const QSharedPointer<T> &point)
     Q_ASSERT_X(id != NULL_ID, Q_FUNC_INFO, "id == 0"); //-V654 //-V712
     SCASSERT(point.isNull() == false)
     point->setId(id);
-    if (d->gObjects.contains(id))
+    // An evaluation with own gradation puts a new instance, the old one is shared with other containers
+    if (d->gObjects.contains(id) and d->gradation.isNull())
     {
         QSharedPointer<T> obj = qSharedPointerDynamicCast<T>(d->gObjects.value(id));
         if (obj.isNull())
@@ -412,5 +509,10 @@ void VContainer::UpdateObject(const quint32 &id, const QSharedPointer<T> &point)
         d->gObjects.insert(id, point);
     }
     UpdateId(id);
+
+    if (journal != nullptr)
+    {
+        journal->writtenObjects.insert(id, d->gObjects.value(id));
+    }
 }
 #endif // VCONTAINER_H
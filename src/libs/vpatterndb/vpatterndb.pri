@@ -19,6 +19,7 @@ SOURCES += \
     $$PWD/vformula.cpp \
     $$PWD/variables/vcurveclength.cpp \
     $$PWD/vpiece.cpp \
+    $$PWD/vpiecegeometry.cpp \
     $$PWD/vpiecenode.cpp \
     $$PWD/vpiecepath.cpp \
     $$PWD/floatItemData/vpiecelabeldata.cpp \
@@ -60,6 +61,7 @@ HEADERS += \
     $$PWD/variables/vcurveclength.h \
     $$PWD/vpiece.h \
     $$PWD/vpiece_p.h \
+    $$PWD/vpiecegeometry.h \
     $$PWD/vpiecenode.h \
     $$PWD/vpiecenode_p.h \
     $$PWD/vpiecepath.h \
@@ -74,4 +76,5 @@ HEADERS += \
     $$PWD/floatItemData/vpatternlabeldata_p.h \
     $$PWD/floatItemData/vpiecelabeldata_p.h \
     $$PWD/measurements.h \
-    $$PWD/pmsystems.h
+    $$PWD/pmsystems.h \
+    $$PWD/vversionedhash.h
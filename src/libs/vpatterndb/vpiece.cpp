@@ -271,7 +271,15 @@ QVector<QPointF> VPiece::SeamAllowancePoints(const VContainer *data) const
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-QVector<QLineF> VPiece::createNotchLines(const VContainer *data, const QVector<QPointF> &seamAllowance) const
+/**
+ * @brief createNotchLines create lines of all notches of the piece.
+ * @param data container the piece is built in.
+ * @param showSecondNotch value of the setting to show the second notch on the seam line. It is passed in, so the
+ * lines can be created on any thread.
+ * @param seamAllowance seam allowance points if they are already calculated.
+ */
+QVector<QLineF> VPiece::createNotchLines(const VContainer *data, bool showSecondNotch,
+                                         const QVector<QPointF> &seamAllowance) const
 {
     const QVector<VPieceNode> unitedPath = GetUnitedPath(data);
     if (not IsSeamAllowance() || not notchesPossible(unitedPath))
@@ -292,7 +300,7 @@ QVector<QLineF> VPiece::createNotchLines(const VContainer *data, const QVector<Q
         const int previousIndex = VPiecePath::FindInLoopNotExcludedUp(i, unitedPath);
         const int nextIndex = VPiecePath::FindInLoopNotExcludedDown(i, unitedPath);
 
-        notches += createNotch(unitedPath, previousIndex, i, nextIndex, data, seamAllowance);
+        notches += createNotch(unitedPath, previousIndex, i, nextIndex, data, showSecondNotch, seamAllowance);
     }
 
     return notches;
@@ -301,7 +309,12 @@ QVector<QLineF> VPiece::createNotchLines(const VContainer *data, const QVector<Q
 //---------------------------------------------------------------------------------------------------------------------
 QPainterPath VPiece::MainPathPath(const VContainer *data) const
 {
-    const QVector<QPointF> points = MainPathPoints(data);
+    return MainPathPath(MainPathPoints(data));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QPainterPath VPiece::MainPathPath(const QVector<QPointF> &points)
+{
     QPainterPath path;
 
     if (not points.isEmpty())
@@ -348,9 +361,15 @@ QPainterPath VPiece::SeamAllowancePath(const QVector<QPointF> &points) const
 }
 
 //---------------------------------------------------------------------------------------------------------------------
-QPainterPath VPiece::getNotchesPath(const VContainer *data, const QVector<QPointF> &pathPoints) const
+QPainterPath VPiece::getNotchesPath(const VContainer *data, bool showSecondNotch,
+                                    const QVector<QPointF> &pathPoints) const
+{
+    return getNotchesPath(createNotchLines(data, showSecondNotch, pathPoints));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QPainterPath VPiece::getNotchesPath(const QVector<QLineF> &notches) const
 {
-    const QVector<QLineF> notches = createNotchLines(data, pathPoints);
     QPainterPath path;
 
     // seam allowence
@@ -914,7 +933,7 @@ bool VPiece::isNotchVisible(const QVector<VPieceNode> &path, int notchIndex) con
 
 //---------------------------------------------------------------------------------------------------------------------
 QVector<QLineF> VPiece::createNotch(const QVector<VPieceNode> &path, int previousIndex, int notchIndex,
-                                       int nextIndex, const VContainer *data,
+                                       int nextIndex, const VContainer *data, bool showSecondNotch,
                                        const QVector<QPointF> &pathPoints) const
 {
     SCASSERT(data != nullptr);
@@ -951,7 +970,7 @@ QVector<QLineF> VPiece::createNotch(const QVector<VPieceNode> &path, int previou
             lines += createSeamAllowanceNotch(path, previousSAPoint, notchSAPoint,  nextSAPoint,
                                               data, notchIndex, pathPoints);
         }
-        if (qApp->Settings()->showSecondNotch()
+        if (showSecondNotch
                 && not IsHideMainPath()
                 && path.at(notchIndex).IsMainPathNode()
                 && path.at(notchIndex).getNotchSubType() != NotchSubType::Intersection
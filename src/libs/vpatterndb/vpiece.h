@@ -106,14 +106,16 @@ class VPiece : public VAbstractPiece
     QVector<QPointF>         MainPathPoints(const VContainer *data) const;
     QVector<VPointF>         MainPathNodePoints(const VContainer *data, bool showExcluded = false) const;
     QVector<QPointF>         SeamAllowancePoints(const VContainer *data) const;
-    QVector<QLineF>          createNotchLines(const VContainer *data,
+    QVector<QLineF>          createNotchLines(const VContainer *data, bool showSecondNotch,
                                               const QVector<QPointF> &seamAllowance = QVector<QPointF>()) const;
 
     QPainterPath             MainPathPath(const VContainer *data) const;
+    static QPainterPath      MainPathPath(const QVector<QPointF> &points);
     QPainterPath             SeamAllowancePath(const VContainer *data) const;
     QPainterPath             SeamAllowancePath(const QVector<QPointF> &points) const;
-    QPainterPath             getNotchesPath(const VContainer *data,
+    QPainterPath             getNotchesPath(const VContainer *data, bool showSecondNotch,
                                            const QVector<QPointF> &seamAllowance = QVector<QPointF>()) const;
+    QPainterPath             getNotchesPath(const QVector<QLineF> &notches) const;
 
     bool                     IsInLayout() const;
     void                     SetInLayout(bool inLayout);
@@ -178,7 +180,7 @@ class VPiece : public VAbstractPiece
     bool                     isNotchVisible(const QVector<VPieceNode> &path, int notchIndex) const;
 
     QVector<QLineF>          createNotch(const QVector<VPieceNode> &path, int previousIndex, int notchIndex,
-                                         int nextIndex, const VContainer *data,
+                                         int nextIndex, const VContainer *data, bool showSecondNotch,
                                          const QVector<QPointF> &pathPoints = QVector<QPointF>()) const;
 
     QVector<QLineF>          createSeamAllowanceNotch(const QVector<VPieceNode> &path, VSAPoint &previousSAPoint,
@@ -0,0 +1,275 @@
+/***************************************************************************
+ *                                                                         *
+ *   @file   vpiecegeometry.cpp                                            *
+ *   @author Seamly2D project                                              *
+ *   @date   10.16.2026                                                    *
+ *   Copyright (C) 2017  Seamly, LLC                                       *
+ *                                                                         *
+ *   https://github.com/fashionfreedom/seamly2d                            *
+ *                                                                         *
+ ***************************************************************************
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **************************************************************************/
+
+#include "vpiecegeometry.h"
+#include "vcontainer.h"
+#include "vpiece.h"
+#include "vpiecenode.h"
+#include "vpiecepath.h"
+#include "../vmisc/vabstractapplication.h"
+
+#include <QDataStream>
+#include <QIODevice>
+#include <QMutexLocker>
+#include <QtNumeric>
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+void WriteNodes(QDataStream &out, const QVector<VPieceNode> &nodes)
+{
+    out << nodes.size();
+    for (int i = 0; i < nodes.size(); ++i)
+    {
+        const VPieceNode &node = nodes.at(i);
+        out << node.GetId()
+            << static_cast<int>(node.GetTypeTool())
+            << node.GetReverse()
+            << node.isExcluded()
+            << node.isNotch()
+            << node.IsMainPathNode()
+            << node.GetFormulaSABefore()
+            << node.GetFormulaSAAfter()
+            << static_cast<int>(node.GetAngleType())
+            << static_cast<int>(node.getNotchType())
+            << static_cast<int>(node.getNotchSubType())
+            << node.showNotch()
+            << node.showSecondNotch()
+            << node.getNotchLength()
+            << node.getNotchWidth()
+            << node.getNotchAngle()
+            << node.getNotchCount();
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void WritePiecePath(QDataStream &out, quint32 id, const VContainer *data)
+{
+    try
+    {
+        const VPiecePath path = data->GetPiecePath(id);
+        out << true << static_cast<int>(path.GetType());
+        WriteNodes(out, path.GetNodes());
+    }
+    catch (const VExceptionBadId &)
+    {
+        out << false;
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+qreal VariableValue(const VContainer *data, const QString &name)
+{
+    // Const access doesn't write to the variable, copies of the container may read it on other threads
+    const QSharedPointer<const VInternalVariable> variable = data->DataVariables()->value(name);
+    return variable.isNull() ? qQNaN() : variable->GetValue();
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+VPieceGeometryCache::VPieceGeometryCache()
+    : mutex(),
+      entries(),
+      calculations(0)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Geometry return geometry of a piece, calculate it only if something it depends on has changed.
+ * @param id id of the piece.
+ * @param piece the piece.
+ * @param data container the piece is built in.
+ * @param showSecondNotch value of the setting to show the second notch. Callers read it on GUI thread.
+ * @return geometry of the piece.
+ */
+VPieceGeometry VPieceGeometryCache::Geometry(quint32 id, const VPiece &piece, const VContainer *data,
+                                             bool showSecondNotch)
+{
+    SCASSERT(data != nullptr)
+
+    const QByteArray definition = Definition(piece, data, showSecondNotch);
+    {
+        QMutexLocker locker(&mutex);
+        auto entry = entries.constFind(id);
+        if (entry != entries.constEnd() && IsValid(entry.value(), definition, data))
+        {
+            return entry.value().geometry;
+        }
+    }
+
+    Entry entry = Calculate(piece, data, showSecondNotch);
+    entry.definition = definition;
+
+    QMutexLocker locker(&mutex);
+    ++calculations;
+    entries.insert(id, entry);
+    return entry.geometry;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VPieceGeometryCache::Remove(quint32 id)
+{
+    QMutexLocker locker(&mutex);
+    entries.remove(id);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VPieceGeometryCache::Clear()
+{
+    QMutexLocker locker(&mutex);
+    entries.clear();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief CalculationsCount how many times geometry was calculated instead of taken from the cache.
+ */
+int VPieceGeometryCache::CalculationsCount() const
+{
+    QMutexLocker locker(&mutex);
+    return calculations;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Definition everything from the piece, its paths and settings that affects geometry, in one byte array.
+ */
+QByteArray VPieceGeometryCache::Definition(const VPiece &piece, const VContainer *data, bool showSecondNotch)
+{
+    QByteArray definition;
+    QDataStream out(&definition, QIODevice::WriteOnly);
+
+    out << static_cast<int>(*data->GetPatternUnit())
+        << showSecondNotch
+        << piece.IsSeamAllowance()
+        << piece.IsSeamAllowanceBuiltIn()
+        << piece.IsHideMainPath()
+        << piece.GetSAWidth();
+    WriteNodes(out, piece.GetPath().GetNodes());
+
+    const QVector<CustomSARecord> records = piece.GetCustomSARecords();
+    out << records.size();
+    for (int i = 0; i < records.size(); ++i)
+    {
+        const CustomSARecord &record = records.at(i);
+        out << record.startPoint << record.path << record.endPoint << record.reverse
+            << static_cast<int>(record.includeType);
+        WritePiecePath(out, record.path, data);
+    }
+
+    const QVector<quint32> internalPaths = piece.GetInternalPaths();
+    out << internalPaths.size();
+    for (int i = 0; i < internalPaths.size(); ++i)
+    {
+        out << internalPaths.at(i);
+        WritePiecePath(out, internalPaths.at(i), data);
+    }
+
+    return definition;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool VPieceGeometryCache::IsValid(const Entry &entry, const QByteArray &definition, const VContainer *data)
+{
+    if (entry.definition != definition)
+    {
+        return false;
+    }
+
+    auto object = entry.objects.constBegin();
+    while (object != entry.objects.constEnd())
+    {
+        try
+        {
+            if (data->GetGObject(object.key()) != object.value())
+            {
+                return false;
+            }
+        }
+        catch (const VExceptionBadId &)
+        {
+            return false;
+        }
+        ++object;
+    }
+
+    auto variable = entry.variables.constBegin();
+    while (variable != entry.variables.constEnd())
+    {
+        const qreal value = VariableValue(data, variable.key());
+        if (qIsNaN(value) != qIsNaN(variable.value())
+                || (not qIsNaN(value) && not VFuzzyComparePossibleNulls(value, variable.value())))
+        {
+            return false;
+        }
+        ++variable;
+    }
+
+    return true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Calculate calculate geometry of a piece and record objects and variables the calculation has read.
+ *
+ * The seam allowance is calculated once and passed to notches, they don't need to calculate it again.
+ */
+VPieceGeometryCache::Entry VPieceGeometryCache::Calculate(const VPiece &piece, const VContainer *data,
+                                                          bool showSecondNotch)
+{
+    VContainer pattern(*data);
+    VContainerJournal journal;
+    pattern.SetJournal(&journal);
+
+    Entry entry;
+    entry.geometry.mainPathPoints = piece.MainPathPoints(&pattern);
+    entry.geometry.seamAllowancePoints = piece.SeamAllowancePoints(&pattern);
+    entry.geometry.notches = piece.createNotchLines(&pattern, showSecondNotch, entry.geometry.seamAllowancePoints);
+
+    const QVector<quint32> internalPaths = piece.GetInternalPaths();
+    for (int i = 0; i < internalPaths.size(); ++i)
+    {
+        const VPiecePath path = pattern.GetPiecePath(internalPaths.at(i));
+        if (path.GetType() == PiecePathType::InternalPath)
+        {
+            entry.geometry.internalPaths.insert(internalPaths.at(i), path.PathPoints(&pattern));
+        }
+    }
+
+    pattern.SetJournal(nullptr);
+
+    for (auto id = journal.readObjects.constBegin(); id != journal.readObjects.constEnd(); ++id)
+    {
+        entry.objects.insert(*id, pattern.GetGObject(*id));
+    }
+
+    for (auto name = journal.readVariables.constBegin(); name != journal.readVariables.constEnd(); ++name)
+    {
+        entry.variables.insert(*name, VariableValue(&pattern, *name));
+    }
+
+    return entry;
+}
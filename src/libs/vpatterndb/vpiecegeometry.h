@@ -0,0 +1,97 @@
+/***************************************************************************
+ *                                                                         *
+ *   @file   vpiecegeometry.h                                              *
+ *   @author Seamly2D project                                              *
+ *   @date   10.16.2026                                                    *
+ *   Copyright (C) 2017  Seamly, LLC                                       *
+ *                                                                         *
+ *   https://github.com/fashionfreedom/seamly2d                            *
+ *                                                                         *
+ ***************************************************************************
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **************************************************************************/
+
+#ifndef VPIECEGEOMETRY_H
+#define VPIECEGEOMETRY_H
+
+#include <QByteArray>
+#include <QHash>
+#include <QLineF>
+#include <QMutex>
+#include <QPointF>
+#include <QSharedPointer>
+#include <QString>
+#include <QVector>
+#include <QtGlobal>
+
+class VContainer;
+class VGObject;
+class VPiece;
+
+/**
+ * @brief The VPieceGeometry struct geometry of a piece the scene, the layout and the export are built from.
+ */
+struct VPieceGeometry
+{
+    QVector<QPointF>                 mainPathPoints{};
+    QVector<QPointF>                 seamAllowancePoints{};
+    QVector<QLineF>                  notches{};
+    /** @brief internalPaths points of internal paths by id of a path. */
+    QHash<quint32, QVector<QPointF>> internalPaths{};
+};
+
+/**
+ * @brief The VPieceGeometryCache class keeps geometry of pieces between recalculations of a pattern.
+ *
+ * An entry is stamped with everything its calculation has read: definition of the piece and its paths, instances of
+ * geometric objects and values of variables. Incremental parsing puts back the same instances of objects for tools
+ * that were not recalculated, so an entry stays valid until something the piece is built from really changes.
+ *
+ * All copies of a container share one cache. Access is guarded by a mutex, calculation itself runs unlocked.
+ */
+class VPieceGeometryCache
+{
+public:
+    VPieceGeometryCache();
+
+    VPieceGeometry Geometry(quint32 id, const VPiece &piece, const VContainer *data, bool showSecondNotch);
+    void           Remove(quint32 id);
+    void           Clear();
+
+    int            CalculationsCount() const;
+
+private:
+    Q_DISABLE_COPY(VPieceGeometryCache)
+
+    struct Entry
+    {
+        QByteArray                               definition{};
+        QHash<quint32, QSharedPointer<VGObject>> objects{};
+        /** @brief variables values of read variables, NaN if a variable was missing. */
+        QHash<QString, qreal>                    variables{};
+        VPieceGeometry                           geometry{};
+    };
+
+    mutable QMutex        mutex;
+    QHash<quint32, Entry> entries;
+    int                   calculations;
+
+    static QByteArray Definition(const VPiece &piece, const VContainer *data, bool showSecondNotch);
+    static bool       IsValid(const Entry &entry, const QByteArray &definition, const VContainer *data);
+    static Entry      Calculate(const VPiece &piece, const VContainer *data, bool showSecondNotch);
+};
+
+#endif // VPIECEGEOMETRY_H
@@ -68,12 +68,13 @@ qreal EvalFormula(const VContainer *data, QString formula)
     }
     else
     {
+        // Replace line return character with spaces for calc if exist
+        formula.replace("\n", " ");
+        QScopedPointer<Calculator> cal(new Calculator());
         try
         {
-            // Replace line return character with spaces for calc if exist
-            formula.replace("\n", " ");
-            QScopedPointer<Calculator> cal(new Calculator());
             const qreal result = cal->EvalFormula(data->DataVariables(), formula);
+            data->JournalVariableReads(cal->GetTokens().values());
 
             if (qIsInf(result) || qIsNaN(result))
             {
@@ -84,6 +85,7 @@ qreal EvalFormula(const VContainer *data, QString formula)
         catch (qmu::QmuParserError &e)
         {
             Q_UNUSED(e)
+            data->JournalVariableReads(cal->GetTokens().values());
             return -1;
         }
     }
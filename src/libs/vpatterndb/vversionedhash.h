@@ -0,0 +1,297 @@
+/***************************************************************************
+ *                                                                         *
+ *   @file   vversionedhash.h                                              *
+ *   @author Seamly2D project                                              *
+ *   @date   10.16.2026                                                    *
+ *   Copyright (C) 2017  Seamly, LLC                                       *
+ *                                                                         *
+ *   https://github.com/fashionfreedom/seamly2d                            *
+ *                                                                         *
+ ***************************************************************************
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **************************************************************************/
+
+#ifndef VVERSIONEDHASH_H
+#define VVERSIONEDHASH_H
+
+#include <QExplicitlySharedDataPointer>
+#include <QHash>
+#include <QList>
+#include <QSharedData>
+#include <QVector>
+#include <QtGlobal>
+
+#include "../vmisc/def.h"
+
+/**
+ * @brief The VVersionedHash class hash of shared pointers whose copies share structure.
+ *
+ * Entries are kept in a stack of levels, a newer level shadows older ones. A level shared with another copy is never
+ * changed, a write goes to a new level on top instead. After each write the top level is merged into the level below
+ * while that one is not bigger, the same way a binary counter carries. So a hash with n entries has O(log n) levels,
+ * a copy costs O(log n) and the first write after copying doesn't duplicate all entries.
+ *
+ * A removed key is kept as null value until it reaches the bottom level, that's why null values can't be stored.
+ */
+template <typename Key, typename T>
+class VVersionedHash
+{
+public:
+    VVersionedHash();
+
+    T             value(const Key &key) const;
+    bool          contains(const Key &key) const;
+    int           size() const;
+    bool          isEmpty() const;
+    QList<Key>    keys() const;
+    QHash<Key, T> toHash() const;
+
+    void          insert(const Key &key, const T &value);
+    void          remove(const Key &key);
+    void          clear();
+    template <typename Predicate>
+    void          removeIf(Predicate predicate);
+
+    int           levelCount() const;
+
+private:
+    struct Level : public QSharedData
+    {
+        QHash<Key, T> entries;
+    };
+
+    /** @brief levels from the oldest to the newest. */
+    QVector<QExplicitlySharedDataPointer<Level>> levels;
+
+    /** @brief count number of keys with not null value. */
+    int count;
+
+    void Write(const Key &key, const T &value);
+    void Merge();
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+template <typename Key, typename T>
+VVersionedHash<Key, T>::VVersionedHash()
+    : levels(),
+      count(0)
+{}
+
+//---------------------------------------------------------------------------------------------------------------------
+template <typename Key, typename T>
+T VVersionedHash<Key, T>::value(const Key &key) const
+{
+    for (int i = levels.size() - 1; i >= 0; --i)
+    {
+        const QHash<Key, T> &entries = levels.at(i)->entries;
+        const auto entry = entries.constFind(key);
+        if (entry != entries.constEnd())
+        {
+            return entry.value();
+        }
+    }
+    return T();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+template <typename Key, typename T>
+bool VVersionedHash<Key, T>::contains(const Key &key) const
+{
+    return not value(key).isNull();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+template <typename Key, typename T>
+int VVersionedHash<Key, T>::size() const
+{
+    return count;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+template <typename Key, typename T>
+bool VVersionedHash<Key, T>::isEmpty() const
+{
+    return count == 0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+template <typename Key, typename T>
+QList<Key> VVersionedHash<Key, T>::keys() const
+{
+    return toHash().keys();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief toHash flatten all levels. Cheap if there is only one level, the hash is implicitly shared then.
+ * @return all entries.
+ */
+template <typename Key, typename T>
+QHash<Key, T> VVersionedHash<Key, T>::toHash() const
+{
+    if (levels.isEmpty())
+    {
+        return QHash<Key, T>();
+    }
+
+    QHash<Key, T> hash = levels.first()->entries;
+    for (int i = 1; i < levels.size(); ++i)
+    {
+        const QHash<Key, T> &entries = levels.at(i)->entries;
+        for (auto entry = entries.constBegin(); entry != entries.constEnd(); ++entry)
+        {
+            if (entry.value().isNull())
+            {
+                hash.remove(entry.key());
+            }
+            else
+            {
+                hash.insert(entry.key(), entry.value());
+            }
+        }
+    }
+    return hash;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+template <typename Key, typename T>
+void VVersionedHash<Key, T>::insert(const Key &key, const T &value)
+{
+    SCASSERT(not value.isNull())
+    if (not contains(key))
+    {
+        ++count;
+    }
+    Write(key, value);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+template <typename Key, typename T>
+void VVersionedHash<Key, T>::remove(const Key &key)
+{
+    if (contains(key))
+    {
+        --count;
+        Write(key, T());
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+template <typename Key, typename T>
+void VVersionedHash<Key, T>::clear()
+{
+    levels.clear();
+    count = 0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief removeIf remove all entries that match predicate. Leaves one level.
+ * @param predicate callable that takes key and value and returns true for entries to remove.
+ */
+template <typename Key, typename T>
+template <typename Predicate>
+void VVersionedHash<Key, T>::removeIf(Predicate predicate)
+{
+    QHash<Key, T> hash = toHash();
+    auto entry = hash.begin();
+    while (entry != hash.end())
+    {
+        if (predicate(entry.key(), entry.value()))
+        {
+            entry = hash.erase(entry);
+        }
+        else
+        {
+            ++entry;
+        }
+    }
+
+    levels.clear();
+    count = hash.size();
+    if (not hash.isEmpty())
+    {
+        QExplicitlySharedDataPointer<Level> level(new Level);
+        level->entries = hash;
+        levels.append(level);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+template <typename Key, typename T>
+int VVersionedHash<Key, T>::levelCount() const
+{
+    return levels.size();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+template <typename Key, typename T>
+void VVersionedHash<Key, T>::Write(const Key &key, const T &value)
+{
+    // Non const access detaches the vector, after that the reference counter shows if a level is shared by other
+    // copies.
+    if (levels.isEmpty() or levels.last()->ref.load() > 1)
+    {
+        levels.append(QExplicitlySharedDataPointer<Level>(new Level));
+    }
+
+    if (value.isNull() and levels.size() == 1)
+    {
+        levels.last()->entries.remove(key);
+    }
+    else
+    {
+        levels.last()->entries.insert(key, value);
+    }
+    Merge();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+template <typename Key, typename T>
+void VVersionedHash<Key, T>::Merge()
+{
+    while (levels.size() >= 2 and levels.at(levels.size() - 2)->entries.size() <= levels.last()->entries.size())
+    {
+        const QExplicitlySharedDataPointer<Level> top = levels.takeLast();
+        QExplicitlySharedDataPointer<Level> &below = levels.last();
+        if (below->ref.load() > 1)
+        {
+            QExplicitlySharedDataPointer<Level> copy(new Level);
+            copy->entries = below->entries;
+            below = copy;
+        }
+
+        const bool bottom = levels.size() == 1;
+        for (auto entry = top->entries.constBegin(); entry != top->entries.constEnd(); ++entry)
+        {
+            if (bottom and entry.value().isNull())
+            {
+                below->entries.remove(entry.key());
+            }
+            else
+            {
+                below->entries.insert(entry.key(), entry.value());
+            }
+        }
+    }
+
+    if (levels.size() == 1 and levels.last()->entries.isEmpty())
+    {
+        levels.clear();
+    }
+}
+
+#endif // VVERSIONEDHASH_H
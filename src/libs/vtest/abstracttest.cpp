@@ -69,6 +69,40 @@
 #include <QVector>
 #include <QtGlobal>
 
+#ifdef __GLIBC__
+#   include <malloc.h>
+#endif
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ProcessStatus read a memory field of /proc/self/status in bytes, or -1 if there is no such file or field.
+ */
+qint64 ProcessStatus(const QByteArray &field)
+{
+    QFile file(QStringLiteral("/proc/self/status"));
+    if (not file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        return -1;
+    }
+
+    const QByteArray prefix = field + ':';
+    while (not file.atEnd())
+    {
+        const QByteArray line = file.readLine();
+        if (line.startsWith(prefix))
+        {
+            // Values are in kB
+            bool ok = false;
+            const qint64 kb = line.mid(prefix.size()).simplified().split(' ').first().toLongLong(&ok);
+            return ok ? kb * 1024 : -1;
+        }
+    }
+    return -1;
+}
+}
+
 #include "logging.h"
 #include "vsysexits.h"
 #include "../vgeometry/vgobject.h"
@@ -236,3 +270,64 @@ bool AbstractTest::CopyRecursively(const QString &srcFilePath, const QString &tg
     }
     return true;
 }
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief AllocatedMemory return number of bytes the heap has handed out and not got back yet, or -1 if the C library
+ * doesn't report it. Unlike resident size it goes down after a free, so differences measure what a block of code keeps
+ * alive and rows of a benchmark don't depend on each other.
+ */
+qint64 AbstractTest::AllocatedMemory()
+{
+#ifdef __GLIBC__
+#   if __GLIBC_PREREQ(2, 33)
+    const struct mallinfo2 info = mallinfo2();
+    return static_cast<qint64>(info.uordblks + info.hblkhd);
+#   else
+    const struct mallinfo info = mallinfo();
+    return static_cast<qint64>(static_cast<unsigned int>(info.uordblks))
+            + static_cast<qint64>(static_cast<unsigned int>(info.hblkhd));
+#   endif
+#else
+    return -1;
+#endif
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ResetPeakMemory give freed heap back to the system and set peak resident size to the current one, so
+ * PeakMemory() tells the peak of the code that runs next. Works on Linux only.
+ * @return false if the peak can't be reset.
+ */
+bool AbstractTest::ResetPeakMemory()
+{
+#ifdef __GLIBC__
+    // Otherwise memory freed by previous code is reused without raising the peak
+    malloc_trim(0);
+#endif
+
+    QFile file(QStringLiteral("/proc/self/clear_refs"));
+    if (not file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+    return file.write("5") == 1;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief PeakMemory return peak resident size of the process in bytes (VmHWM), or -1 if it isn't available.
+ */
+qint64 AbstractTest::PeakMemory()
+{
+    return ProcessStatus(QByteArrayLiteral("VmHWM"));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ResidentMemory return resident size of the process in bytes (VmRSS), or -1 if it isn't available.
+ */
+qint64 AbstractTest::ResidentMemory()
+{
+    return ProcessStatus(QByteArrayLiteral("VmRSS"));
+}
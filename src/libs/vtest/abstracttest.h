@@ -93,6 +93,11 @@ class AbstractTest : public QObject
 
     int Run(int exit, const QString &program, const QStringList &arguments, QString &error, int msecs = 120000);
     bool CopyRecursively(const QString &srcFilePath, const QString &tgtFilePath) const;
+
+    static qint64 AllocatedMemory();
+    static bool   ResetPeakMemory();
+    static qint64 PeakMemory();
+    static qint64 ResidentMemory();
 };
 
 #endif // ABSTRACTTEST_H
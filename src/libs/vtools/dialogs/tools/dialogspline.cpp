@@ -475,7 +475,7 @@ VSpline DialogSpline::CurrentSpline() const
     QString length2F = ui->plainTextEditLength2F->toPlainText();
     length2F.replace("\n", " ");
 
-    const QHash<QString, QSharedPointer<VInternalVariable> > *vars = data->DataVariables();
+    const VVersionedHash<QString, QSharedPointer<VInternalVariable> > *vars = data->DataVariables();
 
     const qreal angle1 = Visualization::FindVal(angle1F, vars);
     const qreal angle2 = Visualization::FindVal(angle2F, vars);
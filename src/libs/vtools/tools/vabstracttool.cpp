@@ -72,6 +72,7 @@
 #include <QStringData>
 #include <QStringDataPtr>
 #include <QStyle>
+#include <QThread>
 #include <QUndoStack>
 #include <QVector>
 #include <new>
@@ -187,6 +188,7 @@ qreal VAbstractTool::CheckFormula(const quint32 &toolId, QString &formula, VCont
     {
         QScopedPointer<Calculator> cal(new Calculator());
         result = cal->EvalFormula(data->DataVariables(), formula);
+        data->JournalVariableReads(cal->GetTokens().values());
 
         if (qIsInf(result) || qIsNaN(result))
         {
@@ -202,7 +204,8 @@ qreal VAbstractTool::CheckFormula(const quint32 &toolId, QString &formula, VCont
                  << "Expression:  " << e.GetExpr() << "\n"
                  << "--------------------------------------";
 
-        if (qApp->IsAppInGUIMode())
+        // Evaluations of gradations run in a thread pool, only GUI thread can ask user to fix the formula
+        if (qApp->IsAppInGUIMode() && QThread::currentThread() == qApp->thread())
         {
             QScopedPointer<DialogUndo> dialogUndo(new DialogUndo(qApp->getMainWindow()));
             forever
@@ -223,6 +226,7 @@ qreal VAbstractTool::CheckFormula(const quint32 &toolId, QString &formula, VCont
                             delete dialog;
                             QScopedPointer<Calculator> cal1(new Calculator());
                             result = cal1->EvalFormula(data->DataVariables(), formula);
+                            data->JournalVariableReads(cal1->GetTokens().values());
 
                             if (qIsInf(result) || qIsNaN(result))
                             {
@@ -437,10 +441,10 @@ QPixmap VAbstractTool::createColorIcon(const int w, const int h, const QString &
 // cppcheck-suppress unusedFunction
 QMap<QString, quint32> VAbstractTool::PointsList() const
 {
-    const QHash<quint32, QSharedPointer<VGObject> > *objs = data.DataGObjects();
+    const QHash<quint32, QSharedPointer<VGObject> > objs = data.DataGObjects();
     QMap<QString, quint32> list;
     QHash<quint32, QSharedPointer<VGObject> >::const_iterator i;
-    for (i = objs->constBegin(); i != objs->constEnd(); ++i)
+    for (i = objs.constBegin(); i != objs.constEnd(); ++i)
     {
         if (i.key() != m_id)
         {
@@ -82,8 +82,22 @@
 #include <QGraphicsSceneMouseEvent>
 #include <QGraphicsView>
 #include <QKeyEvent>
+#include <QLoggingCategory>
 #include <QMenu>
 #include <QMessageBox>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QRunnable>
+#include <QThreadPool>
+#include <functional>
+
+QT_WARNING_PUSH
+QT_WARNING_DISABLE_CLANG("-Wmissing-prototypes")
+QT_WARNING_DISABLE_INTEL(1418)
+
+Q_LOGGING_CATEGORY(vToolSeamAllowance, "v.toolSeamAllowance")
+
+QT_WARNING_POP
 
 // Current version of seam allowance tag need for backward compatibility
 const quint8 VToolSeamAllowance::pieceVersion = 2;
@@ -107,6 +121,51 @@ const QString VToolSeamAllowance::AttrCenterPin            = QStringLiteral("cen
 const QString VToolSeamAllowance::AttrTopPin               = QStringLiteral("topPin");
 const QString VToolSeamAllowance::AttrBottomPin            = QStringLiteral("bottomPin");
 
+/**
+ * @brief The VGeometryRequests struct links a tool with background calculations of its geometry.
+ *
+ * Each request increases revision, a result of any other revision than the last one is stale and is dropped. The tool
+ * clears the pointer when it is destroyed, the mutex makes sure a result is never posted to a deleted tool.
+ *
+ * A calculation leaves its result here and asks the tool to pick it up in GUI thread, only the newest result is kept.
+ */
+struct VGeometryRequests
+{
+    QMutex              mutex{};
+    VToolSeamAllowance *tool{nullptr};
+    QAtomicInt          revision{0};
+
+    int                 resultRevision{0};
+    VPiece              piece{};
+    VPieceGeometry      geometry{};
+    /** @brief size, height gradation the result was calculated for. */
+    qreal               size{0};
+    qreal               height{0};
+};
+
+namespace
+{
+/**
+ * @brief The VGeometryJob class runs a calculation of geometry in a thread pool.
+ */
+class VGeometryJob : public QRunnable
+{
+public:
+    explicit VGeometryJob(const std::function<void ()> &job)
+        : job(job)
+    {}
+
+    virtual void run() Q_DECL_OVERRIDE
+    {
+        job();
+    }
+
+private:
+    Q_DISABLE_COPY(VGeometryJob)
+    std::function<void ()> job;
+};
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 VToolSeamAllowance *VToolSeamAllowance::Create(QSharedPointer<DialogTool> dialog, VMainGraphicsScene *scene,
                                                VAbstractPattern *doc, VContainer *data)
@@ -481,7 +540,15 @@ void VToolSeamAllowance::GroupVisibility(quint32 object, bool visible)
 void VToolSeamAllowance::FullUpdateFromFile()
 {
     UpdateExcludeState();
-    RefreshGeometry();
+
+    if (qApp->IsAppInGUIMode())
+    {
+        RefreshGeometryInBackground();
+    }
+    else
+    {
+        RefreshGeometry();
+    }
 }
 
 //---------------------------------------------------------------------------------------------------------------------
@@ -1147,7 +1214,10 @@ VToolSeamAllowance::VToolSeamAllowance(VAbstractPattern *doc, VContainer *data,
     , m_patternInfo(new VTextGraphicsItem(this))
     , m_grainLine(new VGrainlineItem(this))
     , m_notches(new QGraphicsPathItem(this))
+    , m_geometryRequests(new VGeometryRequests())
 {
+    m_geometryRequests->tool = this;
+
     VPiece piece = data->GetPiece(id);
     InitNodes(piece, scene);
     InitCSAPaths(piece);
@@ -1155,7 +1225,19 @@ VToolSeamAllowance::VToolSeamAllowance(VAbstractPattern *doc, VContainer *data,
     InitPins(piece);
     this->setFlag(QGraphicsItem::ItemIsMovable, true);
     this->setFlag(QGraphicsItem::ItemIsSelectable, true);
-    RefreshGeometry();
+    if (qApp->IsAppInGUIMode())
+    {
+        // Full parse creates all tools again, so nothing is cached for them yet. Until the seam allowance is ready
+        // the piece shows its main path, it doesn't need the heavy calculation.
+        VPieceGeometry placeholder;
+        placeholder.mainPathPoints = piece.MainPathPoints(data);
+        ApplyGeometry(piece, placeholder);
+        RefreshGeometryInBackground();
+    }
+    else
+    {
+        RefreshGeometry();
+    }
 
     this->setFlag(QGraphicsItem::ItemSendsGeometryChanges, true);
     this->setFlag(QGraphicsItem::ItemIsFocusable, true);// For keyboard input focus
@@ -1210,13 +1292,124 @@ void VToolSeamAllowance::UpdateExcludeState()
     }
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+VToolSeamAllowance::~VToolSeamAllowance()
+{
+    QMutexLocker locker(&m_geometryRequests->mutex);
+    m_geometryRequests->tool = nullptr;
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void VToolSeamAllowance::RefreshGeometry()
 {
-    this->setFlag(QGraphicsItem::ItemSendsGeometryChanges, false);
+    m_geometryRequests->revision.ref(); // Results of background calculations are stale now
 
     const VPiece piece = VAbstractTool::data.GetPiece(m_id);
-    QPainterPath path = piece.MainPathPath(this->getData());
+    ApplyGeometry(piece, VAbstractTool::data.GetPieceGeometry(m_id, piece, qApp->Settings()->showSecondNotch()));
+    UpdatePosition(piece);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief RefreshGeometryInBackground calculate geometry in a thread pool, the scene shows the previous geometry until
+ * the new one is ready.
+ *
+ * The calculation reads a snapshot of the container, so parsing can continue meanwhile. A newer request or
+ * RefreshGeometry() makes the result stale. A stale calculation that hasn't started yet is skipped, a stale result
+ * is dropped. Everything the calculation needs from the application is read here, in GUI thread. The position
+ * doesn't need the calculation and is updated at once.
+ */
+void VToolSeamAllowance::RefreshGeometryInBackground()
+{
+    const int revision = m_geometryRequests->revision.fetchAndAddOrdered(1) + 1;
+    const QSharedPointer<VGeometryRequests> requests = m_geometryRequests;
+    const VPiece piece = VAbstractTool::data.GetPiece(m_id);
+    const VContainer snapshot = VAbstractTool::data.Snapshot();
+    const quint32 id = m_id;
+    const bool showSecondNotch = qApp->Settings()->showSecondNotch();
+    const qreal size = VAbstractTool::data.Gradation().size;
+    const qreal height = VAbstractTool::data.Gradation().height;
+
+    UpdatePosition(piece);
+
+    QThreadPool::globalInstance()->start(new VGeometryJob([requests, revision, piece, snapshot, id, showSecondNotch,
+                                                           size, height]()
+    {
+        if (requests->revision.load() != revision)
+        {
+            return; // Cancelled by a newer request
+        }
+
+        VPieceGeometry geometry;
+        try
+        {
+            geometry = snapshot.GetPieceGeometry(id, piece, showSecondNotch);
+        }
+        catch (const VException &e)
+        {
+            qCWarning(vToolSeamAllowance, "Can't calculate geometry of piece %u. %s", id,
+                      qUtf8Printable(e.ErrorMessage()));
+            return;
+        }
+
+        QMutexLocker locker(&requests->mutex);
+        if (requests->tool != nullptr && requests->revision.load() == revision)
+        {
+            requests->resultRevision = revision;
+            requests->piece = piece;
+            requests->geometry = geometry;
+            requests->size = size;
+            requests->height = height;
+            QMetaObject::invokeMethod(requests->tool, "ApplyBackgroundGeometry", Qt::QueuedConnection,
+                                      Q_ARG(int, revision));
+        }
+    }));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ApplyBackgroundGeometry show result of RefreshGeometryInBackground() if it is still the newest one.
+ * @param revision revision of the request the result belongs to.
+ */
+void VToolSeamAllowance::ApplyBackgroundGeometry(int revision)
+{
+    VPiece piece;
+    VPieceGeometry geometry;
+    {
+        QMutexLocker locker(&m_geometryRequests->mutex);
+        if (m_geometryRequests->revision.load() != revision || m_geometryRequests->resultRevision != revision)
+        {
+            return;
+        }
+
+        // Measurements read gradation directly, a change of it while calculating makes the result useless. The change
+        // also re-parses the pattern, so a newer request is on its way.
+        const VGradation gradation = VAbstractTool::data.Gradation();
+        if (not VFuzzyComparePossibleNulls(m_geometryRequests->size, gradation.size)
+                || not VFuzzyComparePossibleNulls(m_geometryRequests->height, gradation.height))
+        {
+            return;
+        }
+
+        piece = m_geometryRequests->piece;
+        geometry = m_geometryRequests->geometry;
+    }
+
+    ApplyGeometry(piece, geometry);
+
+    // The result may come after the parse has already updated the scene rect
+    if (QGraphicsScene *sc = scene())
+    {
+        VMainGraphicsView::NewSceneRect(sc, qApp->getSceneView(), this);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void VToolSeamAllowance::ApplyGeometry(const VPiece &piece, const VPieceGeometry &geometry)
+{
+    this->setFlag(QGraphicsItem::ItemSendsGeometryChanges, false);
+
+    QPainterPath path = VPiece::MainPathPath(geometry.mainPathPoints);
 
     if (not piece.IsHideMainPath() || not piece.IsSeamAllowance() || piece.IsSeamAllowanceBuiltIn())
     {
@@ -1235,20 +1428,11 @@ void VToolSeamAllowance::RefreshGeometry()
 
     this->setPath(path);
 
-    QVector<QPointF> seamAllowancePoints;
-
-    if (piece.IsSeamAllowance())
-    {
-        seamAllowancePoints = piece.SeamAllowancePoints(this->getData());
-    }
-
-    m_notches->setPath(piece.getNotchesPath(this->getData(), seamAllowancePoints));
-
-    this->setPos(piece.GetMx(), piece.GetMy());
+    m_notches->setPath(piece.getNotchesPath(geometry.notches));
 
     if (piece.IsSeamAllowance() && not piece.IsSeamAllowanceBuiltIn())
     {
-        path.addPath(piece.SeamAllowancePath(seamAllowancePoints));
+        path.addPath(piece.SeamAllowancePath(geometry.seamAllowancePoints));
         path.setFillRule(Qt::OddEvenFill);
         m_seamAllowance->setPath(path);
     }
@@ -1260,6 +1444,22 @@ void VToolSeamAllowance::RefreshGeometry()
     this->setFlag(QGraphicsItem::ItemSendsGeometryChanges, true);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief UpdatePosition move the piece to the position it has in the pattern unless the user drags it right now.
+ */
+void VToolSeamAllowance::UpdatePosition(const VPiece &piece)
+{
+    if (scene() != nullptr && scene()->mouseGrabberItem() == this)
+    {
+        return; // The position follows the mouse and is saved by itemChange()
+    }
+
+    this->setFlag(QGraphicsItem::ItemSendsGeometryChanges, false);
+    this->setPos(piece.GetMx(), piece.GetMy());
+    this->setFlag(QGraphicsItem::ItemSendsGeometryChanges, true);
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void VToolSeamAllowance::SaveDialogChange()
 {
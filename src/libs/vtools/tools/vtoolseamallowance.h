@@ -56,6 +56,7 @@
 #include <qcompilerdetection.h>
 #include <QObject>
 #include <QGraphicsPathItem>
+#include <QSharedPointer>
 
 #include "vinteractivetool.h"
 #include "../vwidgets/vtextgraphicsitem.h"
@@ -63,12 +64,14 @@
 
 class DialogTool;
 class VNoBrushScalePathItem;
+struct VGeometryRequests;
+struct VPieceGeometry;
 
 class VToolSeamAllowance : public VInteractiveTool, public QGraphicsPathItem
 {
     Q_OBJECT
 public:
-    virtual ~VToolSeamAllowance() Q_DECL_EQ_DEFAULT;
+    virtual ~VToolSeamAllowance();
 
     static VToolSeamAllowance *Create(QSharedPointer<DialogTool> dialog, VMainGraphicsScene *scene,
                                       VAbstractPattern *doc, VContainer *data);
@@ -143,6 +146,8 @@ protected slots:
     void SaveMoveGrainline(const QPointF& ptPos);
     void SaveResizeGrainline(qreal dLength);
     void SaveRotateGrainline(qreal dRot, const QPointF& ptPos);
+private slots:
+    void ApplyBackgroundGeometry(int revision);
 protected:
     virtual void       AddToFile () Q_DECL_OVERRIDE;
     virtual void       RefreshDataInFile() Q_DECL_OVERRIDE;
@@ -175,11 +180,17 @@ protected slots:
     VGrainlineItem        *m_grainLine;
     QGraphicsPathItem     *m_notches;
 
+    /** @brief m_geometryRequests state shared with background calculations of geometry. */
+    QSharedPointer<VGeometryRequests> m_geometryRequests;
+
     VToolSeamAllowance(VAbstractPattern *doc, VContainer *data, const quint32 &id, const Source &typeCreation,
                        VMainGraphicsScene *scene, const QString &drawName, QGraphicsItem * parent = nullptr);
 
     void UpdateExcludeState();
     void RefreshGeometry();
+    void RefreshGeometryInBackground();
+    void ApplyGeometry(const VPiece &piece, const VPieceGeometry &geometry);
+    void UpdatePosition(const VPiece &piece);
 
     VPieceItem::MoveTypes FindLabelGeometry(const VPatternLabelData &labelData, qreal &rotationAngle, qreal &labelWidth,
                                             qreal &labelHeight, QPointF &pos);
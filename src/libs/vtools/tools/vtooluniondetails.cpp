@@ -1569,6 +1569,7 @@ void VToolUnionDetails::AddToModeling(const QDomElement &domElement)
     if (not modeling.isNull())
     {
         modeling.appendChild(domElement);
+        doc->RegisterElementId(domElement);
     }
     else
     {
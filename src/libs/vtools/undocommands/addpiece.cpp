@@ -84,6 +84,7 @@ void AddPiece::undo()
                 qCDebug(vUndo, "Can't delete node");
                 return;
             }
+            doc->UnregisterElementId(domElement);
 
             DecrementReferences(m_detail.GetPath().GetNodes());
             DecrementReferences(m_detail.GetCustomSARecords());
@@ -113,6 +114,7 @@ void AddPiece::redo()
     if (not details.isNull())
     {
         details.appendChild(xml);
+        doc->RegisterElementId(xml);
     }
     else
     {
@@ -87,6 +87,7 @@ void AddToCalc::undo()
                 qCDebug(vUndo, "Can't delete node.");
                 return;
             }
+            doc->UnregisterElementId(domElement);
         }
         else
         {
@@ -118,6 +119,7 @@ void AddToCalc::redo()
         if (cursor == NULL_ID)
         {
             calcElement.appendChild(xml);
+            doc->RegisterElementId(xml);
         }
         else
         {
@@ -125,6 +127,7 @@ void AddToCalc::redo()
             if (refElement.isElement())
             {
                 calcElement.insertAfter(xml, refElement);
+                doc->RegisterElementId(xml);
             }
             else
             {
@@ -118,6 +118,7 @@ void DeletePiece::redo()
     if (domElement.isElement())
     {
         m_parentNode.removeChild(domElement);
+        doc->UnregisterElementId(domElement);
 
         // UnionDetails delete two old details and create one new.
         // So when UnionDetail delete detail we can't use FullParsing. So we hide detail on scene directly.
@@ -94,5 +94,6 @@ void DelTool::redo()
     doc->SetCurrentPP(nameActivDraw);//Without this user will not see this change
     QDomElement domElement = doc->NodeById(nodeId);
     parentNode.removeChild(domElement);
+    doc->UnregisterElementId(domElement);
     emit NeedFullParsing();
 }
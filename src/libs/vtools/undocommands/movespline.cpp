@@ -134,6 +134,7 @@ void MoveSpline::Do(const VSpline &spl)
         doc->SetAttribute(domElement, AttrLength1, spl.GetC1LengthFormula());
         doc->SetAttribute(domElement, AttrLength2, spl.GetC2LengthFormula());
 
+        doc->MarkToolChanged(nodeId);
         emit NeedLiteParsing(Document::LiteParse);
     }
     else
@@ -149,6 +149,7 @@ void MoveSPoint::Do(double x, double y)
         doc->SetAttribute(domElement, AttrX, QString().setNum(qApp->fromPixel(x)));
         doc->SetAttribute(domElement, AttrY, QString().setNum(qApp->fromPixel(y)));
 
+        doc->MarkToolChanged(nodeId);
         emit NeedLiteParsing(Document::LitePPParse);
     }
     else
@@ -80,7 +80,9 @@ void SaveToolOptions::undo()
     if (domElement.isElement())
     {
         domElement.parentNode().replaceChild(oldXml, domElement);
+        doc->RegisterElementId(oldXml);
 
+        doc->MarkToolChanged(nodeId);
         emit NeedLiteParsing(Document::LiteParse);
     }
     else
@@ -99,7 +101,9 @@ void SaveToolOptions::redo()
     if (domElement.isElement())
     {
         domElement.parentNode().replaceChild(newXml, domElement);
+        doc->RegisterElementId(newXml);
 
+        doc->MarkToolChanged(nodeId);
         emit NeedLiteParsing(Document::LiteParse);
     }
     else
@@ -72,6 +72,7 @@ class VScaledLine;
 class VContainer;
 //class VInternalVariable;
 #include "variables/vinternalvariable.h"
+#include "vversionedhash.h"
 enum class Mode : char {Creation, Show};
 
 class Visualization : public QObject
@@ -95,8 +96,10 @@ class Visualization : public QObject
     Mode GetMode() const;
     void SetMode(const Mode &value);
 
-    static qreal FindLength(const QString &expression, const QHash<QString, QSharedPointer<VInternalVariable> > *vars);
-    static qreal FindVal(const QString &expression, const QHash<QString, QSharedPointer<VInternalVariable> > *vars);
+    static qreal FindLength(const QString &expression,
+                            const VVersionedHash<QString, QSharedPointer<VInternalVariable> > *vars);
+    static qreal FindVal(const QString &expression,
+                         const VVersionedHash<QString, QSharedPointer<VInternalVariable> > *vars);
 signals:
     void         ToolTip(const QString &toolTip);
 public slots:
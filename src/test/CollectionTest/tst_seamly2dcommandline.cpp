@@ -298,6 +298,85 @@ void TST_Seamly2DCommandLine::TestOpenCollection()
     QVERIFY2(exit == exitCode, qUtf8Printable(error));
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+void TST_Seamly2DCommandLine::TestIncrementalParse_data() const
+{
+    QTest::addColumn<QString>("file");
+    QTest::addColumn<QString>("arguments");
+    QTest::addColumn<int>("exitCode");
+
+    const QString tmp = QCoreApplication::applicationDirPath() + QDir::separator() + tmpTestCollectionFolder;
+    const QString keyTest = QStringLiteral("--test;;--testincremental");
+    const QString testGOST = QString("--test;;--testincremental;;-m;;%1")
+            .arg(tmp + QDir::separator() + QLatin1String("GOST_man_ru.vst"));
+
+    QTest::newRow("TestDart")    << "TestDart.val"    << keyTest << V_EX_OK;
+    QTest::newRow("TShirt_test") << "TShirt_test.val" << keyTest << V_EX_OK;
+    QTest::newRow("pants7, another size and height") << "pants7.val"
+                                                     << testGOST + QLatin1String(";;--gsize;;46;;--gheight;;170")
+                                                     << V_EX_OK;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief TestIncrementalParse switch size and height or change length formulas one by one and compare objects,
+ * variables and pieces of incremental recalculation with a full parse.
+ */
+void TST_Seamly2DCommandLine::TestIncrementalParse()
+{
+    QFETCH(QString, file);
+    QFETCH(QString, arguments);
+    QFETCH(int, exitCode);
+
+    QString error;
+    const QString tmp = QCoreApplication::applicationDirPath() + QDir::separator() + tmpTestCollectionFolder;
+    const QStringList arg = QStringList() << tmp + QDir::separator() + file
+                                          << arguments.split(";;");
+    const int exit = Run(exitCode, Seamly2DPath(), arg, error);
+
+    QVERIFY2(exit == exitCode, qUtf8Printable(error));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_Seamly2DCommandLine::TestGradations_data() const
+{
+    QTest::addColumn<QString>("file");
+    QTest::addColumn<QString>("arguments");
+    QTest::addColumn<int>("exitCode");
+
+    const QString tmp = QCoreApplication::applicationDirPath() + QDir::separator() + tmpTestCollectionFolder;
+    const QString testGOST = QString("--test;;--testgradations;;-m;;%1")
+            .arg(tmp + QDir::separator() + QLatin1String("GOST_man_ru.vst"));
+
+    QTest::newRow("pants7")                          << "pants7.val" << testGOST << V_EX_OK;
+    QTest::newRow("pants7, another size and height") << "pants7.val"
+                                                     << testGOST + QLatin1String(";;--gsize;;46;;--gheight;;170")
+                                                     << V_EX_OK;
+    QTest::newRow("TestDart, no multisize measurements") << "TestDart.val"
+                                                         << QStringLiteral("--test;;--testgradations")
+                                                         << V_EX_SOFTWARE;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief TestGradations evaluate several sizes and heights in parallel and compare objects, variables and pieces with
+ * parsing the pattern for each of them in turn.
+ */
+void TST_Seamly2DCommandLine::TestGradations()
+{
+    QFETCH(QString, file);
+    QFETCH(QString, arguments);
+    QFETCH(int, exitCode);
+
+    QString error;
+    const QString tmp = QCoreApplication::applicationDirPath() + QDir::separator() + tmpTestCollectionFolder;
+    const QStringList arg = QStringList() << tmp + QDir::separator() + file
+                                          << arguments.split(";;");
+    const int exit = Run(exitCode, Seamly2DPath(), arg, error);
+
+    QVERIFY2(exit == exitCode, qUtf8Printable(error));
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 // cppcheck-suppress unusedFunction
 void TST_Seamly2DCommandLine::cleanupTestCase()
@@ -70,6 +70,10 @@ private slots:
     void TestMode();
     void TestOpenCollection_data() const;
     void TestOpenCollection();
+    void TestIncrementalParse_data() const;
+    void TestIncrementalParse();
+    void TestGradations_data() const;
+    void TestGradations();
     void cleanupTestCase();
 
 private:
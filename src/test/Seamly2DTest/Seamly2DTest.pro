@@ -62,7 +62,13 @@ SOURCES += \
     tst_vpointf.cpp \
     tst_readval.cpp \
     tst_vtranslatevars.cpp \
-    tst_vabstractpiece.cpp
+    tst_vabstractpiece.cpp \
+    tst_vlayoutgenerator.cpp \
+    tst_calculator.cpp \
+    tst_vcontainer.cpp \
+    tst_vdomdocument.cpp \
+    tst_vbatchexport.cpp \
+    ../../app/seamly2d/core/vbatchexport.cpp
 
 *msvc*:SOURCES += stable.cpp
 
@@ -88,7 +94,13 @@ HEADERS += \
     tst_vpointf.h \
     tst_readval.h \
     tst_vtranslatevars.h \
-    tst_vabstractpiece.h
+    tst_vabstractpiece.h \
+    tst_vlayoutgenerator.h \
+    tst_calculator.h \
+    tst_vcontainer.h \
+    tst_vdomdocument.h \
+    tst_vbatchexport.h \
+    ../../app/seamly2d/core/vbatchexport.h
 
 # Set using ccache. Function enable_ccache() defined in common.pri.
 $$enable_ccache()
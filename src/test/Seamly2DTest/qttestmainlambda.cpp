@@ -72,7 +72,13 @@
 #include "tst_vpointf.h"
 #include "tst_readval.h"
 #include "tst_vtranslatevars.h"
+#include "tst_vlayoutgenerator.h"
+#include "tst_calculator.h"
+#include "tst_vcontainer.h"
+#include "tst_vdomdocument.h"
+#include "tst_vbatchexport.h"
 
+#include "../ifc/xml/vabstractconverter.h"
 #include "../vmisc/def.h"
 #include "../qmuparser/qmudef.h"
 #include "../vmisc/vabstractapplication.h"
@@ -130,6 +136,7 @@ int main(int argc, char** argv)
     Q_INIT_RESOURCE(schema);
 
     TestVApplication app( argc, argv );// For QPrinter
+    VAbstractConverter::SetIntermediateValidation(true);
 
     int status = 0;
     auto ASSERT_TEST = [&status, argc, argv](QObject* obj)
@@ -159,6 +166,11 @@ int main(int argc, char** argv)
     ASSERT_TEST(new TST_VPointF());
     ASSERT_TEST(new TST_ReadVal());
     ASSERT_TEST(new TST_VTranslateVars());
+    ASSERT_TEST(new TST_VLayoutGenerator());
+    ASSERT_TEST(new TST_Calculator());
+    ASSERT_TEST(new TST_VContainer());
+    ASSERT_TEST(new TST_VDomDocument());
+    ASSERT_TEST(new TST_VBatchExport());
 
     return status;
 }
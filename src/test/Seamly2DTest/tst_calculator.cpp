@@ -0,0 +1,224 @@
+/***************************************************************************
+ *                                                                         *
+ *   Copyright (C) 2017  Seamly, LLC                                       *
+ *                                                                         *
+ *   https://github.com/fashionfreedom/seamly2d                             *
+ *                                                                         *
+ ***************************************************************************
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **************************************************************************
+
+ ************************************************************************
+ **
+ **  @file
+ **  @author Seamly2D project
+ **  @date   16 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Seamly2D project
+ **  <https://github.com/fashionfreedom/seamly2d> All Rights Reserved.
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#include "tst_calculator.h"
+#include "../vpatterndb/calculator.h"
+#include "../vpatterndb/vcontainer.h"
+#include "../vpatterndb/variables/vincrement.h"
+#include "../qmuparser/qmuparsererror.h"
+#include "../vmisc/def.h"
+
+#include <QtMath>
+#include <QtTest>
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+void AddIncrement(VContainer *data, const QString &name, qreal value)
+{
+    data->AddVariable(name, new VIncrement(data, name, 0, value, QString::number(value), true));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief LargePattern fill container with a chain of increments each depending on previous ones, the way a big
+ * pattern defines its measurements.
+ * @return formulas in order of parsing.
+ */
+QStringList LargePattern(VContainer *data)
+{
+    const int count = 2000;
+    QStringList formulas;
+    formulas.reserve(count);
+
+    AddIncrement(data, QStringLiteral("#inc_0"), 10);
+    AddIncrement(data, QStringLiteral("#inc_1"), 20);
+    AddIncrement(data, QStringLiteral("#inc_2"), 30);
+    for (int i = 3; i < count; ++i)
+    {
+        const QString formula = QStringLiteral("#inc_%1*1.01+#inc_%2/2-(#inc_%3+%4)*0.3")
+                .arg(i-1).arg(i-2).arg(i-3).arg(i%17);
+        formulas.append(formula);
+        AddIncrement(data, QStringLiteral("#inc_%1").arg(i), i);
+    }
+    return formulas;
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+TST_Calculator::TST_Calculator(QObject *parent)
+    : QObject(parent)
+{
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_Calculator::TestCachedFormula_data() const
+{
+    QTest::addColumn<QString>("formula");
+    QTest::addColumn<qreal>("result1");
+    QTest::addColumn<qreal>("result2");
+
+    // #a = 2, #b = 3 for result1 and #a = 5, #b = 3 for result2
+    QTest::newRow("Constant") << "(2+3)*4" << 20.0 << 20.0;
+    QTest::newRow("Product") << "#a*#b+1" << 7.0 << 16.0;
+    QTest::newRow("Square") << "#a*#a" << 4.0 << 25.0;
+    QTest::newRow("Multiply by value") << "#a*2+#b" << 7.0 << 13.0;
+    QTest::newRow("Function") << "sqrt(#a*8)+#b" << 7.0 << qSqrt(40.0)+3;
+    QTest::newRow("Condition") << "#a>3?#a:#b" << 3.0 << 5.0;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief TestCachedFormula check that a cached formula uses values of the variables it is evaluated with.
+ */
+void TST_Calculator::TestCachedFormula() const
+{
+    QFETCH(QString, formula);
+    QFETCH(qreal, result1);
+    QFETCH(qreal, result2);
+
+    Unit unit = Unit::Cm;
+    VContainer data1(nullptr, &unit);
+    AddIncrement(&data1, QStringLiteral("#a"), 2);
+    AddIncrement(&data1, QStringLiteral("#b"), 3);
+
+    VContainer data2(nullptr, &unit);
+    AddIncrement(&data2, QStringLiteral("#a"), 5);
+    AddIncrement(&data2, QStringLiteral("#b"), 3);
+
+    Calculator::ClearCache();
+
+    Calculator cal;
+    QCOMPARE(cal.EvalFormula(data1.DataVariables(), formula), result1);
+    QCOMPARE(Calculator::CacheMisses(), 1);
+    QCOMPARE(Calculator::CacheHits(), 0);
+
+    const QMap<int, QString> tokens = cal.GetTokens();
+
+    Calculator cal2;
+    QCOMPARE(cal2.EvalFormula(data1.DataVariables(), formula), result1);
+    QCOMPARE(cal2.GetTokens(), tokens);
+    QCOMPARE(cal2.EvalFormula(data2.DataVariables(), formula), result2);
+    QCOMPARE(Calculator::CacheMisses(), 1);
+    QCOMPARE(Calculator::CacheHits(), 2);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_Calculator::TestCachedUnknownVariable() const
+{
+    Unit unit = Unit::Cm;
+    VContainer data1(nullptr, &unit);
+    AddIncrement(&data1, QStringLiteral("#a"), 2);
+    AddIncrement(&data1, QStringLiteral("#b"), 3);
+
+    VContainer data2(nullptr, &unit);
+    AddIncrement(&data2, QStringLiteral("#a"), 2);
+
+    Calculator::ClearCache();
+
+    const QString formula = QStringLiteral("#a+#b");
+    Calculator cal;
+    QCOMPARE(cal.EvalFormula(data1.DataVariables(), formula), 5.0);
+    QVERIFY_EXCEPTION_THROWN(cal.EvalFormula(data2.DataVariables(), formula), qmu::QmuParserError);
+    QCOMPARE(Calculator::CacheHits(), 1);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_Calculator::BenchmarkReparse_data() const
+{
+    QTest::addColumn<bool>("cached");
+
+    QTest::newRow("Parse") << false;
+    QTest::newRow("Cached") << true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief BenchmarkReparse evaluate all formulas of a large pattern the way a full reparse does.
+ */
+void TST_Calculator::BenchmarkReparse() const
+{
+    QFETCH(bool, cached);
+
+    Unit unit = Unit::Cm;
+    VContainer data(nullptr, &unit);
+    const QStringList formulas = LargePattern(&data);
+
+    Calculator::ClearCache();
+
+    Calculator cal;
+    if (cached)
+    {
+        for (int i = 0; i < formulas.size(); ++i)
+        {
+            cal.EvalFormula(data.DataVariables(), formulas.at(i));
+        }
+    }
+
+    QBENCHMARK
+    {
+        if (not cached)
+        {
+            Calculator::ClearCache();
+        }
+
+        for (int i = 0; i < formulas.size(); ++i)
+        {
+            cal.EvalFormula(data.DataVariables(), formulas.at(i));
+        }
+    }
+
+    if (cached)
+    {
+        QCOMPARE(Calculator::CacheMisses(), formulas.size());
+        QVERIFY(Calculator::CacheHits() >= formulas.size());
+    }
+}
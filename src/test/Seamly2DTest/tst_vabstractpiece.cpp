@@ -54,6 +54,7 @@
 
 #include <QPointF>
 #include <QVector>
+#include <QtMath>
 
 #include <QtTest>
 
@@ -2973,6 +2974,76 @@ void TST_VAbstractPiece::TestCorrectEquidistantPoints() const
     Comparison(after, expect);
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VAbstractPiece::LargePathRemoveLoop_data() const
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<bool>("loop");
+
+    QTest::newRow("1000 points, no loop") << 1000 << false;
+    QTest::newRow("1000 points, loop") << 1000 << true;
+    QTest::newRow("5000 points, no loop") << 5000 << false;
+    QTest::newRow("5000 points, loop") << 5000 << true;
+    QTest::newRow("10000 points, no loop") << 10000 << false;
+    QTest::newRow("10000 points, loop") << 10000 << true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// cppcheck-suppress unusedFunction
+void TST_VAbstractPiece::LargePathRemoveLoop() const
+{
+    QFETCH(int, count);
+    QFETCH(bool, loop);
+
+    QVector<QPointF> path;
+    QVector<QPointF> expect;
+    LargePath(count, loop, path, expect);
+
+    QVector<QPointF> res;
+    QBENCHMARK
+    {
+        res = VAbstractPiece::CheckLoops(path);
+    }
+    Comparison(res, expect);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief LargePath closed polygon close to a circle, like a flattened curve. With loop a small loop is added after
+ * the middle point: the path goes forward, turns back and crosses itself.
+ */
+void TST_VAbstractPiece::LargePath(int count, bool loop, QVector<QPointF> &path, QVector<QPointF> &expect)
+{
+    path.clear();
+    expect.clear();
+
+    const qreal radius = count; // Keep segments several pixels long
+    const int middle = count/2;
+
+    for (int k = 0; k <= count; ++k)
+    {
+        const qreal angle = 2*M_PI*(k % count)/count;
+        const QPointF point(radius*qCos(angle), radius*qSin(angle));
+        path.append(point);
+        expect.append(point);
+
+        if (loop && k == middle)
+        {
+            const qreal nextAngle = 2*M_PI*(k+1)/count;
+            const QPointF next(radius*qCos(nextAngle), radius*qSin(nextAngle));
+            const QPointF t = next - point;              // Along the path
+            const QPointF n(-t.y(), t.x());              // Across the path
+
+            const QPointF a = point + 0.8*t;
+            const QPointF b = point + 0.6*t + 0.3*n;
+            const QPointF c = point + 0.6*t - 0.3*n;
+
+            path << a << b << c;
+            expect << point + 0.6*t << c; // Segment b-c crosses segment point-a
+        }
+    }
+}
+
 #ifndef Q_OS_WIN
 //---------------------------------------------------------------------------------------------------------------------
 void TST_VAbstractPiece::PossibleInfiniteClearLoops_data() const
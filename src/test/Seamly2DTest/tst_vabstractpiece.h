@@ -76,12 +76,16 @@ private slots:
     void CorrectEquidistantPoints() const;
     void TestCorrectEquidistantPoints_data();
     void TestCorrectEquidistantPoints() const;
+    void LargePathRemoveLoop_data() const;
+    void LargePathRemoveLoop() const;
 #ifndef Q_OS_WIN // Disabled due to "undefined behavior" problem
     void PossibleInfiniteClearLoops_data() const;
     void PossibleInfiniteClearLoops() const;
 #endif
 
 private:
+    static void LargePath(int count, bool loop, QVector<QPointF> &path, QVector<QPointF> &expect);
+
     QVector<VSAPoint> InputPointsCase1() const;
     QVector<QPointF>  OutputPointsCase1() const;
 
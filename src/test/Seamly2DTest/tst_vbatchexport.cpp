@@ -0,0 +1,268 @@
+/***************************************************************************
+ *                                                                         *
+ *   Copyright (C) 2017  Seamly, LLC                                       *
+ *                                                                         *
+ *   https://github.com/fashionfreedom/seamly2d                             *
+ *                                                                         *
+ ***************************************************************************
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **************************************************************************
+
+ ************************************************************************
+ **
+ **  @file
+ **  @author Seamly2D project
+ **  @date   16 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Seamly2D project
+ **  <https://github.com/fashionfreedom/seamly2d> All Rights Reserved.
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#include "tst_vbatchexport.h"
+#include "../../app/seamly2d/core/vbatchexport.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtTest>
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+bool WriteFile(const QString &fileName, const QByteArray &data)
+{
+    QFile file(fileName);
+    if (not file.open(QIODevice::WriteOnly | QIODevice::Text))
+    {
+        return false;
+    }
+    return file.write(data) == data.size();
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+TST_VBatchExport::TST_VBatchExport(QObject *parent)
+    : AbstractTest(parent)
+{
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// cppcheck-suppress unusedFunction
+void TST_VBatchExport::TestReadManifest() const
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QDir base(dir.path());
+
+    const QString manifest = base.absoluteFilePath(QStringLiteral("jobs.txt"));
+    QVERIFY(WriteFile(manifest, "# Shirts\n"
+                                "\n"
+                                "shirt.val\n"
+                                "  dress.val ; /tmp/m.vit ; 34,36 ; 164 ; 2 ; out  \n"
+                                "skirt.val;;;;;/tmp/export\n"));
+
+    QString error;
+    const QVector<VBatchJob> jobs = VBatchExport::ReadManifest(manifest, error);
+    QVERIFY2(error.isEmpty(), qUtf8Printable(error));
+    QCOMPARE(jobs.size(), 4);
+
+    QCOMPARE(jobs.at(0).line, 3);
+    QCOMPARE(jobs.at(0).pattern, base.absoluteFilePath(QStringLiteral("shirt.val")));
+    QVERIFY(jobs.at(0).measurements.isEmpty());
+    QVERIFY(jobs.at(0).gradationSize.isEmpty());
+    QVERIFY(jobs.at(0).gradationHeight.isEmpty());
+    QCOMPARE(jobs.at(0).format, 0);
+    QCOMPARE(jobs.at(0).destination, base.absolutePath());
+
+    // Sweep of one line keeps its line number and order of sizes
+    for (int i = 1; i <= 2; ++i)
+    {
+        QCOMPARE(jobs.at(i).line, 4);
+        QCOMPARE(jobs.at(i).pattern, base.absoluteFilePath(QStringLiteral("dress.val")));
+        QCOMPARE(jobs.at(i).measurements, QStringLiteral("/tmp/m.vit"));
+        QCOMPARE(jobs.at(i).gradationHeight, QStringLiteral("164"));
+        QCOMPARE(jobs.at(i).format, 2);
+        QCOMPARE(jobs.at(i).destination, base.absoluteFilePath(QStringLiteral("out")));
+    }
+    QCOMPARE(jobs.at(1).gradationSize, QStringLiteral("34"));
+    QCOMPARE(jobs.at(2).gradationSize, QStringLiteral("36"));
+    QCOMPARE(jobs.at(1).BaseName(), QStringLiteral("dress_34_164"));
+    QVERIFY(jobs.at(1).SamePattern(jobs.at(2)));
+    QVERIFY(not jobs.at(0).SamePattern(jobs.at(1)));
+
+    QCOMPARE(jobs.at(3).line, 5);
+    QCOMPARE(jobs.at(3).destination, QStringLiteral("/tmp/export"));
+
+    // Written manifest is read back with the same jobs
+    const QString copy = base.absoluteFilePath(QStringLiteral("copy.txt"));
+    QVERIFY(VBatchExport::WriteManifest(copy, jobs));
+    const QVector<VBatchJob> copied = VBatchExport::ReadManifest(copy, error);
+    QVERIFY2(error.isEmpty(), qUtf8Printable(error));
+    QCOMPARE(copied.size(), jobs.size());
+    for (int i = 0; i < jobs.size(); ++i)
+    {
+        QCOMPARE(copied.at(i).line, i + 1);
+        QCOMPARE(copied.at(i).pattern, jobs.at(i).pattern);
+        QCOMPARE(copied.at(i).measurements, jobs.at(i).measurements);
+        QCOMPARE(copied.at(i).gradationSize, jobs.at(i).gradationSize);
+        QCOMPARE(copied.at(i).gradationHeight, jobs.at(i).gradationHeight);
+        QCOMPARE(copied.at(i).format, jobs.at(i).format);
+        QCOMPARE(copied.at(i).destination, jobs.at(i).destination);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VBatchExport::TestReadInvalidManifest_data() const
+{
+    QTest::addColumn<QByteArray>("data");
+
+    QTest::newRow("Too many fields") << QByteArray("a.val;;;;;;extra\n");
+    QTest::newRow("Empty pattern") << QByteArray("shirt.val\n ;m.vit\n");
+    QTest::newRow("Wrong format") << QByteArray("a.val;;;;pdf\n");
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// cppcheck-suppress unusedFunction
+void TST_VBatchExport::TestReadInvalidManifest() const
+{
+    QFETCH(QByteArray, data);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString manifest = QDir(dir.path()).absoluteFilePath(QStringLiteral("jobs.txt"));
+    QVERIFY(WriteFile(manifest, data));
+
+    QString error;
+    const QVector<VBatchJob> jobs = VBatchExport::ReadManifest(manifest, error);
+    QVERIFY(not error.isEmpty());
+    QVERIFY(jobs.isEmpty());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// cppcheck-suppress unusedFunction
+void TST_VBatchExport::TestReadEmptyManifest() const
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString manifest = QDir(dir.path()).absoluteFilePath(QStringLiteral("jobs.txt"));
+    QVERIFY(WriteFile(manifest, "# Nothing to do\n\n"));
+
+    QString error;
+    QVERIFY(VBatchExport::ReadManifest(manifest, error).isEmpty());
+    QVERIFY(error.isEmpty());
+
+    VBatchExport::ReadManifest(QDir(dir.path()).absoluteFilePath(QStringLiteral("missing.txt")), error);
+    QVERIFY(not error.isEmpty());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// cppcheck-suppress unusedFunction
+void TST_VBatchExport::TestReportRoundTrip() const
+{
+    QVector<VBatchResult> results;
+
+    VBatchResult ok;
+    ok.line = 3;
+    ok.ok = true;
+    ok.elapsed = 1250;
+    ok.name = QStringLiteral("shirt");
+    results.append(ok);
+
+    VBatchResult failed;
+    failed.line = 4;
+    failed.elapsed = 17;
+    failed.name = QStringLiteral("dress_34_164");
+    failed.error = QStringLiteral("Can't open\tfile\nmissing.vit");
+    results.append(failed);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    const QString report = QDir(dir.path()).absoluteFilePath(QStringLiteral("report.txt"));
+    QVERIFY(VBatchExport::WriteReport(report, results));
+
+    const QVector<VBatchResult> read = VBatchExport::ReadReport(report);
+    QCOMPARE(read.size(), results.size());
+    for (int i = 0; i < results.size(); ++i)
+    {
+        QCOMPARE(read.at(i).line, results.at(i).line);
+        QCOMPARE(read.at(i).ok, results.at(i).ok);
+        QCOMPARE(read.at(i).elapsed, results.at(i).elapsed);
+        QCOMPARE(read.at(i).name, results.at(i).name);
+    }
+
+    // Separators inside an error must not break the report
+    QVERIFY(read.at(0).error.isEmpty());
+    QCOMPARE(read.at(1).error, QStringLiteral("Can't open file missing.vit"));
+
+    QVERIFY(VBatchExport::ReadReport(QDir(dir.path()).absoluteFilePath(QStringLiteral("missing.txt"))).isEmpty());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// cppcheck-suppress unusedFunction
+void TST_VBatchExport::TestSplitByPattern() const
+{
+    auto Job = [](int line, const QString &pattern, const QString &size)
+    {
+        VBatchJob job;
+        job.line = line;
+        job.pattern = pattern;
+        job.measurements = QStringLiteral("m.vst");
+        job.gradationSize = size;
+        return job;
+    };
+
+    QVector<VBatchJob> jobs;
+    jobs << Job(1, QStringLiteral("shirt.sm2d"), QStringLiteral("46"))
+         << Job(1, QStringLiteral("shirt.sm2d"), QStringLiteral("48"))
+         << Job(2, QStringLiteral("dress.sm2d"), QStringLiteral("46"))
+         << Job(3, QStringLiteral("dress.sm2d"), QString())
+         << Job(4, QStringLiteral("shirt.sm2d"), QStringLiteral("50"));
+
+    const QVector<QVector<VBatchJob>> runs = VBatchExport::SplitByPattern(jobs);
+    QCOMPARE(runs.size(), 4);
+    QCOMPARE(runs.at(0).size(), 2);
+    QCOMPARE(runs.at(1).size(), 1);
+    QCOMPARE(runs.at(2).first().line, 3);
+    QCOMPARE(runs.at(3).first().line, 4);
+
+    QVERIFY(VBatchExport::SplitByPattern(QVector<VBatchJob>()).isEmpty());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// cppcheck-suppress unusedFunction
+void TST_VBatchExport::TestRunWorkersWithoutJobs() const
+{
+    // Must return at once without starting a worker process
+    QVERIFY(VBatchExport::RunWorkers(QVector<VBatchJob>(), 4, QStringList()).isEmpty());
+}
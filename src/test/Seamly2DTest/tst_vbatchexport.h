@@ -0,0 +1,76 @@
+/***************************************************************************
+ *                                                                         *
+ *   Copyright (C) 2017  Seamly, LLC                                       *
+ *                                                                         *
+ *   https://github.com/fashionfreedom/seamly2d                             *
+ *                                                                         *
+ ***************************************************************************
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **************************************************************************
+
+ ************************************************************************
+ **
+ **  @file
+ **  @author Seamly2D project
+ **  @date   16 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Seamly2D project
+ **  <https://github.com/fashionfreedom/seamly2d> All Rights Reserved.
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#ifndef TST_VBATCHEXPORT_H
+#define TST_VBATCHEXPORT_H
+
+#include "../vtest/abstracttest.h"
+
+class TST_VBatchExport : public AbstractTest
+{
+    Q_OBJECT
+public:
+    explicit TST_VBatchExport(QObject *parent = nullptr);
+
+private slots:
+    void TestReadManifest() const;
+    void TestReadInvalidManifest_data() const;
+    void TestReadInvalidManifest() const;
+    void TestReadEmptyManifest() const;
+    void TestReportRoundTrip() const;
+    void TestSplitByPattern() const;
+    void TestRunWorkersWithoutJobs() const;
+
+private:
+    Q_DISABLE_COPY(TST_VBatchExport)
+};
+
+#endif // TST_VBATCHEXPORT_H
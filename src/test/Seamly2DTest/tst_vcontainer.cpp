@@ -0,0 +1,599 @@
+/***************************************************************************
+ *                                                                         *
+ *   Copyright (C) 2017  Seamly, LLC                                       *
+ *                                                                         *
+ *   https://github.com/fashionfreedom/seamly2d                             *
+ *                                                                         *
+ ***************************************************************************
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **************************************************************************
+
+ ************************************************************************
+ **
+ **  @file
+ **  @author Seamly2D project
+ **  @date   16 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Seamly2D project
+ **  <https://github.com/fashionfreedom/seamly2d> All Rights Reserved.
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#include "tst_vcontainer.h"
+#include "../vpatterndb/vcontainer.h"
+#include "../vpatterndb/vpiecenode.h"
+#include "../vpatterndb/vpiecepath.h"
+#include "../vpatterndb/vtranslatevars.h"
+#include "../vpatterndb/variables/varcradius.h"
+#include "../vpatterndb/variables/vcurveangle.h"
+#include "../vpatterndb/variables/vcurveclength.h"
+#include "../vpatterndb/variables/vcurvelength.h"
+#include "../vpatterndb/variables/vincrement.h"
+#include "../vpatterndb/variables/vlineangle.h"
+#include "../vpatterndb/variables/vlinelength.h"
+#include "../vpatterndb/variables/vmeasurement.h"
+#include "../vgeometry/vpointf.h"
+#include "../vgeometry/vspline.h"
+#include "../vgeometry/vsplinepath.h"
+#include "../vmisc/def.h"
+#include "../ifc/ifcdef.h"
+
+#include <QtMath>
+#include <QtTest>
+
+namespace
+{
+const int patternSize = 1000;
+const int curvesCount = 200;
+const int curveSegments = 20;
+
+//---------------------------------------------------------------------------------------------------------------------
+quint32 AddPoint(VContainer *data, int i)
+{
+    return data->AddGObject(new VPointF(i, i, QStringLiteral("A%1").arg(i), 0, 0));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SnapshotPattern add points one by one and keep a copy of container after each of them, the way each tool
+ * keeps own copy during parsing.
+ */
+QVector<VContainer> SnapshotPattern(VContainer *data)
+{
+    QVector<VContainer> snapshots;
+    snapshots.reserve(patternSize);
+    for (int i = 0; i < patternSize; ++i)
+    {
+        AddPoint(data, i);
+        snapshots.append(*data);
+    }
+    return snapshots;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief SnapshotHash the same as SnapshotPattern for a plain hash. Shows cost of the old snapshot model.
+ */
+QVector<QHash<quint32, QSharedPointer<VGObject>>> SnapshotHash()
+{
+    QHash<quint32, QSharedPointer<VGObject>> hash;
+    QVector<QHash<quint32, QSharedPointer<VGObject>>> snapshots;
+    snapshots.reserve(patternSize);
+    for (int i = 0; i < patternSize; ++i)
+    {
+        hash.insert(static_cast<quint32>(i), QSharedPointer<VGObject>(new VPointF(i, i, QString(), 0, 0)));
+        snapshots.append(hash);
+    }
+    return snapshots;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<VFSplinePoint> CurvePoints(int curve)
+{
+    QVector<VFSplinePoint> points;
+    points.reserve(curveSegments + 1);
+    for (int i = 0; i <= curveSegments; ++i)
+    {
+        const VPointF point(i * 50, (i % 2) * 30 + curve, QStringLiteral("C%1_%2").arg(curve).arg(i), 0, 0);
+        points.append(VFSplinePoint(point, 1, 45, 1, 225));
+    }
+    return points;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+quint32 AddCurve(VContainer *data, int curve)
+{
+    const quint32 id = data->AddGObject(new VSplinePath(CurvePoints(curve)));
+    data->AddCurveWithSegments(data->GeometricObject<VSplinePath>(id), id);
+    return id;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief The EagerCurveVariable class curve variable with the value calculated at creation, the way all curve
+ * variables were made before they became lazy.
+ */
+class EagerCurveVariable : public VCurveVariable
+{
+public:
+    EagerCurveVariable(quint32 id, VarType type, const QString &name, qreal value)
+        : VCurveVariable(id, NULL_ID)
+    {
+        SetType(type);
+        SetName(name);
+        SetValue(value);
+    }
+};
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief AddCurveEagerly the same as AddCurve() with the old eager variables: the path is flattened and each segment
+ * is built and measured right away. Baseline for lazy curve variables.
+ */
+quint32 AddCurveEagerly(VContainer *data, int curve)
+{
+    const quint32 id = data->AddGObject(new VSplinePath(CurvePoints(curve)));
+    const QSharedPointer<VSplinePath> path = data->GeometricObject<VSplinePath>(id);
+    const Unit unit = *data->GetPatternUnit();
+
+    auto Add = [data, id](VarType type, const QString &name, qreal value)
+    {
+        data->AddVariable(name, new EagerCurveVariable(id, type, name, value));
+    };
+
+    Add(VarType::CurveLength, path->name(), FromPixel(path->GetLength(), unit));
+    Add(VarType::CurveAngle, angle1_V + path->name(), path->GetStartAngle());
+    Add(VarType::CurveAngle, angle2_V + path->name(), path->GetEndAngle());
+    Add(VarType::CurveCLength, c1Length_V + path->name(), FromPixel(path->GetC1Length(), unit));
+    Add(VarType::CurveCLength, c2Length_V + path->name(), FromPixel(path->GetC2Length(), unit));
+
+    for (qint32 i = 1; i <= path->CountSubSpl(); ++i)
+    {
+        const VSpline spl = path->GetSpline(i);
+        const QString name = path->name() + QLatin1String("_") + seg_ + QString().setNum(i);
+
+        Add(VarType::CurveLength, name, FromPixel(spl.GetLength(), unit));
+        Add(VarType::CurveAngle, angle1_V + name, spl.GetStartAngle());
+        Add(VarType::CurveAngle, angle2_V + name, spl.GetEndAngle());
+        Add(VarType::CurveCLength, c1Length_V + name, FromPixel(spl.GetC1Length(), unit));
+        Add(VarType::CurveCLength, c2Length_V + name, FromPixel(spl.GetC2Length(), unit));
+    }
+    return id;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief CurvePattern add spline paths the way tools do while parsing. If eager is true, variables are made the old
+ * way, with values calculated at once. Otherwise if evaluate is true, value of each lazy variable is requested.
+ */
+void CurvePattern(VContainer *data, bool eager, bool evaluate)
+{
+    for (int i = 0; i < curvesCount; ++i)
+    {
+        if (eager)
+        {
+            AddCurveEagerly(data, i);
+        }
+        else
+        {
+            AddCurve(data, i);
+        }
+    }
+
+    if (evaluate)
+    {
+        const QHash<QString, QSharedPointer<VInternalVariable>> variables = data->DataVariables()->toHash();
+        auto i = variables.constBegin();
+        while (i != variables.constEnd())
+        {
+            i.value()->GetValue();
+            ++i;
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief ScanVariables typed listing made the old way, by looking through all variables.
+ */
+template <typename T>
+QMap<QString, QSharedPointer<T>> ScanVariables(const VContainer &data, const VarType &type)
+{
+    QMap<QString, QSharedPointer<T>> map;
+    const QHash<QString, QSharedPointer<VInternalVariable>> variables = data.DataVariables()->toHash();
+    for (auto i = variables.constBegin(); i != variables.constEnd(); ++i)
+    {
+        if (i.value()->GetType() == type)
+        {
+            map.insert(data.GetTrVars()->VarToUser(i.key()), qSharedPointerDynamicCast<T>(i.value()));
+        }
+    }
+    return map;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+template <typename T>
+bool SameListing(const QMap<QString, QSharedPointer<T>> &listing, const QMap<QString, QSharedPointer<T>> &expected)
+{
+    return listing.keys() == expected.keys() && listing.values() == expected.values();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void CheckListings(const VContainer &data)
+{
+    QVERIFY(SameListing(data.DataMeasurements(), ScanVariables<VMeasurement>(data, VarType::Measurement)));
+    QVERIFY(SameListing(data.variablesData(), ScanVariables<VIncrement>(data, VarType::Increment)));
+    QVERIFY(SameListing(data.lineLengthsData(), ScanVariables<VLengthLine>(data, VarType::LineLength)));
+    QVERIFY(SameListing(data.lineAnglesData(), ScanVariables<VLineAngle>(data, VarType::LineAngle)));
+    QVERIFY(SameListing(data.curveLengthsData(), ScanVariables<VCurveLength>(data, VarType::CurveLength)));
+    QVERIFY(SameListing(data.controlPointLengthsData(), ScanVariables<VCurveCLength>(data, VarType::CurveCLength)));
+    QVERIFY(SameListing(data.curveAnglesData(), ScanVariables<VCurveAngle>(data, VarType::CurveAngle)));
+    QVERIFY(SameListing(data.arcRadiusesData(), ScanVariables<VArcRadius>(data, VarType::ArcRadius)));
+
+    int typed = 0;
+    for (int i = 0; i <= static_cast<int>(VarType::Unknown); ++i)
+    {
+        typed += data.DataVariables(static_cast<VarType>(i))->size();
+    }
+    QCOMPARE(typed, data.DataVariables()->size());
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+TST_VContainer::TST_VContainer(QObject *parent)
+    : AbstractTest(parent)
+{
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VContainer::TestSnapshot() const
+{
+    Unit unit = Unit::Cm;
+    VContainer data(nullptr, &unit);
+    const quint32 id1 = AddPoint(&data, 1);
+    data.AddVariable(QStringLiteral("#a"), new VIncrement(&data, QStringLiteral("#a"), 0, 1, QString(), true));
+
+    const VContainer snapshot(data);
+
+    const quint32 id2 = AddPoint(&data, 2);
+    data.AddVariable(QStringLiteral("#b"), new VIncrement(&data, QStringLiteral("#b"), 0, 2, QString(), true));
+
+    QCOMPARE(snapshot.DataGObjects().size(), 1);
+    QVERIFY(snapshot.DataGObjects().contains(id1));
+    QVERIFY(not snapshot.DataGObjects().contains(id2));
+    QCOMPARE(snapshot.DataVariables()->size(), 1);
+    QVERIFY(not snapshot.DataVariables()->contains(QStringLiteral("#b")));
+
+    QCOMPARE(data.DataGObjects().size(), 2);
+    QCOMPARE(data.DataVariables()->size(), 2);
+    QCOMPARE(data.GeometricObject<VPointF>(id1)->name(), snapshot.GeometricObject<VPointF>(id1)->name());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VContainer::TestRemoveFromSnapshot() const
+{
+    Unit unit = Unit::Cm;
+    VContainer data(nullptr, &unit);
+    data.AddVariable(QStringLiteral("#a"), new VIncrement(&data, QStringLiteral("#a"), 0, 1, QString(), true));
+    data.AddVariable(QStringLiteral("#b"), new VIncrement(&data, QStringLiteral("#b"), 1, 2, QString(), true));
+
+    const VContainer snapshot(data);
+
+    data.RemoveVariable(QStringLiteral("#a"));
+    QVERIFY(not data.DataVariables()->contains(QStringLiteral("#a")));
+    QCOMPARE(data.DataVariables()->size(), 1);
+    QCOMPARE(data.DataVariables()->keys(), QList<QString>() << QStringLiteral("#b"));
+    QVERIFY(snapshot.DataVariables()->contains(QStringLiteral("#a")));
+
+    data.ClearVariables(VarType::Increment);
+    QVERIFY(data.DataVariables()->isEmpty());
+    QCOMPARE(snapshot.DataVariables()->size(), 2);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief TestLevelCount a snapshot after each write must not make lookups linear.
+ */
+void TST_VContainer::TestLevelCount() const
+{
+    VVersionedHash<quint32, QSharedPointer<VGObject>> hash;
+    QVector<VVersionedHash<quint32, QSharedPointer<VGObject>>> snapshots;
+    for (int i = 1; i <= patternSize; ++i)
+    {
+        hash.insert(static_cast<quint32>(i), QSharedPointer<VGObject>(new VGObject()));
+        snapshots.append(hash);
+
+        QVERIFY2(hash.levelCount() <= qCeil(qLn(i)/qLn(2)) + 1, qUtf8Printable(QString::number(hash.levelCount())));
+    }
+
+    for (int i = 0; i < snapshots.size(); ++i)
+    {
+        QCOMPARE(snapshots.at(i).size(), i+1);
+        QVERIFY(snapshots.at(i).contains(static_cast<quint32>(i+1)));
+        QVERIFY(not snapshots.at(i).contains(static_cast<quint32>(i+2)));
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VContainer::BenchmarkSnapshots_data() const
+{
+    QTest::addColumn<bool>("versioned");
+
+    QTest::newRow("Hash copies") << false;
+    QTest::newRow("Container snapshots") << true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief BenchmarkSnapshots time of parsing a pattern where each tool keeps a copy of data.
+ */
+void TST_VContainer::BenchmarkSnapshots() const
+{
+    QFETCH(bool, versioned);
+
+    Unit unit = Unit::Cm;
+    QBENCHMARK
+    {
+        if (versioned)
+        {
+            VContainer data(nullptr, &unit);
+            SnapshotPattern(&data);
+        }
+        else
+        {
+            SnapshotHash();
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VContainer::BenchmarkSnapshotsMemory_data() const
+{
+    BenchmarkSnapshots_data();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief BenchmarkSnapshotsMemory peak memory of making all copies: growth of peak resident size over the resident size
+ * before. Heap the copies keep alive is printed next to it.
+ */
+void TST_VContainer::BenchmarkSnapshotsMemory() const
+{
+    QFETCH(bool, versioned);
+
+    if (not ResetPeakMemory())
+    {
+        QSKIP("Peak resident size is not available on this platform.");
+    }
+    const qint64 resident = ResidentMemory();
+    const qint64 heap = AllocatedMemory();
+
+    Unit unit = Unit::Cm;
+    VContainer data(nullptr, &unit);
+    qint64 kept = 0;
+    if (versioned)
+    {
+        const QVector<VContainer> snapshots = SnapshotPattern(&data);
+        kept = AllocatedMemory() - heap;
+    }
+    else
+    {
+        const QVector<QHash<quint32, QSharedPointer<VGObject>>> snapshots = SnapshotHash();
+        kept = AllocatedMemory() - heap;
+    }
+
+    if (heap >= 0)
+    {
+        qInfo("Live heap of the copies: %lld bytes.", kept);
+    }
+    QTest::setBenchmarkResult(PeakMemory() - resident, QTest::BytesAllocated);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief TestLazyCurveVariables variables of a curve are listed right away and get the same values as if they were
+ * calculated eagerly.
+ */
+void TST_VContainer::TestLazyCurveVariables() const
+{
+    Unit unit = Unit::Cm;
+    VContainer data(nullptr, &unit);
+    const quint32 id = AddCurve(&data, 0);
+    const QSharedPointer<VSplinePath> path = data.GeometricObject<VSplinePath>(id);
+
+    // Length, two angles, two control lengths for the path and for each segment
+    QCOMPARE(data.DataVariables()->size(), 5 * (curveSegments + 1));
+
+    const QSharedPointer<VInternalVariable> length = data.DataVariables()->value(path->name());
+    QVERIFY(not length.isNull());
+    QCOMPARE(*length->GetValue(), FromPixel(path->GetLength(), unit));
+
+    const QString segmentName = path->name() + QLatin1String("_") + seg_ + QString().setNum(curveSegments);
+    const QSharedPointer<VInternalVariable> segment = data.DataVariables()->value(segmentName);
+    QVERIFY(not segment.isNull());
+    QCOMPARE(*segment->GetValue(), FromPixel(path->GetSpline(curveSegments).GetLength(), unit));
+
+    const QSharedPointer<VInternalVariable> angle = data.DataVariables()->value(angle2_V + segmentName);
+    QVERIFY(not angle.isNull());
+    QCOMPARE(*angle->GetValue(), path->GetSpline(curveSegments).GetEndAngle());
+
+    // The eager baseline of benchmarks must make the same variables
+    VContainer eager(nullptr, &unit);
+    AddCurveEagerly(&eager, 0);
+    QCOMPARE(eager.DataVariables()->size(), data.DataVariables()->size());
+    const QHash<QString, QSharedPointer<VInternalVariable>> variables = data.DataVariables()->toHash();
+    for (auto i = variables.constBegin(); i != variables.constEnd(); ++i)
+    {
+        const QSharedPointer<VInternalVariable> variable = eager.DataVariables()->value(i.key());
+        QVERIFY2(not variable.isNull(), qUtf8Printable(i.key()));
+        QCOMPARE(variable->GetType(), i.value()->GetType());
+        QCOMPARE(*variable->GetValue(), *i.value()->GetValue());
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief TestTypedVariables typed listings come from indexes now, they must give the same names in the same order as
+ * a scan of all variables. Also after removing variables and in a snapshot.
+ */
+void TST_VContainer::TestTypedVariables() const
+{
+    const VTranslateVars trVars;
+    Unit unit = Unit::Cm;
+    VContainer data(&trVars, &unit);
+
+    data.AddVariable(QStringLiteral("#c"), new VIncrement(&data, QStringLiteral("#c"), 0, 1, QString(), true));
+    data.AddVariable(QStringLiteral("#a"), new VIncrement(&data, QStringLiteral("#a"), 1, 2, QString(), true));
+    data.AddVariable(QStringLiteral("#b"), new VIncrement(&data, QStringLiteral("#b"), 2, 3, QString(), true));
+    for (int i = 0; i < 10; ++i)
+    {
+        data.AddLine(AddPoint(&data, i), AddPoint(&data, i + 100));
+    }
+    AddCurve(&data, 0);
+    AddCurve(&data, 1);
+    CheckListings(data);
+    QCOMPARE(data.variablesData().keys(), QList<QString>() << QStringLiteral("#a") << QStringLiteral("#b")
+             << QStringLiteral("#c"));
+    QCOMPARE(data.lineAnglesData().size(), 10);
+
+    const VContainer snapshot(data);
+
+    data.RemoveVariable(QStringLiteral("#b"));
+    data.removeCustomVariable(QStringLiteral("#c"));
+    data.ClearVariables(VarType::LineAngle);
+    data.ClearVariables(VarType::CurveLength);
+    CheckListings(data);
+    CheckListings(snapshot);
+    QCOMPARE(data.variablesData().keys(), QList<QString>() << QStringLiteral("#a"));
+    QVERIFY(data.lineAnglesData().isEmpty());
+    QVERIFY(data.curveLengthsData().isEmpty());
+    QCOMPARE(snapshot.variablesData().size(), 3);
+    QCOMPARE(snapshot.lineAnglesData().size(), 10);
+
+    data.ClearVariables();
+    CheckListings(data);
+    QVERIFY(data.DataVariables(VarType::CurveAngle)->isEmpty());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief TestThreadSnapshot a plain copy shares pieces and piece paths with the original, a snapshot for another
+ * thread must not see their later changes.
+ */
+void TST_VContainer::TestThreadSnapshot() const
+{
+    Unit unit = Unit::Cm;
+    VContainer data(nullptr, &unit);
+
+    VPiecePath path(PiecePathType::InternalPath);
+    path.Append(VPieceNode(AddPoint(&data, 1), Tool::NodePoint));
+    const quint32 pathId = data.AddPiecePath(path);
+
+    VPiece piece;
+    piece.GetPath().Append(VPieceNode(AddPoint(&data, 2), Tool::NodePoint));
+    const quint32 pieceId = data.AddPiece(piece);
+
+    const VContainer copy(data);
+    const VContainer snapshot = data.Snapshot();
+
+    path.Append(VPieceNode(AddPoint(&data, 3), Tool::NodePoint));
+    data.UpdatePiecePath(pathId, path);
+    piece.GetPath().Append(VPieceNode(AddPoint(&data, 4), Tool::NodePoint));
+    data.UpdatePiece(pieceId, piece);
+    AddPoint(&data, 5);
+
+    QCOMPARE(copy.GetPiecePath(pathId).CountNodes(), 2);
+    QCOMPARE(copy.GetPiece(pieceId).GetPath().CountNodes(), 2);
+
+    QCOMPARE(snapshot.GetPiecePath(pathId).CountNodes(), 1);
+    QCOMPARE(snapshot.GetPiece(pieceId).GetPath().CountNodes(), 1);
+    QCOMPARE(snapshot.DataGObjects().size(), 2);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VContainer::BenchmarkCurveVariables_data() const
+{
+    QTest::addColumn<bool>("eager");
+    QTest::addColumn<bool>("evaluate");
+
+    QTest::newRow("Eager values (old)") << true << false;
+    QTest::newRow("Lazy, all values requested") << false << true;
+    QTest::newRow("Lazy, values on request") << false << false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief BenchmarkCurveVariables time of adding curve paths to a pattern: with the old eager variables, and with lazy
+ * ones with and without requesting values of all of them.
+ */
+void TST_VContainer::BenchmarkCurveVariables() const
+{
+    QFETCH(bool, eager);
+    QFETCH(bool, evaluate);
+
+    Unit unit = Unit::Cm;
+    QBENCHMARK
+    {
+        VContainer data(nullptr, &unit);
+        CurvePattern(&data, eager, evaluate);
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VContainer::BenchmarkCurveVariablesMemory_data() const
+{
+    BenchmarkCurveVariables_data();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief BenchmarkCurveVariablesMemory heap kept by a pattern with curve paths. Eager variables keep only numbers,
+ * unevaluated lazy ones keep the curve instead, evaluation also flattens curves.
+ */
+void TST_VContainer::BenchmarkCurveVariablesMemory() const
+{
+    QFETCH(bool, eager);
+    QFETCH(bool, evaluate);
+
+    const qint64 before = AllocatedMemory();
+    if (before < 0)
+    {
+        QSKIP("Heap usage is not available on this platform.");
+    }
+
+    Unit unit = Unit::Cm;
+    VContainer data(nullptr, &unit);
+    CurvePattern(&data, eager, evaluate);
+
+    QTest::setBenchmarkResult(AllocatedMemory() - before, QTest::BytesAllocated);
+}
@@ -0,0 +1,80 @@
+/***************************************************************************
+ *                                                                         *
+ *   Copyright (C) 2017  Seamly, LLC                                       *
+ *                                                                         *
+ *   https://github.com/fashionfreedom/seamly2d                             *
+ *                                                                         *
+ ***************************************************************************
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **************************************************************************
+
+ ************************************************************************
+ **
+ **  @file
+ **  @author Seamly2D project
+ **  @date   16 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Seamly2D project
+ **  <https://github.com/fashionfreedom/seamly2d> All Rights Reserved.
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#ifndef TST_VCONTAINER_H
+#define TST_VCONTAINER_H
+
+#include "../vtest/abstracttest.h"
+
+class TST_VContainer : public AbstractTest
+{
+    Q_OBJECT
+public:
+    explicit TST_VContainer(QObject *parent = nullptr);
+
+private slots:
+    void TestSnapshot() const;
+    void TestRemoveFromSnapshot() const;
+    void TestLevelCount() const;
+    void BenchmarkSnapshots_data() const;
+    void BenchmarkSnapshots() const;
+    void BenchmarkSnapshotsMemory_data() const;
+    void BenchmarkSnapshotsMemory() const;
+    void TestLazyCurveVariables() const;
+    void TestTypedVariables() const;
+    void TestThreadSnapshot() const;
+    void BenchmarkCurveVariables_data() const;
+    void BenchmarkCurveVariables() const;
+    void BenchmarkCurveVariablesMemory_data() const;
+    void BenchmarkCurveVariablesMemory() const;
+};
+
+#endif // TST_VCONTAINER_H
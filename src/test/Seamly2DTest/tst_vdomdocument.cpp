@@ -0,0 +1,384 @@
+/***************************************************************************
+ *                                                                         *
+ *   Copyright (C) 2017  Seamly, LLC                                       *
+ *                                                                         *
+ *   https://github.com/fashionfreedom/seamly2d                             *
+ *                                                                         *
+ ***************************************************************************
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **************************************************************************
+
+ ************************************************************************
+ **
+ **  @file
+ **  @author Seamly2D project
+ **  @date   16 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Seamly2D project
+ **  <https://github.com/fashionfreedom/seamly2d> All Rights Reserved.
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#include "tst_vdomdocument.h"
+#include "../ifc/xml/vdomdocument.h"
+#include "../ifc/xml/vpatternconverter.h"
+#include "../ifc/exception/vexception.h"
+
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtTest>
+
+namespace
+{
+const QString schemaV0_2_0 = QStringLiteral("://schema/pattern/v0.2.0.xsd");
+
+//---------------------------------------------------------------------------------------------------------------------
+QByteArray PatternV0_2_0(const QString &calculation)
+{
+    return QStringLiteral("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                          "<pattern>\n"
+                          "    <version>0.2.0</version>\n"
+                          "    <unit>cm</unit>\n"
+                          "    <author/>\n"
+                          "    <description/>\n"
+                          "    <notes/>\n"
+                          "    <measurements/>\n"
+                          "    <increments/>\n"
+                          "    <draw name=\"Pattern piece 1\">\n"
+                          "        <calculation>\n"
+                          "            %1\n"
+                          "        </calculation>\n"
+                          "        <modeling/>\n"
+                          "        <details/>\n"
+                          "    </draw>\n"
+                          "</pattern>\n").arg(calculation).toUtf8();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QByteArray ValidPattern()
+{
+    return PatternV0_2_0(QStringLiteral("<point type=\"single\" x=\"0.926042\" y=\"1.05833\" id=\"1\" name=\"A\" "
+                                        "mx=\"0.132292\" my=\"0.264583\"/>"));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief WriteBigPattern write a pattern with a long chain of points, close to the size of real patterns from the
+ * collection multiplied several times.
+ */
+bool WriteBigPattern(const QString &fileName)
+{
+    const int size = 20000;
+    QString calculation = QStringLiteral("<!--Big pattern-->\n            "
+                                         "<point type=\"single\" x=\"0\" y=\"0\" id=\"1\" name=\"A1\" "
+                                         "mx=\"0.1\" my=\"0.2\"/>");
+    for (int i = 2; i <= size; ++i)
+    {
+        calculation += QStringLiteral("\n            <point type=\"endLine\" id=\"%1\" name=\"A%1\" basePoint=\"%2\" "
+                                      "typeLine=\"hair\" lineColor=\"black\" length=\"Line_A%2_A1 + %1*0.1\" "
+                                      "angle=\"%3\" mx=\"0.1\" my=\"0.2\"/>").arg(i).arg(i - 1).arg(i % 360);
+    }
+
+    QFile file(fileName);
+    if (not file.open(QIODevice::WriteOnly))
+    {
+        return false;
+    }
+    return file.write(PatternV0_2_0(calculation)) > 0;
+}
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+TST_VDomDocument::TST_VDomDocument(QObject *parent)
+    : AbstractTest(parent)
+{
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VDomDocument::TestValidateInMemory_data() const
+{
+    QTest::addColumn<QByteArray>("data");
+    QTest::addColumn<bool>("valid");
+
+    QTest::newRow("Valid") << ValidPattern() << true;
+    QTest::newRow("Unknown tag") << PatternV0_2_0(QStringLiteral("<unknown id=\"1\"/>")) << false;
+    QTest::newRow("Missing id") << PatternV0_2_0(QStringLiteral("<point type=\"single\" x=\"0\" y=\"0\" name=\"A\" "
+                                                                "mx=\"0\" my=\"0\"/>")) << false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief TestValidateInMemory validation must give the same result with compiled schema taken from cache.
+ */
+void TST_VDomDocument::TestValidateInMemory() const
+{
+    QFETCH(QByteArray, data);
+    QFETCH(bool, valid);
+
+    VDomDocument::ClearSchemaCache();
+    for (int i = 0; i < 2; ++i)
+    {
+        try
+        {
+            VDomDocument::ValidateXML(schemaV0_2_0, data, QStringLiteral("pattern.val"));
+            QVERIFY2(valid, "Invalid document passed validation.");
+        }
+        catch (VException &e)
+        {
+            QVERIFY2(not valid, qUtf8Printable(e.ErrorMessage()));
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VDomDocument::TestValidateDocument() const
+{
+    QDomDocument document;
+    QVERIFY(document.setContent(ValidPattern()));
+
+    try
+    {
+        VDomDocument::ValidateXML(schemaV0_2_0, document, QStringLiteral("pattern.val"));
+    }
+    catch (VException &e)
+    {
+        QFAIL(qUtf8Printable(e.ErrorMessage()));
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VDomDocument::TestElementById() const
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString fileName = dir.path() + QStringLiteral("/pattern.val");
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(ValidPattern());
+    file.close();
+
+    VDomDocument doc;
+    doc.setXMLContent(fileName);
+
+    QDomElement point = doc.elementById(1);
+    QVERIFY(point.isElement());
+    QCOMPARE(point.attribute(QStringLiteral("name")), QStringLiteral("A"));
+    QVERIFY(doc.elementById(2).isNull());
+
+    QDomNode calculation = point.parentNode();
+    calculation.removeChild(point);
+    QVERIFY2(doc.elementById(1).isNull(), "Removed element must not be found.");
+
+    calculation.appendChild(point);
+    doc.RegisterElementId(point);
+    QVERIFY(doc.elementById(1) == point);
+
+    QDomElement clone = point.cloneNode().toElement();
+    calculation.replaceChild(clone, point);
+    doc.UnregisterElementId(point);
+    doc.RegisterElementId(clone);
+    QVERIFY(doc.elementById(1) == clone);
+
+    calculation.removeChild(clone);
+    doc.UnregisterElementId(clone);
+    QVERIFY(doc.elementById(1).isNull());
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief TestStreamLoading both loaders must build the same tree.
+ */
+void TST_VDomDocument::TestStreamLoading() const
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString fileName = dir.path() + QStringLiteral("/pattern.val");
+    QVERIFY(WriteBigPattern(fileName));
+
+    VDomDocument domDoc;
+    VDomDocument::SetStreamLoading(false);
+    domDoc.setXMLContent(fileName);
+
+    VDomDocument streamDoc;
+    VDomDocument::SetStreamLoading(true);
+    streamDoc.setXMLContent(fileName);
+    VDomDocument::SetStreamLoading(false);
+
+    QCOMPARE(streamDoc.toString(), domDoc.toString());
+    QVERIFY(streamDoc.elementById(2).isElement());
+
+    // Namespace declarations must stay attributes of their elements
+    const QString nsFileName = dir.path() + QStringLiteral("/namespaces.vit");
+    QFile file(nsFileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("<?xml version='1.0' encoding='UTF-8'?>\n"
+               "<vit xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\" xsi:noNamespaceSchemaLocation=\"a.xsd\">\n"
+               "    <body xmlns=\"http://example.com/body\"><m name=\"a\"/></body>\n"
+               "</vit>\n");
+    file.close();
+
+    VDomDocument nsDomDoc;
+    nsDomDoc.setXMLContent(nsFileName);
+
+    VDomDocument nsStreamDoc;
+    VDomDocument::SetStreamLoading(true);
+    nsStreamDoc.setXMLContent(nsFileName);
+    VDomDocument::SetStreamLoading(false);
+
+    QCOMPARE(nsStreamDoc.toString(), nsDomDoc.toString());
+    QCOMPARE(nsStreamDoc.documentElement().attribute(QStringLiteral("xmlns:xsi")),
+             QStringLiteral("http://www.w3.org/2001/XMLSchema-instance"));
+    QCOMPARE(nsStreamDoc.documentElement().firstChildElement().attribute(QStringLiteral("xmlns")),
+             QStringLiteral("http://example.com/body"));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VDomDocument::BenchmarkConvert_data() const
+{
+    QTest::addColumn<bool>("cached");
+
+    QTest::newRow("Compile schemas") << false;
+    QTest::newRow("Cached schemas") << true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief BenchmarkConvert open an old pattern and convert it to the current version checking each step, the way test
+ * mode opens collection patterns.
+ */
+void TST_VDomDocument::BenchmarkConvert() const
+{
+    QFETCH(bool, cached);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString fileName = dir.path() + QStringLiteral("/pattern.val");
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(ValidPattern());
+    file.close();
+
+    try
+    {
+        QBENCHMARK
+        {
+            if (not cached)
+            {
+                VDomDocument::ClearSchemaCache();
+            }
+
+            VPatternConverter converter(fileName);
+            converter.Convert();
+        }
+    }
+    catch (VException &e)
+    {
+        QFAIL(qUtf8Printable(e.ErrorMessage()));
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VDomDocument::BenchmarkLoad_data() const
+{
+    QTest::addColumn<bool>("stream");
+
+    QTest::newRow("QDomDocument") << false;
+    QTest::newRow("QXmlStreamReader") << true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VDomDocument::BenchmarkLoad() const
+{
+    QFETCH(bool, stream);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString fileName = dir.path() + QStringLiteral("/pattern.val");
+    QVERIFY(WriteBigPattern(fileName));
+
+    VDomDocument::SetStreamLoading(stream);
+    QBENCHMARK
+    {
+        VDomDocument doc;
+        doc.setXMLContent(fileName);
+    }
+    VDomDocument::SetStreamLoading(false);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VDomDocument::BenchmarkLoadMemory_data() const
+{
+    BenchmarkLoad_data();
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief BenchmarkLoadMemory peak memory of loading a document: growth of peak resident size over the resident size
+ * before loading. Heap the loaded document keeps alive is printed next to it. The peak includes the whole file string
+ * setContent() reads and everything freed before loading has finished.
+ */
+void TST_VDomDocument::BenchmarkLoadMemory() const
+{
+    QFETCH(bool, stream);
+
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString fileName = dir.path() + QStringLiteral("/pattern.val");
+    QVERIFY(WriteBigPattern(fileName));
+
+    if (not ResetPeakMemory())
+    {
+        QSKIP("Peak resident size is not available on this platform.");
+    }
+    const qint64 resident = ResidentMemory();
+    const qint64 heap = AllocatedMemory();
+
+    VDomDocument::SetStreamLoading(stream);
+    {
+        VDomDocument doc;
+        doc.setXMLContent(fileName);
+
+        if (heap >= 0)
+        {
+            qInfo("Live heap of the document: %lld bytes.", AllocatedMemory() - heap);
+        }
+    }
+    VDomDocument::SetStreamLoading(false);
+
+    QTest::setBenchmarkResult(PeakMemory() - resident, QTest::BytesAllocated);
+}
@@ -51,8 +51,64 @@
 
 #include "tst_vlayoutdetail.h"
 #include "../vlayout/vlayoutpiece.h"
+#include "../vlayout/vcollisionpolygon.h"
+#include "../vpatterndb/vcontainer.h"
+#include "../vpatterndb/vpiece.h"
+#include "../vpatterndb/vpiecenode.h"
+#include "../vpatterndb/variables/vmeasurement.h"
+#include "../vgeometry/vpointf.h"
+#include "../vmisc/vabstractapplication.h"
 
 #include <QtDebug>
+#include <QtTest>
+
+namespace
+{
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief PieceData container with four points and a multisize measurement pieces of CreateInParallelKeepsOrder() are
+ * built from.
+ */
+VContainer *PieceData(const Unit *unit)
+{
+    VContainer *data = new VContainer(nullptr, unit);
+    data->UpdateGObject(1, new VPointF(0, 0, "A1", 0, 0));
+    data->UpdateGObject(2, new VPointF(100, 0, "A2", 0, 0));
+    data->UpdateGObject(3, new VPointF(100, 100, "A3", 0, 0));
+    data->UpdateGObject(4, new VPointF(0, 100, "A4", 0, 0));
+
+    VMeasurement *m = new VMeasurement(0, QStringLiteral("seam_width"), 50, 176, 1, 0.1, 0.05);
+    m->SetSize(VContainer::rsize());
+    m->SetHeight(VContainer::rheight());
+    m->SetUnit(unit);
+    data->AddVariable(m->GetName(), m);
+    return data;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<VLayoutPieceSource> PieceSources(const VContainer *data)
+{
+    QVector<VLayoutPieceSource> sources;
+    for (quint32 i = 0; i < 16; ++i)
+    {
+        VLayoutPieceSource source;
+        source.id = 100 + i;
+        source.pattern = data;
+        source.piece.SetName(QStringLiteral("Piece %1").arg(i));
+        source.piece.SetSeamAllowance(true);
+        source.piece.SetSAWidth(0.5 + i * 0.1);
+        for (quint32 id = 1; id <= 4; ++id)
+        {
+            VPieceNode node(id, Tool::NodePoint);
+            node.setNotch(id == 2);
+            source.piece.GetPath().Append(node);
+        }
+        source.piece.GetPath()[0].SetFormulaSABefore(QStringLiteral("seam_width*%1").arg(i + 1));
+        sources.append(source);
+    }
+    return sources;
+}
+}
 
 //---------------------------------------------------------------------------------------------------------------------
 TST_VLayoutDetail::TST_VLayoutDetail(QObject *parent)
@@ -73,6 +129,116 @@ void TST_VLayoutDetail::RemoveDublicates() const
     Case3();
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VLayoutDetail::CollisionMatchesPainterPath_data() const
+{
+    QTest::addColumn<QVector<QPointF>>("subject");
+    QTest::addColumn<QVector<QPointF>>("clip");
+
+    const QVector<QPointF> case1 = InputPointsCase1();
+
+    QTest::newRow("Far away copy") << case1 << Translated(case1, 1000, 0);
+    QTest::newRow("Overlapping copy") << case1 << Translated(case1, 45.5, 30.25);
+    QTest::newRow("Overlapping copy 2") << case1 << Translated(case1, -120.75, 310.5);
+    QTest::newRow("Rectangle inside") << case1 << Rectangle(580, 1280, 40, 40);
+    QTest::newRow("Rectangle outside") << case1 << Rectangle(0, 2000, 100, 100);
+    QTest::newRow("Rectangle crossing") << case1 << Rectangle(300, 1100, 150, 120);
+    QTest::newRow("Rectangle around") << case1 << Rectangle(0, -200, 1200, 1800);
+    QTest::newRow("Rectangle in bounding rect only") << case1 << Rectangle(400, -80, 20, 20);
+
+    // Touching outlines intersect
+    QTest::newRow("Rectangle on part of an edge") << case1 << Rectangle(500, 1446, 100, 50);
+    QTest::newRow("Rectangle touching a vertex") << case1 << Rectangle(957, 500, 50, 100);
+    QTest::newRow("Rectangles sharing an edge") << Rectangle(0, 0, 100, 100) << Rectangle(100, 0, 100, 100);
+    QTest::newRow("Rectangles sharing a vertex") << Rectangle(0, 0, 100, 100) << Rectangle(100, 100, 50, 50);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// cppcheck-suppress unusedFunction
+void TST_VLayoutDetail::CollisionMatchesPainterPath() const
+{
+    QFETCH(QVector<QPointF>, subject);
+    QFETCH(QVector<QPointF>, clip);
+
+    QPainterPath subjectPath = PolygonPath(subject);
+    QPainterPath clipPath = PolygonPath(clip);
+
+    const VCollisionPolygon subjectPolygon(subject);
+    const VCollisionPolygon clipPolygon(clip);
+
+    QCOMPARE(subjectPolygon.Intersects(clipPolygon), subjectPath.intersects(clipPath));
+    QCOMPARE(clipPolygon.Intersects(subjectPolygon), clipPath.intersects(subjectPath));
+    QCOMPARE(subjectPolygon.Contains(clipPolygon), subjectPath.contains(clipPath));
+    QCOMPARE(clipPolygon.Contains(subjectPolygon), clipPath.contains(subjectPath));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// cppcheck-suppress unusedFunction
+void TST_VLayoutDetail::CachedGeometryFollowsTransformations() const
+{
+    VLayoutPiece det = VLayoutPiece();
+    det.SetCountourPoints(InputPointsCase1());
+    CompareGeometry(det);
+
+    // Translation of already mapped geometry is shifted instead of mapped again
+    det.Translate(120.5, -40.25);
+    CompareGeometry(det);
+
+    det.Rotate(QPointF(500, 600), 90);
+    CompareGeometry(det);
+
+    det.Translate(-15, 33.75);
+    CompareGeometry(det);
+
+    det.Mirror(QLineF(500, 500, 700, 650));
+    CompareGeometry(det);
+
+    det.Translate(7.125, 0);
+    CompareGeometry(det);
+
+    det.SetMatrix(QTransform());
+    det.SetMirror(false);
+    CompareGeometry(det);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief CreateInParallelKeepsOrder pieces made in a thread pool must be the same and in the same order as pieces made
+ * one by one.
+ */
+void TST_VLayoutDetail::CreateInParallelKeepsOrder() const
+{
+    const Unit unit = Unit::Cm;
+    qApp->setPatternUnit(unit);
+
+    VLayoutPieceContext context;
+    context.showSecondNotch = true;
+
+    // Separate containers, so the serial pieces don't come from the geometry cache the parallel ones have filled
+    QScopedPointer<VContainer> serialData(PieceData(&unit));
+    const QVector<VLayoutPieceSource> serialSources = PieceSources(serialData.data());
+    QVector<VLayoutPiece> serial;
+    for (int i = 0; i < serialSources.size(); ++i)
+    {
+        const VLayoutPieceSource &source = serialSources.at(i);
+        serial.append(VLayoutPiece::Create(source.piece, source.id, source.pattern, context));
+    }
+
+    QScopedPointer<VContainer> parallelData(PieceData(&unit));
+    const QVector<VLayoutPieceSource> parallelSources = PieceSources(parallelData.data());
+    const QVector<VLayoutPiece> parallel = VLayoutPiece::CreateInParallel(parallelSources, context);
+
+    QCOMPARE(parallel.size(), serial.size());
+    for (int i = 0; i < parallel.size(); ++i)
+    {
+        QCOMPARE(parallel.at(i).GetId(), serial.at(i).GetId());
+        QCOMPARE(parallel.at(i).GetName(), serial.at(i).GetName());
+        Comparison(parallel.at(i).GetContourPoints(), serial.at(i).GetContourPoints());
+        Comparison(parallel.at(i).GetSeamAllowancePoints(), serial.at(i).GetSeamAllowancePoints());
+        QCOMPARE(parallel.at(i).getNotches(), serial.at(i).getNotches());
+    }
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void TST_VLayoutDetail::Case1() const
 {
@@ -206,3 +372,68 @@ QVector<QPointF> TST_VLayoutDetail::OutputPointsCase3() const //-V524
 
     return points;
 }
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QPointF> TST_VLayoutDetail::Rectangle(qreal x, qreal y, qreal width, qreal height)
+{
+    QVector<QPointF> points;
+
+    points += QPointF(x, y);
+    points += QPointF(x + width, y);
+    points += QPointF(x + width, y + height);
+    points += QPointF(x, y + height);
+
+    return points;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<QPointF> TST_VLayoutDetail::Translated(const QVector<QPointF> &points, qreal dx, qreal dy)
+{
+    QVector<QPointF> translated;
+    for (int i = 0; i < points.size(); ++i)
+    {
+        translated += points.at(i) + QPointF(dx, dy);
+    }
+    return translated;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QPainterPath TST_VLayoutDetail::PolygonPath(const QVector<QPointF> &points)
+{
+    // The same way as VContour::ContourPath() and VLayoutPiece::LayoutAllowancePath() do
+    QPainterPath path;
+    path.setFillRule(Qt::WindingFill);
+    path.moveTo(points.at(0));
+    for (qint32 i = 1; i < points.count(); ++i)
+    {
+        path.lineTo(points.at(i));
+    }
+    path.lineTo(points.at(0));
+    return path;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VLayoutDetail::CompareGeometry(const VLayoutPiece &cached) const
+{
+    // The same transformation applied to a piece without cache
+    VLayoutPiece fresh = VLayoutPiece();
+    fresh.SetCountourPoints(InputPointsCase1());
+    fresh.SetMatrix(cached.GetMatrix());
+    fresh.SetMirror(cached.IsMirror());
+
+    Comparison(cached.GetContourPoints(), fresh.GetContourPoints());
+
+    const QRectF cachedRect = cached.DetailBoundingRect();
+    const QRectF freshRect = fresh.DetailBoundingRect();
+    Comparison(QVector<QPointF>() << cachedRect.topLeft() << cachedRect.bottomRight(),
+               QVector<QPointF>() << freshRect.topLeft() << freshRect.bottomRight());
+
+    QCOMPARE(cached.DetailEdgesCount(), fresh.DetailEdgesCount());
+    for (int i = 1; i <= cached.DetailEdgesCount(); ++i)
+    {
+        const QLineF cachedEdge = cached.DetailEdge(i);
+        const QLineF freshEdge = fresh.DetailEdge(i);
+        Comparison(QVector<QPointF>() << cachedEdge.p1() << cachedEdge.p2(),
+                   QVector<QPointF>() << freshEdge.p1() << freshEdge.p2());
+    }
+}
@@ -54,6 +54,12 @@
 
 #include "../vtest/abstracttest.h"
 
+#include <QPainterPath>
+#include <QPointF>
+#include <QVector>
+
+class VLayoutPiece;
+
 class TST_VLayoutDetail : public AbstractTest
 {
     Q_OBJECT
@@ -62,6 +68,10 @@ class TST_VLayoutDetail : public AbstractTest
 
 private slots:
     void RemoveDublicates() const;
+    void CollisionMatchesPainterPath_data() const;
+    void CollisionMatchesPainterPath() const;
+    void CachedGeometryFollowsTransformations() const;
+    void CreateInParallelKeepsOrder() const;
 
 private:
     void Case1() const;
@@ -75,6 +85,12 @@ private slots:
     void Case3() const;
     QVector<QPointF> InputPointsCase3() const;
     QVector<QPointF> OutputPointsCase3() const;
+
+    static QVector<QPointF> Rectangle(qreal x, qreal y, qreal width, qreal height);
+    static QVector<QPointF> Translated(const QVector<QPointF> &points, qreal dx, qreal dy);
+    static QPainterPath     PolygonPath(const QVector<QPointF> &points);
+
+    void CompareGeometry(const VLayoutPiece &cached) const;
 };
 
 #endif // TST_VLAYOUTDETAIL_H
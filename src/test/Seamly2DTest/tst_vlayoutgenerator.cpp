@@ -0,0 +1,459 @@
+/***************************************************************************
+ *                                                                         *
+ *   Copyright (C) 2017  Seamly, LLC                                       *
+ *                                                                         *
+ *   https://github.com/fashionfreedom/seamly2d                             *
+ *                                                                         *
+ ***************************************************************************
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **************************************************************************
+
+ ************************************************************************
+ **
+ **  @file
+ **  @author Seamly2D project
+ **  @date   16 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Seamly2D project
+ **  <https://github.com/fashionfreedom/seamly2d> All Rights Reserved.
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#include "tst_vlayoutgenerator.h"
+#include "../vlayout/vcollisionpolygon.h"
+#include "../vlayout/vlayoutgenerator.h"
+#include "../vlayout/vlayoutpiece.h"
+#include "../vlayout/vnfpcache.h"
+#include "../vmisc/def.h"
+
+#include <QPolygonF>
+#include <QtTest>
+
+Q_DECLARE_METATYPE(LayoutEngine)
+
+namespace
+{
+const qreal paperWidth = 1500;
+const qreal paperHeight = 3000;
+const qreal layoutWidth = 10;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+TST_VLayoutGenerator::TST_VLayoutGenerator(QObject *parent)
+    : QObject(parent)
+{
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VLayoutGenerator::ArrangeAllPieces_data() const
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<bool>("rotate");
+    QTest::addColumn<LayoutEngine>("engine");
+
+    QTest::newRow("5 pieces, no rotation") << 5 << false << LayoutEngine::Contour;
+    QTest::newRow("5 pieces, rotation") << 5 << true << LayoutEngine::Contour;
+    QTest::newRow("20 pieces, rotation") << 20 << true << LayoutEngine::Contour;
+    QTest::newRow("NFP, 5 pieces, no rotation") << 5 << false << LayoutEngine::Nfp;
+    QTest::newRow("NFP, 5 pieces, rotation") << 5 << true << LayoutEngine::Nfp;
+    QTest::newRow("NFP, 20 pieces, rotation") << 20 << true << LayoutEngine::Nfp;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// cppcheck-suppress unusedFunction
+void TST_VLayoutGenerator::ArrangeAllPieces() const
+{
+    QFETCH(int, count);
+    QFETCH(bool, rotate);
+    QFETCH(LayoutEngine, engine);
+
+    VLayoutGenerator generator;
+    SetupGenerator(generator, RectanglePieces(count), rotate, engine);
+
+    generator.Generate();
+
+    QCOMPARE(generator.State(), LayoutErrors::NoError);
+
+    int arranged = 0;
+    const QVector<QVector<VLayoutPiece>> papers = generator.GetAllDetails();
+    for (int i = 0; i < papers.size(); ++i)
+    {
+        arranged += papers.at(i).size();
+
+        if (engine == LayoutEngine::Nfp)
+        {
+            QVERIFY2(not HasOverlaps(papers.at(i)), "Pieces overlap.");
+        }
+    }
+    QCOMPARE(arranged, count);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VLayoutGenerator::BenchmarkGenerate_data() const
+{
+    QTest::addColumn<int>("count");
+    QTest::addColumn<bool>("mixed");
+    QTest::addColumn<LayoutEngine>("engine");
+    QTest::addColumn<int>("attempts");
+    QTest::addColumn<bool>("polling");
+
+    // Polling rows wait for the candidate search the old way, compare them with the rows after them
+    QTest::newRow("10 rectangles, contour, polling wait (old)") << 10 << false << LayoutEngine::Contour << 1 << true;
+    QTest::newRow("10 rectangles, contour") << 10 << false << LayoutEngine::Contour << 1 << false;
+    QTest::newRow("10 rectangles, NFP") << 10 << false << LayoutEngine::Nfp << 1 << false;
+    QTest::newRow("40 rectangles, contour, polling wait (old)") << 40 << false << LayoutEngine::Contour << 1 << true;
+    QTest::newRow("40 rectangles, contour") << 40 << false << LayoutEngine::Contour << 1 << false;
+    QTest::newRow("40 rectangles, NFP") << 40 << false << LayoutEngine::Nfp << 1 << false;
+    QTest::newRow("40 mixed pieces, contour, polling wait (old)") << 40 << true << LayoutEngine::Contour << 1 << true;
+    QTest::newRow("40 mixed pieces, contour") << 40 << true << LayoutEngine::Contour << 1 << false;
+    QTest::newRow("40 mixed pieces, NFP") << 40 << true << LayoutEngine::Nfp << 1 << false;
+    QTest::newRow("40 mixed pieces, contour, best of 8") << 40 << true << LayoutEngine::Contour << 8 << false;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// cppcheck-suppress unusedFunction
+void TST_VLayoutGenerator::BenchmarkGenerate() const
+{
+    QFETCH(int, count);
+    QFETCH(bool, mixed);
+    QFETCH(LayoutEngine, engine);
+    QFETCH(int, attempts);
+    QFETCH(bool, polling);
+
+    const QVector<VLayoutPiece> details = mixed ? MixedPieces(count) : RectanglePieces(count);
+
+    qreal utilization = 0;
+    QBENCHMARK
+    {
+        VLayoutGenerator generator;
+        SetupGenerator(generator, details, true, engine);
+        generator.SetAttempts(attempts);
+        generator.SetPollingWait(polling);
+        generator.Generate();
+        utilization = Utilization(generator);
+    }
+
+    QVERIFY(utilization > 0 and utilization <= 1);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// cppcheck-suppress unusedFunction
+void TST_VLayoutGenerator::NoFitPolygon() const
+{
+    QVector<QPointF> fixed;
+    fixed << QPointF(0, 0) << QPointF(5, 0) << QPointF(10, 0) << QPointF(10, 10) << QPointF(0, 10); // Collinear point
+
+    QVector<QPointF> moving;
+    moving << QPointF(0, 0) << QPointF(4, 0) << QPointF(4, 4) << QPointF(0, 4);
+
+    QCOMPARE(VNfpCache::ConvexHull(fixed).size(), 4);
+    QCOMPARE(VNfpCache::ConvexParts(fixed).size(), 1);
+    QCOMPARE(VNfpCache::ConvexParts(fixed).at(0).size(), 4);
+
+    VNfpCache cache;
+    const int fixedShape = cache.ShapeId(fixed);
+    const int movingShape = cache.ShapeId(moving);
+    QCOMPARE(cache.ShapeId(QVector<QPointF>(moving)), movingShape); // The same points give the same shape
+
+    // Moving square touches the fixed one when its top left corner is on the border of (-4,-4) (10,10)
+    const QVector<QVector<QPointF>> nfp = cache.Nfp(fixedShape, 0, movingShape, 0);
+    QCOMPARE(nfp.size(), 1);
+    QCOMPARE(nfp.at(0).size(), 4);
+    QCOMPARE(QPolygonF(nfp.at(0)).boundingRect(), QRectF(QPointF(-4, -4), QPointF(10, 10)));
+    QCOMPARE(cache.Misses(), 1);
+
+    cache.Nfp(fixedShape, 0, movingShape, 0);
+    QCOMPARE(cache.Hits(), 1);
+
+    // Rotation by 90 degrees of a square gives the same size of the polygon, but around other point
+    const QVector<QVector<QPointF>> rotated = cache.Nfp(fixedShape, 0, movingShape, 90);
+    QCOMPARE(rotated.size(), 1);
+    QCOMPARE(rotated.at(0).size(), 4);
+    const QRectF rect = QPolygonF(rotated.at(0)).boundingRect();
+    QVERIFY(qAbs(rect.width() - 14) < VCollisionPolygon::accuracy);
+    QVERIFY(qAbs(rect.height() - 14) < VCollisionPolygon::accuracy);
+    QCOMPARE(cache.Misses(), 2);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// cppcheck-suppress unusedFunction
+void TST_VLayoutGenerator::NoFitPolygonOfConcavePiece() const
+{
+    // U shape with a 10x20 pocket open to the bottom
+    QVector<QPointF> fixed;
+    fixed << QPointF(0, 0) << QPointF(30, 0) << QPointF(30, 30) << QPointF(20, 30) << QPointF(20, 10)
+          << QPointF(10, 10) << QPointF(10, 30) << QPointF(0, 30);
+
+    QVector<QPointF> moving;
+    moving << QPointF(0, 0) << QPointF(6, 0) << QPointF(6, 6) << QPointF(0, 6);
+
+    const QVector<QVector<QPointF>> parts = VNfpCache::ConvexParts(fixed);
+    QVERIFY(parts.size() > 1);
+    QVERIFY(parts.size() <= VNfpCache::maxParts);
+
+    VNfpCache cache;
+    const QVector<QVector<QPointF>> nfp = cache.Nfp(cache.ShapeId(fixed), 0, cache.ShapeId(moving), 0);
+
+    const QPointF inPocket(12, 15);
+    const QPointF overlapping(2, 2);
+
+    bool pocketFree = true;
+    bool overlapFound = false;
+    for (int i = 0; i < nfp.size(); ++i)
+    {
+        const VCollisionPolygon polygon(nfp.at(i));
+        pocketFree = pocketFree && polygon.PointLocation(inPocket) != VCollisionPolygon::Location::Inside;
+        overlapFound = overlapFound || polygon.PointLocation(overlapping) == VCollisionPolygon::Location::Inside;
+    }
+    QVERIFY2(pocketFree, "The square must fit the pocket.");
+    QVERIFY2(overlapFound, "The square must not be placed over the piece.");
+
+    // Hull of the piece closes the pocket
+    const VCollisionPolygon hullNfp(VNfpCache::MinkowskiSum(VNfpCache::ConvexHull(fixed),
+                                                             VNfpCache::ConvexHull(VNfpCache::Rotated(moving, 180))));
+    QCOMPARE(hullNfp.PointLocation(inPocket), VCollisionPolygon::Location::Inside);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// cppcheck-suppress unusedFunction
+void TST_VLayoutGenerator::BestOfAttempts() const
+{
+    const int count = 20;
+    const QVector<VLayoutPiece> details = MixedPieces(count);
+
+    VLayoutGenerator single;
+    SetupGenerator(single, details, true, LayoutEngine::Contour);
+    single.Generate();
+    QCOMPARE(single.State(), LayoutErrors::NoError);
+
+    VLayoutGenerator bestOf;
+    SetupGenerator(bestOf, details, true, LayoutEngine::Contour);
+    bestOf.SetAttempts(6);
+    QSignalSpy arrangedSpy(&bestOf, &VLayoutGenerator::Arranged);
+    bestOf.Generate();
+    QCOMPARE(bestOf.State(), LayoutErrors::NoError);
+
+    int arranged = 0;
+    const QVector<QVector<VLayoutPiece>> papers = bestOf.GetAllDetails();
+    for (int i = 0; i < papers.size(); ++i)
+    {
+        arranged += papers.at(i).size();
+    }
+    QCOMPARE(arranged, count);
+
+    // The first attempt repeats the single pass, so the best one cannot need more sheets
+    QVERIFY(papers.size() <= single.GetAllDetails().size());
+
+    // Progress only grows, even if attempts report it in a different order
+    QVERIFY(not arrangedSpy.isEmpty());
+    for (int i = 1; i < arrangedSpy.size(); ++i)
+    {
+        QVERIFY(arrangedSpy.at(i).at(0).toInt() > arrangedSpy.at(i-1).at(0).toInt());
+    }
+    QCOMPARE(arrangedSpy.last().at(0).toInt(), count);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+// cppcheck-suppress unusedFunction
+void TST_VLayoutGenerator::IncrementalLayout() const
+{
+    const int count = 12;
+    QVector<VLayoutPiece> details = RectanglePieces(count);
+    for (int i = 0; i < details.size(); ++i)
+    {
+        details[i].SetId(static_cast<quint32>(i + 1));
+    }
+
+    VLayoutGenerator full;
+    SetupGenerator(full, details, true, LayoutEngine::Nfp);
+    full.Generate();
+    QCOMPARE(full.State(), LayoutErrors::NoError);
+
+    QHash<quint32, QTransform> before;
+    const QVector<QVector<VLayoutPiece>> fullPapers = full.GetAllDetails();
+    for (int i = 0; i < fullPapers.size(); ++i)
+    {
+        for (int j = 0; j < fullPapers.at(i).size(); ++j)
+        {
+            before.insert(fullPapers.at(i).at(j).GetId(), fullPapers.at(i).at(j).GetMatrix());
+        }
+    }
+
+    // Make one piece smaller, it must be arranged again while others stay in place
+    const quint32 changedId = 4;
+    QVector<QPointF> points;
+    points << QPointF(0, 0) << QPointF(60, 0) << QPointF(60, 50) << QPointF(0, 50);
+    details[changedId - 1].SetCountourPoints(points);
+
+    VLayoutGenerator incremental;
+    SetupGenerator(incremental, details, true, LayoutEngine::Nfp);
+    incremental.SetIncremental(true);
+    incremental.SetIncrementalThreshold(100);
+    incremental.SetPreviousRevision(full.GetRevision());
+    incremental.Generate();
+    QCOMPARE(incremental.State(), LayoutErrors::NoError);
+
+    int arranged = 0;
+    const QVector<QVector<VLayoutPiece>> papers = incremental.GetAllDetails();
+    for (int i = 0; i < papers.size(); ++i)
+    {
+        arranged += papers.at(i).size();
+        QVERIFY2(not HasOverlaps(papers.at(i)), "Pieces overlap.");
+
+        for (int j = 0; j < papers.at(i).size(); ++j)
+        {
+            const VLayoutPiece &detail = papers.at(i).at(j);
+            if (detail.GetId() != changedId)
+            {
+                QCOMPARE(detail.GetMatrix(), before.value(detail.GetId()));
+            }
+        }
+    }
+    QCOMPARE(arranged, count);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<VLayoutPiece> TST_VLayoutGenerator::RectanglePieces(int count)
+{
+    QVector<VLayoutPiece> details;
+    for (int i = 0; i < count; ++i)
+    {
+        const qreal width = 100 + (i % 5) * 40;
+        const qreal height = 80 + (i % 7) * 30;
+
+        QVector<QPointF> points;
+        points += QPointF(0, 0);
+        points += QPointF(width, 0);
+        points += QPointF(width, height);
+        points += QPointF(0, height);
+
+        VLayoutPiece det;
+        det.SetCountourPoints(points);
+        details.append(det);
+    }
+    return details;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief MixedPieces rectangles, triangles and L-shaped pieces. Concave and slanted outlines leave gaps that two
+ * engines fill differently.
+ */
+QVector<VLayoutPiece> TST_VLayoutGenerator::MixedPieces(int count)
+{
+    QVector<VLayoutPiece> details;
+    for (int i = 0; i < count; ++i)
+    {
+        const qreal width = 100 + (i % 5) * 40;
+        const qreal height = 80 + (i % 7) * 30;
+
+        QVector<QPointF> points;
+        switch (i % 3)
+        {
+            case 0:
+                points << QPointF(0, 0) << QPointF(width, 0) << QPointF(width, height) << QPointF(0, height);
+                break;
+            case 1:
+                points << QPointF(0, 0) << QPointF(width, height) << QPointF(0, height);
+                break;
+            default:
+                points << QPointF(0, 0) << QPointF(width/2, 0) << QPointF(width/2, height/2)
+                       << QPointF(width, height/2) << QPointF(width, height) << QPointF(0, height);
+                break;
+        }
+
+        VLayoutPiece det;
+        det.SetCountourPoints(points);
+        details.append(det);
+    }
+    return details;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VLayoutGenerator::SetupGenerator(VLayoutGenerator &generator, const QVector<VLayoutPiece> &details,
+                                          bool rotate, LayoutEngine engine)
+{
+    generator.SetDetails(details);
+    generator.SetLayoutWidth(layoutWidth);
+    generator.SetCaseType(Cases::CaseDesc);
+    generator.SetPaperWidth(paperWidth);
+    generator.SetPaperHeight(paperHeight);
+    generator.SetPrinterFields(false, QMarginsF());
+    generator.SetShift(0);
+    generator.SetRotate(rotate);
+    generator.SetRotationIncrease(90);
+    generator.SetEngine(engine);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief Utilization area of pieces divided by used area of sheets. Used length of a sheet is the bottom of its
+ * pieces.
+ */
+qreal TST_VLayoutGenerator::Utilization(const VLayoutGenerator &generator)
+{
+    qreal piecesArea = 0;
+    qreal usedArea = 0;
+
+    const QVector<QVector<VLayoutPiece>> papers = generator.GetAllDetails();
+    for (int i = 0; i < papers.size(); ++i)
+    {
+        qreal bottom = 0;
+        for (int j = 0; j < papers.at(i).size(); ++j)
+        {
+            const VLayoutPiece &det = papers.at(i).at(j);
+            piecesArea += qAbs(VAbstractPiece::SumTrapezoids(det.GetContourPoints())/2.0);
+            bottom = qMax(bottom, det.DetailBoundingRect().bottom());
+        }
+        usedArea += bottom * paperWidth;
+    }
+
+    return qFuzzyIsNull(usedArea) ? 0 : piecesArea/usedArea;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+bool TST_VLayoutGenerator::HasOverlaps(const QVector<VLayoutPiece> &details)
+{
+    for (int i = 0; i < details.size(); ++i)
+    {
+        const VCollisionPolygon polygon(details.at(i).GetLayoutAllowancePoints());
+        for (int j = i + 1; j < details.size(); ++j)
+        {
+            if (polygon.Overlaps(VCollisionPolygon(details.at(j).GetLayoutAllowancePoints())))
+            {
+                return true;
+            }
+        }
+    }
+    return false;
+}
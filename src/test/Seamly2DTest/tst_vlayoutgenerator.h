@@ -0,0 +1,88 @@
+/***************************************************************************
+ *                                                                         *
+ *   Copyright (C) 2017  Seamly, LLC                                       *
+ *                                                                         *
+ *   https://github.com/fashionfreedom/seamly2d                             *
+ *                                                                         *
+ ***************************************************************************
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ **************************************************************************
+
+ ************************************************************************
+ **
+ **  @file
+ **  @author Seamly2D project
+ **  @date   16 10, 2026
+ **
+ **  @brief
+ **  @copyright
+ **  This source code is part of the Valentine project, a pattern making
+ **  program, whose allow create and modeling patterns of clothing.
+ **  Copyright (C) 2026 Seamly2D project
+ **  <https://github.com/fashionfreedom/seamly2d> All Rights Reserved.
+ **
+ **  Seamly2D is free software: you can redistribute it and/or modify
+ **  it under the terms of the GNU General Public License as published by
+ **  the Free Software Foundation, either version 3 of the License, or
+ **  (at your option) any later version.
+ **
+ **  Seamly2D is distributed in the hope that it will be useful,
+ **  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ **  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ **  GNU General Public License for more details.
+ **
+ **  You should have received a copy of the GNU General Public License
+ **  along with Seamly2D.  If not, see <http://www.gnu.org/licenses/>.
+ **
+ *************************************************************************/
+
+#ifndef TST_VLAYOUTGENERATOR_H
+#define TST_VLAYOUTGENERATOR_H
+
+#include <QObject>
+#include <QVector>
+
+#include "../vlayout/vlayoutdef.h"
+
+class VLayoutPiece;
+class VLayoutGenerator;
+
+class TST_VLayoutGenerator : public QObject
+{
+    Q_OBJECT
+public:
+    explicit TST_VLayoutGenerator(QObject *parent = nullptr);
+
+private slots:
+    void ArrangeAllPieces_data() const;
+    void ArrangeAllPieces() const;
+    void BenchmarkGenerate_data() const;
+    void BenchmarkGenerate() const;
+    void NoFitPolygon() const;
+    void NoFitPolygonOfConcavePiece() const;
+    void BestOfAttempts() const;
+    void IncrementalLayout() const;
+
+private:
+    static QVector<VLayoutPiece> RectanglePieces(int count);
+    static QVector<VLayoutPiece> MixedPieces(int count);
+    static void                  SetupGenerator(VLayoutGenerator &generator, const QVector<VLayoutPiece> &details,
+                                                bool rotate, LayoutEngine engine);
+    static qreal                 Utilization(const VLayoutGenerator &generator);
+    static bool                  HasOverlaps(const QVector<VLayoutPiece> &details);
+};
+
+#endif // TST_VLAYOUTGENERATOR_H
@@ -52,13 +52,45 @@
 #include "tst_vpiece.h"
 #include "../vpatterndb/vcontainer.h"
 #include "../vpatterndb/vpiece.h"
+#include "../vpatterndb/vpiecegeometry.h"
 #include "../vpatterndb/vpiecenode.h"
 #include "../vpatterndb/vpiecepath.h"
+#include "../vpatterndb/variables/vincrement.h"
 #include "../vgeometry/vsplinepath.h"
 #include "../vmisc/vabstractapplication.h"
 
+#include <QRunnable>
+#include <QThreadPool>
 #include <QtTest>
 
+namespace
+{
+/**
+ * @brief The VGeometryTask class calculates geometry of a piece from a snapshot, like a piece tool does in background.
+ */
+class VGeometryTask : public QRunnable
+{
+public:
+    VGeometryTask(const QSharedPointer<const VContainer> &snapshot, const VPiece &piece, VPieceGeometry *result)
+        : snapshot(snapshot),
+          piece(piece),
+          result(result)
+    {}
+
+    virtual void run() Q_DECL_OVERRIDE
+    {
+        *result = snapshot->GetPieceGeometry(10, piece, true);
+    }
+
+private:
+    Q_DISABLE_COPY(VGeometryTask)
+
+    const QSharedPointer<const VContainer> snapshot;
+    const VPiece                           piece;
+    VPieceGeometry                        *result;
+};
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 TST_VPiece::TST_VPiece(QObject *parent)
     :AbstractTest(parent)
@@ -277,3 +309,123 @@ void TST_VPiece::Issue620()
     // Begin comparison
     Comparison(pointsEkv, origPoints);
 }
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GeometryCache geometry must be calculated again only after the piece or something it is built from changes.
+ */
+void TST_VPiece::GeometryCache()
+{
+    const Unit unit = Unit::Mm;
+    QScopedPointer<VContainer> data(new VContainer(nullptr, &unit));
+    qApp->setPatternUnit(unit);
+
+    data->UpdateGObject(1, new VPointF(0, 0, "A1", 0, 0));
+    data->UpdateGObject(2, new VPointF(100, 0, "A2", 0, 0));
+    data->UpdateGObject(3, new VPointF(100, 100, "A3", 0, 0));
+    data->UpdateGObject(4, new VPointF(0, 100, "A4", 0, 0));
+    data->AddVariable(QStringLiteral("#sa"), new VIncrement(data.data(), QStringLiteral("#sa"), 0, 5, "5", true));
+
+    VPiece piece;
+    piece.SetSeamAllowance(true);
+    piece.SetSAWidth(7);
+    for (quint32 id = 1; id <= 4; ++id)
+    {
+        piece.GetPath().Append(VPieceNode(id, Tool::NodePoint));
+    }
+    piece.GetPath()[0].SetFormulaSABefore(QStringLiteral("#sa"));
+
+    VPieceGeometryCache cache;
+    const VPieceGeometry geometry = cache.Geometry(10, piece, data.data(), true);
+    QCOMPARE(cache.CalculationsCount(), 1);
+    QCOMPARE(geometry.mainPathPoints, piece.MainPathPoints(data.data()));
+    QCOMPARE(geometry.seamAllowancePoints, piece.SeamAllowancePoints(data.data()));
+    QCOMPARE(geometry.notches, piece.createNotchLines(data.data(), true));
+
+    // A copy of the container still has the same objects
+    const VContainer copy(*data);
+    QCOMPARE(cache.Geometry(10, piece, &copy, true).seamAllowancePoints, geometry.seamAllowancePoints);
+    QCOMPARE(cache.CalculationsCount(), 1);
+
+    // Value of a variable the seam allowance reads changes in place
+    data->AddVariable(QStringLiteral("#sa"), new VIncrement(data.data(), QStringLiteral("#sa"), 0, 10, "10", true));
+    QCOMPARE(cache.Geometry(10, piece, data.data(), true).seamAllowancePoints, piece.SeamAllowancePoints(data.data()));
+    QCOMPARE(cache.CalculationsCount(), 2);
+
+    // New instance of a point
+    data->UpdateGObject(3, new VPointF(120, 100, "A3", 0, 0));
+    QCOMPARE(cache.Geometry(10, piece, data.data(), true).mainPathPoints, piece.MainPathPoints(data.data()));
+    QCOMPARE(cache.CalculationsCount(), 3);
+
+    // Definition of the piece
+    piece.SetSAWidth(12);
+    QCOMPARE(cache.Geometry(10, piece, data.data(), true).seamAllowancePoints, piece.SeamAllowancePoints(data.data()));
+    QCOMPARE(cache.CalculationsCount(), 4);
+
+    cache.Geometry(10, piece, data.data(), true);
+    QCOMPARE(cache.CalculationsCount(), 4);
+
+    cache.Remove(10);
+    cache.Geometry(10, piece, data.data(), true);
+    QCOMPARE(cache.CalculationsCount(), 5);
+
+    // Setting notches are built with
+    cache.Geometry(10, piece, data.data(), false);
+    QCOMPARE(cache.CalculationsCount(), 6);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+/**
+ * @brief GeometryOfSnapshotsInBackground geometry calculated in other threads must match the snapshot it was requested
+ * for, while the container itself keeps changing.
+ */
+void TST_VPiece::GeometryOfSnapshotsInBackground()
+{
+    const Unit unit = Unit::Mm;
+    QScopedPointer<VContainer> data(new VContainer(nullptr, &unit));
+    qApp->setPatternUnit(unit);
+
+    data->UpdateGObject(1, new VPointF(0, 0, "A1", 0, 0));
+    data->UpdateGObject(2, new VPointF(100, 0, "A2", 0, 0));
+    data->UpdateGObject(3, new VPointF(100, 100, "A3", 0, 0));
+    data->UpdateGObject(4, new VPointF(0, 100, "A4", 0, 0));
+    data->AddVariable(QStringLiteral("#sa"), new VIncrement(data.data(), QStringLiteral("#sa"), 0, 5, "5", true));
+
+    VPiece piece;
+    piece.SetSeamAllowance(true);
+    piece.SetSAWidth(7);
+    for (quint32 id = 1; id <= 4; ++id)
+    {
+        VPieceNode node(id, Tool::NodePoint);
+        node.setNotch(id == 2);
+        piece.GetPath().Append(node);
+    }
+    piece.GetPath()[0].SetFormulaSABefore(QStringLiteral("#sa"));
+
+    const int requests = 200;
+    QVector<QSharedPointer<const VContainer>> snapshots;
+    snapshots.reserve(requests);
+    QVector<VPieceGeometry> results(requests);
+
+    QThreadPool threadPool;
+    for (int i = 0; i < requests; ++i)
+    {
+        snapshots.append(QSharedPointer<const VContainer>(new VContainer(data->Snapshot())));
+        threadPool.start(new VGeometryTask(snapshots.last(), piece, &results[i]));
+
+        // Parsing goes on while the geometry is being calculated
+        const qreal sa = 1 + i % 10;
+        data->AddVariable(QStringLiteral("#sa"), new VIncrement(data.data(), QStringLiteral("#sa"), 0, sa,
+                                                                QString::number(sa), true));
+        data->UpdateGObject(3, new VPointF(100 + i % 7, 100, "A3", 0, 0));
+    }
+    threadPool.waitForDone();
+
+    for (int i = 0; i < requests; ++i)
+    {
+        const VContainer *snapshot = snapshots.at(i).data();
+        QCOMPARE(results.at(i).mainPathPoints, piece.MainPathPoints(snapshot));
+        QCOMPARE(results.at(i).seamAllowancePoints, piece.SeamAllowancePoints(snapshot));
+        QCOMPARE(results.at(i).notches, piece.createNotchLines(snapshot, true));
+    }
+}
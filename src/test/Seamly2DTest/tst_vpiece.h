@@ -63,6 +63,8 @@ class TST_VPiece : public AbstractTest
 private slots:
     void ClearLoop();
     void Issue620();
+    void GeometryCache();
+    void GeometryOfSnapshotsInBackground();
 
 private:
     Q_DISABLE_COPY(TST_VPiece)
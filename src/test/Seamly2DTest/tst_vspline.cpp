@@ -52,6 +52,7 @@
 #include "tst_vspline.h"
 #include "../vgeometry/vspline.h"
 #include "../vmisc/logging.h"
+#include "../vmisc/vabstractapplication.h"
 
 #include <QtTest>
 
@@ -454,6 +455,135 @@ void TST_VSpline::TestFlip()
     QCOMPARE(spl.GetC2Length(), res.GetC2Length());
 }
 
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSpline::TestApproximationScale()
+{
+    VPointF p1(1168.8582803149607, 39.999874015748034, "p1", 5.0000125984251973, 9.9999874015748045);
+    VPointF p4(681.33729132409951, 1815.7969526662778, "p4", 5.0000125984251973, 9.9999874015748045);
+
+    VSpline spl(p1, p4, 229.381, 41.6325, 0.96294100000000005, 1.00054, 1);
+
+    const qreal scale = qApp->GetCurveApproximationScale();
+    const QVector<QPointF> points = spl.GetPoints();
+
+    qApp->SetCurveApproximationScale(maxCurveApproximationScale);
+    const QVector<QPointF> precisePoints = spl.GetPoints();
+
+    qApp->SetCurveApproximationScale(minCurveApproximationScale);
+    const QVector<QPointF> roughPoints = spl.GetPoints();
+
+    qApp->SetCurveApproximationScale(scale);
+
+    QVERIFY(precisePoints.size() > points.size());
+    QVERIFY(roughPoints.size() < points.size());
+    Comparison(spl.GetPoints(), points);
+
+    // Cached points must follow the control points
+    VSpline changed = spl;
+    changed.SetC1Length(spl.GetC1Length() * 2, QString().setNum(spl.GetC1Length() * 2));
+    const VSpline expected(changed.GetP1(), static_cast<QPointF>(changed.GetP2()),
+                           static_cast<QPointF>(changed.GetP3()), changed.GetP4());
+    Comparison(changed.GetPoints(), expected.GetPoints());
+    Comparison(spl.GetPoints(), points);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSpline::TestLengthQuadrature()
+{
+    VPointF p1(1168.8582803149607, 39.999874015748034, "p1", 5.0000125984251973, 9.9999874015748045);
+    VPointF p4(681.33729132409951, 1815.7969526662778, "p4", 5.0000125984251973, 9.9999874015748045);
+
+    const VSpline spl(p1, p4, 229.381, 41.6325, 0.96294100000000005, 1.00054, 1);
+
+    const qreal scale = qApp->GetCurveApproximationScale();
+    qApp->SetCurveApproximationScale(maxCurveApproximationScale);
+    const qreal polylineLength = VAbstractCurve::PathLength(spl.GetPoints());
+    qApp->SetCurveApproximationScale(scale);
+
+    // Polyline is always a bit shorter than the curve
+    QVERIFY(spl.GetLength() >= polylineLength);
+    QVERIFY(spl.GetLength() - polylineLength < ToPixel(0.5, Unit::Mm));
+
+    QCOMPARE(spl.LengthT(0), 0.0);
+    QCOMPARE(spl.LengthT(1), spl.GetLength());
+    QCOMPARE(spl.LengthT(-0.5), 0.0); // Out of range parameter is clamped
+    QCOMPARE(spl.LengthT(1.5), spl.GetLength());
+    QCOMPARE(spl.GetParmT(0), 0.0);
+    QCOMPARE(spl.GetParmT(spl.GetLength()), 1.0);
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSpline::TestCutSpline_data()
+{
+    QTest::addColumn<qreal>("fraction");
+
+    QTest::newRow("Begin") << 0.05;
+    QTest::newRow("Quarter") << 0.25;
+    QTest::newRow("Middle") << 0.5;
+    QTest::newRow("Two thirds") << 2.0/3.0;
+    QTest::newRow("End") << 0.95;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSpline::TestCutSpline()
+{
+    QFETCH(qreal, fraction);
+
+    VPointF p1(1168.8582803149607, 39.999874015748034, "p1", 5.0000125984251973, 9.9999874015748045);
+    VPointF p4(681.33729132409951, 1815.7969526662778, "p4", 5.0000125984251973, 9.9999874015748045);
+
+    const VSpline spl(p1, p4, 229.381, 41.6325, 0.96294100000000005, 1.00054, 1);
+    const qreal length = spl.GetLength() * fraction;
+
+    VSpline spl1;
+    VSpline spl2;
+    const QPointF cutPoint = spl.CutSpline(length, spl1, spl2);
+
+    QVERIFY(qAbs(spl1.GetLength() - length) < ToPixel(0.5, Unit::Mm));
+    QVERIFY(qAbs(spl1.GetLength() + spl2.GetLength() - spl.GetLength()) < ToPixel(0.5, Unit::Mm));
+    QVERIFY(qAbs(spl.GetLengthByPoint(cutPoint) - length) < ToPixel(0.5, Unit::Mm));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSpline::BenchmarkGetPoints_data()
+{
+    QTest::addColumn<bool>("cached");
+
+    QTest::newRow("Recalculate") << false;
+    QTest::newRow("Cached") << true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSpline::BenchmarkGetPoints()
+{
+    QFETCH(bool, cached);
+
+    VPointF p1(1168.8582803149607, 39.999874015748034, "p1", 5.0000125984251973, 9.9999874015748045);
+    VPointF p4(681.33729132409951, 1815.7969526662778, "p4", 5.0000125984251973, 9.9999874015748045);
+
+    const VSpline spl(p1, p4, 229.381, 41.6325, 0.96294100000000005, 1.00054, 1);
+    const QPointF p2 = static_cast<QPointF>(spl.GetP2());
+    const QPointF p3 = static_cast<QPointF>(spl.GetP3());
+
+    if (cached)
+    {
+        QBENCHMARK
+        {
+            spl.GetPoints();
+            spl.GetLength();
+        }
+    }
+    else
+    {
+        QBENCHMARK
+        {
+            const VSpline fresh(p1, p2, p3, p4);
+            fresh.GetPoints();
+            fresh.GetLength();
+        }
+    }
+}
+
 //---------------------------------------------------------------------------------------------------------------------
 void TST_VSpline::CompareSplines(const VSpline &spl1, const VSpline &spl2) const
 {
@@ -76,6 +76,12 @@ private slots:
     void TestLengthByPoint();
     void TestFlip_data();
     void TestFlip();
+    void TestApproximationScale();
+    void TestLengthQuadrature();
+    void TestCutSpline_data();
+    void TestCutSpline();
+    void BenchmarkGetPoints_data();
+    void BenchmarkGetPoints();
 
 private:
     Q_DISABLE_COPY(TST_VSpline)
@@ -219,3 +219,113 @@ void TST_VSplinePath::TestFlip()
     QCOMPARE(splPath.CountPoints(), res.CountPoints());
 }
 
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSplinePath::BenchmarkGetPoints_data()
+{
+    QTest::addColumn<bool>("cached");
+
+    QTest::newRow("Recalculate") << false;
+    QTest::newRow("Cached") << true;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSplinePath::BenchmarkGetPoints()
+{
+    QFETCH(bool, cached);
+
+    const QVector<VSplinePoint> points = SamplePath();
+    const VSplinePath splPath(points);
+    QCOMPARE(splPath.GetPoints(), VSplinePath(points).GetPoints());
+
+    if (cached)
+    {
+        QBENCHMARK
+        {
+            splPath.GetPoints();
+            splPath.GetLength();
+        }
+    }
+    else
+    {
+        QBENCHMARK
+        {
+            const VSplinePath fresh(points);
+            fresh.GetPoints();
+            fresh.GetLength();
+        }
+    }
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSplinePath::TestCutSplinePath_data()
+{
+    QTest::addColumn<qreal>("fraction");
+
+    QTest::newRow("Begin") << 0.05;
+    QTest::newRow("First spline") << 0.25;
+    QTest::newRow("Middle") << 0.5;
+    QTest::newRow("Second spline") << 0.75;
+    QTest::newRow("End") << 0.95;
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+void TST_VSplinePath::TestCutSplinePath()
+{
+    QFETCH(qreal, fraction);
+
+    const VSplinePath splPath(SamplePath());
+    const qreal length = splPath.GetLength() * fraction;
+
+    qint32 p1 = -1;
+    qint32 p2 = -1;
+    QPointF spl1p2;
+    QPointF spl1p3;
+    QPointF spl2p2;
+    QPointF spl2p3;
+    const QPointF cutPoint = splPath.CutSplinePath(length, p1, p2, spl1p2, spl1p3, spl2p2, spl2p3);
+    QVERIFY(p2 > 0);
+
+    qreal firstLength = 0;
+    for (qint32 i = 1; i < p2; ++i)
+    {
+        firstLength += splPath.GetSpline(i).GetLength();
+    }
+
+    const VSpline cutSpline = splPath.GetSpline(p2);
+    const VSpline first(cutSpline.GetP1(), spl1p2, spl1p3, VPointF(cutPoint));
+    const VSpline second(VPointF(cutPoint), spl2p2, spl2p3, cutSpline.GetP4());
+    firstLength += first.GetLength();
+
+    QVERIFY(qAbs(firstLength - length) < ToPixel(0.5, Unit::Mm));
+    QVERIFY(qAbs(first.GetLength() + second.GetLength() - cutSpline.GetLength()) < ToPixel(0.5, Unit::Mm));
+}
+
+//---------------------------------------------------------------------------------------------------------------------
+QVector<VSplinePoint> TST_VSplinePath::SamplePath()
+{
+    QVector<VSplinePoint> points;
+
+    {
+        VPointF pSpline(30, 39.999874015748034, "X", 5.0000125984251973, 9.9999874015748045);
+        VSplinePoint p(pSpline, 89.208600000000004, "89.2086", 269.20859999999999, "269.209", 0, "0",
+                       153.33618897637794, "4.05702");
+        points.append(p);
+    }
+
+    {
+        VPointF pSpline(198.77104389529981, 249.18158602595835, "X", 5.0000125984251973, 9.9999874015748045);
+        VSplinePoint p(pSpline, 146.43199999999999, "146.432", 326.43200000000002, "326.432",
+                       36.387590551181106, "0.962755", 60.978897637795278, "1.6134");
+        points.append(p);
+    }
+
+    {
+        VPointF pSpline(820.42771653543309, 417.95262992125987, "X", 5.0000125984251973, 9.9999874015748045);
+        VSplinePoint p(pSpline, 173.39500000000001, "173.395", 353.39499999999998, "353.395",
+                       381.23716535433073, "10.0869", 0, "0");
+        points.append(p);
+    }
+
+    return points;
+}
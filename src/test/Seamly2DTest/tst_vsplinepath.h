@@ -53,6 +53,9 @@
 #define TST_VSPLINEPATH_H
 
 #include <QObject>
+#include <QVector>
+
+class VSplinePoint;
 
 class TST_VSplinePath : public QObject
 {
@@ -64,8 +67,14 @@ private slots:
     void TestRotation();
     void TestFlip_data();
     void TestFlip();
+    void BenchmarkGetPoints_data();
+    void BenchmarkGetPoints();
+    void TestCutSplinePath_data();
+    void TestCutSplinePath();
 private:
     Q_DISABLE_COPY(TST_VSplinePath)
+
+    static QVector<VSplinePoint> SamplePath();
 };
 
 #endif // TST_VSPLINEPATH_H